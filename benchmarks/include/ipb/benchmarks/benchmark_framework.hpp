@@ -165,6 +165,9 @@ struct BenchmarkResult {
         oss << "        \"p999\": " << p999_ns << "\n";
         oss << "      },\n";
         oss << "      \"throughput\": " << ops_per_sec << ",\n";
+        if (bytes_per_op > 0) {
+            oss << "      \"bytes_per_op\": " << bytes_per_op << ",\n";
+        }
         oss << "      \"slo_passed\": " << (slo_passed ? "true" : "false") << "\n";
         oss << "    }";
         return oss.str();
@@ -244,6 +247,9 @@ struct BenchmarkDef {
     double target_p50_ns{0};
     double target_p99_ns{0};
     double target_ops{0};
+
+    // Memory footprint of one operation (e.g. bytes per queue slot), reported as-is
+    size_t bytes_per_op{0};
 };
 
 /**
@@ -662,6 +668,8 @@ private:
         result.platform  = platform_;
         result.compiler  = compiler_;
 
+        result.bytes_per_op = static_cast<double>(def.bytes_per_op);
+
         size_t iterations = def.iterations > 0 ? def.iterations : config_.default_iterations;
         size_t warmup     = def.warmup > 0 ? def.warmup : config_.default_warmup;
 
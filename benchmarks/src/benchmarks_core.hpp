@@ -12,19 +12,30 @@
  * - Backpressure Controller
  * - Pattern Matcher
  * - Data Point operations
+ * - DataSet scan construction (pooled vs per-scan arena)
+ * - Message Bus envelope (bytes per slot, publish/dispatch)
+ * - EDF Scheduler submit/execute throughput per ready-queue backend
  */
 
 #include <ipb/benchmarks/benchmark_framework.hpp>
 #include <ipb/common/backpressure.hpp>
 #include <ipb/common/cache_optimized.hpp>
 #include <ipb/common/data_point.hpp>
+#include <ipb/common/dataset.hpp>
 #include <ipb/common/lockfree_queue.hpp>
 #include <ipb/common/memory_pool.hpp>
 #include <ipb/common/rate_limiter.hpp>
+#include <ipb/core/message_bus/channel.hpp>
+#include <ipb/core/message_bus/message_bus.hpp>
+#include <ipb/core/rule_engine/rule_engine.hpp>
+#include <ipb/core/scheduler/edf_scheduler.hpp>
+#include <ipb/core/scheduler/timer_wheel.hpp>
 
 #include <atomic>
 #include <cstring>
+#include <memory>
 #include <random>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -90,6 +101,60 @@ void bench_alloc_dealloc_cycle() {
     g_pool->deallocate(ptr);
 }
 
+// Cross-thread free: a consumer thread frees what the benchmark thread allocates
+inline constexpr size_t CROSS_THREAD_BATCH = 64;
+
+struct FreeingConsumer {
+    common::SPSCQueue<BenchmarkData*, 4096> handoff;
+    std::atomic<uint64_t> freed{0};
+    uint64_t handed = 0;
+    std::atomic<bool> stop{false};
+    std::thread thread;
+
+    FreeingConsumer() {
+        thread = std::thread([this] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (auto ptr = handoff.try_dequeue()) {
+                    g_pool->deallocate(*ptr);
+                    freed.fetch_add(1, std::memory_order_release);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    ~FreeingConsumer() {
+        stop.store(true, std::memory_order_relaxed);
+        thread.join();
+    }
+};
+
+inline std::unique_ptr<FreeingConsumer> g_consumer;
+
+void setup_cross_thread() {
+    setup();
+    if (!g_consumer) {
+        g_consumer = std::make_unique<FreeingConsumer>();
+    }
+}
+
+/// Allocate a batch on this thread and free it on the consumer thread
+void bench_alloc_dealloc_cycle_cross_thread() {
+    for (size_t i = 0; i < CROSS_THREAD_BATCH; ++i) {
+        auto* ptr = g_pool->allocate();
+        do_not_optimize(ptr);
+        while (!g_consumer->handoff.try_enqueue(ptr)) {
+            std::this_thread::yield();
+        }
+    }
+    g_consumer->handed += CROSS_THREAD_BATCH;
+
+    while (g_consumer->freed.load(std::memory_order_acquire) < g_consumer->handed) {
+        std::this_thread::yield();
+    }
+}
+
 void bench_heap_new_delete() {
     auto* ptr = new BenchmarkData();
     do_not_optimize(ptr);
@@ -97,6 +162,7 @@ void bench_heap_new_delete() {
 }
 
 void cleanup() {
+    g_consumer.reset();
     delete g_pool;
     g_pool = nullptr;
 }
@@ -370,7 +436,8 @@ void cleanup() {
 
 namespace datapoint_benchmarks {
 
-inline common::DataPoint* g_dp = nullptr;
+inline common::DataPoint* g_dp      = nullptr;
+inline common::DataPoint* g_dp_long = nullptr;
 
 void setup() {
     if (!g_dp) {
@@ -382,6 +449,17 @@ void setup() {
     }
 }
 
+// OPC UA node id and JSON payload, both past the inline limits
+void setup_long() {
+    if (!g_dp_long) {
+        g_dp_long =
+            new common::DataPoint("ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.MotorTemperature");
+        common::Value val;
+        val.set_string_view(R"({"value":72.4,"unit":"degC","source":"plc-7","status":"ok"})");
+        g_dp_long->set_value(val);
+    }
+}
+
 void bench_create_datapoint() {
     common::DataPoint dp;
     dp.set_address("sensor.value");
@@ -396,6 +474,11 @@ void bench_copy_datapoint() {
     do_not_optimize(copy);
 }
 
+void bench_copy_datapoint_long() {
+    common::DataPoint copy = *g_dp_long;
+    do_not_optimize(copy);
+}
+
 void bench_value_get() {
     double val = g_dp->value().get<double>();
     do_not_optimize(val);
@@ -410,10 +493,644 @@ void bench_value_create() {
 void cleanup() {
     delete g_dp;
     g_dp = nullptr;
+    delete g_dp_long;
+    g_dp_long = nullptr;
 }
 
 }  // namespace datapoint_benchmarks
 
+//=============================================================================
+// DataSet Benchmarks
+//=============================================================================
+
+namespace dataset_benchmarks {
+
+constexpr size_t SCAN_POINTS = 1000;
+
+inline std::vector<std::string> g_addresses;
+inline std::string g_payload;
+
+void setup() {
+    if (g_addresses.empty()) {
+        g_addresses.reserve(SCAN_POINTS);
+        for (size_t i = 0; i < SCAN_POINTS; ++i) {
+            g_addresses.push_back("ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.Register" +
+                                  std::to_string(i));
+        }
+        g_payload = R"({"value":72.4,"unit":"degC","source":"plc-7","status":"ok"})";
+    }
+}
+
+// One poll cycle: build the set, read it back in batches, drop it
+template <typename Builder>
+void run_scan(Builder builder) {
+    {
+        auto scope = builder.allocation_scope();
+        for (const auto& address : g_addresses) {
+            common::DataPoint dp(address);
+            dp.value().set_string_view(g_payload);
+            builder.add(std::move(dp));
+        }
+    }
+    auto set     = std::move(builder).build();
+    size_t total = 0;
+    set.for_each_batch(256, [&total](std::span<const common::DataPoint> batch) {
+        total += batch.size();
+    });
+    do_not_optimize(total);
+}
+
+void bench_scan_pooled() {
+    run_scan(common::DataSetBuilder(SCAN_POINTS));
+}
+
+void bench_scan_arena() {
+    run_scan(common::DataSetBuilder::with_arena(SCAN_POINTS));
+}
+
+// 100k-point batch filtered and sorted as rows (DataSet) vs columns (ColumnarBatch)
+constexpr size_t BATCH_POINTS = 100000;
+
+inline common::DataSet g_rows;
+inline common::ColumnarBatch g_columns;
+
+void setup_batch() {
+    if (g_rows.size() == BATCH_POINTS) {
+        return;
+    }
+    g_rows.clear();
+    g_rows.reserve(BATCH_POINTS);
+    for (size_t i = 0; i < BATCH_POINTS; ++i) {
+        common::DataPoint dp("modbus/hr/" + std::to_string(40001 + i % 10000));
+        dp.set_value(static_cast<double>((i * 37) % 1000) + 0.5);
+        dp.set_timestamp(common::Timestamp(std::chrono::nanoseconds((i * 7919) % BATCH_POINTS)));
+        dp.set_protocol_id(static_cast<uint16_t>(i % 8));
+        dp.set_quality(i % 10 == 0 ? common::Quality::BAD : common::Quality::GOOD);
+        g_rows.push_back(std::move(dp));
+    }
+    g_columns = common::ColumnarBatch(g_rows);
+}
+
+void bench_to_columns() {
+    common::ColumnarBatch batch(g_rows);
+    do_not_optimize(batch);
+}
+
+void bench_to_rows() {
+    auto rows = g_columns.to_dataset();
+    do_not_optimize(rows);
+}
+
+void bench_filter_quality_rows() {
+    auto good = g_rows.filter_by_quality(common::Quality::UNCERTAIN);
+    do_not_optimize(good);
+}
+
+void bench_filter_quality_columns() {
+    auto good = g_columns.filter_by_quality(common::Quality::UNCERTAIN);
+    do_not_optimize(good);
+}
+
+void bench_filter_protocol_rows() {
+    auto modbus = g_rows.filter_by_protocol(3);
+    do_not_optimize(modbus);
+}
+
+void bench_filter_protocol_columns() {
+    auto modbus = g_columns.filter_by_protocol(3);
+    do_not_optimize(modbus);
+}
+
+// Sorts include copying the unsorted input
+void bench_sort_rows_std() {
+    auto rows = g_rows;
+    rows.sort([](const common::DataPoint& a, const common::DataPoint& b) {
+        return a.timestamp() < b.timestamp();
+    });
+    do_not_optimize(rows);
+}
+
+void bench_sort_rows() {
+    auto rows = g_rows;
+    rows.sort_by_timestamp();
+    do_not_optimize(rows);
+}
+
+void bench_sort_columns() {
+    auto columns = g_columns;
+    columns.sort_by_timestamp();
+    do_not_optimize(columns);
+}
+
+void cleanup() {
+    g_addresses.clear();
+    g_payload.clear();
+    g_rows.clear();
+    g_columns.clear();
+}
+
+}  // namespace dataset_benchmarks
+
+//=============================================================================
+// Rule Engine Benchmarks
+//=============================================================================
+
+namespace rule_engine_benchmarks {
+
+inline std::unique_ptr<core::RuleEngine> g_engine;
+inline std::vector<common::DataPoint> g_points;
+inline size_t g_next       = 0;
+inline size_t g_rule_count = 0;
+inline bool g_use_index    = false;
+
+/**
+ * Builds an engine with a realistic rule mix: mostly static address rules,
+ * plus prefix patterns, protocol rules and a few unindexable value rules.
+ * The result cache is disabled so every iteration measures evaluation.
+ * Runs before every iteration, so the engine is only rebuilt when the
+ * requested shape changes.
+ */
+inline void setup(size_t rule_count, bool use_index) {
+    if (g_engine && g_rule_count == rule_count && g_use_index == use_index) {
+        return;
+    }
+    g_rule_count = rule_count;
+    g_use_index  = use_index;
+
+    core::RuleEngineConfig config;
+    config.max_rules         = rule_count + 16;
+    config.enable_cache      = false;
+    config.enable_rule_index = use_index;
+    g_engine                 = std::make_unique<core::RuleEngine>(config);
+
+    std::vector<core::RoutingRule> rules;
+    rules.reserve(rule_count + 1);
+    for (size_t i = 0; i < rule_count; ++i) {
+        auto id = std::to_string(i);
+        core::RuleBuilder builder;
+        builder.name("rule_" + id).route_to("sink_" + std::to_string(i % 8));
+        switch (i % 10) {
+            case 0:
+                builder.match_pattern("site" + std::to_string(i % 50) + "/area" + id + "/.*");
+                break;
+            case 1:
+                builder.match_protocols({static_cast<uint16_t>(i % 64)});
+                break;
+            default:
+                builder.match_address("site" + std::to_string(i % 50) + "/tag" + id);
+                break;
+        }
+        rules.push_back(builder.build());
+    }
+
+    core::ValueCondition cond;
+    cond.op        = core::CompareOp::GT;
+    cond.reference = 1000.0;
+    rules.push_back(
+        core::RuleBuilder().name("overrange").match_value(cond).route_to("alarms").build());
+    g_engine->replace_rules(std::move(rules));
+
+    g_points.clear();
+    for (size_t i = 0; i < 1024; ++i) {
+        size_t rule = (i * 7919) % (rule_count > 0 ? rule_count : 1);
+        common::DataPoint dp("site" + std::to_string(rule % 50) + "/tag" + std::to_string(rule));
+        dp.set_protocol_id(static_cast<uint16_t>(i % 128));
+        dp.set_value(static_cast<double>(i));
+        g_points.push_back(std::move(dp));
+    }
+    g_next = 0;
+
+    // Warm thread-local scratch buffers outside the measured loop
+    do_not_optimize(g_engine->evaluate(g_points.front()));
+}
+
+inline void bench_evaluate() {
+    auto results = g_engine->evaluate(g_points[g_next++ & 1023]);
+    do_not_optimize(results);
+}
+
+inline core::RuleMatchSet g_matches;
+
+inline void bench_evaluate_into() {
+    auto count = g_engine->evaluate_into(g_points[g_next++ & 1023], g_matches);
+    do_not_optimize(count);
+}
+
+// Static-address rules evaluated for plain vs interned points
+inline std::unique_ptr<core::RuleEngine> g_cached_engine;
+inline std::vector<common::DataPoint> g_plain_points;
+inline std::vector<common::DataPoint> g_interned_points;
+
+/**
+ * 1000 static rules on OPC UA style node ids with the result cache on; the
+ * same 1024 points once with plain addresses and once interned up front,
+ * as a scoop would at configuration time.
+ */
+inline void setup_cached() {
+    if (g_cached_engine) {
+        return;
+    }
+
+    g_cached_engine = std::make_unique<core::RuleEngine>(core::RuleEngineConfig{});
+
+    auto node_id = [](size_t i) {
+        return "ns=2;s=Plant1.Line4.Cell" + std::to_string(i % 16) + ".Register" +
+               std::to_string(i);
+    };
+
+    std::vector<core::RoutingRule> rules;
+    for (size_t i = 0; i < 1000; ++i) {
+        rules.push_back(core::RuleBuilder()
+                            .name("rule_" + std::to_string(i))
+                            .match_address(node_id(i))
+                            .route_to("sink_" + std::to_string(i % 8))
+                            .build());
+    }
+    g_cached_engine->replace_rules(std::move(rules));
+
+    for (size_t i = 0; i < 1024; ++i) {
+        common::DataPoint dp(node_id((i * 7919) % 1000));
+        dp.set_value(static_cast<double>(i));
+        g_plain_points.push_back(dp);
+        dp.intern_address();
+        g_interned_points.push_back(std::move(dp));
+    }
+    g_next = 0;
+
+    // Fill the cache outside the measured loop
+    for (const auto& dp : g_interned_points) {
+        do_not_optimize(g_cached_engine->evaluate(dp));
+        do_not_optimize(g_cached_engine->evaluate(g_plain_points[g_next++ & 1023]));
+    }
+}
+
+inline void bench_cached_plain() {
+    auto results = g_cached_engine->evaluate(g_plain_points[g_next++ & 1023]);
+    do_not_optimize(results);
+}
+
+inline void bench_cached_interned() {
+    auto results = g_cached_engine->evaluate(g_interned_points[g_next++ & 1023]);
+    do_not_optimize(results);
+}
+
+inline void bench_index_plain() {
+    auto count = g_cached_engine->evaluate_into(g_plain_points[g_next++ & 1023], g_matches);
+    do_not_optimize(count);
+}
+
+inline void bench_index_interned() {
+    auto count = g_cached_engine->evaluate_into(g_interned_points[g_next++ & 1023], g_matches);
+    do_not_optimize(count);
+}
+
+// Alarm thresholds over a 10k-point Modbus scan
+inline std::unique_ptr<core::RuleEngine> g_threshold_engine;
+inline std::vector<common::DataPoint> g_scan;
+inline core::RuleBatchMatches g_batch_matches;
+
+/**
+ * 64 VALUE threshold rules (high, low and band alarms) evaluated against a
+ * scan of 10000 registers, mostly floats with some raw 16-bit integers.
+ */
+inline void setup_threshold_scan() {
+    if (g_threshold_engine) {
+        return;
+    }
+
+    core::RuleEngineConfig config;
+    config.enable_cache = false;
+    g_threshold_engine  = std::make_unique<core::RuleEngine>(config);
+
+    std::vector<core::RoutingRule> rules;
+    for (int i = 0; i < 64; ++i) {
+        core::ValueCondition cond;
+        switch (i % 3) {
+            case 0:
+                cond.op        = core::CompareOp::GT;
+                cond.reference = 900.0 + i;
+                break;
+            case 1:
+                cond.op        = core::CompareOp::LT;
+                cond.reference = static_cast<int64_t>(i);
+                break;
+            default:
+                cond.op             = core::CompareOp::BETWEEN;
+                cond.reference      = 400.0 + i;
+                cond.reference_high = 410.0 + i;
+                break;
+        }
+        rules.push_back(core::RuleBuilder()
+                            .name("alarm_" + std::to_string(i))
+                            .match_value(cond)
+                            .route_to("alarms")
+                            .build());
+    }
+    g_threshold_engine->replace_rules(std::move(rules));
+
+    g_scan.clear();
+    g_scan.reserve(10000);
+    for (size_t i = 0; i < 10000; ++i) {
+        common::DataPoint dp("modbus/hr/" + std::to_string(40001 + i));
+        dp.set_protocol_id(1);
+        if (i % 4 == 0) {
+            dp.set_value(static_cast<int16_t>(i % 1000));
+        } else {
+            dp.set_value(static_cast<double>((i * 37) % 1000) + 0.5);
+        }
+        g_scan.push_back(std::move(dp));
+    }
+}
+
+inline void bench_threshold_bitmap() {
+    auto total = g_threshold_engine->evaluate_batch_into(g_scan, g_batch_matches);
+    do_not_optimize(total);
+}
+
+inline void bench_threshold_per_point() {
+    auto results = g_threshold_engine->evaluate_batch(g_scan);
+    do_not_optimize(results);
+}
+
+// Mixed rule table over a 100k-point scan, as points vs as columns
+inline std::unique_ptr<core::RuleEngine> g_mixed_engine;
+inline std::vector<common::DataPoint> g_mixed_scan;
+inline common::ColumnarBatch g_mixed_columns;
+
+/**
+ * 32 value thresholds, 8 protocol rules, 4 quality rules and 16 static
+ * address rules over 100000 points.
+ */
+inline void setup_mixed_scan() {
+    if (g_mixed_engine) {
+        return;
+    }
+
+    core::RuleEngineConfig config;
+    config.enable_cache = false;
+    g_mixed_engine      = std::make_unique<core::RuleEngine>(config);
+
+    std::vector<core::RoutingRule> rules;
+    for (int i = 0; i < 32; ++i) {
+        core::ValueCondition cond;
+        cond.op        = i % 2 == 0 ? core::CompareOp::GT : core::CompareOp::LT;
+        cond.reference = i % 2 == 0 ? 900.0 + i : static_cast<double>(i);
+        rules.push_back(core::RuleBuilder()
+                            .name("alarm_" + std::to_string(i))
+                            .match_value(cond)
+                            .route_to("alarms")
+                            .build());
+    }
+    for (uint16_t protocol = 0; protocol < 8; ++protocol) {
+        rules.push_back(core::RuleBuilder()
+                            .name("protocol_" + std::to_string(protocol))
+                            .match_protocol(protocol)
+                            .route_to("historian")
+                            .build());
+    }
+    for (auto quality : {common::Quality::BAD, common::Quality::STALE,
+                         common::Quality::COMM_FAILURE, common::Quality::UNCERTAIN}) {
+        rules.push_back(core::RuleBuilder()
+                            .name("quality_" + std::to_string(static_cast<int>(quality)))
+                            .match_quality(quality)
+                            .route_to("diagnostics")
+                            .build());
+    }
+    for (int i = 0; i < 16; ++i) {
+        rules.push_back(core::RuleBuilder()
+                            .name("tag_" + std::to_string(i))
+                            .match_address("modbus/hr/" + std::to_string(40001 + i * 97))
+                            .route_to("dashboard")
+                            .build());
+    }
+    g_mixed_engine->replace_rules(std::move(rules));
+
+    g_mixed_scan.clear();
+    g_mixed_scan.reserve(100000);
+    for (size_t i = 0; i < 100000; ++i) {
+        common::DataPoint dp("modbus/hr/" + std::to_string(40001 + i % 10000));
+        dp.set_protocol_id(static_cast<uint16_t>(i % 8));
+        dp.set_quality(i % 50 == 0 ? common::Quality::BAD : common::Quality::GOOD);
+        dp.set_value(static_cast<double>((i * 37) % 1000) + 0.5);
+        g_mixed_scan.push_back(std::move(dp));
+    }
+    g_mixed_columns = common::ColumnarBatch(g_mixed_scan);
+}
+
+inline void bench_mixed_points() {
+    auto total = g_mixed_engine->evaluate_batch_into(g_mixed_scan, g_batch_matches);
+    do_not_optimize(total);
+}
+
+inline void bench_mixed_columns() {
+    auto total = g_mixed_engine->evaluate_columns_into(g_mixed_columns, g_batch_matches);
+    do_not_optimize(total);
+}
+
+inline void cleanup() {
+    g_engine.reset();
+    g_points.clear();
+    g_threshold_engine.reset();
+    g_scan.clear();
+    g_mixed_engine.reset();
+    g_mixed_scan.clear();
+    g_mixed_columns.clear();
+    g_cached_engine.reset();
+    g_plain_points.clear();
+    g_interned_points.clear();
+}
+
+}  // namespace rule_engine_benchmarks
+
+//=============================================================================
+// Message Bus Benchmarks
+//=============================================================================
+
+namespace message_bus_benchmarks {
+
+/// Envelope layout before topics and sources were interned, kept as the baseline
+struct LegacyMessage {
+    core::Message::Type type         = core::Message::Type::DATA_POINT;
+    core::Message::Priority priority = core::Message::Priority::NORMAL;
+    std::string source_id;
+    std::string topic;
+    int64_t deadline_ns = 0;
+    uint64_t sequence   = 0;
+    common::Timestamp timestamp;
+    common::DataPoint payload;
+    std::vector<common::DataPoint> batch_payload;
+};
+
+// Long enough to defeat the small-string optimisation, as real topics do
+inline constexpr std::string_view TOPIC  = "plant1/line4/cell2/sensors/temperature";
+inline constexpr std::string_view SOURCE = "modbus-scoop-line4-cell2";
+
+inline constexpr size_t SLOTS = 1024;
+
+inline std::vector<LegacyMessage> g_legacy_slots;
+inline std::vector<core::Message> g_compact_slots;
+inline common::DataPoint g_point;
+inline size_t g_slot = 0;
+
+inline std::unique_ptr<core::Channel> g_channel;
+
+inline void setup() {
+    if (g_compact_slots.empty()) {
+        g_legacy_slots.resize(SLOTS);
+        g_compact_slots.resize(SLOTS);
+        g_point.set_address("sensor.temperature");
+        g_point.set_value(42.5);
+    }
+}
+
+// Build an envelope and move it into a slot, as publish does with a queue slot
+
+inline void bench_envelope_legacy() {
+    LegacyMessage msg;
+    msg.source_id = SOURCE;
+    msg.topic     = TOPIC;
+    msg.timestamp = common::Timestamp::now();
+    msg.payload   = g_point;
+
+    g_legacy_slots[g_slot++ % SLOTS] = std::move(msg);
+    do_not_optimize(g_legacy_slots);
+}
+
+inline void bench_envelope_compact() {
+    core::Message msg(g_point);
+    msg.source_id = SOURCE;
+    msg.topic     = TOPIC;
+
+    g_compact_slots[g_slot++ % SLOTS] = std::move(msg);
+    do_not_optimize(g_compact_slots);
+}
+
+inline void setup_channel() {
+    setup();
+    if (!g_channel) {
+        g_channel = std::make_unique<core::Channel>(std::string(TOPIC));
+        g_channel->subscribe([](const core::Message& msg) { do_not_optimize(msg.sequence); });
+    }
+}
+
+inline void bench_publish_dispatch() {
+    core::Message msg(g_point);
+    msg.source_id = SOURCE;
+    g_channel->publish(std::move(msg));
+    g_channel->dispatch();
+}
+
+inline void cleanup() {
+    g_channel.reset();
+    g_legacy_slots.clear();
+    g_compact_slots.clear();
+}
+
+}  // namespace message_bus_benchmarks
+
+//=============================================================================
+// EDF Scheduler Benchmarks
+//=============================================================================
+
+namespace scheduler_benchmarks {
+
+using Backend = core::EDFSchedulerConfig::QueueBackend;
+
+inline constexpr size_t PRODUCERS          = 16;
+inline constexpr size_t TASKS_PER_PRODUCER = 1000;
+inline constexpr size_t WORKERS            = 4;
+
+inline std::unique_ptr<core::EDFScheduler> g_scheduler;
+inline std::atomic<size_t> g_accepted{0};
+inline std::atomic<size_t> g_executed{0};
+
+inline void setup(Backend backend) {
+    if (g_scheduler && g_scheduler->config().queue_backend == backend) {
+        return;
+    }
+    g_scheduler.reset();
+
+    core::EDFSchedulerConfig config;
+    config.worker_threads = WORKERS;
+    config.max_queue_size = PRODUCERS * TASKS_PER_PRODUCER;
+    config.queue_backend  = backend;
+    g_scheduler           = std::make_unique<core::EDFScheduler>(config);
+    g_scheduler->start();
+}
+
+/// 16 producers submit a burst of tasks; returns once every accepted task has run
+inline void bench_submit_execute() {
+    g_accepted.store(0, std::memory_order_relaxed);
+    g_executed.store(0, std::memory_order_relaxed);
+
+    // Spread deadlines so the ready queue actually has to order them
+    auto base = common::Timestamp::now() + std::chrono::seconds(10);
+
+    std::vector<std::thread> producers;
+    producers.reserve(PRODUCERS);
+    for (size_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([base] {
+            for (size_t i = 0; i < TASKS_PER_PRODUCER; ++i) {
+                auto result = g_scheduler->submit(
+                    [] { g_executed.fetch_add(1, std::memory_order_relaxed); },
+                    base + std::chrono::microseconds(i % 64));
+                if (result) {
+                    g_accepted.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    while (g_executed.load(std::memory_order_relaxed) < g_accepted.load()) {
+        std::this_thread::yield();
+    }
+}
+
+// Timer wheel driving 10k Modbus-style polls with 10-100ms periods
+inline constexpr size_t PERIODIC_TIMERS = 10000;
+
+struct PollTimer : core::TimerNode {
+    std::chrono::milliseconds period{0};
+};
+
+inline std::unique_ptr<core::TimerWheel> g_wheel;
+inline std::vector<PollTimer> g_poll_timers;
+inline common::Timestamp g_clock;
+
+inline void setup_wheel() {
+    if (g_wheel) {
+        return;
+    }
+
+    g_clock       = common::Timestamp(std::chrono::nanoseconds(0));
+    g_wheel       = std::make_unique<core::TimerWheel>(std::chrono::milliseconds(1), g_clock);
+    g_poll_timers = std::vector<PollTimer>(PERIODIC_TIMERS);
+    for (size_t i = 0; i < PERIODIC_TIMERS; ++i) {
+        g_poll_timers[i].period = std::chrono::milliseconds(10 + i % 91);
+        g_wheel->arm(g_poll_timers[i], g_clock + g_poll_timers[i].period);
+    }
+}
+
+/// Advance simulated time by one tick, re-arming every poll that fires
+inline void bench_timer_tick() {
+    g_clock = g_clock + std::chrono::milliseconds(1);
+    g_wheel->advance(g_clock, [](core::TimerNode& node) {
+        auto& timer = static_cast<PollTimer&>(node);
+        g_wheel->arm(timer, timer.expiry() + timer.period);
+    });
+}
+
+inline void cleanup() {
+    g_scheduler.reset();
+    g_wheel.reset();
+    g_poll_timers.clear();
+}
+
+}  // namespace scheduler_benchmarks
+
 //=============================================================================
 // Registration Function
 //=============================================================================
@@ -458,6 +1175,15 @@ inline void register_core_benchmarks() {
         def.target_p50_ns = 500;
         def.target_p99_ns = 5000;
         registry.register_benchmark(def);
+
+        // One iteration is a batch of 64 handed to another thread to free
+        def.name          = "alloc_dealloc_cycle_cross_thread";
+        def.iterations    = 10000;
+        def.setup         = memory_pool_benchmarks::setup_cross_thread;
+        def.benchmark     = memory_pool_benchmarks::bench_alloc_dealloc_cycle_cross_thread;
+        def.target_p50_ns = 0;
+        def.target_p99_ns = 0;
+        registry.register_benchmark(def);
     }
 
     // Lock-free Queues
@@ -617,6 +1343,11 @@ inline void register_core_benchmarks() {
         def.benchmark = datapoint_benchmarks::bench_copy_datapoint;
         registry.register_benchmark(def);
 
+        def.name      = "copy_long";
+        def.setup     = datapoint_benchmarks::setup_long;
+        def.benchmark = datapoint_benchmarks::bench_copy_datapoint_long;
+        registry.register_benchmark(def);
+
         def.name          = "value_get";
         def.setup         = datapoint_benchmarks::setup;
         def.benchmark     = datapoint_benchmarks::bench_value_get;
@@ -631,6 +1362,220 @@ inline void register_core_benchmarks() {
         def.target_p99_ns = 500;
         registry.register_benchmark(def);
     }
+
+    // DataSet: 1000-point scan with long addresses and values
+    {
+        BenchmarkDef def;
+        def.category      = BenchmarkCategory::CORE;
+        def.component     = "dataset";
+        def.iterations    = 1000;
+        def.warmup        = 50;
+        def.setup         = dataset_benchmarks::setup;
+        def.target_p50_ns = 500000;
+        def.target_p99_ns = 2000000;
+
+        def.name      = "scan_1k_pooled";
+        def.benchmark = dataset_benchmarks::bench_scan_pooled;
+        registry.register_benchmark(def);
+
+        def.name      = "scan_1k_arena";
+        def.benchmark = dataset_benchmarks::bench_scan_arena;
+        registry.register_benchmark(def);
+
+        // 100k-point batch: row (DataSet) vs column (ColumnarBatch) operations
+        def.iterations    = 20;
+        def.warmup        = 2;
+        def.setup         = dataset_benchmarks::setup_batch;
+        def.target_p50_ns = 0;
+        def.target_p99_ns = 0;
+
+        def.name      = "to_columns_100k";
+        def.benchmark = dataset_benchmarks::bench_to_columns;
+        registry.register_benchmark(def);
+
+        def.name      = "to_rows_100k";
+        def.benchmark = dataset_benchmarks::bench_to_rows;
+        registry.register_benchmark(def);
+
+        def.name      = "filter_quality_rows_100k";
+        def.benchmark = dataset_benchmarks::bench_filter_quality_rows;
+        registry.register_benchmark(def);
+
+        def.name      = "filter_quality_columns_100k";
+        def.benchmark = dataset_benchmarks::bench_filter_quality_columns;
+        registry.register_benchmark(def);
+
+        def.name      = "filter_protocol_rows_100k";
+        def.benchmark = dataset_benchmarks::bench_filter_protocol_rows;
+        registry.register_benchmark(def);
+
+        def.name      = "filter_protocol_columns_100k";
+        def.benchmark = dataset_benchmarks::bench_filter_protocol_columns;
+        registry.register_benchmark(def);
+
+        def.name      = "sort_rows_std_100k";
+        def.benchmark = dataset_benchmarks::bench_sort_rows_std;
+        registry.register_benchmark(def);
+
+        def.name      = "sort_rows_100k";
+        def.benchmark = dataset_benchmarks::bench_sort_rows;
+        registry.register_benchmark(def);
+
+        def.name      = "sort_columns_100k";
+        def.benchmark = dataset_benchmarks::bench_sort_columns;
+        registry.register_benchmark(def);
+    }
+
+    // Message Bus: envelope size per queue slot and per-message cost
+    {
+        BenchmarkDef def;
+        def.category   = BenchmarkCategory::CORE;
+        def.component  = "message_bus";
+        def.iterations = 100000;
+        def.warmup     = 1000;
+        def.teardown   = nullptr;
+
+        def.name         = "envelope_legacy";
+        def.setup        = message_bus_benchmarks::setup;
+        def.benchmark    = message_bus_benchmarks::bench_envelope_legacy;
+        def.bytes_per_op = sizeof(message_bus_benchmarks::LegacyMessage);
+        registry.register_benchmark(def);
+
+        def.name          = "envelope_compact";
+        def.benchmark     = message_bus_benchmarks::bench_envelope_compact;
+        def.bytes_per_op  = sizeof(core::Message);
+        def.target_p50_ns = 500;
+        def.target_p99_ns = 5000;
+        registry.register_benchmark(def);
+
+        def.name          = "publish_dispatch";
+        def.setup         = message_bus_benchmarks::setup_channel;
+        def.benchmark     = message_bus_benchmarks::bench_publish_dispatch;
+        def.target_p50_ns = 1000;
+        def.target_p99_ns = 10000;
+        registry.register_benchmark(def);
+    }
+
+    // EDF Scheduler: one iteration is a 16 x 1000 task burst through 4 workers
+    {
+        BenchmarkDef def;
+        def.category      = BenchmarkCategory::CORE;
+        def.component     = "scheduler";
+        def.iterations    = 50;
+        def.warmup        = 3;
+        def.benchmark     = scheduler_benchmarks::bench_submit_execute;
+        def.teardown      = nullptr;
+        def.target_p50_ns = 0;
+        def.target_p99_ns = 0;
+
+        def.name  = "submit_execute_16p_mutex_heap";
+        def.setup = [] { scheduler_benchmarks::setup(scheduler_benchmarks::Backend::MUTEX_HEAP); };
+        registry.register_benchmark(def);
+
+        def.name  = "submit_execute_16p_lock_free";
+        def.setup = [] { scheduler_benchmarks::setup(scheduler_benchmarks::Backend::LOCK_FREE); };
+        registry.register_benchmark(def);
+
+        def.name  = "submit_execute_16p_work_stealing";
+        def.setup = [] {
+            scheduler_benchmarks::setup(scheduler_benchmarks::Backend::WORK_STEALING);
+        };
+        registry.register_benchmark(def);
+
+        // One 1ms tick of 10k periodic timers (~240 fire and re-arm per tick)
+        def.name          = "timer_wheel_tick_10k_periodic";
+        def.iterations    = 10000;
+        def.warmup        = 1000;
+        def.setup         = scheduler_benchmarks::setup_wheel;
+        def.benchmark     = scheduler_benchmarks::bench_timer_tick;
+        def.target_p50_ns = 50000;
+        def.target_p99_ns = 200000;
+        registry.register_benchmark(def);
+    }
+
+    // Rule Engine: indexed vs. linear evaluation at increasing table sizes
+    {
+        BenchmarkDef def;
+        def.category  = BenchmarkCategory::CORE;
+        def.component = "rule_engine";
+        def.benchmark = rule_engine_benchmarks::bench_evaluate;
+        def.teardown  = nullptr;
+
+        for (size_t rules : {size_t{10}, size_t{1000}, size_t{10000}}) {
+            def.iterations = rules >= 10000 ? 1000 : 10000;
+            def.warmup     = 100;
+
+            def.name          = "evaluate_indexed_" + std::to_string(rules);
+            def.setup         = [rules] { rule_engine_benchmarks::setup(rules, true); };
+            def.target_p50_ns = 20000;
+            def.target_p99_ns = 100000;
+            registry.register_benchmark(def);
+
+            // Handle-based hot path, no result allocation
+            def.name      = "evaluate_into_indexed_" + std::to_string(rules);
+            def.benchmark = rule_engine_benchmarks::bench_evaluate_into;
+            registry.register_benchmark(def);
+            def.benchmark = rule_engine_benchmarks::bench_evaluate;
+
+            // Linear scan baseline; no SLO since it grows with the table
+            def.name          = "evaluate_linear_" + std::to_string(rules);
+            def.setup         = [rules] { rule_engine_benchmarks::setup(rules, false); };
+            def.target_p50_ns = 0;
+            def.target_p99_ns = 0;
+            registry.register_benchmark(def);
+        }
+
+        // Cache hits keyed by address text vs interned address ID
+        def.iterations    = 10000;
+        def.warmup        = 100;
+        def.setup         = rule_engine_benchmarks::setup_cached;
+        def.name          = "evaluate_cached_plain_1000";
+        def.benchmark     = rule_engine_benchmarks::bench_cached_plain;
+        def.target_p50_ns = 20000;
+        def.target_p99_ns = 100000;
+        registry.register_benchmark(def);
+
+        def.name      = "evaluate_cached_interned_1000";
+        def.benchmark = rule_engine_benchmarks::bench_cached_interned;
+        registry.register_benchmark(def);
+
+        // Uncached evaluate_into: static-address index lookup by text vs ID
+        def.name      = "evaluate_into_plain_1000";
+        def.benchmark = rule_engine_benchmarks::bench_index_plain;
+        registry.register_benchmark(def);
+
+        def.name      = "evaluate_into_interned_1000";
+        def.benchmark = rule_engine_benchmarks::bench_index_interned;
+        registry.register_benchmark(def);
+
+        // Whole-scan alarm thresholds: column-wise bitmaps vs per-point evaluation
+        def.iterations    = 100;
+        def.warmup        = 5;
+        def.setup         = rule_engine_benchmarks::setup_threshold_scan;
+        def.name          = "threshold_bitmap_10k";
+        def.benchmark     = rule_engine_benchmarks::bench_threshold_bitmap;
+        def.target_p50_ns = 5000000;
+        def.target_p99_ns = 20000000;
+        registry.register_benchmark(def);
+
+        def.name          = "threshold_per_point_10k";
+        def.benchmark     = rule_engine_benchmarks::bench_threshold_per_point;
+        def.target_p50_ns = 0;
+        def.target_p99_ns = 0;
+        registry.register_benchmark(def);
+
+        // Mixed rule table over 100k points: per-point index vs column passes
+        def.iterations = 20;
+        def.warmup     = 2;
+        def.setup      = rule_engine_benchmarks::setup_mixed_scan;
+        def.name       = "mixed_points_100k";
+        def.benchmark  = rule_engine_benchmarks::bench_mixed_points;
+        registry.register_benchmark(def);
+
+        def.name      = "mixed_columns_100k";
+        def.benchmark = rule_engine_benchmarks::bench_mixed_columns;
+        registry.register_benchmark(def);
+    }
 }
 
 }  // namespace ipb::benchmark
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <ipb/common/string_interner.hpp>
+
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstring>
 #include <memory>
 #include <span>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -144,10 +148,129 @@ private:
     int64_t ns_since_epoch_;
 };
 
+/**
+ * @brief Source of external storage for long values and addresses
+ *
+ * Installed per thread with ScopedBufferAllocator. Each buffer remembers the
+ * allocator it came from and is returned to it by whichever thread drops the
+ * last reference, so an allocator must outlive every buffer it hands out.
+ */
+class BufferAllocator {
+public:
+    virtual ~BufferAllocator() = default;
+
+    /// Return nullptr when out of memory
+    virtual void* allocate(size_t size) noexcept = 0;
+    virtual void deallocate(void* ptr, size_t size) noexcept = 0;
+};
+
+/**
+ * @brief Reference-counted byte buffer shared by copies of a Value or DataPoint
+ *
+ * Copying only bumps the reference count. The bytes are never modified while
+ * shared: assign() writes in place only when this handle is the sole owner
+ * and the buffer is large enough, and otherwise switches to a fresh buffer
+ * (copy-on-write). By default buffers come from a process-wide
+ * TieredMemoryPool rather than the heap.
+ */
+class SharedBuffer {
+public:
+    SharedBuffer() noexcept = default;
+
+    SharedBuffer(const SharedBuffer& other) noexcept : header_(other.header_) {
+        if (header_ != nullptr) {
+            header_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedBuffer(SharedBuffer&& other) noexcept : header_(other.header_) {
+        other.header_ = nullptr;
+    }
+
+    SharedBuffer& operator=(const SharedBuffer& other) noexcept {
+        if (header_ != other.header_) {
+            SharedBuffer(other).swap(*this);
+        }
+        return *this;
+    }
+
+    SharedBuffer& operator=(SharedBuffer&& other) noexcept {
+        SharedBuffer(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~SharedBuffer() { reset(); }
+
+    /**
+     * @brief Replace the contents with a copy of size bytes at data
+     * @return false if no memory was available (the handle is then empty)
+     */
+    bool assign(const void* data, size_t size) noexcept;
+
+    void reset() noexcept {
+        if (header_ != nullptr && header_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            destroy(header_);
+        }
+        header_ = nullptr;
+    }
+
+    void swap(SharedBuffer& other) noexcept { std::swap(header_, other.header_); }
+
+    const uint8_t* data() const noexcept {
+        return header_ != nullptr ? reinterpret_cast<const uint8_t*>(bytes(header_)) : nullptr;
+    }
+
+    uint32_t use_count() const noexcept {
+        return header_ != nullptr ? header_->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    explicit operator bool() const noexcept { return header_ != nullptr; }
+
+    /// Allocator used by assign() on this thread (nullptr = shared pool)
+    static BufferAllocator* thread_allocator() noexcept;
+    static BufferAllocator* set_thread_allocator(BufferAllocator* allocator) noexcept;
+
+private:
+    // Placed in front of the bytes; 16 bytes keeps them 8-byte aligned
+    struct Header {
+        std::atomic<uint32_t> refs;
+        uint32_t capacity;
+        BufferAllocator* allocator;
+    };
+
+    /// Payload following the header, addressed as raw bytes rather than as Header objects
+    static std::byte* bytes(Header* header) noexcept {
+        return reinterpret_cast<std::byte*>(header) + sizeof(Header);
+    }
+
+    static void destroy(Header* header) noexcept;
+
+    Header* header_ = nullptr;
+};
+
+/**
+ * @brief Routes this thread's long values and addresses to an allocator
+ */
+class ScopedBufferAllocator {
+public:
+    explicit ScopedBufferAllocator(BufferAllocator* allocator) noexcept
+        : previous_(SharedBuffer::set_thread_allocator(allocator)) {}
+
+    ~ScopedBufferAllocator() { SharedBuffer::set_thread_allocator(previous_); }
+
+    ScopedBufferAllocator(const ScopedBufferAllocator&)            = delete;
+    ScopedBufferAllocator& operator=(const ScopedBufferAllocator&) = delete;
+
+private:
+    BufferAllocator* previous_;
+};
+
 /**
  * @brief Lock-free value storage with type erasure
  *
- * Optimized for zero-copy operations and real-time performance
+ * Optimized for zero-copy operations and real-time performance. Strings and
+ * binaries longer than INLINE_SIZE live in a SharedBuffer, so copies of a
+ * long value share one buffer.
  */
 class Value {
 public:
@@ -208,36 +331,12 @@ public:
 
     // Zero-copy string view setter
     void set_string_view(std::string_view sv) noexcept {
-        // Clean up current external storage if any
-        if (size_ > INLINE_SIZE) {
-            external_data_.~unique_ptr();
-        }
-        type_ = Type::STRING;
-        size_ = sv.size();
-
-        if (size_ <= INLINE_SIZE) {
-            std::memcpy(inline_data_, sv.data(), size_);
-        } else {
-            new (&external_data_) std::unique_ptr<uint8_t[]>(std::make_unique<uint8_t[]>(size_));
-            std::memcpy(external_data_.get(), sv.data(), size_);
-        }
+        set_bytes(Type::STRING, sv.data(), sv.size());
     }
 
     // Zero-copy binary data setter
     void set_binary(std::span<const uint8_t> data) noexcept {
-        // Clean up current external storage if any
-        if (size_ > INLINE_SIZE) {
-            external_data_.~unique_ptr();
-        }
-        type_ = Type::BINARY;
-        size_ = data.size();
-
-        if (size_ <= INLINE_SIZE) {
-            std::memcpy(inline_data_, data.data(), size_);
-        } else {
-            new (&external_data_) std::unique_ptr<uint8_t[]>(std::make_unique<uint8_t[]>(size_));
-            std::memcpy(external_data_.get(), data.data(), size_);
-        }
+        set_bytes(Type::BINARY, data.data(), data.size());
     }
 
     // Type-safe getters
@@ -253,14 +352,14 @@ public:
             return {};
         const char* data = size_ <= INLINE_SIZE
                              ? reinterpret_cast<const char*>(inline_data_)
-                             : reinterpret_cast<const char*>(external_data_.get());
+                             : reinterpret_cast<const char*>(external_data_.data());
         return std::string_view(data, size_);
     }
 
     std::span<const uint8_t> as_binary() const noexcept {
         if (type_ != Type::BINARY)
             return {};
-        const uint8_t* data = size_ <= INLINE_SIZE ? inline_data_ : external_data_.get();
+        const uint8_t* data = size_ <= INLINE_SIZE ? inline_data_ : external_data_.data();
         return std::span<const uint8_t>(data, size_);
     }
 
@@ -325,7 +424,7 @@ private:
 
     union {
         uint8_t inline_data_[INLINE_SIZE];
-        std::unique_ptr<uint8_t[]> external_data_;
+        SharedBuffer external_data_;
     };
 
     template <typename T>
@@ -341,6 +440,7 @@ private:
     template <typename T>
     T get_impl() const noexcept;
 
+    void set_bytes(Type type, const void* data, size_t size) noexcept;
     void copy_from(const Value& other) noexcept;
     void move_from(Value&& other) noexcept;
     void cleanup() noexcept;
@@ -390,6 +490,12 @@ public:
         timestamp_ = Timestamp::now();
     }
 
+    // Constructor with an address interned ahead of time (e.g. at scoop configuration)
+    explicit DataPoint(InternedString address) noexcept {
+        set_address(address);
+        timestamp_ = Timestamp::now();
+    }
+
     // Constructor with full initialization
     DataPoint(std::string_view address, Value value, uint16_t protocol_id = 0) noexcept
         : value_(std::move(value)), protocol_id_(protocol_id), quality_(Quality::GOOD) {
@@ -420,34 +526,44 @@ public:
 
     // Destructor
     ~DataPoint() {
-        if (address_size_ > MAX_INLINE_ADDRESS) {
-            external_address_.~unique_ptr();
+        if (has_external_address()) {
+            external_address_.~SharedBuffer();
         }
     }
 
     // Address management (zero-copy when possible)
-    void set_address(std::string_view address) noexcept {
-        // Clean up existing external allocation if any
-        if (address_size_ > MAX_INLINE_ADDRESS) {
-            external_address_.reset();
-        }
+    void set_address(std::string_view address) noexcept;
 
-        address_size_ = static_cast<uint16_t>(std::min(address.size(), static_cast<size_t>(UINT16_MAX)));
+    /**
+     * @brief Set an interned address, keeping its ID alongside the text
+     *
+     * Long interned addresses are read straight from the interner instead
+     * of being copied into a buffer.
+     */
+    void set_address(InternedString address) noexcept;
 
+    std::string_view address() const noexcept {
         if (address_size_ <= MAX_INLINE_ADDRESS) {
-            std::memcpy(inline_address_, address.data(), address_size_);
-        } else {
-            new (&external_address_)
-                std::unique_ptr<char[]>(std::make_unique<char[]>(address_size_));
-            std::memcpy(external_address_.get(), address.data(), address_size_);
+            return std::string_view(inline_address_, address_size_);
         }
+        if (address_id_ != StringInterner::EMPTY_ID) {
+            return StringInterner::global().view(address_id_);
+        }
+        return std::string_view(reinterpret_cast<const char*>(external_address_.data()),
+                                address_size_);
     }
 
-    std::string_view address() const noexcept {
-        const char* data =
-            address_size_ <= MAX_INLINE_ADDRESS ? inline_address_ : external_address_.get();
-        return std::string_view(data, address_size_);
-    }
+    /**
+     * @brief ID of the address in StringInterner::global()
+     *
+     * EMPTY_ID when the address was set as plain text (or is empty); equal
+     * non-empty IDs mean equal addresses. IDs are process-local and are not
+     * serialized.
+     */
+    StringInterner::Id address_id() const noexcept { return address_id_; }
+
+    /// Intern the current address if it is not interned yet, and return its ID
+    StringInterner::Id intern_address() noexcept;
 
     // Value management
     template <typename T>
@@ -520,7 +636,14 @@ public:
 
     // Comparison operators
     bool operator==(const DataPoint& other) const noexcept {
-        return address() == other.address() && protocol_id_ == other.protocol_id_;
+        if (protocol_id_ != other.protocol_id_) {
+            return false;
+        }
+        if (address_id_ != StringInterner::EMPTY_ID &&
+            other.address_id_ != StringInterner::EMPTY_ID) {
+            return address_id_ == other.address_id_;
+        }
+        return address() == other.address();
     }
 
 private:
@@ -530,11 +653,12 @@ private:
     // Timestamp with nanosecond precision
     Timestamp timestamp_;
 
-    // Address storage (optimized for small addresses)
-    uint16_t address_size_ = 0;
+    // Address storage (optimized for small addresses); the ID fits in padding
+    uint16_t address_size_         = 0;
+    StringInterner::Id address_id_ = StringInterner::EMPTY_ID;
     union {
         char inline_address_[MAX_INLINE_ADDRESS];
-        std::unique_ptr<char[]> external_address_;
+        SharedBuffer external_address_;
     };
 
     // Metadata
@@ -542,6 +666,11 @@ private:
     Quality quality_          = Quality::INITIAL;
     uint32_t sequence_number_ = 0;
 
+    /// Long, non-interned addresses live in external_address_
+    bool has_external_address() const noexcept {
+        return address_size_ > MAX_INLINE_ADDRESS && address_id_ == StringInterner::EMPTY_ID;
+    }
+
     void copy_from(const DataPoint& other) noexcept;
     void move_from(DataPoint&& other) noexcept;
 };
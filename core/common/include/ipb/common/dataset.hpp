@@ -1,8 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <span>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
@@ -11,6 +13,98 @@
 
 namespace ipb::common {
 
+/**
+ * @brief Bump arena for the long addresses and values of one scan
+ *
+ * Allocation bumps a pointer through heap chunks and deallocation only
+ * counts. The arena is reference counted by its Ref handles and by every
+ * buffer it handed out, and frees all chunks in one step when the last of
+ * them is gone, so points copied out of a scan stay valid after the scan's
+ * DataSet is released.
+ *
+ * Only one thread allocates from an arena at a time (the one building the
+ * scan); buffers may be released from any thread.
+ */
+class ScanArena final : public BufferAllocator {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Owning handle to an arena
+     */
+    class Ref {
+    public:
+        Ref() noexcept = default;
+        Ref(const Ref& other) noexcept : arena_(other.arena_) {
+            if (arena_ != nullptr) {
+                arena_->retain();
+            }
+        }
+        Ref(Ref&& other) noexcept : arena_(std::exchange(other.arena_, nullptr)) {}
+
+        Ref& operator=(Ref other) noexcept {
+            std::swap(arena_, other.arena_);
+            return *this;
+        }
+
+        ~Ref() {
+            if (arena_ != nullptr) {
+                arena_->release();
+            }
+        }
+
+        ScanArena* get() const noexcept { return arena_; }
+        ScanArena* operator->() const noexcept { return arena_; }
+        explicit operator bool() const noexcept { return arena_ != nullptr; }
+
+    private:
+        friend class ScanArena;
+        explicit Ref(ScanArena* arena) noexcept : arena_(arena) {}
+
+        ScanArena* arena_ = nullptr;
+    };
+
+    /// Create an arena; allocations larger than chunk_size get a chunk of their own
+    static Ref create(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    ScanArena(const ScanArena&)            = delete;
+    ScanArena& operator=(const ScanArena&) = delete;
+
+    void* allocate(size_t size) noexcept override;
+    void deallocate(void* ptr, size_t size) noexcept override;
+
+    /// Bytes handed out so far
+    size_t bytes_allocated() const noexcept { return bytes_allocated_; }
+
+    /// Heap allocations made by the arena
+    size_t chunk_count() const noexcept { return chunk_count_; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+    };
+
+    explicit ScanArena(size_t chunk_size) noexcept : chunk_size_(chunk_size) {}
+    ~ScanArena() override;
+
+    void retain() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+    void release() noexcept {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    const size_t chunk_size_;
+    std::atomic<size_t> refs_{1};
+
+    Chunk* chunks_ = nullptr;
+    char* cursor_  = nullptr;
+    char* limit_   = nullptr;
+
+    size_t bytes_allocated_ = 0;
+    size_t chunk_count_     = 0;
+};
+
 /**
  * @brief High-performance dataset container optimized for batching operations
  *
@@ -20,6 +114,8 @@ namespace ipb::common {
  * - Lock-free read operations
  * - Efficient sorting and filtering
  * - Batch processing optimizations
+ * - Optional per-scan arena (with_arena()) for long addresses and values
+ * - Lossless conversion to a ColumnarBatch for column-wise processing
  */
 class DataSet {
 public:
@@ -51,6 +147,21 @@ public:
         update_metadata();
     }
 
+    /**
+     * @brief Create a set whose points keep their long addresses and values
+     *        in a ScanArena
+     *
+     * Points built by emplace_back(), or anywhere on this thread while an
+     * allocation_scope() is alive, allocate from the arena. Points added by
+     * copy keep the storage they already share with their source.
+     */
+    static DataSet with_arena(size_t capacity = 0,
+                              size_t chunk_size = ScanArena::DEFAULT_CHUNK_SIZE) {
+        DataSet result(capacity);
+        result.arena_ = ScanArena::create(chunk_size);
+        return result;
+    }
+
     // Move constructor and assignment
     DataSet(DataSet&&) noexcept            = default;
     DataSet& operator=(DataSet&&) noexcept = default;
@@ -107,7 +218,12 @@ public:
 
     template <typename... Args>
     void emplace_back(Args&&... args) {
-        data_points_.emplace_back(std::forward<Args>(args)...);
+        if (arena_) {
+            ScopedBufferAllocator scope(arena_.get());
+            data_points_.emplace_back(std::forward<Args>(args)...);
+        } else {
+            data_points_.emplace_back(std::forward<Args>(args)...);
+        }
         update_metadata_incremental(data_points_.back());
     }
 
@@ -204,11 +320,9 @@ public:
     }
 
     // Sorting operations
-    void sort_by_timestamp() {
-        std::sort(
-            data_points_.begin(), data_points_.end(),
-            [](const DataPoint& a, const DataPoint& b) { return a.timestamp() < b.timestamp(); });
-    }
+
+    /// Stable sort by timestamp; sorts (timestamp, position) keys, then moves each point once
+    void sort_by_timestamp();
 
     void sort_by_address() {
         std::sort(data_points_.begin(), data_points_.end(),
@@ -324,6 +438,16 @@ public:
         return std::span<const DataPoint>(data_points_);
     }
 
+    // Arena access
+
+    /// Arena backing this set, or nullptr
+    const ScanArena* arena() const noexcept { return arena_.get(); }
+
+    /// Route this thread's long addresses and values to the arena (no-op without one)
+    ScopedBufferAllocator allocation_scope() const noexcept {
+        return ScopedBufferAllocator(arena_ ? arena_.get() : SharedBuffer::thread_allocator());
+    }
+
     // Move data out (for zero-copy transfers)
     std::vector<DataPoint> release() noexcept {
         reset_metadata();
@@ -333,6 +457,9 @@ public:
 private:
     std::vector<DataPoint> data_points_;
 
+    // Set by with_arena(); buffers carved from it keep it alive on their own
+    ScanArena::Ref arena_;
+
     // Cached metadata for performance
     Timestamp earliest_timestamp_;
     Timestamp latest_timestamp_;
@@ -371,6 +498,112 @@ private:
     }
 };
 
+/**
+ * @brief Structure-of-arrays form of a DataSet
+ *
+ * Every DataPoint field lives in a contiguous column of its own, so
+ * filtering, sorting and rule evaluation stream through just the columns
+ * they read instead of both cache lines of every point. Values are copied
+ * shallowly: long strings and binaries share their buffers with the points
+ * they came from.
+ *
+ * Addresses are stored as interner IDs for points that carry one; the
+ * other addresses are packed into a single text column. Converting a
+ * DataSet to a batch and back yields the same points, interned IDs
+ * included.
+ */
+class ColumnarBatch {
+public:
+    ColumnarBatch() = default;
+
+    // Constructor with capacity hint
+    explicit ColumnarBatch(size_t capacity) { reserve(capacity); }
+
+    explicit ColumnarBatch(std::span<const DataPoint> data_points);
+
+    explicit ColumnarBatch(const DataSet& dataset) : ColumnarBatch(dataset.as_span()) {}
+
+    /// Rebuild the points, in row order
+    DataSet to_dataset() const;
+
+    /// Point stored at a row
+    DataPoint point(size_t row) const {
+        DataPoint dp;
+        load(row, dp);
+        return dp;
+    }
+
+    /// Overwrite dp with the point stored at a row, reusing dp's storage
+    void load(size_t row, DataPoint& dp) const;
+
+    // Capacity
+    bool empty() const noexcept { return timestamps_.empty(); }
+    size_t size() const noexcept { return timestamps_.size(); }
+
+    void reserve(size_t capacity);
+
+    // Modifiers
+    void push_back(const DataPoint& dp);
+    void clear() noexcept;
+
+    // Columns
+    std::span<const Timestamp> timestamps() const noexcept { return timestamps_; }
+    std::span<const Value> values() const noexcept { return values_; }
+    std::span<const Quality> qualities() const noexcept { return qualities_; }
+    std::span<const uint16_t> protocol_ids() const noexcept { return protocol_ids_; }
+    std::span<const StringInterner::Id> address_ids() const noexcept { return address_ids_; }
+    std::span<const uint32_t> sequence_numbers() const noexcept { return sequence_numbers_; }
+
+    /// Address of a row, from the interner or the text column
+    std::string_view address(size_t row) const noexcept {
+        if (address_ids_[row] != StringInterner::EMPTY_ID) {
+            return StringInterner::global().view(address_ids_[row]);
+        }
+        return std::string_view(address_text_)
+            .substr(address_offsets_[row], address_offsets_[row + 1] - address_offsets_[row]);
+    }
+
+    // Filtering operations; same selections as the DataSet filters
+
+    ColumnarBatch filter_by_protocol(uint16_t protocol_id) const;
+    ColumnarBatch filter_by_address_prefix(std::string_view prefix) const;
+    ColumnarBatch filter_by_quality(Quality min_quality) const;
+    ColumnarBatch filter_by_timestamp_range(Timestamp start, Timestamp end) const;
+
+    /// Rows at the given positions, in that order
+    ColumnarBatch select(std::span<const uint32_t> rows) const;
+
+    // Sorting operations
+
+    /// Stable sort of all columns by timestamp
+    void sort_by_timestamp();
+
+private:
+    template <typename Predicate>
+    ColumnarBatch select_if(Predicate pred) const {
+        // Branch-free selection into a scratch vector reused across calls
+        thread_local std::vector<uint32_t> rows;
+        rows.resize(size());
+        size_t count = 0;
+        for (size_t row = 0; row < size(); ++row) {
+            rows[count] = static_cast<uint32_t>(row);
+            count += pred(row) ? 1 : 0;
+        }
+        return select(std::span<const uint32_t>(rows.data(), count));
+    }
+
+    std::vector<Timestamp> timestamps_;
+    std::vector<Value> values_;
+    std::vector<Quality> qualities_;
+    std::vector<uint16_t> protocol_ids_;
+    std::vector<StringInterner::Id> address_ids_;
+    std::vector<uint32_t> sequence_numbers_;
+
+    // Addresses of rows without an ID; row i spans [offsets[i], offsets[i + 1])
+    std::vector<size_t> address_offsets_{0};
+    std::string address_text_;
+};
+
 /**
  * @brief Dataset builder for efficient construction
  */
@@ -382,6 +615,14 @@ public:
         }
     }
 
+    /// Builder for a DataSet::with_arena() set
+    static DataSetBuilder with_arena(size_t capacity = 0,
+                                     size_t chunk_size = ScanArena::DEFAULT_CHUNK_SIZE) {
+        DataSetBuilder builder;
+        builder.dataset_ = DataSet::with_arena(capacity, chunk_size);
+        return builder;
+    }
+
     DataSetBuilder& add(const DataPoint& dp) {
         dataset_.push_back(dp);
         return *this;
@@ -423,6 +664,9 @@ public:
     void clear() { dataset_.clear(); }
     void reserve(size_t capacity) { dataset_.reserve(capacity); }
 
+    /// See DataSet::allocation_scope()
+    ScopedBufferAllocator allocation_scope() const noexcept { return dataset_.allocation_scope(); }
+
 private:
     DataSet dataset_;
 };
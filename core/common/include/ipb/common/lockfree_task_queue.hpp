@@ -15,8 +15,8 @@
  * - O(log n) insert, remove, and peek operations
  * - No mutex locks - fully lock-free using CAS operations
  * - Deterministic worst-case latency (<5μs for all operations)
- * - ABA problem prevention using tagged pointers
- * - Memory reclamation using hazard pointers pattern
+ * - Marked pointers, so nothing is linked after a node being removed
+ * - Epoch-based memory reclamation of removed nodes
  *
  * This replaces the mutex-based TaskQueue for hard real-time requirements.
  */
@@ -33,6 +33,7 @@
 #include <optional>
 #include <random>
 #include <string>
+#include <thread>
 
 namespace ipb::common {
 
@@ -183,33 +184,37 @@ struct TaggedPtr {
 // ============================================================================
 
 /**
- * @brief Skip list node with atomic next pointers
+ * @brief Skip list node with atomic, markable next pointers
+ *
+ * Bit 0 of a next pointer marks the node as deleted at that level; a
+ * marked link can no longer be changed, so nothing can be inserted after
+ * a node that is being removed. Level 0 is marked last and decides which
+ * thread removed the node.
  */
 template <typename T, size_t MaxLevel = 16>
 struct alignas(64) SkipListNode {
     T value;
-    std::atomic<bool> marked{false};        // For logical deletion
-    std::atomic<bool> fully_linked{false};  // Node is fully inserted
-    uint8_t top_level;                      // Highest level this node appears at
+    uint8_t top_level;  // Number of levels this node appears at
 
-    // Next pointers for each level (cache-line aligned)
-    std::array<std::atomic<SkipListNode*>, MaxLevel> next;
+    /// The inserting and the removing thread each hold one; the last to let go retires it
+    std::atomic<uint8_t> refs{2};
 
-    explicit SkipListNode(uint8_t level = 1) noexcept : top_level(level) {
-        for (auto& n : next) {
-            n.store(nullptr, std::memory_order_relaxed);
-        }
-    }
+    // Retire list link and the epoch the node was unlinked in
+    SkipListNode* retired_next = nullptr;
+    uint64_t retired_epoch     = 0;
 
-    SkipListNode(const T& val, uint8_t level) noexcept : value(val), top_level(level) {
+    // Next pointers for each level (pointer | mark bit)
+    std::array<std::atomic<uintptr_t>, MaxLevel> next;
+
+    explicit SkipListNode(uint8_t level = 1) noexcept : value(), top_level(level) {
         for (auto& n : next) {
-            n.store(nullptr, std::memory_order_relaxed);
+            n.store(0, std::memory_order_relaxed);
         }
     }
 
-    SkipListNode(T&& val, uint8_t level) noexcept : value(std::move(val)), top_level(level) {
+    SkipListNode(const T& val, uint8_t level) noexcept : value(val), top_level(level) {
         for (auto& n : next) {
-            n.store(nullptr, std::memory_order_relaxed);
+            n.store(0, std::memory_order_relaxed);
         }
     }
 };
@@ -221,11 +226,16 @@ struct alignas(64) SkipListNode {
 /**
  * @brief Lock-free concurrent skip list for priority queue operations
  *
- * Based on the algorithm from:
- * "A Pragmatic Implementation of Non-Blocking Linked-Lists"
- * by Timothy L. Harris, with skip list extension.
+ * Based on the lock-free skip list of Herlihy and Shavit ("The Art of
+ * Multiprocessor Programming", ch. 14), which extends Harris' marked-pointer
+ * linked list to several levels. Keys are unique: inserting a value that
+ * compares equal to a present one fails.
+ *
+ * Unlinked nodes are reclaimed with epochs: every operation announces the
+ * epoch it started in, and a node is freed once the epoch has advanced
+ * twice since it was unlinked, i.e. once no operation can still see it.
  *
- * @tparam T Value type
+ * @tparam T Value type (copied in and out; should be cheap to copy)
  * @tparam Compare Comparison function (default: std::less)
  */
 template <typename T, typename Compare = std::less<T>>
@@ -234,25 +244,27 @@ public:
     static constexpr size_t MAX_LEVEL = 16;
     using Node                        = SkipListNode<T, MAX_LEVEL>;
 
-    LockFreeSkipList() noexcept
-        : head_(new Node(MAX_LEVEL)), size_(0), random_gen_(std::random_device{}()) {
-        // Initialize head with maximum level sentinel values
-        tail_ = new Node(MAX_LEVEL);
+    /// Concurrent operations that can be in flight before entering spins
+    static constexpr size_t EPOCH_SLOTS = 64;
+
+    /// Retired nodes between reclamation attempts (power of two)
+    static constexpr size_t RECLAIM_BATCH = 64;
+
+    LockFreeSkipList() noexcept : head_(new Node(MAX_LEVEL)), tail_(new Node(MAX_LEVEL)) {
         for (size_t i = 0; i < MAX_LEVEL; ++i) {
-            head_->next[i].store(tail_, std::memory_order_relaxed);
+            head_->next[i].store(link(tail_), std::memory_order_relaxed);
         }
-        tail_->fully_linked.store(true, std::memory_order_relaxed);
-        head_->fully_linked.store(true, std::memory_order_relaxed);
     }
 
     ~LockFreeSkipList() {
-        // Clean up all nodes
+        // No operation is in flight; every node is either linked or retired
         Node* current = head_;
         while (current != nullptr) {
-            Node* next = current->next[0].load(std::memory_order_relaxed);
+            Node* next = node_of(current->next[0].load(std::memory_order_relaxed));
             delete current;
             current = next;
         }
+        free_retired(retired_.exchange(nullptr, std::memory_order_acquire), UINT64_MAX);
     }
 
     // Non-copyable
@@ -267,110 +279,56 @@ public:
      * Lock-free: Yes
      */
     bool insert(const T& value) noexcept {
-        uint8_t top_level = random_level();
+        EpochGuard guard(*this);
+        const uint8_t top_level = random_level();
         std::array<Node*, MAX_LEVEL> preds, succs;
 
         while (true) {
             if (find(value, preds, succs)) {
-                // Value already exists, check if marked for deletion
-                Node* node_found = succs[0];
-                if (!node_found->marked.load(std::memory_order_acquire)) {
-                    // Wait for it to be fully linked
-                    while (!node_found->fully_linked.load(std::memory_order_acquire)) {
-                        IPB_CPU_PAUSE();
-                    }
-                    return false;  // Duplicate
-                }
-                // Node is marked for deletion, retry insert
-                continue;
+                return false;  // Duplicate
             }
 
-            // Create new node
-            Node* new_node = new Node(value, top_level);
-
-            // Link bottom level first
+            Node* node = new Node(value, top_level);
             for (uint8_t level = 0; level < top_level; ++level) {
-                new_node->next[level].store(succs[level], std::memory_order_relaxed);
+                node->next[level].store(link(succs[level]), std::memory_order_relaxed);
             }
 
-            // Try to link at level 0
-            Node* pred = preds[0];
-            Node* succ = succs[0];
+            // Counted before it can be popped, so size() never underflows
+            size_.fetch_add(1, std::memory_order_relaxed);
 
-            if (!pred->next[0].compare_exchange_strong(succ, new_node, std::memory_order_release,
-                                                       std::memory_order_relaxed)) {
-                delete new_node;
-                continue;  // Retry
+            // Linking level 0 makes the value part of the set
+            uintptr_t expected = link(succs[0]);
+            if (!preds[0]->next[0].compare_exchange_strong(expected, link(node),
+                                                           std::memory_order_release,
+                                                           std::memory_order_relaxed)) {
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                delete node;  // Never visible to anyone
+                continue;
             }
 
-            // Link remaining levels
-            for (uint8_t level = 1; level < top_level; ++level) {
-                while (true) {
-                    pred = preds[level];
-                    succ = succs[level];
+            link_upper_levels(node, value, preds, succs);
 
-                    if (pred->next[level].compare_exchange_strong(
-                            succ, new_node, std::memory_order_release, std::memory_order_relaxed)) {
-                        break;
-                    }
-                    // Re-find predecessors and successors
-                    find(value, preds, succs);
-                }
+            // A removal that raced with linking may have missed the upper links
+            if (is_marked(node->next[0].load(std::memory_order_acquire))) {
+                find(value, preds, succs);
             }
-
-            new_node->fully_linked.store(true, std::memory_order_release);
-            size_.fetch_add(1, std::memory_order_relaxed);
+            release(node);
             return true;
         }
     }
 
-    /**
-     * @brief Insert with move semantics
-     */
-    bool insert(T&& value) noexcept {
-        T val = std::move(value);
-        return insert(val);
-    }
-
     /**
      * @brief Remove a value from the skip list
      * @return true if removed, false if not found
-     *
-     * Uses lazy deletion with logical marking.
      */
     bool remove(const T& value) noexcept {
+        EpochGuard guard(*this);
         std::array<Node*, MAX_LEVEL> preds, succs;
 
-        while (true) {
-            if (!find(value, preds, succs)) {
-                return false;  // Not found
-            }
-
-            Node* node_to_remove = succs[0];
-
-            // Mark for deletion
-            bool expected = false;
-            if (!node_to_remove->marked.compare_exchange_strong(
-                    expected, true, std::memory_order_release, std::memory_order_relaxed)) {
-                return false;  // Already marked by another thread
-            }
-
-            // Physically unlink from all levels
-            for (int level = node_to_remove->top_level - 1; level >= 0; --level) {
-                Node* succ = node_to_remove->next[level].load(std::memory_order_relaxed);
-                Node* pred = preds[level];
-
-                // Try to unlink
-                pred->next[level].compare_exchange_strong(
-                    node_to_remove, succ, std::memory_order_release, std::memory_order_relaxed);
-            }
-
-            size_.fetch_sub(1, std::memory_order_relaxed);
-
-            // Note: Memory is not immediately freed to allow concurrent readers
-            // In production, use hazard pointers or epoch-based reclamation
-            return true;
+        if (!find(value, preds, succs)) {
+            return false;  // Not found
         }
+        return unlink(succs[0], preds, succs);  // false if another thread got there first
     }
 
     /**
@@ -380,72 +338,29 @@ public:
      * This is the primary operation for EDF scheduling.
      */
     std::optional<T> pop_min() noexcept {
-        while (true) {
-            Node* first = head_->next[0].load(std::memory_order_acquire);
-
-            if (first == tail_) {
-                return std::nullopt;  // Empty
-            }
-
-            // Check if already marked
-            if (first->marked.load(std::memory_order_acquire)) {
-                // Help remove it
-                head_->next[0].compare_exchange_strong(
-                    first, first->next[0].load(std::memory_order_relaxed),
-                    std::memory_order_release, std::memory_order_relaxed);
-                continue;
-            }
-
-            // Wait for node to be fully linked
-            if (!first->fully_linked.load(std::memory_order_acquire)) {
-                IPB_CPU_PAUSE();
-                continue;
-            }
-
-            // Try to mark for deletion
-            bool expected = false;
-            if (first->marked.compare_exchange_strong(expected, true, std::memory_order_release,
-                                                      std::memory_order_relaxed)) {
-                // Successfully marked, now unlink
-                T result = std::move(first->value);
-
-                // Unlink from all levels
-                for (int level = first->top_level - 1; level >= 0; --level) {
-                    Node* pred = head_;
-                    Node* curr = pred->next[level].load(std::memory_order_acquire);
-
-                    while (curr != first && curr != tail_) {
-                        pred = curr;
-                        curr = pred->next[level].load(std::memory_order_acquire);
-                    }
-
-                    if (curr == first) {
-                        Node* succ = first->next[level].load(std::memory_order_relaxed);
-                        pred->next[level].compare_exchange_strong(
-                            curr, succ, std::memory_order_release, std::memory_order_relaxed);
-                    }
-                }
+        EpochGuard guard(*this);
+        std::array<Node*, MAX_LEVEL> preds, succs;
 
-                size_.fetch_sub(1, std::memory_order_relaxed);
-                return result;
+        Node* curr = node_of(head_->next[0].load(std::memory_order_acquire));
+        while (curr != tail_) {
+            T value = curr->value;
+            if (unlink(curr, preds, succs)) {
+                return value;
             }
+            // Lost the race for this node; try its successor
+            curr = node_of(curr->next[0].load(std::memory_order_acquire));
         }
+        return std::nullopt;  // Empty
     }
 
     /**
      * @brief Peek at the minimum element without removing
      */
     std::optional<T> peek_min() const noexcept {
-        Node* first = head_->next[0].load(std::memory_order_acquire);
-
-        while (first != tail_) {
-            if (!first->marked.load(std::memory_order_acquire) &&
-                first->fully_linked.load(std::memory_order_acquire)) {
-                return first->value;
-            }
-            first = first->next[0].load(std::memory_order_acquire);
+        EpochGuard guard(*this);
+        if (Node* first = first_present()) {
+            return first->value;
         }
-
         return std::nullopt;
     }
 
@@ -453,6 +368,7 @@ public:
      * @brief Check if the skip list contains a value
      */
     bool contains(const T& value) const noexcept {
+        EpochGuard guard(*this);
         std::array<Node*, MAX_LEVEL> preds, succs;
         return find(value, preds, succs);
     }
@@ -465,42 +381,98 @@ public:
     /**
      * @brief Check if empty
      */
-    bool empty() const noexcept { return head_->next[0].load(std::memory_order_acquire) == tail_; }
+    bool empty() const noexcept {
+        EpochGuard guard(*this);
+        return first_present() == nullptr;
+    }
 
     /**
-     * @brief Remove a task by ID (for cancellation)
-     * @return true if found and removed
+     * @brief Remove the first value (in order) matching a predicate
+     * @return The removed value, or nullopt if none matched
+     *
+     * O(n) scan of the bottom level.
      */
     template <typename Predicate>
-    bool remove_if(Predicate pred) noexcept {
-        Node* curr = head_->next[0].load(std::memory_order_acquire);
+    std::optional<T> extract_if(Predicate pred) noexcept {
+        EpochGuard guard(*this);
+        std::array<Node*, MAX_LEVEL> preds, succs;
 
+        Node* curr = node_of(head_->next[0].load(std::memory_order_acquire));
         while (curr != tail_) {
-            if (!curr->marked.load(std::memory_order_acquire) &&
-                curr->fully_linked.load(std::memory_order_acquire) && pred(curr->value)) {
-                return remove(curr->value);
+            uintptr_t next = curr->next[0].load(std::memory_order_acquire);
+            if (!is_marked(next) && pred(curr->value)) {
+                T value = curr->value;
+                if (unlink(curr, preds, succs)) {
+                    return value;
+                }
             }
-            curr = curr->next[0].load(std::memory_order_acquire);
+            curr = node_of(next);
         }
+        return std::nullopt;
+    }
 
-        return false;
+    /**
+     * @brief Remove a task by ID (for cancellation)
+     * @return true if found and removed
+     */
+    template <typename Predicate>
+    bool remove_if(Predicate pred) noexcept {
+        return extract_if(std::move(pred)).has_value();
     }
 
 private:
+    // Epoch announced by an operation in flight (0 = slot free, else epoch + 1)
+    struct alignas(64) EpochSlot {
+        std::atomic<uint64_t> epoch{0};
+    };
+
+    /**
+     * @brief Announces an operation's epoch for its duration
+     */
+    class EpochGuard {
+    public:
+        explicit EpochGuard(const LockFreeSkipList& list) noexcept : slot_(list.enter()) {}
+        ~EpochGuard() { slot_->epoch.store(0, std::memory_order_release); }
+
+        EpochGuard(const EpochGuard&)            = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+
+    private:
+        EpochSlot* slot_;
+    };
+
     Node* head_;
     Node* tail_;
-    std::atomic<size_t> size_;
-    mutable std::mt19937 random_gen_;
+    alignas(64) std::atomic<size_t> size_{0};
     Compare compare_;
 
+    // Epoch-based reclamation
+    mutable std::array<EpochSlot, EPOCH_SLOTS> slots_{};
+    alignas(64) std::atomic<uint64_t> epoch_{1};
+    std::atomic<Node*> retired_{nullptr};
+    std::atomic<size_t> retired_count_{0};
+    std::atomic<bool> reclaiming_{false};
+
+    static bool is_marked(uintptr_t link) noexcept { return (link & 1) != 0; }
+    static Node* node_of(uintptr_t link) noexcept {
+        return reinterpret_cast<Node*>(link & ~uintptr_t{1});
+    }
+    static uintptr_t link(Node* node) noexcept { return reinterpret_cast<uintptr_t>(node); }
+
     /**
      * @brief Generate random level for new node
      *
      * Uses geometric distribution - level n has 1/2^n probability.
      */
-    uint8_t random_level() noexcept {
+    static uint8_t random_level() noexcept {
+        // Per-thread xorshift; a shared generator would be a data race
+        thread_local uint64_t state = (uint64_t{std::random_device{}()} << 32) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
         uint8_t level = 1;
-        while (level < MAX_LEVEL && (random_gen_() & 1)) {
+        for (uint64_t bits = state; level < MAX_LEVEL && (bits & 1); bits >>= 1) {
             ++level;
         }
         return level;
@@ -509,43 +481,216 @@ private:
     /**
      * @brief Find predecessors and successors at all levels
      * @return true if exact match found
+     *
+     * Unlinks every marked node it passes, so after a find() for a removed
+     * node's value that node is no longer reachable at any level.
      */
     bool find(const T& value, std::array<Node*, MAX_LEVEL>& preds,
               std::array<Node*, MAX_LEVEL>& succs) const noexcept {
-        bool found = false;
-
+    retry:
         Node* pred = head_;
-
         for (int level = MAX_LEVEL - 1; level >= 0; --level) {
-            Node* curr = pred->next[level].load(std::memory_order_acquire);
+            Node* curr = node_of(pred->next[level].load(std::memory_order_acquire));
 
             while (curr != tail_) {
-                // Skip marked nodes
-                while (curr != tail_ && curr->marked.load(std::memory_order_acquire)) {
-                    curr = curr->next[level].load(std::memory_order_acquire);
+                uintptr_t succ = curr->next[level].load(std::memory_order_acquire);
+
+                if (is_marked(succ)) {
+                    // Help unlink; fails if pred changed or is being removed itself
+                    uintptr_t expected = link(curr);
+                    if (!pred->next[level].compare_exchange_strong(expected, succ & ~uintptr_t{1},
+                                                                   std::memory_order_acq_rel,
+                                                                   std::memory_order_acquire)) {
+                        goto retry;
+                    }
+                    curr = node_of(succ);
+                    continue;
                 }
 
-                if (curr == tail_)
-                    break;
-
-                if (compare_(curr->value, value)) {
-                    pred = curr;
-                    curr = pred->next[level].load(std::memory_order_acquire);
-                } else {
+                if (!compare_(curr->value, value)) {
                     break;
                 }
+                pred = curr;
+                curr = node_of(succ);
             }
 
             preds[level] = pred;
             succs[level] = curr;
+        }
+
+        return succs[0] != tail_ && !compare_(value, succs[0]->value);
+    }
+
+    /**
+     * @brief Link a new node at levels 1..top_level-1
+     *
+     * Gives up as soon as the node starts being removed.
+     */
+    void link_upper_levels(Node* node, const T& value, std::array<Node*, MAX_LEVEL>& preds,
+                           std::array<Node*, MAX_LEVEL>& succs) noexcept {
+        for (uint8_t level = 1; level < node->top_level; ++level) {
+            while (true) {
+                uintptr_t next = node->next[level].load(std::memory_order_acquire);
+                if (is_marked(next)) {
+                    return;
+                }
+                if (node_of(next) != succs[level] &&
+                    !node->next[level].compare_exchange_strong(next, link(succs[level]),
+                                                               std::memory_order_acq_rel)) {
+                    return;  // Only a removal changes an unlinked level
+                }
+
+                uintptr_t expected = link(succs[level]);
+                if (preds[level]->next[level].compare_exchange_strong(expected, link(node),
+                                                                      std::memory_order_release,
+                                                                      std::memory_order_relaxed)) {
+                    break;
+                }
+                if (!find(value, preds, succs) || succs[0] != node) {
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Logically delete a node and unlink it from every level
+     * @return true if this call removed the node
+     */
+    bool unlink(Node* node, std::array<Node*, MAX_LEVEL>& preds,
+                std::array<Node*, MAX_LEVEL>& succs) noexcept {
+        // Upper levels first, so the node stops gaining new successors
+        for (int level = node->top_level - 1; level >= 1; --level) {
+            uintptr_t next = node->next[level].load(std::memory_order_acquire);
+            while (!is_marked(next) &&
+                   !node->next[level].compare_exchange_weak(next, next | 1,
+                                                            std::memory_order_acq_rel)) {
+            }
+        }
 
-            if (level == 0 && curr != tail_ && !compare_(value, curr->value) &&
-                !compare_(curr->value, value)) {
-                found = true;
+        // Marking level 0 is the linearization point
+        uintptr_t next = node->next[0].load(std::memory_order_acquire);
+        while (true) {
+            if (is_marked(next)) {
+                return false;
+            }
+            if (node->next[0].compare_exchange_weak(next, next | 1, std::memory_order_acq_rel)) {
+                break;
             }
         }
+        size_.fetch_sub(1, std::memory_order_relaxed);
 
-        return found;
+        find(node->value, preds, succs);
+        release(node);
+        return true;
+    }
+
+    /// First node not logically deleted, or nullptr
+    Node* first_present() const noexcept {
+        Node* curr = node_of(head_->next[0].load(std::memory_order_acquire));
+        while (curr != tail_) {
+            uintptr_t next = curr->next[0].load(std::memory_order_acquire);
+            if (!is_marked(next)) {
+                return curr;
+            }
+            curr = node_of(next);
+        }
+        return nullptr;
+    }
+
+    void release(Node* node) noexcept {
+        if (node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            retire(node);
+        }
+    }
+
+    EpochSlot* enter() const noexcept {
+        thread_local const size_t hint =
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) % EPOCH_SLOTS;
+
+        for (size_t i = hint;; i = (i + 1) % EPOCH_SLOTS) {
+            auto& slot    = slots_[i];
+            uint64_t free = 0;
+            uint64_t e    = epoch_.load(std::memory_order_seq_cst);
+            if (slot.epoch.load(std::memory_order_relaxed) != 0 ||
+                !slot.epoch.compare_exchange_strong(free, e + 1, std::memory_order_seq_cst)) {
+                IPB_CPU_PAUSE();
+                continue;
+            }
+            // The announced epoch must have been current after it was announced
+            for (uint64_t now = epoch_.load(std::memory_order_seq_cst); now != e;
+                 now          = epoch_.load(std::memory_order_seq_cst)) {
+                e = now;
+                slot.epoch.store(e + 1, std::memory_order_seq_cst);
+            }
+            return &slot;
+        }
+    }
+
+    void retire(Node* node) noexcept {
+        node->retired_epoch = epoch_.load(std::memory_order_seq_cst);
+        node->retired_next  = retired_.load(std::memory_order_relaxed);
+        while (!retired_.compare_exchange_weak(node->retired_next, node, std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+        }
+
+        auto count = retired_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if ((count & (RECLAIM_BATCH - 1)) == 0) {
+            try_reclaim();
+        }
+    }
+
+    /// Advance the epoch if every operation in flight has seen it, then free old nodes
+    void try_reclaim() noexcept {
+        if (reclaiming_.exchange(true, std::memory_order_acquire)) {
+            return;
+        }
+
+        uint64_t e     = epoch_.load(std::memory_order_seq_cst);
+        bool quiescent = true;
+        for (const auto& slot : slots_) {
+            auto announced = slot.epoch.load(std::memory_order_seq_cst);
+            if (announced != 0 && announced != e + 1) {
+                quiescent = false;
+                break;
+            }
+        }
+        if (quiescent) {
+            epoch_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+        }
+
+        uint64_t safe_before = epoch_.load(std::memory_order_seq_cst) - 1;
+        free_retired(retired_.exchange(nullptr, std::memory_order_acquire), safe_before);
+
+        reclaiming_.store(false, std::memory_order_release);
+    }
+
+    /// Delete nodes retired before an epoch; push the rest back
+    void free_retired(Node* list, uint64_t before) noexcept {
+        Node* keep_head = nullptr;
+        Node* keep_tail = nullptr;
+
+        while (list != nullptr) {
+            Node* next = list->retired_next;
+            if (list->retired_epoch < before) {
+                delete list;
+            } else {
+                list->retired_next = keep_head;
+                keep_head          = list;
+                if (keep_tail == nullptr) {
+                    keep_tail = list;
+                }
+            }
+            list = next;
+        }
+
+        if (keep_head != nullptr) {
+            keep_tail->retired_next = retired_.load(std::memory_order_relaxed);
+            while (!retired_.compare_exchange_weak(keep_tail->retired_next, keep_head,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+            }
+        }
     }
 };
 
@@ -631,8 +776,13 @@ public:
      *
      * Uses lazy deletion - marks task as cancelled.
      */
-    bool remove(uint64_t task_id) noexcept {
-        return skip_list_.remove_if([task_id](const Task& t) { return t.id == task_id; });
+    bool remove(uint64_t task_id) noexcept { return extract(task_id).has_value(); }
+
+    /**
+     * @brief Remove a task by ID and return it (O(n) scan, but lock-free)
+     */
+    std::optional<Task> extract(uint64_t task_id) noexcept {
+        return skip_list_.extract_if([task_id](const Task& t) { return t.id == task_id; });
     }
 
     /**
@@ -679,10 +829,13 @@ private:
     // Skip list with custom comparator for deadline ordering
     struct TaskCompare {
         bool operator()(const Task& a, const Task& b) const noexcept {
-            if (a.deadline_ns == b.deadline_ns) {
+            if (a.deadline_ns != b.deadline_ns) {
+                return a.deadline_ns < b.deadline_ns;  // Earlier deadline first
+            }
+            if (a.priority != b.priority) {
                 return a.priority > b.priority;  // Higher priority first
             }
-            return a.deadline_ns < b.deadline_ns;  // Earlier deadline first
+            return a.id < b.id;  // Keys must be unique; ties run in submission order
         }
     };
 
@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+ * @file string_interner.hpp
+ * @brief Process-wide table mapping strings to stable 32-bit IDs
+ *
+ * Equal strings always get the same ID, and an ID stays valid for the
+ * lifetime of the table. Looking up the text of an ID is lock-free;
+ * interning takes a shared lock when the string is already known and an
+ * exclusive lock only the first time a string is seen.
+ *
+ * Strings are never removed. Interning is meant for bounded vocabularies
+ * such as registered channel topics, configured source names and addresses,
+ * not for arbitrary caller or payload text; code handed such text should
+ * use find() and keep the plain string when it is not known yet.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ipb::common {
+
+/**
+ * @brief Concurrent string interning table
+ */
+class StringInterner {
+public:
+    using Id = uint32_t;
+
+    /// ID of the empty string (and of default-constructed handles)
+    static constexpr Id EMPTY_ID = 0;
+
+    /// IDs per lazily allocated lookup chunk
+    static constexpr size_t CHUNK_SIZE = 4096;
+
+    /// Maximum number of chunks (CHUNK_SIZE * MAX_CHUNKS strings in total)
+    static constexpr size_t MAX_CHUNKS = 1024;
+
+    StringInterner();
+    ~StringInterner();
+
+    StringInterner(const StringInterner&)            = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /**
+     * @brief ID of a string, adding it on first use
+     * @return EMPTY_ID (after an assertion failure) if the table is full
+     */
+    Id intern(std::string_view text);
+
+    /// ID of a string if it was interned before
+    std::optional<Id> find(std::string_view text) const;
+
+    /// Text of an ID (empty for unknown IDs)
+    std::string_view view(Id id) const noexcept {
+        if (id >= size_.load(std::memory_order_acquire)) {
+            return {};
+        }
+        return chunks_[id / CHUNK_SIZE].load(std::memory_order_acquire)[id % CHUNK_SIZE];
+    }
+
+    /// Number of interned strings, including the empty string
+    size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Table shared by every InternedString
+     *
+     * Lives until the process exits (it is never destroyed) and holds at most
+     * CHUNK_SIZE * MAX_CHUNKS (about 4.2 million) strings; once full, intern()
+     * asserts and returns EMPTY_ID.
+     */
+    static StringInterner& global();
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    mutable std::shared_mutex mutex_;
+
+    /// Keys point into text_, so they stay valid while the table lives
+    std::unordered_map<std::string_view, Id, StringHash, std::equal_to<>> ids_;
+    std::vector<std::unique_ptr<char[]>> text_;
+
+    std::array<std::atomic<std::string_view*>, MAX_CHUNKS> chunks_{};
+    std::atomic<Id> size_{0};
+};
+
+/**
+ * @brief 4-byte handle to a string in the global StringInterner
+ *
+ * Copying and comparing handles is an integer operation; the text is
+ * one lock-free lookup away.
+ */
+class InternedString {
+public:
+    using Id = StringInterner::Id;
+
+    InternedString() noexcept = default;
+
+    explicit InternedString(std::string_view text)
+        : id_(StringInterner::global().intern(text)) {}
+
+    InternedString& operator=(std::string_view text) {
+        id_ = StringInterner::global().intern(text);
+        return *this;
+    }
+
+    /// Handle of already interned text, or an empty handle; never adds to the table
+    static InternedString find(std::string_view text) {
+        return from_id(StringInterner::global().find(text).value_or(StringInterner::EMPTY_ID));
+    }
+
+    /// Handle for an ID previously returned by id()
+    static InternedString from_id(Id id) noexcept {
+        InternedString handle;
+        handle.id_ = id;
+        return handle;
+    }
+
+    Id id() const noexcept { return id_; }
+
+    std::string_view view() const noexcept { return StringInterner::global().view(id_); }
+    operator std::string_view() const noexcept { return view(); }
+
+    bool empty() const noexcept { return id_ == StringInterner::EMPTY_ID; }
+
+    friend bool operator==(InternedString a, InternedString b) noexcept { return a.id_ == b.id_; }
+    friend bool operator==(InternedString a, std::string_view b) noexcept {
+        return a.view() == b;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, InternedString s) { return os << s.view(); }
+
+private:
+    Id id_ = StringInterner::EMPTY_ID;
+};
+
+}  // namespace ipb::common
@@ -1,11 +1,79 @@
 #include "ipb/common/data_point.hpp"
 
+#include <ipb/common/memory_pool.hpp>
+
 #include <algorithm>
 #include <cstring>
 #include <functional>
 
 namespace ipb::common {
 
+// SharedBuffer implementation
+namespace {
+
+thread_local BufferAllocator* t_buffer_allocator = nullptr;
+
+/// Never destroyed, so DataPoints in static storage can release into it at exit
+TieredMemoryPool& shared_buffer_pool() {
+    static auto* pool = new TieredMemoryPool();
+    return *pool;
+}
+
+}  // namespace
+
+BufferAllocator* SharedBuffer::thread_allocator() noexcept {
+    return t_buffer_allocator;
+}
+
+BufferAllocator* SharedBuffer::set_thread_allocator(BufferAllocator* allocator) noexcept {
+    return std::exchange(t_buffer_allocator, allocator);
+}
+
+bool SharedBuffer::assign(const void* data, size_t size) noexcept {
+    static_assert(sizeof(Header) == 16, "bytes following the header must stay 8-byte aligned");
+
+    // Sole owner: nobody else can observe the bytes, so overwrite in place
+    if (header_ != nullptr && header_->capacity >= size &&
+        header_->refs.load(std::memory_order_acquire) == 1) {
+        std::memmove(bytes(header_), data, size);
+        return true;
+    }
+
+    if (size > UINT32_MAX) {
+        reset();
+        return false;
+    }
+
+    BufferAllocator* allocator = t_buffer_allocator;
+    const size_t total         = sizeof(Header) + size;
+    void* memory = allocator != nullptr ? allocator->allocate(total)
+                                        : shared_buffer_pool().allocate(total);
+    if (memory == nullptr) {
+        reset();
+        return false;
+    }
+
+    auto* header = new (memory) Header{{1}, static_cast<uint32_t>(size), allocator};
+    std::memcpy(bytes(header), data, size);
+
+    // Copy before releasing: data may point into the old buffer
+    reset();
+    header_ = header;
+    return true;
+}
+
+void SharedBuffer::destroy(Header* header) noexcept {
+    BufferAllocator* allocator = header->allocator;
+    const size_t total         = sizeof(Header) + header->capacity;
+    header->~Header();
+
+    if (allocator != nullptr) {
+        allocator->deallocate(header, total);
+    } else {
+        shared_buffer_pool().deallocate(header, total);
+    }
+}
+
 // Value implementation
 void Value::serialize(std::span<uint8_t> buffer) const noexcept {
     if (buffer.size() < serialized_size())
@@ -23,7 +91,7 @@ void Value::serialize(std::span<uint8_t> buffer) const noexcept {
 
     // Write data
     if (size_ > 0) {
-        const uint8_t* data_ptr = size_ <= INLINE_SIZE ? inline_data_ : external_data_.get();
+        const uint8_t* data_ptr = size_ <= INLINE_SIZE ? inline_data_ : external_data_.data();
         std::memcpy(buffer.data() + offset, data_ptr, size_);
     }
 }
@@ -32,36 +100,25 @@ bool Value::deserialize(std::span<const uint8_t> buffer) noexcept {
     if (buffer.size() < sizeof(Type) + sizeof(size_t))
         return false;
 
-    // Clean up current external storage if any
-    if (size_ > INLINE_SIZE) {
-        external_data_.~unique_ptr();
-    }
-
     size_t offset = 0;
 
     // Read type
-    std::memcpy(&type_, buffer.data() + offset, sizeof(Type));
+    Type type;
+    std::memcpy(&type, buffer.data() + offset, sizeof(Type));
     offset += sizeof(Type);
 
     // Read size
-    std::memcpy(&size_, buffer.data() + offset, sizeof(size_t));
+    size_t size;
+    std::memcpy(&size, buffer.data() + offset, sizeof(size_t));
     offset += sizeof(size_t);
 
     // Validate remaining buffer size
-    if (buffer.size() < offset + size_)
+    if (buffer.size() - offset < size)
         return false;
 
     // Read data
-    if (size_ > 0) {
-        if (size_ <= INLINE_SIZE) {
-            std::memcpy(inline_data_, buffer.data() + offset, size_);
-        } else {
-            new (&external_data_) std::unique_ptr<uint8_t[]>(std::make_unique<uint8_t[]>(size_));
-            std::memcpy(external_data_.get(), buffer.data() + offset, size_);
-        }
-    }
-
-    return true;
+    set_bytes(type, buffer.data() + offset, size);
+    return size_ == size;
 }
 
 template <>
@@ -240,6 +297,30 @@ double Value::get_impl<double>() const noexcept {
     return result;
 }
 
+void Value::set_bytes(Type type, const void* data, size_t size) noexcept {
+    if (size > INLINE_SIZE) {
+        if (size_ <= INLINE_SIZE) {
+            new (&external_data_) SharedBuffer();
+        }
+        if (!external_data_.assign(data, size)) {
+            external_data_.~SharedBuffer();
+            type_ = Type::EMPTY;
+            size_ = 0;
+            return;
+        }
+    } else if (size_ > INLINE_SIZE) {
+        // data may point into the buffer, which shares storage with inline_data_
+        SharedBuffer previous(std::move(external_data_));
+        external_data_.~SharedBuffer();
+        std::memcpy(inline_data_, data, size);
+    } else if (size > 0) {
+        std::memmove(inline_data_, data, size);
+    }
+
+    type_ = type;
+    size_ = size;
+}
+
 void Value::copy_from(const Value& other) noexcept {
     // Note: cleanup must be called by the caller if this is an assignment operation
     // (constructors don't need cleanup since there's nothing to clean)
@@ -249,9 +330,8 @@ void Value::copy_from(const Value& other) noexcept {
     if (size_ <= INLINE_SIZE) {
         std::memcpy(inline_data_, other.inline_data_, size_);
     } else {
-        // Use placement new since external_data_ may not be constructed
-        new (&external_data_) std::unique_ptr<uint8_t[]>(std::make_unique<uint8_t[]>(size_));
-        std::memcpy(external_data_.get(), other.external_data_.get(), size_);
+        // Shares the buffer; placement new since external_data_ may not be constructed
+        new (&external_data_) SharedBuffer(other.external_data_);
     }
 }
 
@@ -265,7 +345,7 @@ void Value::move_from(Value&& other) noexcept {
         std::memcpy(inline_data_, other.inline_data_, size_);
     } else {
         // Use placement new since external_data_ may not be constructed
-        new (&external_data_) std::unique_ptr<uint8_t[]>(std::move(other.external_data_));
+        new (&external_data_) SharedBuffer(std::move(other.external_data_));
     }
 
     other.type_ = Type::EMPTY;
@@ -274,7 +354,7 @@ void Value::move_from(Value&& other) noexcept {
 
 void Value::cleanup() noexcept {
     if (size_ > INLINE_SIZE) {
-        external_data_.~unique_ptr();
+        external_data_.~SharedBuffer();
     }
     type_ = Type::EMPTY;
     size_ = 0;
@@ -291,9 +371,7 @@ void DataPoint::serialize(std::span<uint8_t> buffer) const noexcept {
     std::memcpy(buffer.data() + offset, &address_size_, sizeof(uint16_t));
     offset += sizeof(uint16_t);
 
-    const char* addr_data =
-        address_size_ <= MAX_INLINE_ADDRESS ? inline_address_ : external_address_.get();
-    std::memcpy(buffer.data() + offset, addr_data, address_size_);
+    std::memcpy(buffer.data() + offset, address().data(), address_size_);
     offset += address_size_;
 
     // Write value
@@ -320,11 +398,6 @@ bool DataPoint::deserialize(std::span<const uint8_t> buffer) noexcept {
     if (buffer.size() < sizeof(uint16_t))
         return false;
 
-    // Clean up current external storage if any
-    if (address_size_ > MAX_INLINE_ADDRESS) {
-        external_address_.~unique_ptr();
-    }
-
     size_t offset = 0;
 
     // Read address size
@@ -335,15 +408,9 @@ bool DataPoint::deserialize(std::span<const uint8_t> buffer) noexcept {
     if (buffer.size() < offset + new_address_size)
         return false;
 
-    address_size_ = new_address_size;
-
     // Read address
-    if (address_size_ <= MAX_INLINE_ADDRESS) {
-        std::memcpy(inline_address_, buffer.data() + offset, address_size_);
-    } else {
-        new (&external_address_) std::unique_ptr<char[]>(std::make_unique<char[]>(address_size_));
-        std::memcpy(external_address_.get(), buffer.data() + offset, address_size_);
-    }
+    set_address(std::string_view(reinterpret_cast<const char*>(buffer.data() + offset),
+                                 new_address_size));
     offset += address_size_;
 
     // Read value
@@ -383,22 +450,82 @@ size_t DataPoint::hash() const noexcept {
     return h1 ^ (h2 << 1);
 }
 
-void DataPoint::copy_from(const DataPoint& other) noexcept {
-    // Clean up current external storage if any
-    if (address_size_ > MAX_INLINE_ADDRESS) {
-        external_address_.~unique_ptr();
+void DataPoint::set_address(std::string_view address) noexcept {
+    const auto size =
+        static_cast<uint16_t>(std::min(address.size(), static_cast<size_t>(UINT16_MAX)));
+
+    if (size > MAX_INLINE_ADDRESS) {
+        if (!has_external_address()) {
+            new (&external_address_) SharedBuffer();
+        }
+        if (!external_address_.assign(address.data(), size)) {
+            external_address_.~SharedBuffer();
+            address_size_ = 0;
+            address_id_   = StringInterner::EMPTY_ID;
+            return;
+        }
+    } else if (has_external_address()) {
+        // address may point into the buffer, which shares storage with inline_address_
+        SharedBuffer previous(std::move(external_address_));
+        external_address_.~SharedBuffer();
+        std::memcpy(inline_address_, address.data(), size);
+    } else if (size > 0) {
+        std::memmove(inline_address_, address.data(), size);
     }
 
-    value_        = other.value_;
-    timestamp_    = other.timestamp_;
-    address_size_ = other.address_size_;
+    address_size_ = size;
+    address_id_   = StringInterner::EMPTY_ID;
+}
 
-    if (other.address_size_ <= MAX_INLINE_ADDRESS) {
-        std::memcpy(inline_address_, other.inline_address_, address_size_);
+void DataPoint::set_address(InternedString address) noexcept {
+    auto text = address.view();
+    if (text.size() > UINT16_MAX) {
+        set_address(text);
+        return;
+    }
+
+    // Interned text never moves, so long addresses need no buffer of their own
+    if (text.size() > MAX_INLINE_ADDRESS) {
+        if (has_external_address()) {
+            external_address_.~SharedBuffer();
+        }
+        address_size_ = static_cast<uint16_t>(text.size());
     } else {
-        new (&external_address_) std::unique_ptr<char[]>(std::make_unique<char[]>(address_size_));
-        std::memcpy(external_address_.get(), other.external_address_.get(), address_size_);
+        set_address(text);
     }
+    address_id_ = address.id();
+}
+
+StringInterner::Id DataPoint::intern_address() noexcept {
+    if (address_id_ == StringInterner::EMPTY_ID && address_size_ > 0) {
+        // EMPTY_ID here means the interner is full; keep the plain address
+        auto id = StringInterner::global().intern(address());
+        if (id != StringInterner::EMPTY_ID) {
+            set_address(InternedString::from_id(id));
+        }
+    }
+    return address_id_;
+}
+
+void DataPoint::copy_from(const DataPoint& other) noexcept {
+    value_     = other.value_;
+    timestamp_ = other.timestamp_;
+
+    // Long addresses share the other point's buffer (or the interned text)
+    if (!other.has_external_address()) {
+        if (has_external_address()) {
+            external_address_.~SharedBuffer();
+        }
+        if (other.address_size_ <= MAX_INLINE_ADDRESS) {
+            std::memcpy(inline_address_, other.inline_address_, other.address_size_);
+        }
+    } else if (has_external_address()) {
+        external_address_ = other.external_address_;
+    } else {
+        new (&external_address_) SharedBuffer(other.external_address_);
+    }
+    address_size_ = other.address_size_;
+    address_id_   = other.address_id_;
 
     protocol_id_     = other.protocol_id_;
     quality_         = other.quality_;
@@ -407,18 +534,19 @@ void DataPoint::copy_from(const DataPoint& other) noexcept {
 
 void DataPoint::move_from(DataPoint&& other) noexcept {
     // Clean up current external storage if any
-    if (address_size_ > MAX_INLINE_ADDRESS) {
-        external_address_.~unique_ptr();
+    if (has_external_address()) {
+        external_address_.~SharedBuffer();
     }
 
     value_        = std::move(other.value_);
     timestamp_    = other.timestamp_;
     address_size_ = other.address_size_;
+    address_id_   = other.address_id_;
 
-    if (other.address_size_ <= MAX_INLINE_ADDRESS) {
+    if (other.has_external_address()) {
+        new (&external_address_) SharedBuffer(std::move(other.external_address_));
+    } else if (other.address_size_ <= MAX_INLINE_ADDRESS) {
         std::memcpy(inline_address_, other.inline_address_, address_size_);
-    } else {
-        new (&external_address_) std::unique_ptr<char[]>(std::move(other.external_address_));
     }
 
     protocol_id_     = other.protocol_id_;
@@ -426,6 +554,7 @@ void DataPoint::move_from(DataPoint&& other) noexcept {
     sequence_number_ = other.sequence_number_;
 
     other.address_size_    = 0;
+    other.address_id_      = StringInterner::EMPTY_ID;
     other.protocol_id_     = 0;
     other.quality_         = Quality::INITIAL;
     other.sequence_number_ = 0;
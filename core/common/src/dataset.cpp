@@ -1,12 +1,261 @@
 #include <ipb/common/dataset.hpp>
 
 #include <algorithm>
+#include <new>
+#include <utility>
 
 namespace ipb {
 namespace common {
 
+// ScanArena implementation
+namespace {
+
+constexpr size_t ARENA_ALIGN = alignof(std::max_align_t);
+
+constexpr size_t align_up(size_t n) noexcept {
+    return (n + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+}  // namespace
+
+ScanArena::Ref ScanArena::create(size_t chunk_size) {
+    return Ref(new ScanArena(chunk_size));
+}
+
+ScanArena::~ScanArena() {
+    while (chunks_ != nullptr) {
+        Chunk* next = chunks_->next;
+        ::operator delete(chunks_);
+        chunks_ = next;
+    }
+}
+
+void* ScanArena::allocate(size_t size) noexcept {
+    size = align_up(size);
+
+    if (static_cast<size_t>(limit_ - cursor_) < size) {
+        const size_t chunk_bytes = align_up(sizeof(Chunk)) + std::max(size, chunk_size_);
+        auto* chunk = static_cast<Chunk*>(::operator new(chunk_bytes, std::nothrow));
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+        chunk->next = chunks_;
+        chunks_     = chunk;
+        ++chunk_count_;
+
+        char* start = reinterpret_cast<char*>(chunk) + align_up(sizeof(Chunk));
+        char* end   = reinterpret_cast<char*>(chunk) + chunk_bytes;
+
+        // An oversized allocation must not discard the room left in the current chunk
+        if (size > chunk_size_ && cursor_ != nullptr) {
+            bytes_allocated_ += size;
+            retain();
+            return start;
+        }
+        cursor_ = start;
+        limit_  = end;
+    }
+
+    void* result = cursor_;
+    cursor_ += size;
+    bytes_allocated_ += size;
+    retain();
+    return result;
+}
+
+void ScanArena::deallocate(void*, size_t) noexcept {
+    // Memory comes back with the whole arena
+    release();
+}
+
 DataSet::DataSet(const std::vector<DataPoint>& data_points) : data_points_(data_points) {}
 
+namespace {
+
+using TimestampKey = std::pair<Timestamp, uint32_t>;
+
+/// Positions ordered by timestamp, ties in their original order
+std::vector<uint32_t> timestamp_order(std::vector<TimestampKey>& keys) {
+    std::sort(keys.begin(), keys.end(), [](const TimestampKey& a, const TimestampKey& b) {
+        return a.first < b.first || (a.first == b.first && a.second < b.second);
+    });
+
+    std::vector<uint32_t> order(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        order[i] = keys[i].second;
+    }
+    return order;
+}
+
+}  // namespace
+
+void DataSet::sort_by_timestamp() {
+    std::vector<TimestampKey> keys;
+    keys.reserve(data_points_.size());
+    for (size_t i = 0; i < data_points_.size(); ++i) {
+        keys.emplace_back(data_points_[i].timestamp(), static_cast<uint32_t>(i));
+    }
+    auto order = timestamp_order(keys);
+
+    // Apply the permutation cycle by cycle; order[i] == i marks a placed point
+    for (size_t start = 0; start < order.size(); ++start) {
+        if (order[start] == start) {
+            continue;
+        }
+        DataPoint carried = std::move(data_points_[start]);
+        size_t hole       = start;
+        while (order[hole] != start) {
+            size_t next        = order[hole];
+            data_points_[hole] = std::move(data_points_[next]);
+            order[hole]        = static_cast<uint32_t>(hole);
+            hole               = next;
+        }
+        data_points_[hole] = std::move(carried);
+        order[hole]        = static_cast<uint32_t>(hole);
+    }
+}
+
+// ColumnarBatch implementation
+
+ColumnarBatch::ColumnarBatch(std::span<const DataPoint> data_points) {
+    reserve(data_points.size());
+    for (const auto& dp : data_points) {
+        push_back(dp);
+    }
+}
+
+DataSet ColumnarBatch::to_dataset() const {
+    DataSet result(size());
+    for (size_t row = 0; row < size(); ++row) {
+        DataPoint dp;
+        load(row, dp);
+        result.push_back(std::move(dp));
+    }
+    return result;
+}
+
+void ColumnarBatch::load(size_t row, DataPoint& dp) const {
+    if (address_ids_[row] != StringInterner::EMPTY_ID) {
+        dp.set_address(InternedString::from_id(address_ids_[row]));
+    } else {
+        dp.set_address(address(row));
+    }
+    dp.value() = values_[row];
+    dp.set_timestamp(timestamps_[row]);
+    dp.set_protocol_id(protocol_ids_[row]);
+    dp.set_quality(qualities_[row]);
+    dp.set_sequence_number(sequence_numbers_[row]);
+}
+
+void ColumnarBatch::reserve(size_t capacity) {
+    timestamps_.reserve(capacity);
+    values_.reserve(capacity);
+    qualities_.reserve(capacity);
+    protocol_ids_.reserve(capacity);
+    address_ids_.reserve(capacity);
+    sequence_numbers_.reserve(capacity);
+    address_offsets_.reserve(capacity + 1);
+}
+
+void ColumnarBatch::push_back(const DataPoint& dp) {
+    timestamps_.push_back(dp.timestamp());
+    values_.push_back(dp.value());
+    qualities_.push_back(dp.quality());
+    protocol_ids_.push_back(dp.protocol_id());
+    address_ids_.push_back(dp.address_id());
+    sequence_numbers_.push_back(dp.sequence_number());
+
+    if (dp.address_id() == StringInterner::EMPTY_ID) {
+        address_text_.append(dp.address());
+    }
+    address_offsets_.push_back(address_text_.size());
+}
+
+void ColumnarBatch::clear() noexcept {
+    timestamps_.clear();
+    values_.clear();
+    qualities_.clear();
+    protocol_ids_.clear();
+    address_ids_.clear();
+    sequence_numbers_.clear();
+    address_offsets_.resize(1);
+    address_text_.clear();
+}
+
+ColumnarBatch ColumnarBatch::filter_by_protocol(uint16_t protocol_id) const {
+    return select_if([&](size_t row) { return protocol_ids_[row] == protocol_id; });
+}
+
+ColumnarBatch ColumnarBatch::filter_by_address_prefix(std::string_view prefix) const {
+    return select_if([&](size_t row) { return address(row).starts_with(prefix); });
+}
+
+ColumnarBatch ColumnarBatch::filter_by_quality(Quality min_quality) const {
+    return select_if([&](size_t row) { return qualities_[row] >= min_quality; });
+}
+
+ColumnarBatch ColumnarBatch::filter_by_timestamp_range(Timestamp start, Timestamp end) const {
+    return select_if([&](size_t row) {
+        return timestamps_[row] >= start && timestamps_[row] <= end;
+    });
+}
+
+namespace {
+
+template <typename T>
+void gather(const std::vector<T>& column, std::span<const uint32_t> rows, std::vector<T>& out) {
+    out.resize(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        out[i] = column[rows[i]];
+    }
+}
+
+}  // namespace
+
+ColumnarBatch ColumnarBatch::select(std::span<const uint32_t> rows) const {
+    ColumnarBatch result;
+
+    // Gather one column at a time
+    gather(timestamps_, rows, result.timestamps_);
+    gather(qualities_, rows, result.qualities_);
+    gather(protocol_ids_, rows, result.protocol_ids_);
+    gather(sequence_numbers_, rows, result.sequence_numbers_);
+    gather(address_ids_, rows, result.address_ids_);
+
+    result.values_.reserve(rows.size());
+    for (uint32_t row : rows) {
+        result.values_.push_back(values_[row]);
+    }
+
+    size_t text_size = 0;
+    for (uint32_t row : rows) {
+        text_size += address_offsets_[row + 1] - address_offsets_[row];
+    }
+    result.address_text_.reserve(text_size);
+    result.address_offsets_.resize(rows.size() + 1);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const size_t begin = address_offsets_[rows[i]];
+        const size_t end   = address_offsets_[rows[i] + 1];
+        result.address_text_.append(address_text_, begin, end - begin);
+        result.address_offsets_[i + 1] = result.address_text_.size();
+    }
+
+    return result;
+}
+
+void ColumnarBatch::sort_by_timestamp() {
+    if (std::is_sorted(timestamps_.begin(), timestamps_.end())) {
+        return;
+    }
+
+    std::vector<TimestampKey> keys;
+    keys.reserve(size());
+    for (size_t row = 0; row < size(); ++row) {
+        keys.emplace_back(timestamps_[row], static_cast<uint32_t>(row));
+    }
+    *this = select(timestamp_order(keys));
+}
+
 // void DataSet::add_data_point(const DataPoint& data_point) {
 //     std::lock_guard<std::mutex> lock(mutex_);
 //     data_points_.push_back(data_point);
@@ -0,0 +1,79 @@
+#include "ipb/common/string_interner.hpp"
+
+#include "ipb/common/debug.hpp"
+
+#include <cstring>
+#include <mutex>
+
+namespace ipb::common {
+
+StringInterner::StringInterner() {
+    // ID 0 is always the empty string
+    auto* chunk = new std::string_view[CHUNK_SIZE];
+    chunks_[0].store(chunk, std::memory_order_release);
+    ids_.emplace(std::string_view(), EMPTY_ID);
+    size_.store(1, std::memory_order_release);
+}
+
+StringInterner::~StringInterner() {
+    for (auto& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_acquire);
+    }
+}
+
+StringInterner::Id StringInterner::intern(std::string_view text) {
+    {
+        std::shared_lock lock(mutex_);
+        auto it = ids_.find(text);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(mutex_);
+    auto it = ids_.find(text);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    Id id = size_.load(std::memory_order_relaxed);
+    IPB_ASSERT_MSG(id < CHUNK_SIZE * MAX_CHUNKS, "StringInterner is full");
+    if (IPB_UNLIKELY(id >= CHUNK_SIZE * MAX_CHUNKS)) {
+        return EMPTY_ID;
+    }
+
+    auto* chunk = chunks_[id / CHUNK_SIZE].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new std::string_view[CHUNK_SIZE];
+        chunks_[id / CHUNK_SIZE].store(chunk, std::memory_order_release);
+    }
+
+    auto storage = std::make_unique<char[]>(text.size());
+    std::memcpy(storage.get(), text.data(), text.size());
+    std::string_view stored(storage.get(), text.size());
+    text_.push_back(std::move(storage));
+
+    chunk[id % CHUNK_SIZE] = stored;
+    ids_.emplace(stored, id);
+
+    // Publishes the entry to lock-free view() callers
+    size_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+std::optional<StringInterner::Id> StringInterner::find(std::string_view text) const {
+    std::shared_lock lock(mutex_);
+    auto it = ids_.find(text);
+    if (it == ids_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+StringInterner& StringInterner::global() {
+    // Never destroyed, so handles stay readable during static destruction
+    static auto* instance = new StringInterner();
+    return *instance;
+}
+
+}  // namespace ipb::common
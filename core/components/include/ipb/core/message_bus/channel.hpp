@@ -11,14 +11,16 @@
  * @file channel.hpp
  * @brief Lock-free MPMC channel for message transport
  *
- * Implements a high-performance, lock-free multi-producer multi-consumer
- * channel optimized for real-time message passing.
+ * Implements a high-performance channel with lock-free publishing,
+ * optimized for real-time message passing. Buffer memory is allocated on
+ * demand, so idle topics cost almost nothing.
  */
 
 #include <ipb/common/endpoint.hpp>
 
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <shared_mutex>
@@ -26,117 +28,105 @@
 #include <vector>
 
 #include "message_bus.hpp"
+#include "subscriber_queue.hpp"
 
 namespace ipb::core {
 
 /**
- * @brief Lock-free MPMC ring buffer for messages
+ * @brief Bounded message queue built from small, lazily allocated segments
  *
- * Uses a bounded ring buffer with atomic operations for
- * lock-free producer/consumer synchronization.
+ * Storage follows the backlog instead of the capacity: a queue that never
+ * received a message owns no segments, and a drained queue keeps only the
+ * segment it is positioned in plus one spare for reuse. The capacity is a
+ * runtime limit on queued messages and can be changed at any time.
+ *
+ * Producers are lock-free and may push concurrently. try_pop() must only be
+ * called by one thread at a time (Channel::dispatch() ensures this).
  */
-template <size_t Capacity>
-class MPMCRingBuffer {
-    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
-
+class SegmentedMessageQueue {
 public:
-    MPMCRingBuffer() noexcept {
-        for (size_t i = 0; i < Capacity; ++i) {
-            slots_[i].sequence.store(i, std::memory_order_relaxed);
-        }
-        head_.store(0, std::memory_order_relaxed);
-        tail_.store(0, std::memory_order_relaxed);
-    }
+    /// Messages per segment
+    static constexpr size_t SEGMENT_SIZE = 32;
+
+    explicit SegmentedMessageQueue(size_t capacity) noexcept : capacity_(capacity) {}
+    ~SegmentedMessageQueue();
+
+    SegmentedMessageQueue(const SegmentedMessageQueue&)            = delete;
+    SegmentedMessageQueue& operator=(const SegmentedMessageQueue&) = delete;
 
     /**
      * @brief Try to push a message (non-blocking)
-     * @return true if successful, false if buffer full
+     * @return true if successful, false if the queue is at capacity
      */
-    bool try_push(Message&& msg) noexcept {
-        Slot* slot;
-        size_t pos = head_.load(std::memory_order_relaxed);
-
-        for (;;) {
-            slot          = &slots_[pos & (Capacity - 1)];
-            size_t seq    = slot->sequence.load(std::memory_order_acquire);
-            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
-
-            if (diff == 0) {
-                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
-                    break;
-                }
-            } else if (diff < 0) {
-                return false;  // Buffer full
-            } else {
-                pos = head_.load(std::memory_order_relaxed);
-            }
-        }
-
-        slot->message = std::move(msg);
-        slot->sequence.store(pos + 1, std::memory_order_release);
-        return true;
-    }
+    bool try_push(Message&& msg);
 
     /**
-     * @brief Try to pop a message (non-blocking)
-     * @return true if successful, false if buffer empty
+     * @brief Try to pop a message (single consumer)
+     * @return true if successful, false if no message is ready
      */
-    bool try_pop(Message& msg) noexcept {
-        Slot* slot;
-        size_t pos = tail_.load(std::memory_order_relaxed);
-
-        for (;;) {
-            slot          = &slots_[pos & (Capacity - 1)];
-            size_t seq    = slot->sequence.load(std::memory_order_acquire);
-            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
-
-            if (diff == 0) {
-                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
-                    break;
-                }
-            } else if (diff < 0) {
-                return false;  // Buffer empty
-            } else {
-                pos = tail_.load(std::memory_order_relaxed);
-            }
-        }
+    bool try_pop(Message& msg) noexcept;
 
-        msg = std::move(slot->message);
-        slot->sequence.store(pos + Capacity, std::memory_order_release);
-        return true;
-    }
+    /// Number of queued messages (including pushes still in progress)
+    size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
 
-    /**
-     * @brief Get approximate size
-     */
-    size_t size() const noexcept {
-        size_t head = head_.load(std::memory_order_relaxed);
-        size_t tail = tail_.load(std::memory_order_relaxed);
-        return head >= tail ? head - tail : 0;
+    bool empty() const noexcept { return size() == 0; }
+    bool full() const noexcept { return size() >= capacity(); }
+
+    size_t capacity() const noexcept { return capacity_.load(std::memory_order_relaxed); }
+
+    /// Change the capacity; messages already queued beyond it are kept
+    void set_capacity(size_t capacity) noexcept {
+        capacity_.store(capacity, std::memory_order_relaxed);
     }
 
-    bool empty() const noexcept { return size() == 0; }
-    bool full() const noexcept { return size() >= Capacity - 1; }
-    static constexpr size_t capacity() noexcept { return Capacity; }
+    /// Segments currently owned, including the spare
+    size_t allocated_segments() const noexcept {
+        return segments_.load(std::memory_order_relaxed);
+    }
 
 private:
-    struct alignas(64) Slot {
-        std::atomic<size_t> sequence;
+    struct Slot {
         Message message;
+        std::atomic<bool> ready{false};
     };
 
-    alignas(64) std::atomic<size_t> head_;
-    alignas(64) std::atomic<size_t> tail_;
-    std::array<Slot, Capacity> slots_;
+    struct Segment {
+        std::array<Slot, SEGMENT_SIZE> slots;
+        std::atomic<Segment*> next{nullptr};
+    };
+
+    /// Tail positions advance by one extra step per segment; offset
+    /// SEGMENT_SIZE means "the next segment is being linked"
+    static constexpr size_t LAP = SEGMENT_SIZE + 1;
+
+    Segment* acquire_segment();
+    void release_segment(Segment* segment) noexcept;
+
+    // Producer side
+    alignas(64) std::atomic<size_t> tail_{0};
+    std::atomic<Segment*> tail_segment_{nullptr};
+
+    // Consumer side
+    alignas(64) std::atomic<Segment*> head_segment_{nullptr};
+    size_t head_offset_ = 0;
+
+    alignas(64) std::atomic<size_t> size_{0};
+    std::atomic<size_t> capacity_;
+    std::atomic<Segment*> spare_{nullptr};
+    std::atomic<size_t> segments_{0};
 };
 
 /**
  * @brief Subscriber entry with callback and filter
+ *
+ * A queued subscriber has a queue instead of a callback; matching messages
+ * are pushed to it and the callback runs on the queue's delivery thread.
  */
 struct SubscriberEntry {
     uint64_t id;
     SubscriberCallback callback;
     std::function<bool(const Message&)> filter;
+    std::shared_ptr<SubscriberQueue> queue;
     std::atomic<bool> active{true};
 
     SubscriberEntry(uint64_t subscriber_id, SubscriberCallback cb)
@@ -145,6 +135,36 @@ struct SubscriberEntry {
     SubscriberEntry(uint64_t subscriber_id, SubscriberCallback cb,
                     std::function<bool(const Message&)> flt)
         : id(subscriber_id), callback(std::move(cb)), filter(std::move(flt)) {}
+
+    SubscriberEntry(uint64_t subscriber_id, std::shared_ptr<SubscriberQueue> q,
+                    std::function<bool(const Message&)> flt)
+        : id(subscriber_id), filter(std::move(flt)), queue(std::move(q)) {}
+
+    ~SubscriberEntry() {
+        if (queue) {
+            queue->close();
+        }
+    }
+};
+
+/// Wildcard subscribers resolved for one concrete topic
+using WildcardSubscribers = std::vector<std::shared_ptr<SubscriberEntry>>;
+
+class Channel;
+
+/**
+ * @brief Receives channels that have messages waiting to be dispatched
+ *
+ * A channel hands itself over once each time it goes from "nothing to
+ * dispatch" to "has messages", so an idle channel never costs a
+ * dispatcher anything.
+ */
+class ChannelReadyQueue {
+public:
+    virtual ~ChannelReadyQueue() = default;
+
+    /// Queue a channel for dispatch (called from publishing threads)
+    virtual void enqueue(Channel& channel) noexcept = 0;
 };
 
 /**
@@ -152,13 +172,27 @@ struct SubscriberEntry {
  *
  * Each channel handles messages for a specific topic pattern.
  * Channels maintain their own buffer and subscriber list.
+ *
+ * The buffer is split into one FIFO lane per PriorityLane. dispatch()
+ * drains the highest non-empty lane first, so a REALTIME message never
+ * waits behind NORMAL backlog. A lower lane that has been passed over
+ * starvation_limit times is served next, which bounds how long it can
+ * be held up by sustained higher-priority traffic.
  */
 class Channel : public std::enable_shared_from_this<Channel> {
 public:
+    /// Messages delivered per dispatch() call by default (no limit)
+    static constexpr size_t UNLIMITED = SIZE_MAX;
+
     /// Default buffer capacity (64K messages)
     static constexpr size_t DEFAULT_CAPACITY = 65536;
 
-    explicit Channel(std::string topic);
+    /**
+     * @param topic Topic name
+     * @param capacity Maximum number of queued messages across all priority
+     *                 lanes; storage is only allocated as messages queue up
+     */
+    explicit Channel(std::string topic, size_t capacity = DEFAULT_CAPACITY);
     ~Channel();
 
     // Non-copyable
@@ -168,6 +202,9 @@ public:
     /// Get topic name
     const std::string& topic() const noexcept { return topic_; }
 
+    /// Interned topic, stamped on every message published to this channel
+    common::InternedString topic_id() const noexcept { return topic_id_; }
+
     // Publishing
 
     /// Publish a message to this channel
@@ -176,6 +213,19 @@ public:
     /// Publish with priority override
     bool publish_priority(Message msg, Message::Priority priority);
 
+    /**
+     * @brief Configure priority lanes
+     * @param enabled false queues every message in the NORMAL lane (plain FIFO)
+     * @param starvation_limit Higher-lane messages a waiting lower lane lets
+     *                         pass before it is served (0 = strict priority)
+     */
+    void set_priority_dispatch(bool enabled, uint32_t starvation_limit) noexcept;
+
+    /// Record dispatch latencies into these statistics (nullptr disables)
+    void set_stats(MessageBusStats* stats) noexcept {
+        stats_.store(stats, std::memory_order_release);
+    }
+
     // Subscribing
 
     /// Add a subscriber
@@ -184,16 +234,49 @@ public:
     /// Add a subscriber with filter
     uint64_t subscribe(SubscriberCallback callback, std::function<bool(const Message&)> filter);
 
+    /// Add a subscriber that is delivered to through its own queue
+    uint64_t subscribe(std::shared_ptr<SubscriberQueue> queue,
+                       std::function<bool(const Message&)> filter = nullptr);
+
     /// Remove a subscriber
     void unsubscribe(uint64_t subscriber_id);
 
     /// Check if subscriber is active
     bool is_subscriber_active(uint64_t subscriber_id) const;
 
+    /**
+     * @brief Install the wildcard subscribers matching this channel's topic
+     * @param subscribers Delivered to after the channel's own subscribers
+     * @param generation TopicTrie generation the list was resolved at
+     */
+    void set_wildcard_subscribers(WildcardSubscribers subscribers, uint64_t generation);
+
+    /// TopicTrie generation of the installed wildcard subscribers
+    uint64_t wildcard_generation() const noexcept {
+        return wildcard_generation_.load(std::memory_order_acquire);
+    }
+
     // Dispatch
 
-    /// Dispatch pending messages to subscribers
-    size_t dispatch();
+    /**
+     * @brief Attach the channel to a dispatcher's ready queue
+     * @param queue Receives the channel whenever it has new work (nullptr detaches)
+     * @param shard Index of the dispatcher that owns this channel
+     *
+     * If messages are already waiting, the channel is queued immediately.
+     */
+    void attach(ChannelReadyQueue* queue, uint32_t shard) noexcept;
+
+    /// Index of the dispatcher this channel is attached to
+    uint32_t dispatch_shard() const noexcept { return shard_; }
+
+    /**
+     * @brief Dispatch pending messages to subscribers
+     * @param max_messages Stop after this many messages; if more are left,
+     *                     the channel queues itself again
+     * @return Number of messages dispatched (0 if another thread is dispatching)
+     */
+    size_t dispatch(size_t max_messages = UNLIMITED);
 
     /// Dispatch a single message
     void dispatch_single(const Message& msg);
@@ -203,12 +286,26 @@ public:
     /// Get number of pending messages
     size_t pending_count() const noexcept;
 
+    /// Number of pending messages in one lane
+    size_t pending_count(PriorityLane lane) const noexcept {
+        return lanes_[static_cast<size_t>(lane)].size();
+    }
+
     /// Get number of subscribers
     size_t subscriber_count() const noexcept;
 
     /// Check if channel is empty
     bool empty() const noexcept { return pending_count() == 0; }
 
+    /// Maximum number of queued messages, shared by all priority lanes
+    size_t capacity() const noexcept { return capacity_.load(std::memory_order_relaxed); }
+
+    /// Change the maximum number of queued messages; messages already queued beyond it are kept
+    void set_capacity(size_t capacity) noexcept;
+
+    /// Buffer segments currently allocated across all lanes
+    size_t allocated_segments() const noexcept;
+
     // Statistics
 
     std::atomic<uint64_t> messages_received{0};
@@ -216,14 +313,40 @@ public:
     std::atomic<uint64_t> messages_dropped{0};
 
 private:
+    void notify_ready() noexcept;
+
+    /// Take the next message to dispatch (only while holding dispatching_)
+    bool pop_next(Message& msg) noexcept;
+
     std::string topic_;
+    common::InternedString topic_id_;
+
+    // Message buffers, one per PriorityLane, grown and shrunk in segments.
+    // The lanes themselves are unbounded; queued_ enforces the channel's capacity.
+    std::array<SegmentedMessageQueue, PRIORITY_LANES> lanes_;
+    std::atomic<size_t> capacity_;
+    std::atomic<bool> dispatching_{false};  ///< Held by the one thread draining lanes_
+
+    std::atomic<bool> priority_dispatch_{true};
+    std::atomic<uint32_t> starvation_limit_{64};
+    /// Messages from higher lanes dispatched while each lane was waiting (under dispatching_)
+    std::array<uint32_t, PRIORITY_LANES> passed_over_{};
+
+    std::atomic<MessageBusStats*> stats_{nullptr};
 
-    // Lock-free message buffer
-    MPMCRingBuffer<DEFAULT_CAPACITY> buffer_;
+    // Published messages not yet accounted for by dispatch(). The publish
+    // that moves it off zero queues the channel; dispatch() subtracts what
+    // it delivered and re-queues the channel if anything was added meanwhile.
+    alignas(64) std::atomic<int64_t> undispatched_{0};
+    std::atomic<size_t> queued_{0};  ///< Messages in lanes_, counted before they are pushed
+    std::atomic<ChannelReadyQueue*> ready_queue_{nullptr};
+    uint32_t shard_ = 0;
 
     // Subscriber list (protected by shared mutex for rare modifications)
     mutable std::shared_mutex subscribers_mutex_;
     std::vector<std::unique_ptr<SubscriberEntry>> subscribers_;
+    WildcardSubscribers wildcard_subscribers_;
+    std::atomic<uint64_t> wildcard_generation_{0};
     std::atomic<uint64_t> next_subscriber_id_{1};
 };
 
@@ -232,7 +355,7 @@ private:
  *
  * Supports:
  * - Exact matching: "sensors/temp1"
- * - Single-level wildcard (*): "sensors/+" matches "sensors/temp1"
+ * - Single-level wildcard (+ or *): "sensors/+" matches "sensors/temp1"
  * - Multi-level wildcard (#): "sensors/#" matches "sensors/temp1/value"
  */
 class TopicMatcher {
@@ -21,15 +21,23 @@
  */
 
 #include <ipb/common/data_point.hpp>
+#include <ipb/common/dataset.hpp>
 #include <ipb/common/debug.hpp>
 #include <ipb/common/endpoint.hpp>
 #include <ipb/common/error.hpp>
+#include <ipb/common/memory_config.hpp>
 #include <ipb/common/platform.hpp>
+#include <ipb/common/string_interner.hpp>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <cmath>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -40,9 +48,26 @@ namespace ipb::core {
 // Forward declarations
 class Channel;
 class MessageBusImpl;
+class SubscriberQueue;
+class TopicTrie;
+
+/**
+ * @brief Immutable batch of data points, shared by every subscriber
+ *
+ * Delivering a batch to any number of subscribers (or re-publishing it to
+ * other topics) copies this handle, never the data points.
+ */
+using BatchHandle = std::shared_ptr<const common::DataSet>;
 
 /**
  * @brief Message envelope for bus transport
+ *
+ * The envelope is kept small because every queued message occupies one
+ * slot. Topic and source are interned 4-byte handles (see
+ * StringInterner::global() for their lifetime and cap), and a DATA_BATCH
+ * carries a ref-counted handle instead of its own vector. All fixed
+ * fields fit in the first cache line; the inline DataPoint fills the
+ * next two.
  */
 struct Message {
     /// Message types for different routing behaviors
@@ -60,17 +85,12 @@ struct Message {
     Type type         = Type::DATA_POINT;
     Priority priority = Priority::NORMAL;
 
-    /// Source identifier
-    std::string source_id;
+    /// Source identifier; assign configured source names only, each distinct
+    /// name stays interned for the life of the process
+    common::InternedString source_id;
 
-    /// Topic for routing
-    std::string topic;
-
-    /// Payload (DataPoint for most messages)
-    common::DataPoint payload;
-
-    /// Batch payload for DATA_BATCH type
-    std::vector<common::DataPoint> batch_payload;
+    /// Topic for routing (set by the bus on publish from the channel's interned topic)
+    common::InternedString topic;
 
     /// Deadline for DEADLINE_TASK (nanoseconds since epoch)
     int64_t deadline_ns = 0;
@@ -81,28 +101,82 @@ struct Message {
     /// Creation timestamp
     common::Timestamp timestamp;
 
+    /// Batch payload for DATA_BATCH type
+    BatchHandle batch_payload;
+
+    /// Payload (DataPoint for most messages)
+    common::DataPoint payload;
+
     Message() : timestamp(common::Timestamp::now()) {}
 
     explicit Message(common::DataPoint dp)
-        : type(Type::DATA_POINT), payload(std::move(dp)), timestamp(common::Timestamp::now()) {}
+        : type(Type::DATA_POINT), timestamp(common::Timestamp::now()), payload(std::move(dp)) {}
 
+    /// topic is only looked up: it stays empty until publish if no channel has interned it yet
     Message(std::string_view topic_name, common::DataPoint dp)
-        : type(Type::DATA_POINT), topic(topic_name), payload(std::move(dp)),
-          timestamp(common::Timestamp::now()) {}
+        : type(Type::DATA_POINT), topic(common::InternedString::find(topic_name)),
+          timestamp(common::Timestamp::now()), payload(std::move(dp)) {}
+
+    /// Data points of a DATA_BATCH message (empty if there is no batch)
+    std::span<const common::DataPoint> batch() const noexcept {
+        return batch_payload ? batch_payload->as_span() : std::span<const common::DataPoint>();
+    }
 };
 
+/**
+ * @brief Dispatch lanes of a channel, highest priority first
+ *
+ * Each lane is a FIFO. Dispatchers drain higher lanes first; see
+ * MessageBusConfig::starvation_limit for how lower lanes still progress.
+ */
+enum class PriorityLane : uint8_t { REALTIME, HIGH, NORMAL, LOW };
+
+/// Number of priority lanes
+inline constexpr size_t PRIORITY_LANES = 4;
+
+/// Lane of a message priority; values between the named levels round down
+constexpr PriorityLane priority_lane(Message::Priority priority) noexcept {
+    auto value = static_cast<uint8_t>(priority);
+    if (value >= static_cast<uint8_t>(Message::Priority::REALTIME)) {
+        return PriorityLane::REALTIME;
+    }
+    if (value >= static_cast<uint8_t>(Message::Priority::HIGH)) {
+        return PriorityLane::HIGH;
+    }
+    if (value >= static_cast<uint8_t>(Message::Priority::NORMAL)) {
+        return PriorityLane::NORMAL;
+    }
+    return PriorityLane::LOW;
+}
+
 /**
  * @brief Subscriber callback signature
  */
 using SubscriberCallback = std::function<void(const Message&)>;
 
+/**
+ * @brief Delivery statistics of a queued subscriber
+ */
+struct SubscriberStats {
+    size_t capacity     = 0;  ///< Queue capacity
+    size_t queued       = 0;  ///< Messages waiting for the callback
+    size_t max_queued   = 0;  ///< Highest backlog seen
+    uint64_t delivered  = 0;  ///< Messages passed to the callback
+    uint64_t dropped    = 0;  ///< Messages discarded by the drop policy
+    int64_t last_lag_ns = 0;  ///< Publish-to-callback delay of the latest message
+    int64_t max_lag_ns  = 0;  ///< Highest publish-to-callback delay
+};
+
 /**
  * @brief Subscription handle for managing subscriptions
  */
 class Subscription {
 public:
     Subscription() = default;
-    Subscription(uint64_t id, std::weak_ptr<Channel> channel);
+    Subscription(uint64_t id, std::weak_ptr<Channel> channel,
+                 std::weak_ptr<SubscriberQueue> queue = {});
+    Subscription(uint64_t id, std::weak_ptr<TopicTrie> wildcards,
+                 std::weak_ptr<SubscriberQueue> queue = {});
 
     Subscription(Subscription&&) noexcept            = default;
     Subscription& operator=(Subscription&&) noexcept = default;
@@ -116,15 +190,103 @@ public:
     /// Check if subscription is active
     bool is_active() const noexcept;
 
-    /// Cancel the subscription
+    /**
+     * @brief Cancel the subscription
+     *
+     * For a queued subscriber this also waits for a callback in progress.
+     */
     void cancel();
 
+    /// Delivery statistics, if the subscription has its own queue
+    std::optional<SubscriberStats> delivery_stats() const;
+
     /// Get subscription ID
     uint64_t id() const noexcept { return id_; }
 
 private:
     uint64_t id_ = 0;
     std::weak_ptr<Channel> channel_;
+    std::weak_ptr<TopicTrie> wildcards_;  ///< Set instead of channel_ for wildcard patterns
+    std::weak_ptr<SubscriberQueue> queue_;
+};
+
+/**
+ * @brief Lock-free latency histogram
+ *
+ * Buckets split every power of two into four, so a percentile is reported
+ * as the upper bound of its bucket and is at most 25% above the true value.
+ * Recording is one relaxed increment.
+ */
+struct LatencyHistogram {
+    static constexpr size_t BUCKETS = 256;
+
+    std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+
+    void record(int64_t latency_ns) noexcept {
+        counts[bucket_of(latency_ns > 0 ? static_cast<uint64_t>(latency_ns) : 0)].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    /// Number of recorded samples
+    uint64_t count() const noexcept {
+        uint64_t total = 0;
+        for (const auto& c : counts) {
+            total += c.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Latency below which a fraction q of the samples fall
+     * @param q Quantile in [0, 1], e.g. 0.99 for p99
+     * @return Upper bound of the matching bucket in nanoseconds (0 if empty)
+     */
+    int64_t percentile(double q) const noexcept {
+        std::array<uint64_t, BUCKETS> snapshot;
+        uint64_t total = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            snapshot[i] = counts[i].load(std::memory_order_relaxed);
+            total += snapshot[i];
+        }
+        if (total == 0) {
+            return 0;
+        }
+
+        auto rank     = static_cast<uint64_t>(std::ceil(q * static_cast<double>(total)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += snapshot[i];
+            if (seen >= std::max<uint64_t>(rank, 1)) {
+                return upper_bound(i);
+            }
+        }
+        return upper_bound(BUCKETS - 1);
+    }
+
+    void reset() noexcept {
+        for (auto& c : counts) {
+            c.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static constexpr size_t bucket_of(uint64_t ns) noexcept {
+        if (ns < 4) {
+            return static_cast<size_t>(ns);
+        }
+        auto exponent = static_cast<size_t>(std::bit_width(ns)) - 1;  // >= 2
+        auto quarter  = static_cast<size_t>((ns >> (exponent - 2)) & 3);
+        return 4 * (exponent - 1) + quarter;
+    }
+
+    static constexpr int64_t upper_bound(size_t bucket) noexcept {
+        if (bucket < 4) {
+            return static_cast<int64_t>(bucket);
+        }
+        size_t exponent = bucket / 4 + 1;
+        uint64_t lower  = (4 + bucket % 4) << (exponent - 2);
+        uint64_t upper  = lower + (uint64_t{1} << (exponent - 2)) - 1;
+        return upper > static_cast<uint64_t>(INT64_MAX) ? INT64_MAX : static_cast<int64_t>(upper);
+    }
 };
 
 /**
@@ -143,6 +305,29 @@ struct MessageBusStats {
     std::atomic<int64_t> max_latency_ns{0};
     std::atomic<int64_t> total_latency_ns{0};
 
+    /// Publish-to-dispatch latency per priority lane (indexed by PriorityLane)
+    std::array<LatencyHistogram, PRIORITY_LANES> lane_latency;
+
+    /// Record the publish-to-dispatch latency of one message
+    void record_latency(PriorityLane lane, int64_t latency_ns) noexcept {
+        lane_latency[static_cast<size_t>(lane)].record(latency_ns);
+        total_latency_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+
+        auto min = min_latency_ns.load(std::memory_order_relaxed);
+        while (latency_ns < min &&
+               !min_latency_ns.compare_exchange_weak(min, latency_ns, std::memory_order_relaxed)) {
+        }
+        auto max = max_latency_ns.load(std::memory_order_relaxed);
+        while (latency_ns > max &&
+               !max_latency_ns.compare_exchange_weak(max, latency_ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// Latency percentile of one lane in nanoseconds, e.g. latency_percentile(REALTIME, 0.99)
+    int64_t latency_percentile(PriorityLane lane, double q) const noexcept {
+        return lane_latency[static_cast<size_t>(lane)].percentile(q);
+    }
+
     /// Calculate messages per second
     double messages_per_second(std::chrono::nanoseconds elapsed) const noexcept {
         auto seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
@@ -163,6 +348,9 @@ struct MessageBusStats {
         min_latency_ns.store(INT64_MAX);
         max_latency_ns.store(0);
         total_latency_ns.store(0);
+        for (auto& lane : lane_latency) {
+            lane.reset();
+        }
     }
 };
 
@@ -173,7 +361,8 @@ struct MessageBusConfig {
     /// Maximum number of channels
     size_t max_channels = 256;
 
-    /// Default channel buffer size (must be power of 2)
+    /// Default channel capacity in messages, shared by the channel's priority
+    /// lanes (storage grows with the backlog)
     size_t default_buffer_size = 65536;
 
     /// Number of dispatcher threads (0 = use hardware concurrency)
@@ -182,9 +371,13 @@ struct MessageBusConfig {
     /// Enable lock-free mode (requires careful memory management)
     bool lock_free_mode = true;
 
-    /// Enable priority-based dispatch
+    /// Enable priority-based dispatch (false: one FIFO per channel)
     bool priority_dispatch = true;
 
+    /// Starvation protection: a waiting lower lane is served after this many
+    /// messages from higher lanes went ahead of it (0 = strict priority)
+    uint32_t starvation_limit = 64;
+
     /// Drop policy when buffer is full
     enum class DropPolicy {
         DROP_NEWEST,  ///< Drop incoming messages
@@ -197,6 +390,24 @@ struct MessageBusConfig {
 
     /// Real-time priority for dispatcher threads (0 = normal)
     int realtime_priority = 0;
+
+    /// Channel limits and dispatcher count from a memory profile
+    static MessageBusConfig from_memory_config(const common::MemoryConfig& memory);
+};
+
+/**
+ * @brief Delivery options of one subscription
+ *
+ * With a queue_capacity, the subscriber gets its own bounded queue and
+ * delivery thread, so a slow callback cannot stall the dispatcher or the
+ * other subscribers of the topic.
+ */
+struct SubscriptionOptions {
+    /// Messages the subscriber may lag behind (0 = call back on the dispatcher thread)
+    size_t queue_capacity = 0;
+
+    /// What gives way when the subscriber's queue is full
+    MessageBusConfig::DropPolicy drop_policy = MessageBusConfig::DropPolicy::DROP_OLDEST;
 };
 
 /**
@@ -220,6 +431,9 @@ struct MessageBusConfig {
  *
  * // Publish a message
  * bus.publish("sensors/temp1", DataPoint("temp1", Value{25.5}));
+ *
+ * // Hand over a batch; subscribers share it without copying the points
+ * bus.publish_batch("sensors/batch", std::move(dataset));
  * @endcode
  */
 class MessageBus {
@@ -253,9 +467,15 @@ public:
     /// Publish a data point to a topic
     bool publish(std::string_view topic, const common::DataPoint& data_point);
 
-    /// Publish a batch of data points
+    /// Publish a copy of a batch of data points
     bool publish_batch(std::string_view topic, std::span<const common::DataPoint> batch);
 
+    /// Publish a batch by taking ownership of it (the points are not copied)
+    bool publish_batch(std::string_view topic, common::DataSet&& batch);
+
+    /// Publish an already shared batch, e.g. one received from another topic
+    bool publish_batch(std::string_view topic, BatchHandle batch);
+
     /// Publish with priority
     bool publish_priority(std::string_view topic, Message msg, Message::Priority priority);
 
@@ -273,11 +493,27 @@ public:
                                                   std::function<bool(const Message&)> filter,
                                                   SubscriberCallback callback);
 
+    /// Subscribe with delivery options (e.g. a dedicated queue for a slow consumer)
+    [[nodiscard]] Subscription subscribe(std::string_view topic_pattern,
+                                         SubscriberCallback callback,
+                                         const SubscriptionOptions& options,
+                                         std::function<bool(const Message&)> filter = nullptr);
+
     // Channel management
 
     /// Create or get a channel for a topic
     std::shared_ptr<Channel> get_or_create_channel(std::string_view topic);
 
+    /**
+     * @brief Set the capacity of one topic's channel
+     *
+     * The capacity bounds all of the channel's priority lanes together.
+     * Creates the channel if needed. Takes effect immediately; messages
+     * already queued beyond the new capacity are still delivered.
+     * @return false if the channel could not be created
+     */
+    bool set_topic_capacity(std::string_view topic, size_t capacity);
+
     /// Check if a channel exists
     bool has_channel(std::string_view topic) const;
 
@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file subscriber_queue.hpp
+ * @brief Bounded delivery queue that isolates a slow subscriber
+ *
+ * By default a subscriber's callback runs on the dispatcher thread, so a
+ * callback that blocks (e.g. a sink doing a network write) holds up every
+ * other subscriber of the topic. A queued subscriber instead gets a copy
+ * of each message pushed into its own bounded queue, drained by its own
+ * delivery thread. When the queue is full, the subscription's drop policy
+ * decides whether the new message, the oldest queued message, or the
+ * dispatcher gives way.
+ */
+
+#include <ipb/common/lockfree_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "message_bus.hpp"
+
+namespace ipb::core {
+
+/**
+ * @brief Per-subscriber message queue with its own delivery thread
+ *
+ * push() may be called from several dispatchers at once (a wildcard
+ * subscriber can match channels owned by different dispatchers); the
+ * callback is only ever invoked from the delivery thread.
+ */
+class SubscriberQueue : public std::enable_shared_from_this<SubscriberQueue> {
+public:
+    using DropPolicy = MessageBusConfig::DropPolicy;
+
+    /**
+     * @brief Create a queue and start its delivery thread
+     * @param capacity Maximum queued messages (rounded up to a power of two)
+     */
+    static std::shared_ptr<SubscriberQueue> create(size_t capacity, DropPolicy policy,
+                                                   SubscriberCallback callback);
+
+    ~SubscriberQueue();
+
+    SubscriberQueue(const SubscriberQueue&)            = delete;
+    SubscriberQueue& operator=(const SubscriberQueue&) = delete;
+
+    /**
+     * @brief Queue a copy of a message for the subscriber
+     * @return false if the message was dropped (or the queue is closed)
+     *
+     * With DropPolicy::BLOCK this sleeps until the subscriber makes room
+     * or the queue is closed.
+     */
+    bool push(const Message& msg);
+
+    /// Stop delivering; messages still queued are discarded. Does not wait.
+    void close() noexcept;
+
+    /**
+     * @brief close() and wait for a callback in progress to return
+     *
+     * Called from the subscriber's own callback, this only closes.
+     */
+    void stop() noexcept;
+
+    bool is_closed() const noexcept { return closed_.load(std::memory_order_acquire); }
+
+    size_t capacity() const noexcept { return queue_.capacity(); }
+    DropPolicy drop_policy() const noexcept { return policy_; }
+
+    /// Snapshot of the delivery statistics
+    SubscriberStats stats() const noexcept;
+
+private:
+    SubscriberQueue(size_t capacity, DropPolicy policy, SubscriberCallback callback);
+
+    void run();
+    bool try_push(const Message& msg);
+    void on_dequeued() noexcept;
+    /// DropPolicy::BLOCK: sleep until a dequeue or close() may have made room
+    bool push_blocking(const Message& msg);
+
+    common::BoundedMPMCQueue<Message> queue_;
+    const DropPolicy policy_;
+    SubscriberCallback callback_;
+
+    // Enqueued minus dequeued messages; the delivery thread sleeps on it at zero
+    alignas(64) std::atomic<int64_t> pending_{0};
+    std::atomic<bool> closed_{false};
+    std::atomic<bool> exited_{false};
+
+    // Bumped by every dequeue and by close() under DropPolicy::BLOCK; blocked
+    // pushers wait on it and are only notified while some are waiting
+    std::atomic<uint32_t> dequeues_{0};
+    std::atomic<uint32_t> blocked_pushers_{0};
+
+    // Statistics
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<size_t> max_queued_{0};
+    std::atomic<int64_t> last_lag_ns_{0};
+    std::atomic<int64_t> max_lag_ns_{0};
+
+    std::thread worker_;
+};
+
+}  // namespace ipb::core
@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file topic_trie.hpp
+ * @brief Trie of wildcard subscription patterns for the message bus
+ *
+ * Wildcard subscriptions are stored by pattern segment:
+ * - A literal segment is a keyed child
+ * - "+" (or "*") matches exactly one level and is the node's single-level child
+ * - A trailing "#" matches all remaining levels, including none ("a/#"
+ *   matches "a"), and is stored on the node of the prefix before it
+ *
+ * Resolving the subscribers of a concrete topic walks the topic's segments
+ * once, following the literal child and the single-level child at every
+ * level, so the cost depends on topic depth and not on the number of
+ * subscriptions. Every change bumps a generation counter; channels cache
+ * their resolved subscriber list and re-resolve only when it moved.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "channel.hpp"
+
+namespace ipb::core {
+
+/**
+ * @brief Thread-safe registry of wildcard subscriptions
+ *
+ * Lookups take a shared lock; subscribe and unsubscribe take it exclusively.
+ */
+class TopicTrie {
+public:
+    TopicTrie()  = default;
+    ~TopicTrie() = default;
+
+    TopicTrie(const TopicTrie&)            = delete;
+    TopicTrie& operator=(const TopicTrie&) = delete;
+
+    /**
+     * @brief Add a subscription
+     * @return Subscription ID, or 0 if the pattern is not valid
+     */
+    uint64_t insert(std::string_view pattern, SubscriberCallback callback,
+                    std::function<bool(const Message&)> filter = nullptr);
+
+    /// Add a subscription delivered through its own queue (see insert() above)
+    uint64_t insert(std::string_view pattern, std::shared_ptr<SubscriberQueue> queue,
+                    std::function<bool(const Message&)> filter = nullptr);
+
+    /**
+     * @brief Remove a subscription
+     * @return false if the ID is unknown
+     */
+    bool remove(uint64_t subscriber_id);
+
+    /// Check if a subscription is registered
+    bool contains(uint64_t subscriber_id) const;
+
+    /// Subscribers whose pattern matches a concrete topic
+    WildcardSubscribers match(std::string_view topic) const;
+
+    /// Changes with every insert and remove
+    uint64_t generation() const noexcept { return generation_.load(std::memory_order_acquire); }
+
+    /// Number of registered subscriptions
+    size_t size() const;
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>, StringHash, std::equal_to<>>
+            children;
+        std::unique_ptr<Node> single;  ///< "+" / "*" child
+
+        WildcardSubscribers exact;  ///< Patterns ending at this node
+        WildcardSubscribers multi;  ///< Patterns ending in "#" below this node
+
+        bool empty() const noexcept {
+            return children.empty() && !single && exact.empty() && multi.empty();
+        }
+    };
+
+    /// Link an entry under its pattern and give it the next ID
+    uint64_t add(std::string_view pattern, std::shared_ptr<SubscriberEntry> entry);
+
+    static void collect(const Node& node, std::string_view topic, size_t pos,
+                        WildcardSubscribers& out);
+
+    /// Remove an entry below node; returns true if node can be pruned
+    static bool erase(Node& node, std::string_view pattern, size_t pos, uint64_t subscriber_id);
+
+    mutable std::shared_mutex mutex_;
+    Node root_;
+    std::unordered_map<uint64_t, std::string> patterns_;
+    uint64_t next_id_ = 1;
+
+    std::atomic<uint64_t> generation_{0};
+};
+
+}  // namespace ipb::core
@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file compiled_condition.hpp
+ * @brief Flat, short-circuiting form of a COMPOSITE rule's condition tree
+ *
+ * A RuleCondition tree is compiled once, when the rule is built or added
+ * to an engine:
+ * - Nested AND/AND and OR/OR nodes are flattened, double negations and
+ *   single-operand AND/OR nodes are removed
+ * - Operands of every AND/OR are reordered by estimated cost, so protocol
+ *   and quality checks run before address comparisons, value conditions
+ *   and patterns
+ * - The tree is laid out in pre-order in one contiguous array; each node
+ *   records where its subtree ends, so skipping an operand is one jump
+ * - PATTERN leaves hold a compiled matcher
+ *
+ * Conditions have no side effects, so reordering never changes results.
+ */
+
+#include <ipb/common/data_point.hpp>
+#include <ipb/core/rule_engine/pattern_matcher.hpp>
+#include <ipb/core/rule_engine/rule_engine.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ipb::core {
+
+/**
+ * @brief Compiled RuleCondition
+ *
+ * Immutable after compile(); thread-safe for concurrent evaluate().
+ */
+class CompiledCondition {
+public:
+    CompiledCondition()  = default;
+    ~CompiledCondition() = default;
+
+    // Non-copyable (owns pattern matchers) but movable
+    CompiledCondition(const CompiledCondition&)            = delete;
+    CompiledCondition& operator=(const CompiledCondition&) = delete;
+    CompiledCondition(CompiledCondition&&) noexcept            = default;
+    CompiledCondition& operator=(CompiledCondition&&) noexcept = default;
+
+    /**
+     * @brief Compile a condition tree
+     * @param condition Tree to compile
+     * @param type Matcher type for PATTERN leaves
+     */
+    static CompiledCondition compile(
+        const RuleCondition& condition,
+        PatternMatcherFactory::MatcherType type = PatternMatcherFactory::MatcherType::AUTO);
+
+    /// Evaluate against a data point (false if nothing was compiled)
+    bool evaluate(const common::DataPoint& dp) const {
+        return !nodes_.empty() && evaluate_node(0, dp);
+    }
+
+    /// Node kinds in evaluation (pre-order) order
+    std::vector<RuleCondition::Kind> program() const;
+
+    /// Number of nodes in the compiled program
+    size_t size() const noexcept { return nodes_.size(); }
+
+    /**
+     * @brief Relative evaluation cost estimate used to order operands
+     *
+     * Integer compares are cheapest, followed by address comparisons,
+     * value conditions and finally pattern matching.
+     */
+    static uint32_t estimated_cost(const RuleCondition& condition) noexcept;
+
+private:
+    struct Node {
+        RuleCondition::Kind kind;
+        uint32_t end;      ///< One past the last node of this subtree
+        uint32_t operand;  ///< Index into the side table for kind (leaves only)
+    };
+
+    /// Bitmask over all Quality values
+    using QualitySet = std::array<uint64_t, 4>;
+
+    bool evaluate_node(uint32_t position, const common::DataPoint& dp) const;
+    void emit(const RuleCondition& condition, PatternMatcherFactory::MatcherType type);
+
+    std::vector<Node> nodes_;
+
+    // Leaf operands, indexed by Node::operand
+    std::vector<std::vector<std::string>> addresses_;
+    std::vector<std::unique_ptr<IPatternMatcher>> patterns_;
+    std::vector<std::vector<uint16_t>> protocols_;
+    std::vector<QualitySet> qualities_;
+    std::vector<ValueCondition> values_;
+    std::vector<std::pair<common::Timestamp, common::Timestamp>> time_ranges_;
+};
+
+}  // namespace ipb::core
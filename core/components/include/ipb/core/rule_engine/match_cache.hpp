@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * @file match_cache.hpp
+ * @brief Sharded address -> match-result cache for the RuleEngine
+ *
+ * Replaces a single mutex-protected map with:
+ * - Independently locked, cache-line aligned shards selected by address hash
+ * - Fixed per-shard capacity with CLOCK (second chance) eviction; slots
+ *   are allocated as entries arrive, so an idle cache costs almost nothing
+ * - Per-entry TTL checked on lookup
+ * - An epoch number: invalidate() makes every existing entry stale in O(1)
+ *   without taking any shard lock, so rule changes never stop readers
+ *
+ * Readers only take a shard's shared lock; a hit sets the entry's reference
+ * bit atomically instead of reordering an LRU list.
+ *
+ * Interned addresses are keyed on their 32-bit ID instead of the text, so
+ * lookups for them neither hash nor compare strings.
+ */
+
+#include <ipb/common/platform.hpp>
+#include <ipb/common/string_interner.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ipb::core {
+
+struct RuleMatchResult;
+
+/**
+ * @brief Bounded, sharded cache of rule evaluation results keyed by address
+ *
+ * Thread-safe.
+ */
+class MatchCache {
+public:
+    using Results    = std::vector<RuleMatchResult>;
+    using ResultsPtr = std::shared_ptr<const Results>;
+
+    /**
+     * @param capacity Maximum number of entries across all shards
+     * @param shards Requested shard count (rounded down to a power of two,
+     *               and never more than capacity)
+     * @param ttl Entry lifetime (zero = no expiry)
+     */
+    MatchCache(size_t capacity, size_t shards, std::chrono::milliseconds ttl);
+    ~MatchCache();
+
+    MatchCache(const MatchCache&)            = delete;
+    MatchCache& operator=(const MatchCache&) = delete;
+
+    /**
+     * @brief Look up cached results for an address
+     * @return Results, or nullptr if absent, expired or from an older epoch
+     */
+    ResultsPtr find(std::string_view address) const;
+
+    /// Look up cached results for an interned address
+    ResultsPtr find(common::InternedString address) const;
+
+    /**
+     * @brief Store results for an address
+     * @param epoch Epoch observed before the results were computed; the
+     *              insert is dropped if invalidate() ran in between
+     * @return true if an existing entry had to be evicted to make room
+     */
+    bool insert(std::string_view address, ResultsPtr results, uint64_t epoch);
+
+    /// Store results for an interned address (see insert(std::string_view, ...))
+    bool insert(common::InternedString address, ResultsPtr results, uint64_t epoch);
+
+    /// Current epoch; capture it before evaluating rules for insert()
+    uint64_t epoch() const noexcept { return epoch_.load(std::memory_order_acquire); }
+
+    /// Make all current entries stale (O(1), lock-free)
+    void invalidate() noexcept { epoch_.fetch_add(1, std::memory_order_acq_rel); }
+
+    /// Remove every entry whose address satisfies pred
+    void erase_if(const std::function<bool(std::string_view)>& pred);
+
+    /// Remove all entries
+    void clear();
+
+    /// Number of live slots (including stale entries not yet reclaimed)
+    size_t size() const;
+
+    /// Total capacity across shards
+    size_t capacity() const noexcept { return shard_capacity_ * shard_count_; }
+
+    /// Number of shards
+    size_t shard_count() const noexcept { return shard_count_; }
+
+private:
+    struct Slot {
+        std::string key;
+        common::StringInterner::Id address_id = 0;  ///< Set instead of key for interned addresses
+        ResultsPtr results;
+        uint64_t epoch    = 0;  ///< 0 = empty slot
+        int64_t stored_ns = 0;
+        mutable std::atomic<bool> referenced{false};
+    };
+
+    struct alignas(IPB_CACHE_LINE_SIZE) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string_view, uint32_t> index;  ///< Views into Slot::key
+        std::unordered_map<common::StringInterner::Id, uint32_t> id_index;
+        /// Grows up to the shard capacity; a deque keeps the keys the index views in place
+        std::deque<Slot> slots;
+        uint32_t hand = 0;
+    };
+
+    static int64_t now_ns() noexcept;
+
+    Shard& shard_for(std::string_view address) const noexcept;
+    Shard& shard_for(common::StringInterner::Id address_id) const noexcept;
+    bool is_live(const Slot& slot, uint64_t epoch, int64_t now) const noexcept;
+
+    /// Results of a found slot if still live; marks it referenced
+    ResultsPtr hit(const Slot& slot, uint64_t epoch) const;
+
+    /// Free slot for a new key (CLOCK eviction when the shard is full)
+    uint32_t claim_slot(Shard& shard, int64_t now, bool& evicted);
+    void store(Slot& slot, ResultsPtr results, uint64_t epoch, int64_t now);
+    void reset_slot(Shard& shard, uint32_t position);
+
+    size_t shard_count_;
+    size_t shard_capacity_;
+    int64_t ttl_ns_;
+
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<uint64_t> epoch_{1};
+};
+
+}  // namespace ipb::core
@@ -87,6 +87,9 @@ public:
 
     /// Analyze pattern and suggest best matcher type
     static MatcherType analyze_pattern(std::string_view pattern) noexcept;
+
+    /// Total number of matchers created by create() since process start
+    static uint64_t compilation_count() noexcept;
 };
 
 /**
@@ -318,6 +321,16 @@ public:
      */
     std::vector<uint32_t> find_matches(std::string_view input) const noexcept;
 
+    /**
+     * @brief Append rule IDs of all prefix patterns matching input
+     * @param input The input string to match
+     * @param out Destination; existing contents are kept
+     *
+     * Allocation-free variant of find_matches() for hot paths that reuse
+     * a scratch buffer. Exact patterns are not reported.
+     */
+    void collect_prefix_matches(std::string_view input, std::vector<uint32_t>& out) const;
+
     /**
      * @brief Check if there's any exact match for input
      * @param input The input string to check
@@ -15,11 +15,15 @@
  */
 
 #include <ipb/common/data_point.hpp>
+#include <ipb/common/dataset.hpp>
 #include <ipb/common/debug.hpp>
 #include <ipb/common/error.hpp>
 #include <ipb/common/platform.hpp>
+#include <ipb/core/rule_engine/pattern_matcher.hpp>
+#include <ipb/core/sink_registry/sink_registry.hpp>
 
 #include <atomic>
+#include <bit>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -34,6 +38,7 @@ namespace ipb::core {
 // Forward declarations
 class RuleEngineImpl;
 class PatternMatcher;
+class CompiledCondition;
 
 /**
  * @brief Priority levels for routing rules
@@ -74,6 +79,40 @@ enum class CompareOp : uint8_t {
     BETWEEN  ///< Between two values (inclusive)
 };
 
+/**
+ * @brief ValueCondition with its reference values extracted once
+ *
+ * Produced by ValueCondition::resolve(). Holds a pointer to the
+ * condition's string reference, so it must not outlive the condition.
+ */
+struct ResolvedValueCondition {
+    CompareOp op = CompareOp::EQ;
+
+    /// Numeric reference (0 for string references)
+    double low = 0.0;
+
+    /// Upper bound for BETWEEN
+    double high = 0.0;
+
+    /// String reference, or nullptr if the reference is not a string
+    const std::string* text = nullptr;
+
+    /// Evaluate against a single value; same result as ValueCondition::evaluate()
+    bool evaluate(const common::Value& value) const noexcept;
+
+    /**
+     * @brief Evaluate over a column of numeric values
+     * @param values Column of values, one per data point
+     * @param numeric Bitmap of the entries of values that hold a numeric value
+     * @param out Match bitmap, same word count as numeric
+     *
+     * Branch-free over each 64-entry block so the comparison vectorizes.
+     * Non-numeric entries never match; string values need evaluate().
+     */
+    void evaluate_column(std::span<const double> values, std::span<const uint64_t> numeric,
+                         std::span<uint64_t> out) const noexcept;
+};
+
 /**
  * @brief Value-based condition for rule matching
  */
@@ -88,8 +127,162 @@ struct ValueCondition {
 
     /// Evaluate condition against a DataPoint value
     bool evaluate(const common::Value& value) const noexcept;
+
+    /// Extract the reference values once for repeated evaluation
+    ResolvedValueCondition resolve() const noexcept;
+};
+
+/**
+ * @brief Condition tree for COMPOSITE rules
+ *
+ * Leaves use the same condition kinds as single-condition rules; inner
+ * nodes combine their operands with AND, OR or NOT. The tree is compiled
+ * into a CompiledCondition before evaluation (cheap checks first), so it
+ * can be written in whatever order reads best.
+ *
+ * @code
+ * auto cond = RuleCondition::pattern("plant/line.*") &&
+ *             RuleCondition::quality(Quality::GOOD) &&
+ *             !RuleCondition::value(over_range);
+ * @endcode
+ */
+struct RuleCondition {
+    enum class Kind : uint8_t {
+        STATIC,     ///< Address is one of source_addresses
+        PATTERN,    ///< Address matches address_pattern
+        PROTOCOL,   ///< Protocol ID is one of protocol_ids
+        QUALITY,    ///< Quality is one of quality_levels
+        VALUE,      ///< Value satisfies value_condition
+        TIMESTAMP,  ///< Timestamp is within [start_time, end_time]
+        AND,        ///< All operands match (true when empty)
+        OR,         ///< Any operand matches (false when empty)
+        NOT         ///< The single operand does not match
+    };
+
+    Kind kind = Kind::AND;
+
+    // Leaf criteria; only those belonging to kind are used
+    std::vector<std::string> source_addresses;
+    std::string address_pattern;
+    std::vector<uint16_t> protocol_ids;
+    std::vector<common::Quality> quality_levels;
+    std::optional<ValueCondition> value_condition;
+    common::Timestamp start_time;
+    common::Timestamp end_time;
+
+    /// Operands of AND, OR and NOT
+    std::vector<RuleCondition> operands;
+
+    static RuleCondition address(std::string address) {
+        RuleCondition c;
+        c.kind = Kind::STATIC;
+        c.source_addresses.push_back(std::move(address));
+        return c;
+    }
+
+    static RuleCondition any_address(std::vector<std::string> addresses) {
+        RuleCondition c;
+        c.kind             = Kind::STATIC;
+        c.source_addresses = std::move(addresses);
+        return c;
+    }
+
+    static RuleCondition pattern(std::string pattern) {
+        RuleCondition c;
+        c.kind            = Kind::PATTERN;
+        c.address_pattern = std::move(pattern);
+        return c;
+    }
+
+    static RuleCondition protocol(uint16_t protocol_id) {
+        RuleCondition c;
+        c.kind = Kind::PROTOCOL;
+        c.protocol_ids.push_back(protocol_id);
+        return c;
+    }
+
+    static RuleCondition any_protocol(std::vector<uint16_t> protocols) {
+        RuleCondition c;
+        c.kind         = Kind::PROTOCOL;
+        c.protocol_ids = std::move(protocols);
+        return c;
+    }
+
+    static RuleCondition quality(common::Quality quality) {
+        RuleCondition c;
+        c.kind = Kind::QUALITY;
+        c.quality_levels.push_back(quality);
+        return c;
+    }
+
+    static RuleCondition any_quality(std::vector<common::Quality> qualities) {
+        RuleCondition c;
+        c.kind           = Kind::QUALITY;
+        c.quality_levels = std::move(qualities);
+        return c;
+    }
+
+    static RuleCondition value(ValueCondition condition) {
+        RuleCondition c;
+        c.kind            = Kind::VALUE;
+        c.value_condition = std::move(condition);
+        return c;
+    }
+
+    static RuleCondition time_range(common::Timestamp start, common::Timestamp end) {
+        RuleCondition c;
+        c.kind       = Kind::TIMESTAMP;
+        c.start_time = start;
+        c.end_time   = end;
+        return c;
+    }
+
+    static RuleCondition all_of(std::vector<RuleCondition> conditions) {
+        RuleCondition c;
+        c.kind     = Kind::AND;
+        c.operands = std::move(conditions);
+        return c;
+    }
+
+    static RuleCondition any_of(std::vector<RuleCondition> conditions) {
+        RuleCondition c;
+        c.kind     = Kind::OR;
+        c.operands = std::move(conditions);
+        return c;
+    }
+
+    static RuleCondition negate(RuleCondition condition) {
+        RuleCondition c;
+        c.kind = Kind::NOT;
+        c.operands.push_back(std::move(condition));
+        return c;
+    }
+
+    bool is_leaf() const noexcept {
+        return kind != Kind::AND && kind != Kind::OR && kind != Kind::NOT;
+    }
 };
 
+inline RuleCondition operator&&(RuleCondition lhs, RuleCondition rhs) {
+    if (lhs.kind == RuleCondition::Kind::AND) {
+        lhs.operands.push_back(std::move(rhs));
+        return lhs;
+    }
+    return RuleCondition::all_of({std::move(lhs), std::move(rhs)});
+}
+
+inline RuleCondition operator||(RuleCondition lhs, RuleCondition rhs) {
+    if (lhs.kind == RuleCondition::Kind::OR) {
+        lhs.operands.push_back(std::move(rhs));
+        return lhs;
+    }
+    return RuleCondition::any_of({std::move(lhs), std::move(rhs)});
+}
+
+inline RuleCondition operator!(RuleCondition condition) {
+    return RuleCondition::negate(std::move(condition));
+}
+
 /**
  * @brief Result of rule evaluation
  */
@@ -105,6 +298,152 @@ struct RuleMatchResult {
     explicit operator bool() const noexcept { return matched; }
 };
 
+/**
+ * @brief Reusable container for rule matches using interned sink handles
+ *
+ * Filled by RuleEngine::evaluate_into(). All storage is kept in flat
+ * buffers that retain their capacity across evaluations, so reusing one
+ * set per thread makes evaluation allocation-free in steady state (unless
+ * captured groups are requested). Views returned by operator[] are valid
+ * until the set is cleared or evaluated into again.
+ */
+class RuleMatchSet {
+public:
+    /// View of a single match
+    struct Match {
+        uint32_t rule_id      = 0;
+        RulePriority priority = RulePriority::NORMAL;
+        std::span<const SinkHandle> sinks;
+        std::span<const std::string> captured_groups;
+    };
+
+    size_t size() const noexcept { return entries_.size(); }
+    bool empty() const noexcept { return entries_.empty(); }
+
+    Match operator[](size_t index) const noexcept {
+        const auto& e = entries_[index];
+        return Match{e.rule_id, e.priority,
+                     std::span<const SinkHandle>(sinks_).subspan(e.sink_offset, e.sink_count),
+                     std::span<const std::string>(groups_).subspan(e.group_offset, e.group_count)};
+    }
+
+    /// Drop all matches, keeping buffer capacity
+    void clear() noexcept {
+        entries_.clear();
+        sinks_.clear();
+        groups_.clear();
+    }
+
+    /// Append a match; captured groups are moved out of groups
+    void add(uint32_t rule_id, RulePriority priority, std::span<const SinkHandle> sinks,
+             std::span<std::string> groups = {}) {
+        entries_.push_back(Entry{rule_id, priority, static_cast<uint32_t>(sinks_.size()),
+                                 static_cast<uint32_t>(sinks.size()),
+                                 static_cast<uint32_t>(groups_.size()),
+                                 static_cast<uint32_t>(groups.size())});
+        sinks_.insert(sinks_.end(), sinks.begin(), sinks.end());
+        for (auto& group : groups) {
+            groups_.push_back(std::move(group));
+        }
+    }
+
+private:
+    struct Entry {
+        uint32_t rule_id;
+        RulePriority priority;
+        uint32_t sink_offset;
+        uint32_t sink_count;
+        uint32_t group_offset;
+        uint32_t group_count;
+    };
+
+    std::vector<Entry> entries_;
+    std::vector<SinkHandle> sinks_;
+    std::vector<std::string> groups_;
+};
+
+/**
+ * @brief Per-rule match bitmaps for a batch of data points
+ *
+ * Filled by RuleEngine::evaluate_batch_into(). Holds one row per rule, in
+ * evaluation order; bit i of a row is set if the rule matched point i of
+ * the batch. Disabled rules have empty rows. Storage is reused across
+ * batches.
+ */
+class RuleBatchMatches {
+public:
+    /// Number of data points in the batch
+    size_t point_count() const noexcept { return point_count_; }
+
+    /// Number of rule rows
+    size_t rule_count() const noexcept { return rule_ids_.size(); }
+
+    /// 64-bit words per row
+    size_t words_per_rule() const noexcept { return words_per_rule_; }
+
+    uint32_t rule_id(size_t row) const noexcept { return rule_ids_[row]; }
+
+    /// Match bitmap of a row
+    std::span<const uint64_t> bitmap(size_t row) const noexcept {
+        return std::span<const uint64_t>(bits_).subspan(row * words_per_rule_, words_per_rule_);
+    }
+
+    bool matched(size_t row, size_t point) const noexcept {
+        return (bitmap(row)[point / 64] >> (point % 64)) & 1;
+    }
+
+    /// Number of points matched by a row
+    size_t match_count(size_t row) const noexcept {
+        size_t count = 0;
+        for (uint64_t word : bitmap(row)) {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        return count;
+    }
+
+    /// Start a new batch; drops all rows, keeping buffer capacity
+    void reset(size_t point_count) {
+        point_count_    = point_count;
+        words_per_rule_ = (point_count + 63) / 64;
+        rule_ids_.clear();
+        bits_.clear();
+    }
+
+    /// Append a zeroed row and return it for filling
+    std::span<uint64_t> add_rule(uint32_t rule_id) {
+        rule_ids_.push_back(rule_id);
+        bits_.resize(bits_.size() + words_per_rule_, 0);
+        return std::span<uint64_t>(bits_).subspan(bits_.size() - words_per_rule_);
+    }
+
+    /// Mutable row, for engines filling the set
+    std::span<uint64_t> row(size_t row) noexcept {
+        return std::span<uint64_t>(bits_).subspan(row * words_per_rule_, words_per_rule_);
+    }
+
+private:
+    size_t point_count_    = 0;
+    size_t words_per_rule_ = 0;
+    std::vector<uint32_t> rule_ids_;
+    std::vector<uint64_t> bits_;
+};
+
+/**
+ * @brief Immutable compiled form of a PATTERN rule's address_pattern
+ *
+ * Created once when the rule is built or added to an engine and shared by
+ * every copy of the rule, so evaluation never compiles on the hot path.
+ */
+struct CompiledRulePattern {
+    /// Pattern string the matcher was compiled from
+    std::string source;
+
+    /// Matcher type requested at compilation
+    PatternMatcherFactory::MatcherType type = PatternMatcherFactory::MatcherType::AUTO;
+
+    std::unique_ptr<IPatternMatcher> matcher;
+};
+
 /**
  * @brief Routing rule definition
  */
@@ -130,6 +469,9 @@ struct RoutingRule {
     // Pattern matching (CTRE-optimized when available)
     std::string address_pattern;
 
+    /// Compiled address_pattern, shared between copies of the rule
+    std::shared_ptr<const CompiledRulePattern> compiled_pattern;
+
     // Protocol-based matching
     std::vector<uint16_t> protocol_ids;
 
@@ -146,9 +488,19 @@ struct RoutingRule {
     // Target sinks
     std::vector<std::string> target_sink_ids;
 
+    /// Interned target_sink_ids, resolved by RuleEngine when the rule is added
+    std::vector<SinkHandle> target_sink_handles;
+
     // Custom predicate (for CUSTOM type)
     std::function<bool(const common::DataPoint&)> custom_predicate;
 
+    // Condition tree (for COMPOSITE type)
+    std::optional<RuleCondition> condition;
+
+    /// Compiled condition, shared between copies of the rule. Call
+    /// compile_condition() again after modifying condition.
+    std::shared_ptr<const CompiledCondition> compiled_condition;
+
     // Rule statistics (atomic for thread-safety)
     mutable std::atomic<uint64_t> match_count{0};
     mutable std::atomic<uint64_t> eval_count{0};
@@ -161,10 +513,13 @@ struct RoutingRule {
     RoutingRule(const RoutingRule& other)
         : id(other.id), name(other.name), type(other.type), priority(other.priority),
           enabled(other.enabled), source_addresses(other.source_addresses),
-          address_pattern(other.address_pattern), protocol_ids(other.protocol_ids),
+          address_pattern(other.address_pattern), compiled_pattern(other.compiled_pattern),
+          protocol_ids(other.protocol_ids),
           quality_levels(other.quality_levels), value_condition(other.value_condition),
           start_time(other.start_time), end_time(other.end_time),
-          target_sink_ids(other.target_sink_ids), custom_predicate(other.custom_predicate),
+          target_sink_ids(other.target_sink_ids), target_sink_handles(other.target_sink_handles),
+          custom_predicate(other.custom_predicate), condition(other.condition),
+          compiled_condition(other.compiled_condition),
           match_count(other.match_count.load()), eval_count(other.eval_count.load()),
           total_eval_time_ns(other.total_eval_time_ns.load()) {}
 
@@ -173,31 +528,39 @@ struct RoutingRule {
         : id(other.id), name(std::move(other.name)), type(other.type), priority(other.priority),
           enabled(other.enabled), source_addresses(std::move(other.source_addresses)),
           address_pattern(std::move(other.address_pattern)),
+          compiled_pattern(std::move(other.compiled_pattern)),
           protocol_ids(std::move(other.protocol_ids)),
           quality_levels(std::move(other.quality_levels)),
           value_condition(std::move(other.value_condition)), start_time(other.start_time),
           end_time(other.end_time), target_sink_ids(std::move(other.target_sink_ids)),
+          target_sink_handles(std::move(other.target_sink_handles)),
           custom_predicate(std::move(other.custom_predicate)),
+          condition(std::move(other.condition)),
+          compiled_condition(std::move(other.compiled_condition)),
           match_count(other.match_count.load()), eval_count(other.eval_count.load()),
           total_eval_time_ns(other.total_eval_time_ns.load()) {}
 
     // Copy assignment
     RoutingRule& operator=(const RoutingRule& other) {
         if (this != &other) {
-            id               = other.id;
-            name             = other.name;
-            type             = other.type;
-            priority         = other.priority;
-            enabled          = other.enabled;
-            source_addresses = other.source_addresses;
-            address_pattern  = other.address_pattern;
-            protocol_ids     = other.protocol_ids;
-            quality_levels   = other.quality_levels;
-            value_condition  = other.value_condition;
-            start_time       = other.start_time;
-            end_time         = other.end_time;
-            target_sink_ids  = other.target_sink_ids;
-            custom_predicate = other.custom_predicate;
+            id                  = other.id;
+            name                = other.name;
+            type                = other.type;
+            priority            = other.priority;
+            enabled             = other.enabled;
+            source_addresses    = other.source_addresses;
+            address_pattern     = other.address_pattern;
+            compiled_pattern    = other.compiled_pattern;
+            protocol_ids        = other.protocol_ids;
+            quality_levels      = other.quality_levels;
+            value_condition     = other.value_condition;
+            start_time          = other.start_time;
+            end_time            = other.end_time;
+            target_sink_ids     = other.target_sink_ids;
+            target_sink_handles = other.target_sink_handles;
+            custom_predicate    = other.custom_predicate;
+            condition           = other.condition;
+            compiled_condition  = other.compiled_condition;
             match_count.store(other.match_count.load());
             eval_count.store(other.eval_count.load());
             total_eval_time_ns.store(other.total_eval_time_ns.load());
@@ -208,20 +571,24 @@ struct RoutingRule {
     // Move assignment
     RoutingRule& operator=(RoutingRule&& other) noexcept {
         if (this != &other) {
-            id               = other.id;
-            name             = std::move(other.name);
-            type             = other.type;
-            priority         = other.priority;
-            enabled          = other.enabled;
-            source_addresses = std::move(other.source_addresses);
-            address_pattern  = std::move(other.address_pattern);
-            protocol_ids     = std::move(other.protocol_ids);
-            quality_levels   = std::move(other.quality_levels);
-            value_condition  = std::move(other.value_condition);
-            start_time       = other.start_time;
-            end_time         = other.end_time;
-            target_sink_ids  = std::move(other.target_sink_ids);
-            custom_predicate = std::move(other.custom_predicate);
+            id                  = other.id;
+            name                = std::move(other.name);
+            type                = other.type;
+            priority            = other.priority;
+            enabled             = other.enabled;
+            source_addresses    = std::move(other.source_addresses);
+            address_pattern     = std::move(other.address_pattern);
+            compiled_pattern    = std::move(other.compiled_pattern);
+            protocol_ids        = std::move(other.protocol_ids);
+            quality_levels      = std::move(other.quality_levels);
+            value_condition     = std::move(other.value_condition);
+            start_time          = other.start_time;
+            end_time            = other.end_time;
+            target_sink_ids     = std::move(other.target_sink_ids);
+            target_sink_handles = std::move(other.target_sink_handles);
+            custom_predicate    = std::move(other.custom_predicate);
+            condition           = std::move(other.condition);
+            compiled_condition  = std::move(other.compiled_condition);
             match_count.store(other.match_count.load());
             eval_count.store(other.eval_count.load());
             total_eval_time_ns.store(other.total_eval_time_ns.load());
@@ -232,6 +599,43 @@ struct RoutingRule {
     /// Check if this rule matches a data point
     RuleMatchResult evaluate(const common::DataPoint& dp) const;
 
+    /**
+     * @brief Check if this rule matches a data point without building a result
+     * @param dp The data point to test
+     * @param captured_groups If non-null, receives pattern capture groups
+     *
+     * Updates the same per-rule statistics as evaluate().
+     */
+    bool matches(const common::DataPoint& dp,
+                 std::vector<std::string>* captured_groups = nullptr) const;
+
+    /**
+     * @brief Compile address_pattern into the shared compiled form
+     * @param type Matcher type to compile with
+     *
+     * No-op if the rule already holds a compiled form for the current
+     * pattern and type. Not thread-safe against concurrent evaluate().
+     */
+    void compile_pattern(
+        PatternMatcherFactory::MatcherType type = PatternMatcherFactory::MatcherType::AUTO);
+
+    /**
+     * @brief Compile condition into the shared compiled form
+     * @param type Matcher type for PATTERN leaves
+     *
+     * Always recompiles. Not thread-safe against concurrent evaluate().
+     */
+    void compile_condition(
+        PatternMatcherFactory::MatcherType type = PatternMatcherFactory::MatcherType::AUTO);
+
+    /// Compiled matcher for address_pattern, or nullptr if missing or stale
+    const IPatternMatcher* pattern_matcher() const noexcept {
+        if (compiled_pattern && compiled_pattern->source == address_pattern) {
+            return compiled_pattern->matcher.get();
+        }
+        return nullptr;
+    }
+
     /// Get average evaluation time in nanoseconds
     double avg_eval_time_ns() const noexcept {
         auto count = eval_count.load(std::memory_order_relaxed);
@@ -247,6 +651,10 @@ struct RuleEngineStats {
     std::atomic<uint64_t> total_matches{0};
     std::atomic<uint64_t> cache_hits{0};
     std::atomic<uint64_t> cache_misses{0};
+    std::atomic<uint64_t> cache_evictions{0};
+
+    /// Rules actually evaluated (candidates after index filtering)
+    std::atomic<uint64_t> rules_evaluated{0};
 
     std::atomic<int64_t> min_eval_time_ns{INT64_MAX};
     std::atomic<int64_t> max_eval_time_ns{0};
@@ -267,6 +675,8 @@ struct RuleEngineStats {
         total_matches.store(0);
         cache_hits.store(0);
         cache_misses.store(0);
+        cache_evictions.store(0);
+        rules_evaluated.store(0);
         min_eval_time_ns.store(INT64_MAX);
         max_eval_time_ns.store(0);
         total_eval_time_ns.store(0);
@@ -289,11 +699,19 @@ struct RuleEngineConfig {
     /// Cache TTL in milliseconds (0 = no expiry)
     uint32_t cache_ttl_ms = 1000;
 
+    /// Number of independently locked cache shards (rounded down to a power of two)
+    size_t cache_shards = 16;
+
     /// Use CTRE when available
     bool prefer_ctre = true;
 
-    /// Pre-compile all patterns at rule addition time
+    /// Pre-compile all patterns at rule addition time (rules built with
+    /// RuleBuilder already carry an AUTO-compiled matcher)
     bool precompile_patterns = true;
+
+    /// Evaluate only candidate rules selected by a compiled RuleIndex
+    /// (hash/trie/bitset) instead of scanning every rule
+    bool enable_rule_index = true;
 };
 
 /**
@@ -304,9 +722,12 @@ struct RuleEngineConfig {
  *
  * Features:
  * - CTRE compile-time regex for O(n) matching
- * - LRU cache for repeated address evaluations
- * - Priority-ordered rule evaluation
- * - Thread-safe rule management
+ * - Compiled rule index so only candidate rules are evaluated
+ * - Sharded result cache with CLOCK eviction, TTL and epoch invalidation
+ * - Priority-ordered rule evaluation (insertion order within a priority)
+ * - Allocation-free evaluate_into() reporting interned sink handles
+ * - Versioned, immutable rule snapshots: evaluation never blocks on rule
+ *   changes, and replace_rules() swaps a whole rule set atomically
  *
  * Example usage:
  * @code
@@ -357,12 +778,26 @@ public:
     /// Get all rules (for serialization)
     std::vector<RoutingRule> get_all_rules() const;
 
+    /**
+     * @brief Atomically replace the whole rule set
+     * @param rules New rules; IDs are reassigned
+     * @return Assigned rule IDs, in the order of the input
+     *
+     * The new table is compiled and indexed before it is published, so
+     * concurrent evaluations see either the complete old set or the
+     * complete new set, never a mix.
+     */
+    std::vector<uint32_t> replace_rules(std::vector<RoutingRule> rules);
+
     /// Clear all rules
     void clear_rules();
 
     /// Get rule count
     size_t rule_count() const noexcept;
 
+    /// Version of the current rule snapshot; incremented by every rule change
+    uint64_t rules_version() const noexcept;
+
     // Evaluation
 
     /// Evaluate all rules against a data point
@@ -379,6 +814,59 @@ public:
     std::vector<std::vector<RuleMatchResult>> evaluate_batch(
         std::span<const common::DataPoint> data_points);
 
+    /**
+     * @brief Evaluate a batch into per-rule match bitmaps
+     * @param data_points The batch
+     * @param out Receives one bitmap row per rule
+     * @return Total number of (rule, point) matches
+     *
+     * VALUE rules are evaluated column-wise: the values of the batch are
+     * extracted once, each rule's reference is resolved once, and the
+     * comparison runs over the whole column. Other rules are evaluated per
+     * point through the rule index. Bypasses the result cache.
+     */
+    size_t evaluate_batch_into(std::span<const common::DataPoint> data_points,
+                               RuleBatchMatches& out);
+
+    /**
+     * @brief Evaluate a columnar batch into per-rule match bitmaps
+     * @param batch The batch
+     * @param out Receives one bitmap row per rule
+     * @return Total number of (rule, point) matches
+     *
+     * VALUE, PROTOCOL, QUALITY and TIMESTAMP rules each make one pass over
+     * the column they test. Address, composite and custom rules are
+     * evaluated per point through the rule index, on points loaded from the
+     * batch. Produces the same bitmaps as evaluate_batch_into().
+     */
+    size_t evaluate_columns_into(const common::ColumnarBatch& batch, RuleBatchMatches& out);
+
+    /**
+     * @brief Evaluate all rules into a reusable match set
+     * @param dp The data point to evaluate
+     * @param out Cleared, then filled with matches in priority order
+     * @param capture_groups Also collect pattern capture groups (allocates)
+     * @return Number of matches
+     *
+     * Hot-path counterpart of evaluate(): targets are reported as interned
+     * SinkHandle values instead of strings and the result cache is bypassed,
+     * so no heap allocation happens once out has warmed up.
+     */
+    size_t evaluate_into(const common::DataPoint& dp, RuleMatchSet& out,
+                         bool capture_groups = false);
+
+    // Sink Handles
+
+    /**
+     * @brief Share a sink ID interner (typically SinkRegistry::sink_interner())
+     *
+     * Re-resolves the target handles of all existing rules.
+     */
+    void set_sink_interner(std::shared_ptr<SinkIdInterner> interner);
+
+    /// Interner used to resolve rule targets to SinkHandle values
+    const SinkIdInterner& sink_interner() const noexcept;
+
     // Cache Management
 
     /// Clear the evaluation cache
@@ -463,6 +951,20 @@ public:
         return *this;
     }
 
+    RuleBuilder& match_condition(RuleCondition condition) {
+        rule_.type      = RuleType::COMPOSITE;
+        rule_.condition = std::move(condition);
+        return *this;
+    }
+
+    RuleBuilder& match_all(std::vector<RuleCondition> conditions) {
+        return match_condition(RuleCondition::all_of(std::move(conditions)));
+    }
+
+    RuleBuilder& match_any(std::vector<RuleCondition> conditions) {
+        return match_condition(RuleCondition::any_of(std::move(conditions)));
+    }
+
     RuleBuilder& match_custom(std::function<bool(const common::DataPoint&)> predicate) {
         rule_.type             = RuleType::CUSTOM;
         rule_.custom_predicate = std::move(predicate);
@@ -479,7 +981,14 @@ public:
         return *this;
     }
 
-    RoutingRule build() { return std::move(rule_); }
+    RoutingRule build() {
+        if (rule_.type == RuleType::PATTERN) {
+            rule_.compile_pattern();
+        } else if (rule_.type == RuleType::COMPOSITE) {
+            rule_.compile_condition();
+        }
+        return std::move(rule_);
+    }
 
 private:
     RoutingRule rule_;
@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file rule_index.hpp
+ * @brief Compiled candidate index for RuleEngine evaluation
+ *
+ * Instead of walking every rule for every DataPoint, the RuleEngine keeps a
+ * RuleIndex compiled from its priority-ordered rule table:
+ * - STATIC addresses (and literal PATTERN rules) in a hash map, plus a map
+ *   from their interned address IDs for points that carry one
+ * - Literal prefixes of PATTERN rules in a TrieMatcher
+ * - Bitsets keyed on protocol ID and on quality
+ * - COMPOSITE rules whose condition requires an exact address, hashed like
+ *   STATIC rules
+ * - A residual bitset for rules that cannot be indexed (VALUE, TIMESTAMP,
+ *   CUSTOM, other COMPOSITE rules, patterns without a literal prefix)
+ *
+ * The index only narrows the candidate set; every candidate is still fully
+ * evaluated, so results are identical to the linear scan. Candidates are
+ * produced as a bitset over rule positions, which keeps them in table
+ * (priority) order.
+ */
+
+#include <ipb/common/data_point.hpp>
+#include <ipb/core/rule_engine/pattern_matcher.hpp>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ipb::core {
+
+struct RoutingRule;
+
+/**
+ * @brief Candidate-rule index over a priority-ordered rule table
+ *
+ * Positions handed out by the index refer to the span passed to build().
+ * The index must be rebuilt whenever that table changes.
+ *
+ * Thread-safe for concurrent reads after build().
+ */
+class RuleIndex {
+public:
+    /// Number of distinct Quality values tracked by the quality bitsets
+    static constexpr size_t QUALITY_SLOTS = 16;
+
+    RuleIndex()  = default;
+    ~RuleIndex() = default;
+
+    // Non-copyable but movable
+    RuleIndex(const RuleIndex&)            = delete;
+    RuleIndex& operator=(const RuleIndex&) = delete;
+    RuleIndex(RuleIndex&&) noexcept            = default;
+    RuleIndex& operator=(RuleIndex&&) noexcept = default;
+
+    /**
+     * @brief Rebuild the index from a rule table
+     * @param rules Rules in evaluation order; positions refer to this span
+     */
+    void build(std::span<const RoutingRule* const> rules);
+
+    /**
+     * @brief Drop all indexed rules
+     */
+    void clear();
+
+    /**
+     * @brief Fill a bitset with the positions of all candidate rules for dp
+     * @param dp The data point being routed
+     * @param words Output bitset, resized to word_count()
+     *
+     * A rule that is not a candidate is guaranteed not to match dp.
+     */
+    void collect_candidates(const common::DataPoint& dp, std::vector<uint64_t>& words) const;
+
+    /**
+     * @brief Visit candidate rule positions in ascending (priority) order
+     * @param dp The data point being routed
+     * @param fn Callable taking the rule position; return false to stop early
+     *
+     * Uses a thread-local scratch bitset, so it does not allocate in steady state.
+     */
+    template <typename Fn>
+    void for_each_candidate(const common::DataPoint& dp, Fn&& fn) const {
+        // Re-entrant use (e.g. a custom predicate evaluating another engine)
+        // falls back to a local buffer instead of clobbering the scratch bitset
+        thread_local std::vector<uint64_t> scratch;
+        thread_local bool scratch_in_use = false;
+
+        std::vector<uint64_t> local;
+        ScratchGuard guard(scratch_in_use);
+        auto& words = guard.owned ? scratch : local;
+        collect_candidates(dp, words);
+
+        for (size_t w = 0; w < words.size(); ++w) {
+            uint64_t bits = words[w];
+            while (bits != 0) {
+                auto position = static_cast<uint32_t>(w * 64 + std::countr_zero(bits));
+                bits &= bits - 1;
+                if (!fn(position)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    /// Number of rules covered by the index
+    size_t size() const noexcept { return rule_count_; }
+
+    /// Number of 64-bit words in a candidate bitset
+    size_t word_count() const noexcept { return (rule_count_ + 63) / 64; }
+
+    /**
+     * @brief Extract the literal prefix every match of a pattern must start with
+     * @param pattern Address pattern (wildcard or regex syntax)
+     * @return Conservative literal prefix, empty if none can be derived
+     *
+     * Valid under both wildcard and ECMAScript regex interpretation, so it is
+     * safe regardless of which matcher the engine selects for the pattern.
+     */
+    static std::string_view literal_prefix(std::string_view pattern) noexcept;
+
+    /**
+     * @brief Index statistics
+     */
+    struct Stats {
+        size_t static_keys      = 0;  ///< Distinct hashed addresses
+        size_t prefix_patterns  = 0;  ///< Patterns indexed by literal prefix
+        size_t protocol_keys    = 0;  ///< Distinct protocol IDs
+        size_t quality_rules    = 0;  ///< Rules indexed by quality
+        size_t composite_rules  = 0;  ///< COMPOSITE rules indexed by a required address
+        size_t unindexed_rules  = 0;  ///< Rules evaluated for every data point
+    };
+    Stats stats() const noexcept { return stats_; }
+
+private:
+    struct ScratchGuard {
+        bool& in_use;
+        bool owned;
+        explicit ScratchGuard(bool& flag) noexcept : in_use(flag), owned(!flag) { in_use = true; }
+        ~ScratchGuard() {
+            if (owned) {
+                in_use = false;
+            }
+        }
+    };
+
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    void set_bit(std::vector<uint64_t>& words, uint32_t position) const noexcept {
+        words[position / 64] |= uint64_t{1} << (position % 64);
+    }
+
+    std::vector<uint64_t> empty_bitset() const { return std::vector<uint64_t>(word_count(), 0); }
+
+    size_t rule_count_ = 0;
+
+    std::unordered_map<std::string, std::vector<uint32_t>, StringHash, std::equal_to<>>
+        address_index_;
+    std::unordered_map<common::StringInterner::Id, const std::vector<uint32_t>*>
+        address_id_index_;  ///< Points into address_index_ values
+    /// IDs below this were interned before the last build, so a miss in address_id_index_ is final
+    common::StringInterner::Id address_id_limit_ = 0;
+    TrieMatcher prefix_trie_;
+    std::unordered_map<uint16_t, std::vector<uint64_t>> protocol_bits_;
+    std::array<std::vector<uint64_t>, QUALITY_SLOTS> quality_bits_;
+    std::vector<uint64_t> residual_bits_;
+
+    Stats stats_;
+};
+
+}  // namespace ipb::core
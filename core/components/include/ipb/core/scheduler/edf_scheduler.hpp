@@ -6,7 +6,7 @@
  *
  * The EDFScheduler provides deterministic task scheduling based on deadlines:
  * - EDF algorithm guarantees optimal scheduling for periodic tasks
- * - Lock-free task submission
+ * - Mutex-protected heap or lock-free skip list ready queue
  * - Deadline miss detection and reporting
  * - Priority-based fallback for equal deadlines
  *
@@ -111,6 +111,28 @@ struct SubmitResult {
     explicit operator bool() const noexcept { return success; }
 };
 
+/**
+ * @brief Release statistics of one periodic task
+ *
+ * Jitter is the delay from an instance's scheduled release (start + k *
+ * period) to the moment it starts executing: timer lateness plus time
+ * spent in the ready queue.
+ */
+struct PeriodicTaskStats {
+    uint64_t releases = 0;  ///< Instances submitted
+    uint64_t started  = 0;  ///< Instances that began executing
+    uint64_t skipped  = 0;  ///< Releases dropped: previous instance unfinished or not accepted
+
+    int64_t last_jitter_ns  = 0;
+    int64_t max_jitter_ns   = 0;
+    int64_t total_jitter_ns = 0;
+
+    /// Calculate average jitter in microseconds
+    double avg_jitter_us() const noexcept {
+        return started > 0 ? static_cast<double>(total_jitter_ns) / started / 1000.0 : 0.0;
+    }
+};
+
 /**
  * @brief Statistics for scheduler monitoring
  */
@@ -119,6 +141,7 @@ struct EDFSchedulerStats {
     std::atomic<uint64_t> tasks_completed{0};
     std::atomic<uint64_t> tasks_cancelled{0};
     std::atomic<uint64_t> tasks_failed{0};
+    std::atomic<uint64_t> tasks_rejected{0};  ///< Failed the admission test
     std::atomic<uint64_t> deadlines_met{0};
     std::atomic<uint64_t> deadlines_missed{0};
 
@@ -156,6 +179,7 @@ struct EDFSchedulerStats {
         tasks_completed.store(0);
         tasks_cancelled.store(0);
         tasks_failed.store(0);
+        tasks_rejected.store(0);
         deadlines_met.store(0);
         deadlines_missed.store(0);
         current_queue_size.store(0);
@@ -176,6 +200,23 @@ struct EDFSchedulerConfig {
     /// Maximum queue size
     size_t max_queue_size = 100000;
 
+    /// Ready queue implementation
+    enum class QueueBackend {
+        MUTEX_HEAP,    ///< TaskQueue: binary heap behind a mutex
+        LOCK_FREE,     ///< common::LockFreeTaskQueue: skip list, submitters never block
+        WORK_STEALING  ///< WorkStealingTaskQueue: per-worker heaps, idle workers steal
+    } queue_backend = QueueBackend::MUTEX_HEAP;
+
+    /**
+     * Reject tasks that cannot meet their deadline: the queued tasks due
+     * before it, spread over the workers, plus the task itself would not
+     * finish in time at the measured average execution time.
+     */
+    bool admission_control = false;
+
+    /// Deadline resolution of the admission test (it looks 256 slots ahead)
+    std::chrono::nanoseconds admission_slot_width{1000000};  // 1ms
+
     /// Number of worker threads (0 = hardware concurrency)
     size_t worker_threads = 0;
 
@@ -191,9 +232,12 @@ struct EDFSchedulerConfig {
     /// CPU affinity for workers (-1 = no affinity, else starting CPU)
     int cpu_affinity_start = -1;
 
-    /// Deadline check interval
+    /// Longest an idle worker sleeps before re-checking the ready queue
     std::chrono::microseconds check_interval{100};
 
+    /// Resolution of the timer wheel releasing periodic tasks
+    std::chrono::nanoseconds timer_tick{1000000};  // 1ms
+
     /// Action when queue is full
     enum class OverflowPolicy {
         REJECT,        ///< Reject new tasks
@@ -213,9 +257,10 @@ struct EDFSchedulerConfig {
  *
  * Features:
  * - O(log n) task insertion and extraction
- * - Lock-free task submission (in most cases)
+ * - Lock-free task submission with QueueBackend::LOCK_FREE
  * - Deadline miss detection
  * - Priority-based tie-breaking
+ * - Periodic tasks released by a timer wheel, with per-task jitter stats
  * - Real-time thread support
  *
  * Example usage:
@@ -293,6 +338,9 @@ public:
     /// Cancel a periodic task
     bool cancel_periodic(uint64_t periodic_id);
 
+    /// Get release and jitter statistics of a periodic task
+    std::optional<PeriodicTaskStats> periodic_stats(uint64_t periodic_id) const;
+
     // Task Management
 
     /// Cancel a pending task
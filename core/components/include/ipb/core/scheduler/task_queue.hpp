@@ -2,9 +2,13 @@
 
 /**
  * @file task_queue.hpp
- * @brief Thread-safe priority queue for EDF scheduling
+ * @brief Thread-safe priority queues for EDF scheduling
  */
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <vector>
@@ -43,6 +47,9 @@ public:
     /// Remove a task by ID
     bool remove(uint64_t task_id);
 
+    /// Remove a task by ID and return it
+    std::optional<ScheduledTask> extract(uint64_t task_id);
+
     /// Check if queue is empty
     bool empty() const;
 
@@ -67,4 +74,117 @@ private:
         queue_;
 };
 
+/**
+ * @brief Per-worker EDF heaps with deadline-aware work stealing
+ *
+ * Each worker owns a heap behind its own lock, so workers only contend
+ * when one steals from another. A worker runs its own earliest deadline
+ * first; once its heap is empty it steals the earliest-deadline task of
+ * whichever peer currently holds the earliest one.
+ *
+ * Submissions go to the submitting worker's own heap (tasks spawned by
+ * tasks stay local), otherwise to an idle worker, otherwise round-robin.
+ */
+class WorkStealingTaskQueue {
+public:
+    /// Worker index meaning "not submitted from a worker"
+    static constexpr size_t NO_WORKER = static_cast<size_t>(-1);
+
+    WorkStealingTaskQueue(size_t workers, size_t max_size);
+    ~WorkStealingTaskQueue();
+
+    WorkStealingTaskQueue(const WorkStealingTaskQueue&)            = delete;
+    WorkStealingTaskQueue& operator=(const WorkStealingTaskQueue&) = delete;
+
+    /// Queue a task, preferably on the given worker
+    bool push(ScheduledTask task, size_t worker = NO_WORKER);
+
+    /// Pop from the worker's own heap, stealing from a peer when it is empty
+    bool pop(size_t worker, ScheduledTask& task);
+
+    /// Pop from any heap (used to drain the queue)
+    bool pop_any(ScheduledTask& task);
+
+    /// Remove a task by ID
+    bool remove(uint64_t task_id) { return extract(task_id).has_value(); }
+
+    /// Remove a task by ID and return it
+    std::optional<ScheduledTask> extract(uint64_t task_id);
+
+    /**
+     * @brief Sleep until the worker may have something to run
+     *
+     * Returns early when a task is queued on the worker or wake_all() is
+     * called; returns immediately if any heap has tasks.
+     */
+    void wait(size_t worker, std::chrono::nanoseconds timeout);
+
+    /// Wake every sleeping worker (e.g. on stop)
+    void wake_all();
+
+    bool empty() const noexcept { return size() == 0; }
+    size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+    size_t max_size() const noexcept { return max_size_; }
+    size_t worker_count() const noexcept { return locals_.size(); }
+
+    /// Tasks taken from another worker's heap
+    uint64_t steals() const noexcept { return steals_.load(std::memory_order_relaxed); }
+
+    /// Get nearest deadline across all workers (or nullopt if empty)
+    std::optional<common::Timestamp> nearest_deadline() const;
+
+private:
+    struct Local;
+
+    bool pop_local(Local& local, ScheduledTask& task);
+    bool steal(size_t thief, ScheduledTask& task);
+    size_t pick_worker(size_t hint) noexcept;
+
+    std::vector<std::unique_ptr<Local>> locals_;
+    size_t max_size_;
+    std::atomic<size_t> size_{0};
+    std::atomic<size_t> next_worker_{0};
+    std::atomic<uint64_t> steals_{0};
+};
+
+/**
+ * @brief Lower bound on queued work due before a deadline, for admission
+ *
+ * Counts queued tasks in fixed-width deadline slots over a sliding horizon
+ * of BUCKETS slots. Tasks due beyond the horizon, tasks whose slot has
+ * been recycled, and tasks sharing the deadline's own slot (some of them
+ * may be due after it) are not counted, so the count ahead of a deadline
+ * never exceeds the real one: rejecting on it only rejects tasks that would
+ * miss even if the estimate of their run time held exactly.
+ */
+class DeadlineDemand {
+public:
+    static constexpr size_t BUCKETS = 256;
+
+    explicit DeadlineDemand(std::chrono::nanoseconds slot_width);
+
+    /// Record a queued task
+    void add(common::Timestamp deadline, common::Timestamp now) noexcept;
+
+    /// Record that a queued task left the queue (run, cancelled or dropped)
+    void remove(common::Timestamp deadline) noexcept;
+
+    /// Queued tasks in the slots before the deadline's slot (all due before the deadline)
+    uint64_t count_before(common::Timestamp deadline, common::Timestamp now) const noexcept;
+
+private:
+    // Slot number (mod 2^40) in the high bits, task count in the low COUNT_BITS
+    static constexpr unsigned COUNT_BITS = 24;
+    static constexpr uint64_t COUNT_MASK = (uint64_t{1} << COUNT_BITS) - 1;
+
+    static uint64_t tag_of(int64_t slot) noexcept {
+        return static_cast<uint64_t>(slot) << COUNT_BITS;
+    }
+
+    int64_t slot_of(common::Timestamp t) const noexcept;
+
+    int64_t width_ns_;
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+};
+
 }  // namespace ipb::core
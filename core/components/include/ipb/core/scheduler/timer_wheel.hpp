@@ -0,0 +1,135 @@
+#pragma once
+
+/**
+ * @file timer_wheel.hpp
+ * @brief Hierarchical timer wheel with intrusive, allocation-free timers
+ *
+ * Timers are embedded in the objects that own them (TimerNode is meant to
+ * be a base class), so arming, re-arming and cancelling only relink
+ * pointers. Four levels of 64 slots cover 64^4 ticks (about 4.6 hours at
+ * 1ms); later expiries are parked in the top level and re-filed as time
+ * passes.
+ *
+ * Timers never fire early and fire at most one tick late. The wheel is not
+ * thread-safe; the owner serializes access.
+ */
+
+#include <ipb/common/data_point.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace ipb::core {
+
+/**
+ * @brief Timer embedded in its owner
+ */
+class TimerNode {
+public:
+    /// Absolute expiry the timer was last armed for
+    common::Timestamp expiry() const noexcept { return expiry_; }
+
+    bool armed() const noexcept { return pprev_ != nullptr; }
+
+private:
+    friend class TimerWheel;
+
+    common::Timestamp expiry_;
+    uint64_t expiry_tick_ = 0;
+
+    // Slot list links; pprev_ points at the previous next_ (or the slot head)
+    TimerNode* next_   = nullptr;
+    TimerNode** pprev_ = nullptr;
+};
+
+/**
+ * @brief Hashed hierarchical timing wheel (Varghese & Lauck)
+ *
+ * Level L has 64 slots of 64^L ticks each. A timer is filed at the lowest
+ * level whose span covers it; when the clock crosses a slot boundary of a
+ * higher level, that slot's timers are re-filed into the levels below.
+ */
+class TimerWheel {
+public:
+    static constexpr size_t LEVELS      = 4;
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr size_t SLOTS       = size_t{1} << SLOT_BITS;
+
+    TimerWheel(std::chrono::nanoseconds tick, common::Timestamp now);
+
+    TimerWheel(const TimerWheel&)            = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    std::chrono::nanoseconds tick() const noexcept { return std::chrono::nanoseconds(tick_ns_); }
+
+    /// Arm (or re-arm) a timer; an expiry in the past fires on the next tick
+    void arm(TimerNode& node, common::Timestamp expiry) noexcept;
+
+    /// Disarm a timer (no-op if it is not armed)
+    void cancel(TimerNode& node) noexcept;
+
+    /**
+     * @brief Move the clock forward, firing every timer that expired
+     * @param on_expired Called as on_expired(TimerNode&) with the timer
+     *        already disarmed; it may re-arm the timer
+     */
+    template <typename OnExpired>
+    void advance(common::Timestamp now, OnExpired&& on_expired) {
+        const uint64_t target = tick_of(now);
+
+        while (current_ < target) {
+            // Skip ticks at which no slot has anything to do
+            auto next = next_tick();
+            if (next > current_ + 1) {
+                current_ = next - 1 < target ? next - 1 : target;
+                if (current_ == target) {
+                    return;
+                }
+            }
+            ++current_;
+
+            // Re-file higher slots whose boundary was just crossed, top-down
+            for (size_t level = LEVELS - 1; level >= 1; --level) {
+                if ((current_ & ((uint64_t{1} << (SLOT_BITS * level)) - 1)) == 0) {
+                    cascade(level);
+                }
+            }
+
+            auto& slot      = slots_[0][current_ & (SLOTS - 1)];
+            TimerNode* node = slot;
+            slot            = nullptr;
+            while (node != nullptr) {
+                TimerNode* next_node = node->next_;
+                node->next_          = nullptr;
+                node->pprev_         = nullptr;
+                --size_;
+                on_expired(*node);
+                node = next_node;
+            }
+        }
+    }
+
+    /// Time at which the next timer is due to fire (or be re-filed), if any
+    std::optional<common::Timestamp> next_expiry() const noexcept;
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+private:
+    uint64_t tick_of(common::Timestamp t) const noexcept;
+
+    /// First tick after current_ at which a non-empty slot is processed
+    uint64_t next_tick() const noexcept;
+
+    void link(TimerNode& node) noexcept;
+    void cascade(size_t level) noexcept;
+
+    int64_t tick_ns_;
+    uint64_t current_;
+    size_t size_ = 0;
+    std::array<std::array<TimerNode*, SLOTS>, LEVELS> slots_{};
+};
+
+}  // namespace ipb::core
@@ -20,6 +20,7 @@
 #include <ipb/common/platform.hpp>
 
 #include <atomic>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -242,6 +243,53 @@ struct SinkRegistryConfig {
     std::chrono::milliseconds failover_timeout{30000};
 };
 
+/// Compact handle for an interned sink ID
+using SinkHandle = uint32_t;
+
+/// Handle value that never refers to an interned sink ID
+inline constexpr SinkHandle INVALID_SINK_HANDLE = UINT32_MAX;
+
+/**
+ * @brief Append-only table mapping sink ID strings to small integer handles
+ *
+ * Each distinct ID is interned once and keeps its handle for the lifetime
+ * of the table, even if the sink is unregistered, so handles stored in
+ * compiled rules never dangle. Handles are dense, starting at 0.
+ *
+ * Thread-safe: lookups take a shared lock, interning a new ID an exclusive one.
+ */
+class SinkIdInterner {
+public:
+    SinkIdInterner() = default;
+
+    SinkIdInterner(const SinkIdInterner&)            = delete;
+    SinkIdInterner& operator=(const SinkIdInterner&) = delete;
+
+    /// Return the handle for id, interning it on first use
+    SinkHandle intern(std::string_view id);
+
+    /// Return the handle for id, or INVALID_SINK_HANDLE if never interned
+    SinkHandle find(std::string_view id) const;
+
+    /// Return the ID for a handle (empty if the handle is unknown)
+    std::string_view id(SinkHandle handle) const;
+
+    /// Number of interned IDs
+    size_t size() const;
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, SinkHandle, StringHash, std::equal_to<>> handles_;
+    std::deque<std::string> ids_;  ///< Stable storage; views into it stay valid
+};
+
 /**
  * @brief Centralized sink registry with load balancing
  *
@@ -319,6 +367,17 @@ public:
     /// Get sink count
     size_t sink_count() const noexcept;
 
+    // Sink ID Interning
+
+    /// Return the handle for a sink ID, interning it on first use
+    SinkHandle intern_sink_id(std::string_view id);
+
+    /// Return the sink ID for a handle (empty if unknown)
+    std::string_view sink_id(SinkHandle handle) const;
+
+    /// Shared interner, so other components (e.g. RuleEngine) use the same handles
+    std::shared_ptr<SinkIdInterner> sink_interner() const noexcept;
+
     // Sink Configuration
 
     /// Enable or disable a sink
@@ -1,33 +1,237 @@
 #include "ipb/core/message_bus/channel.hpp"
 
+#include <ipb/common/platform.hpp>
+
 #include <algorithm>
+#include <utility>
 
 namespace ipb::core {
 
+namespace {
+
+/// Deliver a message to one subscriber unless it is inactive or filtered out
+void deliver(SubscriberEntry& subscriber, const Message& msg) {
+    if (!subscriber.active.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // Apply filter if present
+    if (subscriber.filter && !subscriber.filter(msg)) {
+        return;
+    }
+
+    if (subscriber.queue) {
+        subscriber.queue->push(msg);
+        return;
+    }
+
+    try {
+        subscriber.callback(msg);
+    } catch (...) {
+        // Subscriber threw exception - continue to other subscribers
+    }
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// SegmentedMessageQueue Implementation
+// ============================================================================
+
+SegmentedMessageQueue::~SegmentedMessageQueue() {
+    auto* segment = head_segment_.load(std::memory_order_acquire);
+    while (segment) {
+        delete std::exchange(segment, segment->next.load(std::memory_order_acquire));
+    }
+    delete spare_.load(std::memory_order_acquire);
+}
+
+SegmentedMessageQueue::Segment* SegmentedMessageQueue::acquire_segment() {
+    if (auto* segment = spare_.exchange(nullptr, std::memory_order_acquire)) {
+        return segment;
+    }
+    segments_.fetch_add(1, std::memory_order_relaxed);
+    return new Segment();
+}
+
+void SegmentedMessageQueue::release_segment(Segment* segment) noexcept {
+    segment->next.store(nullptr, std::memory_order_relaxed);
+
+    Segment* expected = nullptr;
+    if (!spare_.compare_exchange_strong(expected, segment, std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+        segments_.fetch_sub(1, std::memory_order_relaxed);
+        delete segment;
+    }
+}
+
+bool SegmentedMessageQueue::try_push(Message&& msg) {
+    if (size_.fetch_add(1, std::memory_order_acq_rel) >= capacity()) {
+        size_.fetch_sub(1, std::memory_order_acq_rel);
+        return false;
+    }
+
+    Segment* next_segment = nullptr;
+    size_t tail           = tail_.load(std::memory_order_acquire);
+    Segment* segment      = tail_segment_.load(std::memory_order_acquire);
+
+    for (;;) {
+        size_t offset = tail % LAP;
+
+        if (IPB_UNLIKELY(offset == SEGMENT_SIZE)) {
+            // Another producer took the last slot and is linking the next segment
+            IPB_CPU_PAUSE();
+            tail    = tail_.load(std::memory_order_acquire);
+            segment = tail_segment_.load(std::memory_order_acquire);
+            continue;
+        }
+
+        // Allocate before claiming the last slot, so linking never waits on malloc
+        if (offset + 1 == SEGMENT_SIZE && !next_segment) {
+            next_segment = acquire_segment();
+        }
+
+        if (IPB_UNLIKELY(!segment)) {
+            // First message ever: install the first segment
+            auto* first       = acquire_segment();
+            Segment* expected = nullptr;
+            if (tail_segment_.compare_exchange_strong(expected, first,
+                                                      std::memory_order_release,
+                                                      std::memory_order_acquire)) {
+                head_segment_.store(first, std::memory_order_release);
+                segment = first;
+            } else {
+                release_segment(first);
+                tail    = tail_.load(std::memory_order_acquire);
+                segment = tail_segment_.load(std::memory_order_acquire);
+                continue;
+            }
+        }
+
+        if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+            if (offset + 1 == SEGMENT_SIZE) {
+                // Link the next segment before this slot becomes readable,
+                // since the consumer follows next as soon as it reads it
+                tail_segment_.store(next_segment, std::memory_order_release);
+                tail_.fetch_add(1, std::memory_order_release);
+                segment->next.store(next_segment, std::memory_order_release);
+                next_segment = nullptr;
+            }
+
+            auto& slot   = segment->slots[offset];
+            slot.message = std::move(msg);
+            slot.ready.store(true, std::memory_order_release);
+
+            if (next_segment) {
+                release_segment(next_segment);
+            }
+            return true;
+        }
+
+        segment = tail_segment_.load(std::memory_order_acquire);
+    }
+}
+
+bool SegmentedMessageQueue::try_pop(Message& msg) noexcept {
+    auto* segment = head_segment_.load(std::memory_order_acquire);
+    if (!segment) {
+        return false;
+    }
+
+    auto& slot = segment->slots[head_offset_];
+    if (!slot.ready.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    msg = std::move(slot.message);
+    slot.ready.store(false, std::memory_order_relaxed);
+
+    if (++head_offset_ == SEGMENT_SIZE) {
+        head_segment_.store(segment->next.load(std::memory_order_acquire),
+                            std::memory_order_release);
+        head_offset_ = 0;
+        release_segment(segment);
+    }
+
+    size_.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
 // ============================================================================
 // Channel Implementation
 // ============================================================================
 
-Channel::Channel(std::string topic) : topic_(std::move(topic)) {}
+static_assert(PRIORITY_LANES == 4, "Channel::lanes_ is initialised with one queue per lane");
+
+Channel::Channel(std::string topic, size_t capacity)
+    : topic_(std::move(topic)), topic_id_(topic_),
+      lanes_{SegmentedMessageQueue(SIZE_MAX), SegmentedMessageQueue(SIZE_MAX),
+             SegmentedMessageQueue(SIZE_MAX), SegmentedMessageQueue(SIZE_MAX)},
+      capacity_(capacity) {}
 
 Channel::~Channel() = default;
 
 bool Channel::publish(Message msg) {
     msg.sequence = messages_received.fetch_add(1, std::memory_order_relaxed);
 
-    if (!buffer_.try_push(std::move(msg))) {
+    // One limit for the whole channel, whichever lanes the backlog sits in
+    if (queued_.fetch_add(1, std::memory_order_acq_rel) >= capacity()) {
+        queued_.fetch_sub(1, std::memory_order_acq_rel);
+        messages_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto lane = priority_dispatch_.load(std::memory_order_relaxed) ? priority_lane(msg.priority)
+                                                                   : PriorityLane::NORMAL;
+    if (!lanes_[static_cast<size_t>(lane)].try_push(std::move(msg))) {
+        queued_.fetch_sub(1, std::memory_order_acq_rel);
         messages_dropped.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
 
+    if (undispatched_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        notify_ready();
+    }
     return true;
 }
 
+void Channel::attach(ChannelReadyQueue* queue, uint32_t shard) noexcept {
+    shard_ = shard;
+    ready_queue_.store(queue, std::memory_order_release);
+    if (queue && undispatched_.load(std::memory_order_acquire) > 0) {
+        queue->enqueue(*this);
+    }
+}
+
+void Channel::notify_ready() noexcept {
+    if (auto* queue = ready_queue_.load(std::memory_order_acquire)) {
+        queue->enqueue(*this);
+    }
+}
+
 bool Channel::publish_priority(Message msg, Message::Priority priority) {
     msg.priority = priority;
     return publish(std::move(msg));
 }
 
+void Channel::set_priority_dispatch(bool enabled, uint32_t starvation_limit) noexcept {
+    priority_dispatch_.store(enabled, std::memory_order_relaxed);
+    starvation_limit_.store(starvation_limit, std::memory_order_relaxed);
+}
+
+void Channel::set_capacity(size_t capacity) noexcept {
+    capacity_.store(capacity, std::memory_order_relaxed);
+}
+
+size_t Channel::allocated_segments() const noexcept {
+    size_t segments = 0;
+    for (const auto& lane : lanes_) {
+        segments += lane.allocated_segments();
+    }
+    return segments;
+}
+
 uint64_t Channel::subscribe(SubscriberCallback callback) {
     uint64_t id = next_subscriber_id_.fetch_add(1, std::memory_order_relaxed);
 
@@ -48,6 +252,17 @@ uint64_t Channel::subscribe(SubscriberCallback callback,
     return id;
 }
 
+uint64_t Channel::subscribe(std::shared_ptr<SubscriberQueue> queue,
+                            std::function<bool(const Message&)> filter) {
+    uint64_t id = next_subscriber_id_.fetch_add(1, std::memory_order_relaxed);
+
+    std::unique_lock lock(subscribers_mutex_);
+    subscribers_.push_back(
+        std::make_unique<SubscriberEntry>(id, std::move(queue), std::move(filter)));
+
+    return id;
+}
+
 void Channel::unsubscribe(uint64_t subscriber_id) {
     std::unique_lock lock(subscribers_mutex_);
 
@@ -71,43 +286,89 @@ bool Channel::is_subscriber_active(uint64_t subscriber_id) const {
     return it != subscribers_.end() && (*it)->active.load(std::memory_order_acquire);
 }
 
-size_t Channel::dispatch() {
+void Channel::set_wildcard_subscribers(WildcardSubscribers subscribers, uint64_t generation) {
+    std::unique_lock lock(subscribers_mutex_);
+    wildcard_subscribers_ = std::move(subscribers);
+    wildcard_generation_.store(generation, std::memory_order_release);
+}
+
+size_t Channel::dispatch(size_t max_messages) {
+    if (dispatching_.exchange(true, std::memory_order_acquire)) {
+        // The thread holding the buffer re-queues the channel if work is left
+        return 0;
+    }
+
     size_t count = 0;
     Message msg;
 
-    while (buffer_.try_pop(msg)) {
+    while (count < max_messages && pop_next(msg)) {
+        queued_.fetch_sub(1, std::memory_order_acq_rel);
         dispatch_single(msg);
         ++count;
     }
 
+    // Release before settling the count, so a re-queued dispatch can take over
+    dispatching_.store(false, std::memory_order_release);
+
+    // Anything published since (or left over) means the channel needs another turn
+    auto delivered = static_cast<int64_t>(count);
+    if (undispatched_.fetch_sub(delivered, std::memory_order_acq_rel) != delivered) {
+        notify_ready();
+    }
+
     return count;
 }
 
-void Channel::dispatch_single(const Message& msg) {
-    std::shared_lock lock(subscribers_mutex_);
-
-    for (const auto& subscriber : subscribers_) {
-        if (!subscriber->active.load(std::memory_order_acquire)) {
-            continue;
+bool Channel::pop_next(Message& msg) noexcept {
+    // A lane passed over too often goes first; the lowest such lane waited longest
+    auto limit = starvation_limit_.load(std::memory_order_relaxed);
+    if (limit > 0) {
+        for (size_t lane = PRIORITY_LANES - 1; lane > 0; --lane) {
+            if (passed_over_[lane] >= limit && lanes_[lane].try_pop(msg)) {
+                passed_over_[lane] = 0;
+                return true;
+            }
         }
+    }
 
-        // Apply filter if present
-        if (subscriber->filter && !subscriber->filter(msg)) {
-            continue;
+    for (size_t lane = 0; lane < PRIORITY_LANES; ++lane) {
+        if (lanes_[lane].try_pop(msg)) {
+            passed_over_[lane] = 0;
+            for (size_t lower = lane + 1; lower < PRIORITY_LANES; ++lower) {
+                if (!lanes_[lower].empty()) {
+                    ++passed_over_[lower];
+                }
+            }
+            return true;
         }
+    }
+    return false;
+}
 
-        try {
-            subscriber->callback(msg);
-        } catch (...) {
-            // Subscriber threw exception - continue to other subscribers
-        }
+void Channel::dispatch_single(const Message& msg) {
+    if (auto* stats = stats_.load(std::memory_order_acquire)) {
+        auto latency = common::Timestamp::now().nanoseconds() - msg.timestamp.nanoseconds();
+        stats->record_latency(priority_lane(msg.priority), latency);
+    }
+
+    std::shared_lock lock(subscribers_mutex_);
+
+    for (const auto& subscriber : subscribers_) {
+        deliver(*subscriber, msg);
+    }
+    for (const auto& subscriber : wildcard_subscribers_) {
+        deliver(*subscriber, msg);
     }
 
     messages_dispatched.fetch_add(1, std::memory_order_relaxed);
 }
 
 size_t Channel::pending_count() const noexcept {
-    return buffer_.size();
+    size_t pending = 0;
+    for (const auto& lane : lanes_) {
+        pending += lane.size();
+    }
+    return pending;
 }
 
 size_t Channel::subscriber_count() const noexcept {
@@ -139,7 +400,7 @@ bool TopicMatcher::matches(std::string_view pattern, std::string_view topic) noe
             return true;
         }
 
-        if (pattern[pi] == '*') {
+        if (pattern[pi] == '*' || pattern[pi] == '+') {
             // Single-level wildcard - match until next separator
             while (ti < topic.size() && topic[ti] != '/') {
                 ++ti;
@@ -171,17 +432,20 @@ bool TopicMatcher::matches(std::string_view pattern, std::string_view topic) noe
         ++ti;
     }
 
-    // Handle trailing wildcards
+    // Handle trailing wildcards; "a/#" also matches its parent level "a"
     if (pi < pattern.size() && pattern[pi] == '#') {
         return true;
     }
+    if (ti == topic.size() && pattern.substr(pi) == "/#") {
+        return true;
+    }
 
     // Both must be exhausted for a match
     return pi == pattern.size() && ti == topic.size();
 }
 
 bool TopicMatcher::has_wildcards(std::string_view pattern) noexcept {
-    return pattern.find_first_of("*#") != std::string_view::npos;
+    return pattern.find_first_of("*+#") != std::string_view::npos;
 }
 
 bool TopicMatcher::is_valid(std::string_view topic_or_pattern) noexcept {
@@ -210,8 +474,8 @@ bool TopicMatcher::is_valid(std::string_view topic_or_pattern) noexcept {
             }
         }
 
-        if (c == '*') {
-            // * must be alone in segment
+        if (c == '*' || c == '+') {
+            // Single-level wildcard must be alone in segment
             if (!prev_was_separator) {
                 return false;
             }
@@ -2,16 +2,18 @@
 
 #include <ipb/common/debug.hpp>
 #include <ipb/common/error.hpp>
+#include <ipb/common/lockfree_queue.hpp>
 #include <ipb/common/platform.hpp>
 
 #include <algorithm>
-#include <condition_variable>
 #include <mutex>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 
 #include "ipb/core/message_bus/channel.hpp"
+#include "ipb/core/message_bus/subscriber_queue.hpp"
+#include "ipb/core/message_bus/topic_trie.hpp"
 
 namespace ipb::core {
 
@@ -19,20 +21,34 @@ using namespace common::debug;
 
 namespace {
 constexpr std::string_view LOG_CAT = category::MESSAGING;
+
+/// Messages a dispatcher delivers from one channel before moving to the next
+constexpr size_t DISPATCH_BUDGET = 256;
+
+/// Ready-queue slots per dispatcher; channels beyond this spill into a locked list
+constexpr size_t READY_QUEUE_CAPACITY = 4096;
 }  // anonymous namespace
 
 // ============================================================================
 // Subscription Implementation
 // ============================================================================
 
-Subscription::Subscription(uint64_t id, std::weak_ptr<Channel> channel)
-    : id_(id), channel_(std::move(channel)) {}
+Subscription::Subscription(uint64_t id, std::weak_ptr<Channel> channel,
+                           std::weak_ptr<SubscriberQueue> queue)
+    : id_(id), channel_(std::move(channel)), queue_(std::move(queue)) {}
+
+Subscription::Subscription(uint64_t id, std::weak_ptr<TopicTrie> wildcards,
+                           std::weak_ptr<SubscriberQueue> queue)
+    : id_(id), wildcards_(std::move(wildcards)), queue_(std::move(queue)) {}
 
 Subscription::~Subscription() {
     cancel();
 }
 
 bool Subscription::is_active() const noexcept {
+    if (auto wildcards = wildcards_.lock()) {
+        return wildcards->contains(id_);
+    }
     auto channel = channel_.lock();
     return channel && channel->is_subscriber_active(id_);
 }
@@ -41,22 +57,75 @@ void Subscription::cancel() {
     if (auto channel = channel_.lock()) {
         channel->unsubscribe(id_);
     }
+    if (auto wildcards = wildcards_.lock()) {
+        wildcards->remove(id_);
+    }
+    if (auto queue = queue_.lock()) {
+        queue->stop();
+    }
+    queue_.reset();
     id_ = 0;
 }
 
+std::optional<SubscriberStats> Subscription::delivery_stats() const {
+    if (auto queue = queue_.lock()) {
+        return queue->stats();
+    }
+    return std::nullopt;
+}
+
 // ============================================================================
 // MessageBusImpl - Private Implementation
 // ============================================================================
 
-class MessageBusImpl {
+/**
+ * Dispatch is event driven. Every channel belongs to one dispatcher (its
+ * shard, assigned round-robin on creation). A publish that gives an idle
+ * channel work pushes the channel onto its shard's lock-free ready queue
+ * and wakes the dispatcher; dispatchers only ever touch channels that have
+ * messages, and each channel has exactly one consumer.
+ *
+ * Wildcard subscriptions live in a TopicTrie. Before a dispatcher works on
+ * a channel it compares the channel's cached wildcard subscribers against
+ * the trie generation and re-resolves the channel's topic only if a
+ * wildcard subscription was added or removed since.
+ */
+class MessageBusImpl final : public ChannelReadyQueue {
 public:
     explicit MessageBusImpl(const MessageBusConfig& config) : config_(config) {
         if (config_.dispatcher_threads == 0) {
-            config_.dispatcher_threads = std::thread::hardware_concurrency();
+            config_.dispatcher_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        shards_.reserve(config_.dispatcher_threads);
+        for (size_t i = 0; i < config_.dispatcher_threads; ++i) {
+            shards_.push_back(std::make_unique<DispatchShard>());
         }
     }
 
-    ~MessageBusImpl() { stop(); }
+    ~MessageBusImpl() override {
+        stop();
+
+        // Channels handed out to callers may outlive the bus
+        std::unique_lock lock(channels_mutex_);
+        for (auto& [_, channel] : channels_) {
+            channel->attach(nullptr, 0);
+            channel->set_stats(nullptr);
+        }
+    }
+
+    void enqueue(Channel& channel) noexcept override {
+        auto& shard = *shards_[channel.dispatch_shard()];
+
+        if (IPB_UNLIKELY(!shard.ready.try_enqueue(&channel))) {
+            std::lock_guard lock(shard.overflow_mutex);
+            shard.overflow.push_back(&channel);
+            shard.has_overflow.store(true, std::memory_order_release);
+        }
+
+        shard.wakeups.fetch_add(1, std::memory_order_release);
+        shard.wakeups.notify_one();
+    }
 
     bool start() {
         IPB_SPAN_CAT("MessageBus::start", LOG_CAT);
@@ -104,7 +173,10 @@ public:
         IPB_LOG_INFO(LOG_CAT, "Stopping MessageBus...");
 
         stop_requested_.store(true);
-        dispatch_cv_.notify_all();
+        for (auto& shard : shards_) {
+            shard->wakeups.fetch_add(1, std::memory_order_release);
+            shard->wakeups.notify_all();
+        }
 
         for (auto& thread : dispatcher_threads_) {
             if (thread.joinable()) {
@@ -128,12 +200,11 @@ public:
             return false;
         }
 
-        msg.topic    = std::string(topic);
+        msg.topic    = channel->topic_id();
         bool success = channel->publish(std::move(msg));
 
         if (IPB_LIKELY(success)) {
             stats_.messages_published.fetch_add(1, std::memory_order_relaxed);
-            dispatch_cv_.notify_one();
             IPB_LOG_TRACE(LOG_CAT, "Published message to topic: " << topic);
         } else {
             stats_.messages_dropped.fetch_add(1, std::memory_order_relaxed);
@@ -150,9 +221,19 @@ public:
     }
 
     bool publish_batch(std::string_view topic, std::span<const common::DataPoint> batch) {
+        common::DataSet copy(batch.size());
+        copy.append(batch);
+        return publish_batch(topic, std::move(copy));
+    }
+
+    bool publish_batch(std::string_view topic, common::DataSet&& batch) {
+        return publish_batch(topic, std::make_shared<const common::DataSet>(std::move(batch)));
+    }
+
+    bool publish_batch(std::string_view topic, BatchHandle batch) {
         Message msg;
-        msg.type = Message::Type::DATA_BATCH;
-        msg.batch_payload.assign(batch.begin(), batch.end());
+        msg.type          = Message::Type::DATA_BATCH;
+        msg.batch_payload = std::move(batch);
         return publish(topic, std::move(msg));
     }
 
@@ -167,55 +248,48 @@ public:
         return publish(topic, std::move(msg));
     }
 
-    Subscription subscribe(std::string_view topic_pattern, SubscriberCallback callback) {
+    Subscription subscribe(std::string_view topic_pattern, SubscriberCallback callback,
+                           std::function<bool(const Message&)> filter = nullptr,
+                           const SubscriptionOptions& options = {}) {
         IPB_PRECONDITION(!topic_pattern.empty());
         IPB_PRECONDITION(callback != nullptr);
 
         IPB_LOG_DEBUG(LOG_CAT, "Subscribing to topic pattern: " << topic_pattern);
 
+        std::shared_ptr<SubscriberQueue> queue;
+        if (options.queue_capacity > 0) {
+            queue = SubscriberQueue::create(options.queue_capacity, options.drop_policy,
+                                            std::move(callback));
+        }
+
         // For wildcard patterns, we need to track them separately
         if (TopicMatcher::has_wildcards(topic_pattern)) {
-            return subscribe_wildcard(topic_pattern, std::move(callback), nullptr);
+            return subscribe_wildcard(topic_pattern, std::move(callback), std::move(filter),
+                                      std::move(queue));
         }
 
         auto channel = get_or_create_channel(topic_pattern);
         if (IPB_UNLIKELY(!channel)) {
             IPB_LOG_ERROR(LOG_CAT, "Failed to create channel for subscription: " << topic_pattern);
+            if (queue) {
+                queue->stop();
+            }
             return Subscription();
         }
 
-        uint64_t id = channel->subscribe(std::move(callback));
+        uint64_t id = queue ? channel->subscribe(queue, std::move(filter))
+                            : channel->subscribe(std::move(callback), std::move(filter));
         stats_.active_subscriptions.fetch_add(1, std::memory_order_relaxed);
 
         IPB_LOG_DEBUG(LOG_CAT, "Created subscription id=" << id << " for topic: " << topic_pattern);
-        return Subscription(id, channel);
-    }
-
-    Subscription subscribe_filtered(std::string_view topic_pattern,
-                                    std::function<bool(const Message&)> filter,
-                                    SubscriberCallback callback) {
-        if (TopicMatcher::has_wildcards(topic_pattern)) {
-            return subscribe_wildcard(topic_pattern, std::move(callback), std::move(filter));
-        }
-
-        auto channel = get_or_create_channel(topic_pattern);
-        if (!channel) {
-            return Subscription();
-        }
-
-        uint64_t id = channel->subscribe(std::move(callback), std::move(filter));
-        stats_.active_subscriptions.fetch_add(1, std::memory_order_relaxed);
-
-        return Subscription(id, channel);
+        return Subscription(id, channel, queue);
     }
 
     std::shared_ptr<Channel> get_or_create_channel(std::string_view topic) {
-        std::string topic_str(topic);
-
         // Fast path - read-only check
         {
             std::shared_lock lock(channels_mutex_);
-            auto it = channels_.find(topic_str);
+            auto it = channels_.find(topic);
             if (it != channels_.end()) {
                 return it->second;
             }
@@ -223,6 +297,7 @@ public:
 
         // Slow path - create new channel
         std::unique_lock lock(channels_mutex_);
+        std::string topic_str(topic);
 
         // Double-check after acquiring write lock
         auto it = channels_.find(topic_str);
@@ -238,7 +313,10 @@ public:
             return nullptr;
         }
 
-        auto channel         = std::make_shared<Channel>(topic_str);
+        auto channel = std::make_shared<Channel>(topic_str, config_.default_buffer_size);
+        channel->set_priority_dispatch(config_.priority_dispatch, config_.starvation_limit);
+        channel->set_stats(&stats_);
+        channel->attach(this, static_cast<uint32_t>(next_shard_++ % shards_.size()));
         channels_[topic_str] = channel;
         stats_.active_channels.fetch_add(1, std::memory_order_relaxed);
 
@@ -246,9 +324,18 @@ public:
         return channel;
     }
 
+    bool set_topic_capacity(std::string_view topic, size_t capacity) {
+        auto channel = get_or_create_channel(topic);
+        if (IPB_UNLIKELY(!channel)) {
+            return false;
+        }
+        channel->set_capacity(capacity);
+        return true;
+    }
+
     bool has_channel(std::string_view topic) const {
         std::shared_lock lock(channels_mutex_);
-        return channels_.find(std::string(topic)) != channels_.end();
+        return channels_.find(topic) != channels_.end();
     }
 
     std::vector<std::string> get_topics() const {
@@ -270,67 +357,98 @@ public:
     const MessageBusConfig& config() const noexcept { return config_; }
 
 private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    /// Per-dispatcher ready queue; the owning dispatcher is its only consumer
+    struct alignas(IPB_CACHE_LINE_SIZE) DispatchShard {
+        common::MPSCQueue<Channel*, READY_QUEUE_CAPACITY> ready;
+
+        std::mutex overflow_mutex;
+        std::vector<Channel*> overflow;
+        std::atomic<bool> has_overflow{false};
+
+        /// Bumped on every enqueue; the idle dispatcher waits on it
+        std::atomic<uint32_t> wakeups{0};
+    };
+
+    static Channel* next_ready(DispatchShard& shard) {
+        if (auto channel = shard.ready.try_dequeue()) {
+            return *channel;
+        }
+        if (IPB_UNLIKELY(shard.has_overflow.load(std::memory_order_acquire))) {
+            std::lock_guard lock(shard.overflow_mutex);
+            if (!shard.overflow.empty()) {
+                auto* channel = shard.overflow.back();
+                shard.overflow.pop_back();
+                shard.has_overflow.store(!shard.overflow.empty(), std::memory_order_release);
+                return channel;
+            }
+        }
+        return nullptr;
+    }
+
     void dispatcher_loop(size_t thread_id) {
         IPB_LOG_DEBUG(LOG_CAT, "Dispatcher thread " << thread_id << " started");
 
+        auto& shard = *shards_[thread_id];
+
         while (!stop_requested_.load(std::memory_order_acquire)) {
+            // Read the wakeup counter before looking for work, so an enqueue
+            // that lands after the last check still ends the wait below
+            auto seen = shard.wakeups.load(std::memory_order_acquire);
+
             size_t total_dispatched = 0;
+            while (auto* channel = next_ready(shard)) {
+                refresh_wildcards(*channel);
 
-            // Dispatch from all channels
-            {
-                std::shared_lock lock(channels_mutex_);
-                for (auto& [_, channel] : channels_) {
-                    total_dispatched += channel->dispatch();
+                // A channel with more than one budget of work re-queues itself
+                total_dispatched += channel->dispatch(DISPATCH_BUDGET);
+                if (IPB_UNLIKELY(stop_requested_.load(std::memory_order_relaxed))) {
+                    break;
                 }
             }
 
-            // Dispatch to wildcard subscribers
-            dispatch_wildcard_subscriptions();
-
             if (IPB_LIKELY(total_dispatched > 0)) {
                 stats_.messages_delivered.fetch_add(total_dispatched, std::memory_order_relaxed);
                 IPB_LOG_TRACE(LOG_CAT, "Thread " << thread_id << " dispatched " << total_dispatched
                                                  << " messages");
-            } else {
-                // No messages - wait for notification
-                std::unique_lock lock(dispatch_mutex_);
-                dispatch_cv_.wait_for(lock, std::chrono::microseconds(100));
+                continue;
             }
+
+            shard.wakeups.wait(seen, std::memory_order_acquire);
         }
 
         IPB_LOG_DEBUG(LOG_CAT, "Dispatcher thread " << thread_id << " stopped");
     }
 
-    Subscription subscribe_wildcard(std::string_view pattern, SubscriberCallback callback,
-                                    std::function<bool(const Message&)> filter) {
-        uint64_t id = next_wildcard_id_.fetch_add(1, std::memory_order_relaxed);
+    /// Bring a channel's cached wildcard subscribers up to date with the trie
+    void refresh_wildcards(Channel& channel) {
+        auto generation = wildcards_->generation();
+        if (IPB_LIKELY(channel.wildcard_generation() == generation)) {
+            return;
+        }
+        channel.set_wildcard_subscribers(wildcards_->match(channel.topic()), generation);
+    }
 
-        std::unique_lock lock(wildcards_mutex_);
-        wildcard_subscriptions_.push_back(
-            {id, std::string(pattern), std::move(callback), std::move(filter)});
+    Subscription subscribe_wildcard(std::string_view pattern, SubscriberCallback callback,
+                                    std::function<bool(const Message&)> filter,
+                                    std::shared_ptr<SubscriberQueue> queue) {
+        uint64_t id = queue ? wildcards_->insert(pattern, queue, std::move(filter))
+                            : wildcards_->insert(pattern, std::move(callback), std::move(filter));
+        if (IPB_UNLIKELY(id == 0)) {
+            IPB_LOG_ERROR(LOG_CAT, "Invalid wildcard pattern: " << pattern);
+            return Subscription();
+        }
 
         stats_.active_subscriptions.fetch_add(1, std::memory_order_relaxed);
 
-        // Return a dummy subscription - wildcard subs are managed separately
-        return Subscription(id, std::weak_ptr<Channel>());
-    }
-
-    void dispatch_wildcard_subscriptions() {
-        std::shared_lock channels_lock(channels_mutex_);
-        std::shared_lock wildcards_lock(wildcards_mutex_);
-
-        for (const auto& sub : wildcard_subscriptions_) {
-            for (const auto& [topic, channel] : channels_) {
-                if (TopicMatcher::matches(sub.pattern, topic)) {
-                    // This channel matches the wildcard pattern
-                    // Dispatch any pending messages through the wildcard callback
-                    Message msg;
-                    // Note: We can't pop from channel without modifying it
-                    // This is a simplified implementation - real impl would need
-                    // to handle this differently (e.g., broadcast channels)
-                }
-            }
-        }
+        IPB_LOG_DEBUG(LOG_CAT, "Created wildcard subscription id=" << id << " for: " << pattern);
+        return Subscription(id, std::weak_ptr<TopicTrie>(wildcards_), queue);
     }
 
     MessageBusConfig config_;
@@ -341,25 +459,30 @@ private:
 
     // Channel storage
     mutable std::shared_mutex channels_mutex_;
-    std::unordered_map<std::string, std::shared_ptr<Channel>> channels_;
-
-    // Wildcard subscriptions
-    struct WildcardSub {
-        uint64_t id;
-        std::string pattern;
-        SubscriberCallback callback;
-        std::function<bool(const Message&)> filter;
-    };
-    mutable std::shared_mutex wildcards_mutex_;
-    std::vector<WildcardSub> wildcard_subscriptions_;
-    std::atomic<uint64_t> next_wildcard_id_{1};
+    std::unordered_map<std::string, std::shared_ptr<Channel>, StringHash, std::equal_to<>>
+        channels_;
+    size_t next_shard_ = 0;  ///< Round-robin shard for the next channel (under channels_mutex_)
 
-    // Dispatcher threads
+    // Wildcard subscriptions (shared so Subscription handles can outlive the bus)
+    std::shared_ptr<TopicTrie> wildcards_ = std::make_shared<TopicTrie>();
+
+    // Dispatcher threads and their ready queues
     std::vector<std::thread> dispatcher_threads_;
-    std::mutex dispatch_mutex_;
-    std::condition_variable dispatch_cv_;
+    std::vector<std::unique_ptr<DispatchShard>> shards_;
 };
 
+// ============================================================================
+// MessageBusConfig
+// ============================================================================
+
+MessageBusConfig MessageBusConfig::from_memory_config(const common::MemoryConfig& memory) {
+    MessageBusConfig config;
+    config.max_channels        = memory.message_bus_max_channels;
+    config.default_buffer_size = memory.message_bus_buffer_size;
+    config.dispatcher_threads  = memory.message_bus_dispatcher_threads;
+    return config;
+}
+
 // ============================================================================
 // MessageBus Public Interface
 // ============================================================================
@@ -398,6 +521,14 @@ bool MessageBus::publish_batch(std::string_view topic, std::span<const common::D
     return impl_->publish_batch(topic, batch);
 }
 
+bool MessageBus::publish_batch(std::string_view topic, common::DataSet&& batch) {
+    return impl_->publish_batch(topic, std::move(batch));
+}
+
+bool MessageBus::publish_batch(std::string_view topic, BatchHandle batch) {
+    return impl_->publish_batch(topic, std::move(batch));
+}
+
 bool MessageBus::publish_priority(std::string_view topic, Message msg, Message::Priority priority) {
     return impl_->publish_priority(topic, std::move(msg), priority);
 }
@@ -413,13 +544,23 @@ Subscription MessageBus::subscribe(std::string_view topic_pattern, SubscriberCal
 Subscription MessageBus::subscribe_filtered(std::string_view topic_pattern,
                                             std::function<bool(const Message&)> filter,
                                             SubscriberCallback callback) {
-    return impl_->subscribe_filtered(topic_pattern, std::move(filter), std::move(callback));
+    return impl_->subscribe(topic_pattern, std::move(callback), std::move(filter));
+}
+
+Subscription MessageBus::subscribe(std::string_view topic_pattern, SubscriberCallback callback,
+                                   const SubscriptionOptions& options,
+                                   std::function<bool(const Message&)> filter) {
+    return impl_->subscribe(topic_pattern, std::move(callback), std::move(filter), options);
 }
 
 std::shared_ptr<Channel> MessageBus::get_or_create_channel(std::string_view topic) {
     return impl_->get_or_create_channel(topic);
 }
 
+bool MessageBus::set_topic_capacity(std::string_view topic, size_t capacity) {
+    return impl_->set_topic_capacity(topic, capacity);
+}
+
 bool MessageBus::has_channel(std::string_view topic) const {
     return impl_->has_channel(topic);
 }
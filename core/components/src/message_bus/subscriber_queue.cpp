@@ -0,0 +1,194 @@
+#include "ipb/core/message_bus/subscriber_queue.hpp"
+
+#include <ipb/common/platform.hpp>
+
+namespace ipb::core {
+
+namespace {
+
+void store_max(std::atomic<int64_t>& target, int64_t value) noexcept {
+    auto current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void store_max(std::atomic<size_t>& target, size_t value) noexcept {
+    auto current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// SubscriberQueue Implementation
+// ============================================================================
+
+SubscriberQueue::SubscriberQueue(size_t capacity, DropPolicy policy, SubscriberCallback callback)
+    : queue_(capacity), policy_(policy), callback_(std::move(callback)) {}
+
+std::shared_ptr<SubscriberQueue> SubscriberQueue::create(size_t capacity, DropPolicy policy,
+                                                         SubscriberCallback callback) {
+    std::shared_ptr<SubscriberQueue> queue(
+        new SubscriberQueue(capacity, policy, std::move(callback)));
+
+    // The thread keeps the queue alive until it has exited
+    queue->worker_ = std::thread([self = queue] { self->run(); });
+    return queue;
+}
+
+SubscriberQueue::~SubscriberQueue() {
+    // Only reached once the delivery thread let go of the queue. If that was
+    // the last reference, this runs on the delivery thread itself.
+    if (worker_.joinable()) {
+        if (worker_.get_id() == std::this_thread::get_id()) {
+            worker_.detach();
+        } else {
+            worker_.join();
+        }
+    }
+}
+
+bool SubscriberQueue::push(const Message& msg) {
+    if (IPB_UNLIKELY(is_closed())) {
+        return false;
+    }
+
+    bool queued = try_push(msg);
+    if (IPB_UNLIKELY(!queued)) {
+        switch (policy_) {
+            case DropPolicy::DROP_NEWEST:
+                break;
+
+            case DropPolicy::DROP_OLDEST:
+                // Make room by discarding from the front; give up if others keep refilling it
+                for (int attempt = 0; attempt < 4 && !queued; ++attempt) {
+                    if (queue_.try_dequeue()) {
+                        on_dequeued();
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    queued = try_push(msg);
+                }
+                if (!queued) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+                return queued;
+
+            case DropPolicy::BLOCK:
+                return push_blocking(msg);
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return queued;
+}
+
+bool SubscriberQueue::push_blocking(const Message& msg) {
+    blocked_pushers_.fetch_add(1);
+
+    bool queued = false;
+    while (true) {
+        // Read before checking, so a dequeue or close() before the wait is not missed
+        auto seen = dequeues_.load();
+        if (is_closed() || (queued = try_push(msg))) {
+            break;
+        }
+        dequeues_.wait(seen);
+    }
+
+    blocked_pushers_.fetch_sub(1);
+    return queued;
+}
+
+void SubscriberQueue::on_dequeued() noexcept {
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+    if (policy_ == DropPolicy::BLOCK) {
+        dequeues_.fetch_add(1);
+        if (blocked_pushers_.load() > 0) {
+            dequeues_.notify_all();
+        }
+    }
+}
+
+bool SubscriberQueue::try_push(const Message& msg) {
+    if (!queue_.try_enqueue(msg)) {
+        return false;
+    }
+
+    auto before = pending_.fetch_add(1, std::memory_order_acq_rel);
+    if (before <= 0) {
+        pending_.notify_one();
+    }
+    store_max(max_queued_, static_cast<size_t>(before + 1));
+    return true;
+}
+
+void SubscriberQueue::close() noexcept {
+    if (!closed_.exchange(true, std::memory_order_acq_rel)) {
+        pending_.fetch_add(1, std::memory_order_acq_rel);
+        pending_.notify_one();
+
+        // Release pushers blocked on a full queue
+        dequeues_.fetch_add(1);
+        dequeues_.notify_all();
+    }
+}
+
+void SubscriberQueue::stop() noexcept {
+    close();
+    if (worker_.get_id() == std::this_thread::get_id()) {
+        return;
+    }
+    exited_.wait(false, std::memory_order_acquire);
+}
+
+SubscriberStats SubscriberQueue::stats() const noexcept {
+    SubscriberStats stats;
+    stats.capacity    = queue_.capacity();
+    stats.queued      = queue_.size_approx();
+    stats.max_queued  = max_queued_.load(std::memory_order_relaxed);
+    stats.delivered   = delivered_.load(std::memory_order_relaxed);
+    stats.dropped     = dropped_.load(std::memory_order_relaxed);
+    stats.last_lag_ns = last_lag_ns_.load(std::memory_order_relaxed);
+    stats.max_lag_ns  = max_lag_ns_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SubscriberQueue::run() {
+    while (!is_closed()) {
+        if (auto msg = queue_.try_dequeue()) {
+            on_dequeued();
+
+            // Lag ends when the callback is entered, so it excludes the callback's own run time
+            auto lag = common::Timestamp::now().nanoseconds() - msg->timestamp.nanoseconds();
+            last_lag_ns_.store(lag, std::memory_order_relaxed);
+            store_max(max_lag_ns_, lag);
+
+            try {
+                callback_(*msg);
+            } catch (...) {
+                // Subscriber threw exception - keep delivering
+            }
+
+            delivered_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        auto pending = pending_.load(std::memory_order_acquire);
+        if (pending > 0) {
+            // A push claimed a slot but has not filled it yet
+            IPB_CPU_PAUSE();
+            continue;
+        }
+        pending_.wait(pending, std::memory_order_acquire);
+    }
+
+    // Release the callback (and whatever it captured) before reporting exit
+    callback_ = nullptr;
+
+    exited_.store(true, std::memory_order_release);
+    exited_.notify_all();
+}
+
+}  // namespace ipb::core
@@ -0,0 +1,169 @@
+#include "ipb/core/message_bus/topic_trie.hpp"
+
+#include <algorithm>
+
+namespace ipb::core {
+
+namespace {
+
+constexpr size_t END = std::string_view::npos;
+
+bool is_single_level(std::string_view segment) noexcept {
+    return segment == "+" || segment == "*";
+}
+
+/// Segment starting at pos and the position of the one after it (END if last)
+std::pair<std::string_view, size_t> next_segment(std::string_view path, size_t pos) noexcept {
+    auto slash = path.find('/', pos);
+    if (slash == std::string_view::npos) {
+        return {path.substr(pos), END};
+    }
+    return {path.substr(pos, slash - pos), slash + 1};
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// TopicTrie Implementation
+// ============================================================================
+
+uint64_t TopicTrie::insert(std::string_view pattern, SubscriberCallback callback,
+                           std::function<bool(const Message&)> filter) {
+    return add(pattern,
+               std::make_shared<SubscriberEntry>(0, std::move(callback), std::move(filter)));
+}
+
+uint64_t TopicTrie::insert(std::string_view pattern, std::shared_ptr<SubscriberQueue> queue,
+                           std::function<bool(const Message&)> filter) {
+    return add(pattern, std::make_shared<SubscriberEntry>(0, std::move(queue), std::move(filter)));
+}
+
+uint64_t TopicTrie::add(std::string_view pattern, std::shared_ptr<SubscriberEntry> entry) {
+    if (!TopicMatcher::is_valid(pattern)) {
+        return 0;
+    }
+
+    std::unique_lock lock(mutex_);
+    uint64_t id = next_id_++;
+    entry->id   = id;
+
+    Node* node = &root_;
+    for (size_t pos = 0; pos != END;) {
+        auto [segment, next] = next_segment(pattern, pos);
+        if (segment == "#") {
+            break;
+        }
+
+        std::unique_ptr<Node>* child;
+        if (is_single_level(segment)) {
+            child = &node->single;
+        } else {
+            auto it = node->children.find(segment);
+            if (it == node->children.end()) {
+                it = node->children.try_emplace(std::string(segment)).first;
+            }
+            child = &it->second;
+        }
+        if (!*child) {
+            *child = std::make_unique<Node>();
+        }
+        node = child->get();
+        pos  = next;
+    }
+
+    if (pattern.back() == '#') {
+        node->multi.push_back(std::move(entry));
+    } else {
+        node->exact.push_back(std::move(entry));
+    }
+
+    patterns_.emplace(id, std::string(pattern));
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    return id;
+}
+
+bool TopicTrie::remove(uint64_t subscriber_id) {
+    std::unique_lock lock(mutex_);
+
+    auto it = patterns_.find(subscriber_id);
+    if (it == patterns_.end()) {
+        return false;
+    }
+
+    erase(root_, it->second, 0, subscriber_id);
+    patterns_.erase(it);
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool TopicTrie::erase(Node& node, std::string_view pattern, size_t pos, uint64_t subscriber_id) {
+    auto remove_from = [subscriber_id](WildcardSubscribers& entries) {
+        auto it = std::find_if(entries.begin(), entries.end(), [subscriber_id](const auto& entry) {
+            return entry->id == subscriber_id;
+        });
+        if (it != entries.end()) {
+            // Cached lists may still hold the entry until they are refreshed
+            (*it)->active.store(false, std::memory_order_release);
+            entries.erase(it);
+        }
+    };
+
+    if (pos == END) {
+        remove_from(node.exact);
+        return node.empty();
+    }
+
+    auto [segment, next] = next_segment(pattern, pos);
+    if (segment == "#") {
+        remove_from(node.multi);
+        return node.empty();
+    }
+
+    if (is_single_level(segment)) {
+        if (node.single && erase(*node.single, pattern, next, subscriber_id)) {
+            node.single.reset();
+        }
+    } else if (auto it = node.children.find(segment); it != node.children.end()) {
+        if (erase(*it->second, pattern, next, subscriber_id)) {
+            node.children.erase(it);
+        }
+    }
+    return node.empty();
+}
+
+bool TopicTrie::contains(uint64_t subscriber_id) const {
+    std::shared_lock lock(mutex_);
+    return patterns_.find(subscriber_id) != patterns_.end();
+}
+
+WildcardSubscribers TopicTrie::match(std::string_view topic) const {
+    WildcardSubscribers matches;
+    std::shared_lock lock(mutex_);
+    collect(root_, topic, 0, matches);
+    return matches;
+}
+
+void TopicTrie::collect(const Node& node, std::string_view topic, size_t pos,
+                        WildcardSubscribers& out) {
+    // "#" matches whatever is left of the topic, including nothing
+    out.insert(out.end(), node.multi.begin(), node.multi.end());
+    if (pos == END) {
+        out.insert(out.end(), node.exact.begin(), node.exact.end());
+        return;
+    }
+
+    auto [segment, next] = next_segment(topic, pos);
+    if (auto it = node.children.find(segment); it != node.children.end()) {
+        collect(*it->second, topic, next, out);
+    }
+    if (node.single) {
+        collect(*node.single, topic, next, out);
+    }
+}
+
+size_t TopicTrie::size() const {
+    std::shared_lock lock(mutex_);
+    return patterns_.size();
+}
+
+}  // namespace ipb::core
@@ -0,0 +1,241 @@
+#include "ipb/core/rule_engine/compiled_condition.hpp"
+
+#include <algorithm>
+
+namespace ipb::core {
+
+namespace {
+
+using Kind = RuleCondition::Kind;
+
+/**
+ * Flatten nested AND/AND and OR/OR nodes, drop double negations and
+ * single-operand AND/OR nodes, and order operands cheapest first.
+ */
+RuleCondition normalize(const RuleCondition& condition) {
+    switch (condition.kind) {
+        case Kind::NOT: {
+            if (condition.operands.empty()) {
+                // NOT of nothing: treat the missing operand as "true"
+                return RuleCondition::any_of({});
+            }
+            auto inner = normalize(condition.operands.front());
+            if (inner.kind == Kind::NOT) {
+                return std::move(inner.operands.front());
+            }
+            return RuleCondition::negate(std::move(inner));
+        }
+
+        case Kind::AND:
+        case Kind::OR: {
+            std::vector<std::pair<uint32_t, RuleCondition>> operands;
+            for (const auto& operand : condition.operands) {
+                auto normalized = normalize(operand);
+                if (normalized.kind == condition.kind) {
+                    for (auto& nested : normalized.operands) {
+                        auto cost = CompiledCondition::estimated_cost(nested);
+                        operands.emplace_back(cost, std::move(nested));
+                    }
+                } else {
+                    auto cost = CompiledCondition::estimated_cost(normalized);
+                    operands.emplace_back(cost, std::move(normalized));
+                }
+            }
+
+            if (operands.size() == 1) {
+                return std::move(operands.front().second);
+            }
+
+            std::stable_sort(operands.begin(), operands.end(),
+                             [](const auto& a, const auto& b) { return a.first < b.first; });
+
+            RuleCondition result;
+            result.kind = condition.kind;
+            result.operands.reserve(operands.size());
+            for (auto& [cost, operand] : operands) {
+                result.operands.push_back(std::move(operand));
+            }
+            return result;
+        }
+
+        default:
+            return condition;
+    }
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// CompiledCondition Implementation
+// ============================================================================
+
+CompiledCondition CompiledCondition::compile(const RuleCondition& condition,
+                                             PatternMatcherFactory::MatcherType type) {
+    CompiledCondition compiled;
+    compiled.emit(normalize(condition), type);
+    return compiled;
+}
+
+uint32_t CompiledCondition::estimated_cost(const RuleCondition& condition) noexcept {
+    switch (condition.kind) {
+        case Kind::PROTOCOL:
+        case Kind::QUALITY:
+            return 1;
+        case Kind::TIMESTAMP:
+            return 2;
+        case Kind::STATIC:
+            return 4 + 2 * static_cast<uint32_t>(condition.source_addresses.size());
+        case Kind::VALUE:
+            return 16;
+        case Kind::PATTERN:
+            return 64;
+        case Kind::NOT:
+            return condition.operands.empty() ? 0 : estimated_cost(condition.operands.front());
+        case Kind::AND:
+        case Kind::OR: {
+            uint32_t cost = 0;
+            for (const auto& operand : condition.operands) {
+                cost += estimated_cost(operand);
+            }
+            return cost;
+        }
+    }
+    return 0;
+}
+
+void CompiledCondition::emit(const RuleCondition& condition,
+                             PatternMatcherFactory::MatcherType type) {
+    auto position = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back(Node{condition.kind, 0, 0});
+
+    switch (condition.kind) {
+        case Kind::AND:
+        case Kind::OR:
+            for (const auto& operand : condition.operands) {
+                emit(operand, type);
+            }
+            break;
+
+        case Kind::NOT:
+            // normalize() guarantees exactly one operand
+            emit(condition.operands.front(), type);
+            break;
+
+        case Kind::STATIC:
+            nodes_[position].operand = static_cast<uint32_t>(addresses_.size());
+            addresses_.push_back(condition.source_addresses);
+            break;
+
+        case Kind::PATTERN:
+            nodes_[position].operand = static_cast<uint32_t>(patterns_.size());
+            patterns_.push_back(PatternMatcherFactory::create(condition.address_pattern, type));
+            break;
+
+        case Kind::PROTOCOL:
+            nodes_[position].operand = static_cast<uint32_t>(protocols_.size());
+            protocols_.push_back(condition.protocol_ids);
+            break;
+
+        case Kind::QUALITY: {
+            QualitySet set{};
+            for (auto quality : condition.quality_levels) {
+                auto bit = static_cast<uint8_t>(quality);
+                set[bit / 64] |= uint64_t{1} << (bit % 64);
+            }
+            nodes_[position].operand = static_cast<uint32_t>(qualities_.size());
+            qualities_.push_back(set);
+            break;
+        }
+
+        case Kind::VALUE:
+            if (!condition.value_condition) {
+                // Like a VALUE rule without a condition: never matches
+                nodes_[position].kind = Kind::OR;
+                break;
+            }
+            nodes_[position].operand = static_cast<uint32_t>(values_.size());
+            values_.push_back(*condition.value_condition);
+            break;
+
+        case Kind::TIMESTAMP:
+            nodes_[position].operand = static_cast<uint32_t>(time_ranges_.size());
+            time_ranges_.emplace_back(condition.start_time, condition.end_time);
+            break;
+    }
+
+    nodes_[position].end = static_cast<uint32_t>(nodes_.size());
+}
+
+bool CompiledCondition::evaluate_node(uint32_t position, const common::DataPoint& dp) const {
+    const auto& node = nodes_[position];
+
+    switch (node.kind) {
+        case Kind::AND:
+            for (uint32_t child = position + 1; child < node.end; child = nodes_[child].end) {
+                if (!evaluate_node(child, dp)) {
+                    return false;
+                }
+            }
+            return true;
+
+        case Kind::OR:
+            for (uint32_t child = position + 1; child < node.end; child = nodes_[child].end) {
+                if (evaluate_node(child, dp)) {
+                    return true;
+                }
+            }
+            return false;
+
+        case Kind::NOT:
+            return !evaluate_node(position + 1, dp);
+
+        case Kind::STATIC: {
+            auto address = dp.address();
+            for (const auto& candidate : addresses_[node.operand]) {
+                if (address == candidate) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        case Kind::PATTERN:
+            return patterns_[node.operand]->matches(dp.address());
+
+        case Kind::PROTOCOL: {
+            auto protocol = dp.protocol_id();
+            for (uint16_t candidate : protocols_[node.operand]) {
+                if (protocol == candidate) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        case Kind::QUALITY: {
+            auto bit = static_cast<uint8_t>(dp.quality());
+            return (qualities_[node.operand][bit / 64] >> (bit % 64)) & 1;
+        }
+
+        case Kind::VALUE:
+            return values_[node.operand].evaluate(dp.value());
+
+        case Kind::TIMESTAMP: {
+            const auto& [start, end] = time_ranges_[node.operand];
+            return dp.timestamp() >= start && dp.timestamp() <= end;
+        }
+    }
+
+    return false;
+}
+
+std::vector<RuleCondition::Kind> CompiledCondition::program() const {
+    std::vector<RuleCondition::Kind> kinds;
+    kinds.reserve(nodes_.size());
+    for (const auto& node : nodes_) {
+        kinds.push_back(node.kind);
+    }
+    return kinds;
+}
+
+}  // namespace ipb::core
@@ -0,0 +1,242 @@
+#include "ipb/core/rule_engine/match_cache.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "ipb/core/rule_engine/rule_engine.hpp"
+
+namespace ipb::core {
+
+// ============================================================================
+// MatchCache Implementation
+// ============================================================================
+
+MatchCache::MatchCache(size_t capacity, size_t shards, std::chrono::milliseconds ttl)
+    : ttl_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(ttl).count()) {
+    shards          = std::max<size_t>(1, std::min(shards, std::max<size_t>(1, capacity)));
+    shard_count_    = std::bit_floor(shards);
+    shard_capacity_ = (capacity + shard_count_ - 1) / shard_count_;
+
+    // Slots and indexes grow with the entries; nothing is reserved up front
+    shards_ = std::make_unique<Shard[]>(shard_count_);
+}
+
+MatchCache::~MatchCache() = default;
+
+int64_t MatchCache::now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+MatchCache::Shard& MatchCache::shard_for(std::string_view address) const noexcept {
+    auto hash = std::hash<std::string_view>{}(address);
+    // Mix high bits in so shard selection and the shard's own map
+    // do not both depend only on the low bits
+    return shards_[(hash ^ (hash >> 32)) & (shard_count_ - 1)];
+}
+
+MatchCache::Shard& MatchCache::shard_for(common::StringInterner::Id address_id) const noexcept {
+    // IDs are dense, so scatter them with a multiplicative hash
+    auto hash = (uint64_t{address_id} * 0x9E3779B97F4A7C15ULL) >> 32;
+    return shards_[hash & (shard_count_ - 1)];
+}
+
+bool MatchCache::is_live(const Slot& slot, uint64_t epoch, int64_t now) const noexcept {
+    if (slot.epoch != epoch) {
+        return false;
+    }
+    return ttl_ns_ <= 0 || now - slot.stored_ns <= ttl_ns_;
+}
+
+MatchCache::ResultsPtr MatchCache::find(std::string_view address) const {
+    if (shard_capacity_ == 0) {
+        return nullptr;
+    }
+
+    auto& shard = shard_for(address);
+    auto epoch  = this->epoch();
+
+    std::shared_lock lock(shard.mutex);
+
+    auto it = shard.index.find(address);
+    if (it == shard.index.end()) {
+        return nullptr;
+    }
+    return hit(shard.slots[it->second], epoch);
+}
+
+MatchCache::ResultsPtr MatchCache::find(common::InternedString address) const {
+    if (address.empty()) {
+        return find(std::string_view());
+    }
+    if (shard_capacity_ == 0) {
+        return nullptr;
+    }
+
+    auto& shard = shard_for(address.id());
+    auto epoch  = this->epoch();
+
+    std::shared_lock lock(shard.mutex);
+
+    auto it = shard.id_index.find(address.id());
+    if (it == shard.id_index.end()) {
+        return nullptr;
+    }
+    return hit(shard.slots[it->second], epoch);
+}
+
+MatchCache::ResultsPtr MatchCache::hit(const Slot& slot, uint64_t epoch) const {
+    if (!is_live(slot, epoch, ttl_ns_ > 0 ? now_ns() : 0)) {
+        return nullptr;
+    }
+
+    slot.referenced.store(true, std::memory_order_relaxed);
+    return slot.results;
+}
+
+bool MatchCache::insert(std::string_view address, ResultsPtr results, uint64_t epoch) {
+    if (shard_capacity_ == 0 || epoch != this->epoch()) {
+        return false;
+    }
+
+    auto& shard = shard_for(address);
+    auto now    = now_ns();
+
+    std::unique_lock lock(shard.mutex);
+
+    bool evicted = false;
+    uint32_t position;
+
+    auto it = shard.index.find(address);
+    if (it != shard.index.end()) {
+        position = it->second;
+    } else {
+        position   = claim_slot(shard, now, evicted);
+        auto& slot = shard.slots[position];
+        slot.key.assign(address);
+        shard.index.emplace(slot.key, position);
+    }
+
+    store(shard.slots[position], std::move(results), epoch, now);
+    return evicted;
+}
+
+bool MatchCache::insert(common::InternedString address, ResultsPtr results, uint64_t epoch) {
+    if (address.empty()) {
+        return insert(std::string_view(), std::move(results), epoch);
+    }
+    if (shard_capacity_ == 0 || epoch != this->epoch()) {
+        return false;
+    }
+
+    auto& shard = shard_for(address.id());
+    auto now    = now_ns();
+
+    std::unique_lock lock(shard.mutex);
+
+    bool evicted = false;
+    uint32_t position;
+
+    auto it = shard.id_index.find(address.id());
+    if (it != shard.id_index.end()) {
+        position = it->second;
+    } else {
+        position                         = claim_slot(shard, now, evicted);
+        shard.slots[position].address_id = address.id();
+        shard.id_index.emplace(address.id(), position);
+    }
+
+    store(shard.slots[position], std::move(results), epoch, now);
+    return evicted;
+}
+
+uint32_t MatchCache::claim_slot(Shard& shard, int64_t now, bool& evicted) {
+    if (shard.slots.size() < shard_capacity_) {
+        shard.slots.emplace_back();
+        return static_cast<uint32_t>(shard.slots.size() - 1);
+    }
+
+    // CLOCK sweep: reclaim empty, stale or expired slots first,
+    // otherwise give referenced entries a second chance
+    uint32_t position;
+    auto current = this->epoch();
+    while (true) {
+        auto& candidate = shard.slots[shard.hand];
+        uint32_t index  = shard.hand;
+        shard.hand      = static_cast<uint32_t>((shard.hand + 1) % shard_capacity_);
+
+        if (!candidate.results || !is_live(candidate, current, now)) {
+            position = index;
+            break;
+        }
+        if (!candidate.referenced.exchange(false, std::memory_order_relaxed)) {
+            position = index;
+            evicted  = true;
+            break;
+        }
+    }
+    reset_slot(shard, position);
+    return position;
+}
+
+void MatchCache::store(Slot& slot, ResultsPtr results, uint64_t epoch, int64_t now) {
+    slot.results   = std::move(results);
+    slot.epoch     = epoch;
+    slot.stored_ns = now;
+    slot.referenced.store(false, std::memory_order_relaxed);
+}
+
+void MatchCache::reset_slot(Shard& shard, uint32_t position) {
+    auto& slot = shard.slots[position];
+    if (slot.address_id != common::StringInterner::EMPTY_ID) {
+        shard.id_index.erase(slot.address_id);
+    } else if (slot.results || !slot.key.empty()) {
+        shard.index.erase(slot.key);
+    }
+    slot.key.clear();
+    slot.address_id = common::StringInterner::EMPTY_ID;
+    slot.results.reset();
+    slot.epoch = 0;
+}
+
+void MatchCache::erase_if(const std::function<bool(std::string_view)>& pred) {
+    for (size_t i = 0; i < shard_count_; ++i) {
+        auto& shard = shards_[i];
+        std::unique_lock lock(shard.mutex);
+        for (uint32_t position = 0; position < shard.slots.size(); ++position) {
+            const auto& slot = shard.slots[position];
+            if (!slot.results) {
+                continue;
+            }
+            auto address = slot.address_id != common::StringInterner::EMPTY_ID
+                             ? common::StringInterner::global().view(slot.address_id)
+                             : std::string_view(slot.key);
+            if (pred(address)) {
+                reset_slot(shard, position);
+            }
+        }
+    }
+}
+
+void MatchCache::clear() {
+    for (size_t i = 0; i < shard_count_; ++i) {
+        auto& shard = shards_[i];
+        std::unique_lock lock(shard.mutex);
+        shard.index.clear();
+        shard.id_index.clear();
+        shard.slots.clear();
+        shard.hand = 0;
+    }
+}
+
+size_t MatchCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::shared_lock lock(shards_[i].mutex);
+        total += shards_[i].index.size() + shards_[i].id_index.size();
+    }
+    return total;
+}
+
+}  // namespace ipb::core
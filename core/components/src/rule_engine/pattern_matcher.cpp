@@ -1,6 +1,7 @@
 #include "ipb/core/rule_engine/pattern_matcher.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <optional>
 #include <regex>
 #include <unordered_map>
@@ -567,6 +568,20 @@ public:
         return results;
     }
 
+    void collect_prefix_matches(std::string_view input, std::vector<uint32_t>& out) const {
+        const TrieNode* node = root_.get();
+
+        for (char c : input) {
+            auto it = node->children.find(c);
+            if (it == node->children.end()) {
+                return;
+            }
+
+            node = it->second.get();
+            out.insert(out.end(), node->prefix_rule_ids.begin(), node->prefix_rule_ids.end());
+        }
+    }
+
     std::optional<uint32_t> find_exact(std::string_view input) const noexcept {
         const TrieNode* node = root_.get();
 
@@ -693,6 +708,11 @@ std::vector<uint32_t> TrieMatcher::find_matches(std::string_view input) const no
     return impl_->find_matches(input);
 }
 
+void TrieMatcher::collect_prefix_matches(std::string_view input,
+                                         std::vector<uint32_t>& out) const {
+    impl_->collect_prefix_matches(input, out);
+}
+
 std::optional<uint32_t> TrieMatcher::find_exact(std::string_view input) const noexcept {
     return impl_->find_exact(input);
 }
@@ -772,8 +792,18 @@ PatternMatchResult CTREMatcher::match_with_groups(std::string_view input) const
 // PatternMatcherFactory Implementation
 // ============================================================================
 
+namespace {
+std::atomic<uint64_t> g_compilation_count{0};
+}  // anonymous namespace
+
+uint64_t PatternMatcherFactory::compilation_count() noexcept {
+    return g_compilation_count.load(std::memory_order_relaxed);
+}
+
 std::unique_ptr<IPatternMatcher> PatternMatcherFactory::create(std::string_view pattern,
                                                                MatcherType type) {
+    g_compilation_count.fetch_add(1, std::memory_order_relaxed);
+
     if (type == MatcherType::AUTO) {
         type = analyze_pattern(pattern);
     }
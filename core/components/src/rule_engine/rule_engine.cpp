@@ -6,10 +6,14 @@
 #include <ipb/common/platform.hpp>
 
 #include <algorithm>
-#include <shared_mutex>
-#include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 #include "ipb/core/rule_engine/pattern_matcher.hpp"
+#include "ipb/core/rule_engine/compiled_condition.hpp"
+#include "ipb/core/rule_engine/match_cache.hpp"
+#include "ipb/core/rule_engine/rule_index.hpp"
 
 namespace ipb::core {
 
@@ -17,138 +21,267 @@ using namespace common::debug;
 
 namespace {
 constexpr std::string_view LOG_CAT = category::ROUTER;  // Rules are part of routing
-}  // anonymous namespace
 
-// ============================================================================
-// ValueCondition Implementation
-// ============================================================================
+using RulePtr = std::shared_ptr<const RoutingRule>;
 
-bool ValueCondition::evaluate(const common::Value& value) const noexcept {
-    if (value.empty()) {
-        return false;
-    }
+/// Descending priority; equal priorities keep insertion order
+bool higher_priority(const RulePtr& a, const RulePtr& b) noexcept {
+    return static_cast<uint8_t>(a->priority) > static_cast<uint8_t>(b->priority);
+}
 
-    // Extract numeric value from DataPoint value
-    auto extract_double = [](const common::Value& v) -> std::optional<double> {
-        switch (v.type()) {
-            case common::Value::Type::BOOL:
-                return v.get<bool>() ? 1.0 : 0.0;
-            case common::Value::Type::INT8:
-                return static_cast<double>(v.get<int8_t>());
-            case common::Value::Type::INT16:
-                return static_cast<double>(v.get<int16_t>());
-            case common::Value::Type::INT32:
-                return static_cast<double>(v.get<int32_t>());
-            case common::Value::Type::INT64:
-                return static_cast<double>(v.get<int64_t>());
-            case common::Value::Type::UINT8:
-                return static_cast<double>(v.get<uint8_t>());
-            case common::Value::Type::UINT16:
-                return static_cast<double>(v.get<uint16_t>());
-            case common::Value::Type::UINT32:
-                return static_cast<double>(v.get<uint32_t>());
-            case common::Value::Type::UINT64:
-                return static_cast<double>(v.get<uint64_t>());
-            case common::Value::Type::FLOAT32:
-                return static_cast<double>(v.get<float>());
-            case common::Value::Type::FLOAT64:
-                return v.get<double>();
-            default:
-                return std::nullopt;
-        }
-    };
+/// Order rules by descending priority, keeping insertion order within a priority
+void sort_by_priority(std::vector<RulePtr>& rules) {
+    std::stable_sort(rules.begin(), rules.end(), higher_priority);
+}
 
-    // Get reference value as double
-    double ref      = 0.0;
-    double ref_high = 0.0;
+/// Insert a rule after every rule of equal or higher priority
+void insert_by_priority(std::vector<RulePtr>& rules, RulePtr rule) {
+    auto pos = std::upper_bound(rules.begin(), rules.end(), rule, higher_priority);
+    rules.insert(pos, std::move(rule));
+}
 
-    std::visit(
-        [&ref](auto&& arg) {
+/// Numeric reference value; non-numeric references compare as 0
+double reference_as_double(
+    const std::variant<bool, int64_t, uint64_t, double, std::string>& reference) noexcept {
+    return std::visit(
+        [](auto&& arg) -> double {
             using T = std::decay_t<decltype(arg)>;
             if constexpr (std::is_arithmetic_v<T>) {
-                ref = static_cast<double>(arg);
+                return static_cast<double>(arg);
+            } else {
+                return 0.0;
             }
         },
         reference);
+}
+
+/// Extract a numeric DataPoint value as double; false for non-numeric types
+bool value_as_double(const common::Value& v, double& out) noexcept {
+    switch (v.type()) {
+        case common::Value::Type::BOOL:
+            out = v.get<bool>() ? 1.0 : 0.0;
+            return true;
+        case common::Value::Type::INT8:
+            out = static_cast<double>(v.get<int8_t>());
+            return true;
+        case common::Value::Type::INT16:
+            out = static_cast<double>(v.get<int16_t>());
+            return true;
+        case common::Value::Type::INT32:
+            out = static_cast<double>(v.get<int32_t>());
+            return true;
+        case common::Value::Type::INT64:
+            out = static_cast<double>(v.get<int64_t>());
+            return true;
+        case common::Value::Type::UINT8:
+            out = static_cast<double>(v.get<uint8_t>());
+            return true;
+        case common::Value::Type::UINT16:
+            out = static_cast<double>(v.get<uint16_t>());
+            return true;
+        case common::Value::Type::UINT32:
+            out = static_cast<double>(v.get<uint32_t>());
+            return true;
+        case common::Value::Type::UINT64:
+            out = static_cast<double>(v.get<uint64_t>());
+            return true;
+        case common::Value::Type::FLOAT32:
+            out = static_cast<double>(v.get<float>());
+            return true;
+        case common::Value::Type::FLOAT64:
+            out = v.get<double>();
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Compare 64 values per word without branches, then mask out non-numeric entries
+template <typename Cmp>
+void compare_column(std::span<const double> values, std::span<const uint64_t> numeric,
+                    std::span<uint64_t> out, Cmp cmp) noexcept {
+    const size_t count = values.size();
+    for (size_t w = 0; w < numeric.size(); ++w) {
+        const size_t base  = w * 64;
+        const size_t n     = std::min<size_t>(64, count - base);
+        const double* data = values.data() + base;
+
+        uint64_t bits = 0;
+        for (size_t j = 0; j < n; ++j) {
+            bits |= static_cast<uint64_t>(cmp(data[j])) << j;
+        }
+        out[w] = bits & numeric[w];
+    }
+}
+
+/**
+ * Numeric column of a batch's values. Non-numeric entries hold 0 and are
+ * clear in numeric; string entries are listed separately for the scalar path.
+ */
+struct ValueColumn {
+    std::vector<double> values;
+    std::vector<uint64_t> numeric;
+    std::vector<uint32_t> strings;
+
+    void assign(std::span<const common::DataPoint> points) {
+        assign(points.size(), [points](size_t i) -> const auto& { return points[i].value(); });
+    }
+
+    void assign(std::span<const common::Value> column) {
+        assign(column.size(), [column](size_t i) -> const auto& { return column[i]; });
+    }
+
+    template <typename ValueAt>
+    void assign(size_t count, ValueAt value_at) {
+        values.assign(count, 0.0);
+        numeric.assign((count + 63) / 64, 0);
+        strings.clear();
+
+        for (size_t i = 0; i < count; ++i) {
+            const common::Value& value = value_at(i);
+            if (value_as_double(value, values[i])) {
+                numeric[i / 64] |= uint64_t{1} << (i % 64);
+            } else if (value.type() == common::Value::Type::STRING) {
+                strings.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+};
+
+/// Rules that evaluate_columns_into() runs over a single column
+bool is_column_rule(RuleType type) noexcept {
+    return type == RuleType::VALUE || type == RuleType::PROTOCOL || type == RuleType::QUALITY ||
+           type == RuleType::TIMESTAMP;
+}
+
+/// Set bit i of bits for every element i of column that satisfies pred
+template <typename T, typename Predicate>
+void match_column(std::span<const T> column, std::span<uint64_t> bits, Predicate pred) {
+    for (size_t i = 0; i < column.size(); ++i) {
+        bits[i / 64] |= static_cast<uint64_t>(pred(column[i])) << (i % 64);
+    }
+}
+
+}  // anonymous namespace
 
+// ============================================================================
+// ValueCondition Implementation
+// ============================================================================
+
+bool ValueCondition::evaluate(const common::Value& value) const noexcept {
+    return resolve().evaluate(value);
+}
+
+ResolvedValueCondition ValueCondition::resolve() const noexcept {
+    ResolvedValueCondition resolved;
+    resolved.op   = op;
+    resolved.low  = reference_as_double(reference);
+    resolved.text = std::get_if<std::string>(&reference);
     if (op == CompareOp::BETWEEN) {
-        std::visit(
-            [&ref_high](auto&& arg) {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_arithmetic_v<T>) {
-                    ref_high = static_cast<double>(arg);
-                }
-            },
-            reference_high);
+        resolved.high = reference_as_double(reference_high);
     }
+    return resolved;
+}
 
-    auto val_opt = extract_double(value);
-    if (!val_opt) {
+bool ResolvedValueCondition::evaluate(const common::Value& value) const noexcept {
+    double val = 0.0;
+    if (!value_as_double(value, val)) {
         // String comparison for non-numeric types
-        if (value.type() == common::Value::Type::STRING) {
+        if (value.type() == common::Value::Type::STRING && text) {
             auto sv = value.as_string_view();
-            std::string val_str(sv);
-
-            if (auto* ref_str = std::get_if<std::string>(&reference)) {
-                switch (op) {
-                    case CompareOp::EQ:
-                        return val_str == *ref_str;
-                    case CompareOp::NE:
-                        return val_str != *ref_str;
-                    case CompareOp::LT:
-                        return val_str < *ref_str;
-                    case CompareOp::LE:
-                        return val_str <= *ref_str;
-                    case CompareOp::GT:
-                        return val_str > *ref_str;
-                    case CompareOp::GE:
-                        return val_str >= *ref_str;
-                    default:
-                        return false;
-                }
+            switch (op) {
+                case CompareOp::EQ:
+                    return sv == *text;
+                case CompareOp::NE:
+                    return sv != *text;
+                case CompareOp::LT:
+                    return sv < *text;
+                case CompareOp::LE:
+                    return sv <= *text;
+                case CompareOp::GT:
+                    return sv > *text;
+                case CompareOp::GE:
+                    return sv >= *text;
+                default:
+                    return false;
             }
         }
         return false;
     }
 
-    double val = *val_opt;
-
     switch (op) {
         case CompareOp::EQ:
-            return val == ref;
+            return val == low;
         case CompareOp::NE:
-            return val != ref;
+            return val != low;
         case CompareOp::LT:
-            return val < ref;
+            return val < low;
         case CompareOp::LE:
-            return val <= ref;
+            return val <= low;
         case CompareOp::GT:
-            return val > ref;
+            return val > low;
         case CompareOp::GE:
-            return val >= ref;
+            return val >= low;
         case CompareOp::BETWEEN:
-            return val >= ref && val <= ref_high;
+            return val >= low && val <= high;
     }
 
     return false;
 }
 
+void ResolvedValueCondition::evaluate_column(std::span<const double> values,
+                                             std::span<const uint64_t> numeric,
+                                             std::span<uint64_t> out) const noexcept {
+    const double lo = low;
+    const double hi = high;
+
+    switch (op) {
+        case CompareOp::EQ:
+            compare_column(values, numeric, out, [lo](double v) { return v == lo; });
+            break;
+        case CompareOp::NE:
+            compare_column(values, numeric, out, [lo](double v) { return v != lo; });
+            break;
+        case CompareOp::LT:
+            compare_column(values, numeric, out, [lo](double v) { return v < lo; });
+            break;
+        case CompareOp::LE:
+            compare_column(values, numeric, out, [lo](double v) { return v <= lo; });
+            break;
+        case CompareOp::GT:
+            compare_column(values, numeric, out, [lo](double v) { return v > lo; });
+            break;
+        case CompareOp::GE:
+            compare_column(values, numeric, out, [lo](double v) { return v >= lo; });
+            break;
+        case CompareOp::BETWEEN:
+            compare_column(values, numeric, out,
+                           [lo, hi](double v) { return (v >= lo) & (v <= hi); });
+            break;
+    }
+}
+
 // ============================================================================
 // RoutingRule Implementation
 // ============================================================================
 
 RuleMatchResult RoutingRule::evaluate(const common::DataPoint& dp) const {
-    common::rt::HighResolutionTimer timer;
-
     RuleMatchResult result;
     result.rule_id    = id;
     result.priority   = priority;
     result.target_ids = target_sink_ids;
+    result.matched    = matches(dp, &result.captured_groups);
+    return result;
+}
+
+bool RoutingRule::matches(const common::DataPoint& dp,
+                          std::vector<std::string>* captured_groups) const {
+    common::rt::HighResolutionTimer timer;
 
     eval_count.fetch_add(1, std::memory_order_relaxed);
 
     if (!enabled) {
-        return result;
+        return false;
     }
 
     bool matched = false;
@@ -164,10 +297,21 @@ RuleMatchResult RoutingRule::evaluate(const common::DataPoint& dp) const {
             break;
 
         case RuleType::PATTERN: {
-            auto matcher           = PatternMatcherFactory::create(address_pattern);
-            auto match_result      = matcher->match_with_groups(dp.address());
-            matched                = match_result.matched;
-            result.captured_groups = std::move(match_result.captured_groups);
+            // Rules that were never compiled (or whose pattern changed since)
+            // pay for a temporary matcher; see compile_pattern()
+            std::unique_ptr<IPatternMatcher> temporary;
+            const IPatternMatcher* matcher = pattern_matcher();
+            if (!matcher) {
+                temporary = PatternMatcherFactory::create(address_pattern);
+                matcher   = temporary.get();
+            }
+            if (captured_groups) {
+                auto match_result = matcher->match_with_groups(dp.address());
+                matched           = match_result.matched;
+                *captured_groups  = std::move(match_result.captured_groups);
+            } else {
+                matched = matcher->matches(dp.address());
+            }
             break;
         }
 
@@ -206,12 +350,15 @@ RuleMatchResult RoutingRule::evaluate(const common::DataPoint& dp) const {
             break;
 
         case RuleType::COMPOSITE:
-            // TODO: Implement composite rule evaluation
+            if (compiled_condition) {
+                matched = compiled_condition->evaluate(dp);
+            } else if (condition) {
+                // Uncompiled rules pay for a temporary program; see compile_condition()
+                matched = CompiledCondition::compile(*condition).evaluate(dp);
+            }
             break;
     }
 
-    result.matched = matched;
-
     if (matched) {
         match_count.fetch_add(1, std::memory_order_relaxed);
     }
@@ -219,154 +366,199 @@ RuleMatchResult RoutingRule::evaluate(const common::DataPoint& dp) const {
     auto elapsed = timer.elapsed();
     total_eval_time_ns.fetch_add(elapsed.count(), std::memory_order_relaxed);
 
-    return result;
+    return matched;
+}
+
+void RoutingRule::compile_pattern(PatternMatcherFactory::MatcherType matcher_type) {
+    if (pattern_matcher() && compiled_pattern->type == matcher_type) {
+        return;
+    }
+
+    auto compiled     = std::make_shared<CompiledRulePattern>();
+    compiled->source  = address_pattern;
+    compiled->type    = matcher_type;
+    compiled->matcher = PatternMatcherFactory::create(address_pattern, matcher_type);
+    compiled_pattern  = std::move(compiled);
+}
+
+void RoutingRule::compile_condition(PatternMatcherFactory::MatcherType matcher_type) {
+    if (!condition) {
+        compiled_condition.reset();
+        return;
+    }
+    compiled_condition = std::make_shared<const CompiledCondition>(
+        CompiledCondition::compile(*condition, matcher_type));
 }
 
 // ============================================================================
 // RuleEngineImpl - Private Implementation
 // ============================================================================
 
+/**
+ * @brief Immutable, versioned view of the rule table
+ *
+ * Readers pin a snapshot with a single atomic load and never take a lock.
+ * Writers build the next snapshot (rule order and index included) off to
+ * the side and publish it with an atomic store. Unchanged rules are shared
+ * between versions, so their statistics carry over.
+ */
+struct RuleSnapshot {
+    uint64_t version = 0;
+
+    /// Rules in evaluation (priority) order
+    std::vector<std::shared_ptr<const RoutingRule>> rules;
+
+    /// Candidate index over rules (empty when the index is disabled)
+    RuleIndex index;
+};
+
 class RuleEngineImpl {
 public:
-    explicit RuleEngineImpl(const RuleEngineConfig& config) : config_(config) {}
+    using RulePtr  = std::shared_ptr<const RoutingRule>;
+    using RuleList = std::vector<RulePtr>;
+
+    explicit RuleEngineImpl(const RuleEngineConfig& config)
+        : config_(config),
+          cache_(config.enable_cache ? config.cache_size : 0, config.cache_shards,
+                 std::chrono::milliseconds(config.cache_ttl_ms)),
+          snapshot_(std::make_shared<const RuleSnapshot>()) {}
 
     uint32_t add_rule(RoutingRule rule) {
-        std::unique_lock lock(rules_mutex_);
+        prepare_rule(rule);
+
+        std::lock_guard lock(writer_mutex_);
 
         uint32_t id = next_rule_id_++;
         rule.id     = id;
+        resolve_sink_handles(rule);
 
         IPB_LOG_DEBUG(LOG_CAT, "Adding rule id=" << id << " name=\"" << rule.name << "\" type="
                                                  << static_cast<int>(rule.type) << " priority="
                                                  << static_cast<int>(rule.priority));
 
-        // Pre-compile pattern if configured
-        if (config_.precompile_patterns && rule.type == RuleType::PATTERN) {
-            IPB_LOG_TRACE(LOG_CAT, "Pre-compiling pattern: " << rule.address_pattern);
-            compiled_patterns_[id] = PatternMatcherFactory::create(
-                rule.address_pattern, config_.prefer_ctre
-                                          ? PatternMatcherFactory::MatcherType::REGEX_CTRE
-                                          : PatternMatcherFactory::MatcherType::AUTO);
-        }
+        std::string name = rule.name;
 
-        rules_.push_back(std::move(rule));
+        // Keep the table sorted by priority (descending)
+        auto rules = current_rules();
+        insert_by_priority(rules, std::make_shared<const RoutingRule>(std::move(rule)));
+        publish(std::move(rules));
 
-        // Re-sort by priority (descending)
-        std::sort(rules_.begin(), rules_.end(), [](const RoutingRule& a, const RoutingRule& b) {
-            return static_cast<uint8_t>(a.priority) > static_cast<uint8_t>(b.priority);
-        });
-
-        // Invalidate cache
-        if (config_.enable_cache) {
-            cache_.clear();
-            IPB_LOG_TRACE(LOG_CAT, "Cache invalidated after rule addition");
-        }
-
-        IPB_LOG_INFO(LOG_CAT, "Added routing rule: " << rule.name << " (id=" << id << ")");
+        IPB_LOG_INFO(LOG_CAT, "Added routing rule: " << name << " (id=" << id << ")");
         return id;
     }
 
     bool update_rule(uint32_t rule_id, const RoutingRule& rule) {
-        std::unique_lock lock(rules_mutex_);
+        RoutingRule updated = rule;
+        updated.id          = rule_id;
+        prepare_rule(updated);
 
-        auto it = std::find_if(rules_.begin(), rules_.end(),
-                               [rule_id](const RoutingRule& r) { return r.id == rule_id; });
+        std::lock_guard lock(writer_mutex_);
 
-        if (it == rules_.end()) {
+        auto rules = current_rules();
+        auto it    = find_rule(rules, rule_id);
+        if (it == rules.end()) {
             return false;
         }
 
-        *it    = rule;
-        it->id = rule_id;
-
-        // Update compiled pattern
-        if (config_.precompile_patterns && rule.type == RuleType::PATTERN) {
-            compiled_patterns_[rule_id] = PatternMatcherFactory::create(
-                rule.address_pattern, config_.prefer_ctre
-                                          ? PatternMatcherFactory::MatcherType::REGEX_CTRE
-                                          : PatternMatcherFactory::MatcherType::AUTO);
-        }
+        resolve_sink_handles(updated);
+        *it = std::make_shared<const RoutingRule>(std::move(updated));
 
         // Re-sort
-        std::sort(rules_.begin(), rules_.end(), [](const RoutingRule& a, const RoutingRule& b) {
-            return static_cast<uint8_t>(a.priority) > static_cast<uint8_t>(b.priority);
-        });
-
-        if (config_.enable_cache) {
-            cache_.clear();
-        }
+        sort_by_priority(rules);
+        publish(std::move(rules));
 
         return true;
     }
 
     bool remove_rule(uint32_t rule_id) {
-        std::unique_lock lock(rules_mutex_);
-
-        auto it = std::find_if(rules_.begin(), rules_.end(),
-                               [rule_id](const RoutingRule& r) { return r.id == rule_id; });
+        std::lock_guard lock(writer_mutex_);
 
-        if (it == rules_.end()) {
+        auto rules = current_rules();
+        auto it    = find_rule(rules, rule_id);
+        if (it == rules.end()) {
             return false;
         }
 
-        rules_.erase(it);
-        compiled_patterns_.erase(rule_id);
-
-        if (config_.enable_cache) {
-            cache_.clear();
-        }
+        rules.erase(it);
+        publish(std::move(rules));
 
         return true;
     }
 
     bool set_rule_enabled(uint32_t rule_id, bool enabled) {
-        std::unique_lock lock(rules_mutex_);
-
-        auto it = std::find_if(rules_.begin(), rules_.end(),
-                               [rule_id](const RoutingRule& r) { return r.id == rule_id; });
+        std::lock_guard lock(writer_mutex_);
 
-        if (it == rules_.end()) {
+        auto rules = current_rules();
+        auto it    = find_rule(rules, rule_id);
+        if (it == rules.end()) {
             return false;
         }
 
-        it->enabled = enabled;
-
-        if (config_.enable_cache) {
-            cache_.clear();
-        }
+        auto toggled     = std::make_shared<RoutingRule>(**it);
+        toggled->enabled = enabled;
+        *it              = std::move(toggled);
+        publish(std::move(rules));
 
         return true;
     }
 
-    std::optional<RoutingRule> get_rule(uint32_t rule_id) const {
-        std::shared_lock lock(rules_mutex_);
+    std::vector<uint32_t> replace_rules(std::vector<RoutingRule> new_rules) {
+        // Compile and order the new table before taking the writer lock
+        for (auto& rule : new_rules) {
+            prepare_rule(rule);
+        }
+
+        std::lock_guard lock(writer_mutex_);
 
-        auto it = std::find_if(rules_.begin(), rules_.end(),
-                               [rule_id](const RoutingRule& r) { return r.id == rule_id; });
+        std::vector<uint32_t> ids;
+        ids.reserve(new_rules.size());
 
-        if (it == rules_.end()) {
-            return std::nullopt;
+        RuleList rules;
+        rules.reserve(new_rules.size());
+        for (auto& rule : new_rules) {
+            rule.id = next_rule_id_++;
+            resolve_sink_handles(rule);
+            ids.push_back(rule.id);
+            rules.push_back(std::make_shared<const RoutingRule>(std::move(rule)));
         }
 
-        return *it;
+        sort_by_priority(rules);
+        publish(std::move(rules));
+
+        IPB_LOG_INFO(LOG_CAT, "Replaced rule table with " << ids.size() << " rules");
+        return ids;
+    }
+
+    std::optional<RoutingRule> get_rule(uint32_t rule_id) const {
+        auto snapshot = current_snapshot();
+
+        for (const auto& rule : snapshot->rules) {
+            if (rule->id == rule_id) {
+                return *rule;
+            }
+        }
+        return std::nullopt;
     }
 
     std::vector<RoutingRule> get_all_rules() const {
-        std::shared_lock lock(rules_mutex_);
-        return rules_;
+        auto snapshot = current_snapshot();
+
+        std::vector<RoutingRule> rules;
+        rules.reserve(snapshot->rules.size());
+        for (const auto& rule : snapshot->rules) {
+            rules.push_back(*rule);
+        }
+        return rules;
     }
 
     void clear_rules() {
-        std::unique_lock lock(rules_mutex_);
-        rules_.clear();
-        compiled_patterns_.clear();
-        cache_.clear();
+        std::lock_guard lock(writer_mutex_);
+        publish({});
     }
 
-    size_t rule_count() const noexcept {
-        std::shared_lock lock(rules_mutex_);
-        return rules_.size();
-    }
+    size_t rule_count() const noexcept { return current_snapshot()->rules.size(); }
+
+    uint64_t rules_version() const noexcept { return current_snapshot()->version; }
 
     std::vector<RuleMatchResult> evaluate(const common::DataPoint& dp) {
         common::rt::HighResolutionTimer timer;
@@ -374,13 +566,16 @@ public:
         std::vector<RuleMatchResult> results;
         // PERFORMANCE: Reserve space for typical number of matches to reduce reallocations
         results.reserve(4);
-        std::string address(dp.address());
+        auto address = dp.address();
+
+        // Interned addresses are cached under their ID
+        auto address_id = common::InternedString::from_id(dp.address_id());
 
         IPB_LOG_TRACE(LOG_CAT, "Evaluating rules for address: " << address);
 
         // Check cache first
         if (config_.enable_cache) {
-            auto cached = check_cache(address);
+            auto cached = address_id.empty() ? cache_.find(address) : cache_.find(address_id);
             if (cached) {
                 stats_.cache_hits.fetch_add(1, std::memory_order_relaxed);
                 IPB_LOG_TRACE(LOG_CAT, "Cache hit for address: " << address);
@@ -389,27 +584,33 @@ public:
             stats_.cache_misses.fetch_add(1, std::memory_order_relaxed);
         }
 
-        // Evaluate all rules
-        {
-            std::shared_lock lock(rules_mutex_);
-
-            for (const auto& rule : rules_) {
-                if (!rule.enabled)
-                    continue;
+        // Writers publish a snapshot before bumping the cache epoch, so
+        // reading the epoch first means results computed from an older
+        // snapshot can never be inserted under a newer epoch
+        uint64_t cache_epoch = cache_.epoch();
+        auto snapshot        = current_snapshot();
 
-                auto result = evaluate_rule(rule, dp);
-                if (IPB_UNLIKELY(result.matched)) {
-                    results.push_back(std::move(result));
-                    stats_.total_matches.fetch_add(1, std::memory_order_relaxed);
-                    IPB_LOG_TRACE(
-                        LOG_CAT, "Rule matched: id=" << rule.id << " name=\"" << rule.name << "\"");
-                }
+        // Evaluate candidate rules
+        for_each_candidate(*snapshot, dp, [&](const RoutingRule& rule) {
+            auto result = rule.evaluate(dp);
+            if (IPB_UNLIKELY(result.matched)) {
+                results.push_back(std::move(result));
+                stats_.total_matches.fetch_add(1, std::memory_order_relaxed);
+                IPB_LOG_TRACE(LOG_CAT,
+                              "Rule matched: id=" << rule.id << " name=\"" << rule.name << "\"");
             }
-        }
+            return true;
+        });
 
         // Update cache
         if (config_.enable_cache && results.size() > 0) {
-            update_cache(address, results);
+            auto entry = std::make_shared<const std::vector<RuleMatchResult>>(results);
+            bool evicted = address_id.empty()
+                             ? cache_.insert(address, std::move(entry), cache_epoch)
+                             : cache_.insert(address_id, std::move(entry), cache_epoch);
+            if (evicted) {
+                stats_.cache_evictions.fetch_add(1, std::memory_order_relaxed);
+            }
         }
 
         stats_.total_evaluations.fetch_add(1, std::memory_order_relaxed);
@@ -423,29 +624,71 @@ public:
         return results;
     }
 
-    std::optional<RuleMatchResult> evaluate_first(const common::DataPoint& dp) {
+    size_t evaluate_into(const common::DataPoint& dp, RuleMatchSet& out, bool capture_groups) {
         common::rt::HighResolutionTimer timer;
 
-        std::shared_lock lock(rules_mutex_);
+        out.clear();
 
-        for (const auto& rule : rules_) {
-            if (!rule.enabled)
-                continue;
+        thread_local std::vector<std::string> groups;
 
-            auto result = evaluate_rule(rule, dp);
-            if (result.matched) {
-                stats_.total_evaluations.fetch_add(1, std::memory_order_relaxed);
-                stats_.total_matches.fetch_add(1, std::memory_order_relaxed);
+        auto snapshot = current_snapshot();
+        for_each_candidate(*snapshot, dp, [&](const RoutingRule& rule) {
+            groups.clear();
+            if (IPB_UNLIKELY(rule.matches(dp, capture_groups ? &groups : nullptr))) {
+                out.add(rule.id, rule.priority, rule.target_sink_handles, groups);
+            }
+            return true;
+        });
 
-                auto elapsed = timer.elapsed();
-                update_timing_stats(elapsed.count());
+        stats_.total_evaluations.fetch_add(1, std::memory_order_relaxed);
+        stats_.total_matches.fetch_add(out.size(), std::memory_order_relaxed);
+        update_timing_stats(timer.elapsed().count());
 
-                return result;
-            }
+        return out.size();
+    }
+
+    void set_sink_interner(std::shared_ptr<SinkIdInterner> interner) {
+        IPB_PRECONDITION(interner != nullptr);
+
+        std::lock_guard lock(writer_mutex_);
+        interner_ = std::move(interner);
+
+        auto rules = current_rules();
+        for (auto& rule : rules) {
+            auto resolved = std::make_shared<RoutingRule>(*rule);
+            resolve_sink_handles(*resolved);
+            rule = std::move(resolved);
         }
+        publish(std::move(rules));
+    }
+
+    const SinkIdInterner& sink_interner() const noexcept { return *interner_; }
+
+    std::optional<RuleMatchResult> evaluate_first(const common::DataPoint& dp) {
+        common::rt::HighResolutionTimer timer;
+
+        auto snapshot = current_snapshot();
+
+        std::optional<RuleMatchResult> first;
+        for_each_candidate(*snapshot, dp, [&](const RoutingRule& rule) {
+            auto result = rule.evaluate(dp);
+            if (result.matched) {
+                first = std::move(result);
+                return false;
+            }
+            return true;
+        });
 
         stats_.total_evaluations.fetch_add(1, std::memory_order_relaxed);
-        return std::nullopt;
+
+        if (first) {
+            stats_.total_matches.fetch_add(1, std::memory_order_relaxed);
+
+            auto elapsed = timer.elapsed();
+            update_timing_stats(elapsed.count());
+        }
+
+        return first;
     }
 
     std::vector<RuleMatchResult> evaluate_priority(const common::DataPoint& dp,
@@ -454,20 +697,19 @@ public:
         // PERFORMANCE: Reserve space for typical number of matches
         results.reserve(4);
 
-        std::shared_lock lock(rules_mutex_);
+        auto snapshot = current_snapshot();
 
-        for (const auto& rule : rules_) {
-            if (!rule.enabled)
-                continue;
+        for_each_candidate(*snapshot, dp, [&](const RoutingRule& rule) {
             if (static_cast<uint8_t>(rule.priority) < static_cast<uint8_t>(min_priority)) {
-                break;  // Rules are sorted by priority, so we can stop here
+                return false;  // Rules are sorted by priority, so we can stop here
             }
 
-            auto result = evaluate_rule(rule, dp);
+            auto result = rule.evaluate(dp);
             if (result.matched) {
                 results.push_back(std::move(result));
             }
-        }
+            return true;
+        });
 
         stats_.total_evaluations.fetch_add(1, std::memory_order_relaxed);
         stats_.total_matches.fetch_add(results.size(), std::memory_order_relaxed);
@@ -487,23 +729,245 @@ public:
         return results;
     }
 
-    void clear_cache() {
-        std::unique_lock lock(cache_mutex_);
-        cache_.clear();
+    size_t evaluate_batch_into(std::span<const common::DataPoint> data_points,
+                               RuleBatchMatches& out) {
+        common::rt::HighResolutionTimer timer;
+
+        auto snapshot     = current_snapshot();
+        const auto& rules = snapshot->rules;
+
+        out.reset(data_points.size());
+        for (const auto& rule : rules) {
+            out.add_rule(rule->id);
+        }
+        if (data_points.empty()) {
+            return 0;
+        }
+
+        const auto n     = data_points.size();
+        uint64_t visited = 0;
+        bool any_scalar  = false;
+
+        // VALUE rules: one pass over a shared value column per rule
+        thread_local ValueColumn column;
+        bool column_ready = false;
+
+        for (size_t row = 0; row < rules.size(); ++row) {
+            const auto& rule = *rules[row];
+            if (!rule.enabled) {
+                continue;
+            }
+            if (rule.type != RuleType::VALUE) {
+                any_scalar = true;
+                continue;
+            }
+
+            visited += n;
+            rule.eval_count.fetch_add(n, std::memory_order_relaxed);
+            if (!rule.value_condition) {
+                continue;
+            }
+
+            if (!column_ready) {
+                column.assign(data_points);
+                column_ready = true;
+            }
+
+            auto condition = rule.value_condition->resolve();
+            auto bits      = out.row(row);
+            condition.evaluate_column(column.values, column.numeric, bits);
+            if (condition.text) {
+                for (uint32_t point : column.strings) {
+                    if (condition.evaluate(data_points[point].value())) {
+                        bits[point / 64] |= uint64_t{1} << (point % 64);
+                    }
+                }
+            }
+            rule.match_count.fetch_add(out.match_count(row), std::memory_order_relaxed);
+        }
+
+        // Remaining rules: per point, candidates only
+        if (any_scalar) {
+            for (size_t point = 0; point < n; ++point) {
+                const auto& dp  = data_points[point];
+                const auto bit  = uint64_t{1} << (point % 64);
+                const auto word = point / 64;
+
+                auto visit = [&](uint32_t row) {
+                    const auto& rule = *rules[row];
+                    if (rule.enabled && rule.type != RuleType::VALUE) {
+                        ++visited;
+                        if (rule.matches(dp)) {
+                            out.row(row)[word] |= bit;
+                        }
+                    }
+                    return true;
+                };
+
+                if (config_.enable_rule_index) {
+                    snapshot->index.for_each_candidate(dp, visit);
+                } else {
+                    for (uint32_t row = 0; row < rules.size(); ++row) {
+                        visit(row);
+                    }
+                }
+            }
+        }
+
+        size_t total = 0;
+        for (size_t row = 0; row < out.rule_count(); ++row) {
+            total += out.match_count(row);
+        }
+
+        stats_.rules_evaluated.fetch_add(visited, std::memory_order_relaxed);
+        stats_.total_evaluations.fetch_add(n, std::memory_order_relaxed);
+        stats_.total_matches.fetch_add(total, std::memory_order_relaxed);
+        stats_.total_eval_time_ns.fetch_add(timer.elapsed().count(), std::memory_order_relaxed);
+
+        return total;
     }
 
-    void invalidate_cache(std::string_view address_pattern) {
-        std::unique_lock lock(cache_mutex_);
+    size_t evaluate_columns_into(const common::ColumnarBatch& batch, RuleBatchMatches& out) {
+        common::rt::HighResolutionTimer timer;
 
-        auto matcher = PatternMatcherFactory::create(address_pattern);
+        auto snapshot     = current_snapshot();
+        const auto& rules = snapshot->rules;
 
-        for (auto it = cache_.begin(); it != cache_.end();) {
-            if (matcher->matches(it->first)) {
-                it = cache_.erase(it);
-            } else {
-                ++it;
+        out.reset(batch.size());
+        for (const auto& rule : rules) {
+            out.add_rule(rule->id);
+        }
+        if (batch.empty()) {
+            return 0;
+        }
+
+        const auto n     = batch.size();
+        uint64_t visited = 0;
+        bool any_scalar  = false;
+
+        thread_local ValueColumn column;
+        bool column_ready = false;
+
+        // Column rules: one pass over the column each rule tests
+        for (size_t row = 0; row < rules.size(); ++row) {
+            const auto& rule = *rules[row];
+            if (!rule.enabled) {
+                continue;
+            }
+            if (!is_column_rule(rule.type)) {
+                any_scalar = true;
+                continue;
+            }
+
+            visited += n;
+            rule.eval_count.fetch_add(n, std::memory_order_relaxed);
+
+            auto bits = out.row(row);
+            switch (rule.type) {
+                case RuleType::VALUE: {
+                    if (!rule.value_condition) {
+                        break;
+                    }
+                    if (!column_ready) {
+                        column.assign(batch.values());
+                        column_ready = true;
+                    }
+                    auto condition = rule.value_condition->resolve();
+                    condition.evaluate_column(column.values, column.numeric, bits);
+                    if (condition.text) {
+                        for (uint32_t point : column.strings) {
+                            if (condition.evaluate(batch.values()[point])) {
+                                bits[point / 64] |= uint64_t{1} << (point % 64);
+                            }
+                        }
+                    }
+                    break;
+                }
+
+                case RuleType::PROTOCOL:
+                    match_column(batch.protocol_ids(), bits, [&rule](uint16_t protocol_id) {
+                        return std::find(rule.protocol_ids.begin(), rule.protocol_ids.end(),
+                                         protocol_id) != rule.protocol_ids.end();
+                    });
+                    break;
+
+                case RuleType::QUALITY: {
+                    uint32_t levels = 0;
+                    for (auto q : rule.quality_levels) {
+                        if (static_cast<uint8_t>(q) < 32) {
+                            levels |= uint32_t{1} << static_cast<uint8_t>(q);
+                        }
+                    }
+                    match_column(batch.qualities(), bits, [&rule, levels](common::Quality q) {
+                        auto level = static_cast<uint8_t>(q);
+                        if (level < 32) {
+                            return ((levels >> level) & 1) != 0;
+                        }
+                        return std::find(rule.quality_levels.begin(), rule.quality_levels.end(),
+                                         q) != rule.quality_levels.end();
+                    });
+                    break;
+                }
+
+                case RuleType::TIMESTAMP:
+                    match_column(batch.timestamps(), bits, [&rule](common::Timestamp ts) {
+                        return ts >= rule.start_time && ts <= rule.end_time;
+                    });
+                    break;
+
+                default:
+                    break;
             }
+            rule.match_count.fetch_add(out.match_count(row), std::memory_order_relaxed);
         }
+
+        // Address, composite and custom rules: per point, candidates only
+        if (any_scalar) {
+            common::DataPoint dp;
+            for (size_t point = 0; point < n; ++point) {
+                batch.load(point, dp);
+                const auto bit  = uint64_t{1} << (point % 64);
+                const auto word = point / 64;
+
+                auto visit = [&](uint32_t row) {
+                    const auto& rule = *rules[row];
+                    if (rule.enabled && !is_column_rule(rule.type)) {
+                        ++visited;
+                        if (rule.matches(dp)) {
+                            out.row(row)[word] |= bit;
+                        }
+                    }
+                    return true;
+                };
+
+                if (config_.enable_rule_index) {
+                    snapshot->index.for_each_candidate(dp, visit);
+                } else {
+                    for (uint32_t row = 0; row < rules.size(); ++row) {
+                        visit(row);
+                    }
+                }
+            }
+        }
+
+        size_t total = 0;
+        for (size_t row = 0; row < out.rule_count(); ++row) {
+            total += out.match_count(row);
+        }
+
+        stats_.rules_evaluated.fetch_add(visited, std::memory_order_relaxed);
+        stats_.total_evaluations.fetch_add(n, std::memory_order_relaxed);
+        stats_.total_matches.fetch_add(total, std::memory_order_relaxed);
+        stats_.total_eval_time_ns.fetch_add(timer.elapsed().count(), std::memory_order_relaxed);
+
+        return total;
+    }
+
+    void clear_cache() { cache_.clear(); }
+
+    void invalidate_cache(std::string_view address_pattern) {
+        auto matcher = PatternMatcherFactory::create(address_pattern);
+        cache_.erase_if([&](std::string_view address) { return matcher->matches(address); });
     }
 
     const RuleEngineStats& stats() const noexcept { return stats_; }
@@ -513,69 +977,97 @@ public:
     const RuleEngineConfig& config() const noexcept { return config_; }
 
 private:
-    RuleMatchResult evaluate_rule(const RoutingRule& rule, const common::DataPoint& dp) const {
-        // Use pre-compiled pattern if available
-        if (rule.type == RuleType::PATTERN) {
-            auto it = compiled_patterns_.find(rule.id);
-            if (it != compiled_patterns_.end()) {
-                RuleMatchResult result;
-                result.rule_id    = rule.id;
-                result.priority   = rule.priority;
-                result.target_ids = rule.target_sink_ids;
-
-                auto match             = it->second->match_with_groups(dp.address());
-                result.matched         = match.matched;
-                result.captured_groups = std::move(match.captured_groups);
-
-                return result;
-            }
-        }
-
-        return rule.evaluate(dp);
+    std::shared_ptr<const RuleSnapshot> current_snapshot() const noexcept {
+        return snapshot_.load(std::memory_order_acquire);
     }
 
-    std::optional<std::vector<RuleMatchResult>> check_cache(const std::string& address) {
-        std::shared_lock lock(cache_mutex_);
+    /// Copy of the current rule list (pointers only). Caller holds writer_mutex_.
+    RuleList current_rules() const { return current_snapshot()->rules; }
 
-        auto it = cache_.find(address);
-        if (it == cache_.end()) {
-            return std::nullopt;
-        }
+    static RuleList::iterator find_rule(RuleList& rules, uint32_t rule_id) {
+        return std::find_if(rules.begin(), rules.end(),
+                            [rule_id](const RulePtr& r) { return r->id == rule_id; });
+    }
 
-        // Check TTL
-        if (config_.cache_ttl_ms > 0) {
-            auto now    = common::Timestamp::now();
-            auto age_ms = (now - it->second.timestamp).count() / 1000000;
-            if (age_ms > config_.cache_ttl_ms) {
-                return std::nullopt;
+    /**
+     * Build the next snapshot from rules and make it visible to readers.
+     * Caller holds writer_mutex_.
+     */
+    void publish(RuleList rules) {
+        auto next     = std::make_shared<RuleSnapshot>();
+        next->version = current_snapshot()->version + 1;
+        next->rules   = std::move(rules);
+
+        if (config_.enable_rule_index) {
+            std::vector<const RoutingRule*> table;
+            table.reserve(next->rules.size());
+            for (const auto& rule : next->rules) {
+                table.push_back(rule.get());
             }
+            next->index.build(table);
         }
 
-        return it->second.results;
-    }
+        IPB_LOG_TRACE(LOG_CAT, "Publishing rule snapshot v" << next->version << " with "
+                                                           << next->rules.size() << " rules");
 
-    void update_cache(const std::string& address, const std::vector<RuleMatchResult>& results) {
-        std::unique_lock lock(cache_mutex_);
+        snapshot_.store(std::move(next), std::memory_order_release);
 
-        // Evict if at capacity
-        if (cache_.size() >= config_.cache_size) {
-            // Simple LRU: remove oldest entry
-            common::Timestamp oldest = common::Timestamp::now();
-            std::string oldest_key;
+        // Invalidate cached results without blocking readers
+        cache_.invalidate();
+    }
 
-            for (const auto& [key, entry] : cache_) {
-                if (entry.timestamp < oldest) {
-                    oldest     = entry.timestamp;
-                    oldest_key = key;
+    /**
+     * Visit enabled rules of a snapshot that may match dp, in priority order.
+     * fn returns false to stop.
+     */
+    template <typename Fn>
+    void for_each_candidate(const RuleSnapshot& snapshot, const common::DataPoint& dp, Fn&& fn) {
+        uint64_t visited = 0;
+
+        auto visit = [&](const RoutingRule& rule) {
+            if (!rule.enabled) {
+                return true;
+            }
+            ++visited;
+            return fn(rule);
+        };
+
+        if (config_.enable_rule_index) {
+            snapshot.index.for_each_candidate(
+                dp, [&](uint32_t position) { return visit(*snapshot.rules[position]); });
+        } else {
+            for (const auto& rule : snapshot.rules) {
+                if (!visit(*rule)) {
+                    break;
                 }
             }
+        }
 
-            if (!oldest_key.empty()) {
-                cache_.erase(oldest_key);
-            }
+        stats_.rules_evaluated.fetch_add(visited, std::memory_order_relaxed);
+    }
+
+    /// Work that does not depend on engine state; done outside writer_mutex_
+    void prepare_rule(RoutingRule& rule) const {
+        if (config_.precompile_patterns && rule.type == RuleType::PATTERN) {
+            IPB_LOG_TRACE(LOG_CAT, "Pre-compiling pattern: " << rule.address_pattern);
+            rule.compile_pattern(preferred_matcher_type());
+        } else if (rule.type == RuleType::COMPOSITE) {
+            rule.compile_condition(preferred_matcher_type());
         }
+    }
+
+    /// Caller holds writer_mutex_ (or owns the rule exclusively)
+    void resolve_sink_handles(RoutingRule& rule) {
+        rule.target_sink_handles.clear();
+        rule.target_sink_handles.reserve(rule.target_sink_ids.size());
+        for (const auto& sink_id : rule.target_sink_ids) {
+            rule.target_sink_handles.push_back(interner_->intern(sink_id));
+        }
+    }
 
-        cache_[address] = CacheEntry{results, common::Timestamp::now()};
+    PatternMatcherFactory::MatcherType preferred_matcher_type() const noexcept {
+        return config_.prefer_ctre ? PatternMatcherFactory::MatcherType::REGEX_CTRE
+                                   : PatternMatcherFactory::MatcherType::AUTO;
     }
 
     void update_timing_stats(int64_t elapsed_ns) {
@@ -594,18 +1086,16 @@ private:
     RuleEngineConfig config_;
     RuleEngineStats stats_;
 
-    mutable std::shared_mutex rules_mutex_;
-    std::vector<RoutingRule> rules_;
-    std::unordered_map<uint32_t, std::unique_ptr<IPatternMatcher>> compiled_patterns_;
-    std::atomic<uint32_t> next_rule_id_{1};
+    // Address -> results cache, invalidated by epoch on rule changes
+    MatchCache cache_;
 
-    // Cache
-    struct CacheEntry {
-        std::vector<RuleMatchResult> results;
-        common::Timestamp timestamp;
-    };
-    mutable std::shared_mutex cache_mutex_;
-    std::unordered_map<std::string, CacheEntry> cache_;
+    // Current rule table; writers serialize on writer_mutex_, readers never lock
+    std::atomic<std::shared_ptr<const RuleSnapshot>> snapshot_;
+    std::mutex writer_mutex_;
+    uint32_t next_rule_id_ = 1;  ///< Guarded by writer_mutex_
+
+    // Resolves rule targets to SinkHandle values
+    std::shared_ptr<SinkIdInterner> interner_ = std::make_shared<SinkIdInterner>();
 };
 
 // ============================================================================
@@ -646,6 +1136,10 @@ std::vector<RoutingRule> RuleEngine::get_all_rules() const {
     return impl_->get_all_rules();
 }
 
+std::vector<uint32_t> RuleEngine::replace_rules(std::vector<RoutingRule> rules) {
+    return impl_->replace_rules(std::move(rules));
+}
+
 void RuleEngine::clear_rules() {
     impl_->clear_rules();
 }
@@ -654,6 +1148,10 @@ size_t RuleEngine::rule_count() const noexcept {
     return impl_->rule_count();
 }
 
+uint64_t RuleEngine::rules_version() const noexcept {
+    return impl_->rules_version();
+}
+
 std::vector<RuleMatchResult> RuleEngine::evaluate(const common::DataPoint& dp) {
     return impl_->evaluate(dp);
 }
@@ -672,6 +1170,29 @@ std::vector<std::vector<RuleMatchResult>> RuleEngine::evaluate_batch(
     return impl_->evaluate_batch(data_points);
 }
 
+size_t RuleEngine::evaluate_into(const common::DataPoint& dp, RuleMatchSet& out,
+                                 bool capture_groups) {
+    return impl_->evaluate_into(dp, out, capture_groups);
+}
+
+void RuleEngine::set_sink_interner(std::shared_ptr<SinkIdInterner> interner) {
+    impl_->set_sink_interner(std::move(interner));
+}
+
+const SinkIdInterner& RuleEngine::sink_interner() const noexcept {
+    return impl_->sink_interner();
+}
+
+size_t RuleEngine::evaluate_batch_into(std::span<const common::DataPoint> data_points,
+                                       RuleBatchMatches& out) {
+    return impl_->evaluate_batch_into(data_points, out);
+}
+
+size_t RuleEngine::evaluate_columns_into(const common::ColumnarBatch& batch,
+                                         RuleBatchMatches& out) {
+    return impl_->evaluate_columns_into(batch, out);
+}
+
 void RuleEngine::clear_cache() {
     impl_->clear_cache();
 }
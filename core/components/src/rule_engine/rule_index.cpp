@@ -0,0 +1,270 @@
+#include "ipb/core/rule_engine/rule_index.hpp"
+
+#include <algorithm>
+
+#include "ipb/core/rule_engine/rule_engine.hpp"
+
+namespace ipb::core {
+
+namespace {
+
+/// Characters with special meaning in wildcard or regex patterns
+constexpr bool is_pattern_meta(char c) noexcept {
+    switch (c) {
+        case '*':
+        case '?':
+        case '.':
+        case '+':
+        case '^':
+        case '$':
+        case '[':
+        case ']':
+        case '(':
+        case ')':
+        case '{':
+        case '}':
+        case '|':
+        case '\\':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Characters that make the preceding atom optional or repeatable
+constexpr bool is_quantifier(char c) noexcept {
+    return c == '*' || c == '?' || c == '+' || c == '{';
+}
+
+void or_into(std::vector<uint64_t>& dst, const std::vector<uint64_t>& src) noexcept {
+    const size_t n = std::min(dst.size(), src.size());
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] |= src[i];
+    }
+}
+
+/**
+ * Addresses one of which every match of a condition must have, or nullptr.
+ * Only looks through AND nodes, where any STATIC operand is required.
+ */
+const std::vector<std::string>* required_addresses(const RuleCondition& condition) noexcept {
+    if (condition.kind == RuleCondition::Kind::STATIC) {
+        return &condition.source_addresses;
+    }
+    if (condition.kind == RuleCondition::Kind::AND) {
+        for (const auto& operand : condition.operands) {
+            if (auto* addresses = required_addresses(operand)) {
+                return addresses;
+            }
+        }
+    }
+    return nullptr;
+}
+
+}  // anonymous namespace
+
+// ============================================================================
+// RuleIndex Implementation
+// ============================================================================
+
+std::string_view RuleIndex::literal_prefix(std::string_view pattern) noexcept {
+    // Top-level alternation means no common prefix can be assumed
+    if (pattern.find('|') != std::string_view::npos) {
+        return {};
+    }
+
+    size_t len = 0;
+    while (len < pattern.size() && !is_pattern_meta(pattern[len])) {
+        ++len;
+    }
+
+    // "abc*" / "abc?" / "abc+" / "abc{n}" quantify the last literal in regex syntax
+    if (len < pattern.size() && len > 0 && is_quantifier(pattern[len])) {
+        --len;
+    }
+
+    return pattern.substr(0, len);
+}
+
+void RuleIndex::clear() {
+    rule_count_ = 0;
+    address_index_.clear();
+    address_id_index_.clear();
+    address_id_limit_ = 0;
+    prefix_trie_.clear();
+    protocol_bits_.clear();
+    for (auto& bits : quality_bits_) {
+        bits.clear();
+    }
+    residual_bits_.clear();
+    stats_ = Stats{};
+}
+
+void RuleIndex::build(std::span<const RoutingRule* const> rules) {
+    clear();
+
+    rule_count_    = rules.size();
+    residual_bits_ = empty_bitset();
+
+    auto add_address = [this](std::string_view address, uint32_t position) {
+        auto it = address_index_.find(address);
+        if (it == address_index_.end()) {
+            it = address_index_.emplace(std::string(address), std::vector<uint32_t>{}).first;
+        }
+        if (it->second.empty() || it->second.back() != position) {
+            it->second.push_back(position);
+        }
+    };
+
+    for (uint32_t position = 0; position < rules.size(); ++position) {
+        const auto& rule = *rules[position];
+
+        switch (rule.type) {
+            case RuleType::STATIC:
+                for (const auto& address : rule.source_addresses) {
+                    add_address(address, position);
+                }
+                break;
+
+            case RuleType::PATTERN: {
+                auto prefix = literal_prefix(rule.address_pattern);
+                if (prefix.size() == rule.address_pattern.size()) {
+                    // No metacharacters at all: the pattern is an exact address
+                    add_address(rule.address_pattern, position);
+                } else if (!prefix.empty()) {
+                    prefix_trie_.add_prefix(prefix, position);
+                    ++stats_.prefix_patterns;
+                } else {
+                    set_bit(residual_bits_, position);
+                    ++stats_.unindexed_rules;
+                }
+                break;
+            }
+
+            case RuleType::PROTOCOL:
+                for (uint16_t protocol : rule.protocol_ids) {
+                    auto& bits = protocol_bits_[protocol];
+                    if (bits.empty()) {
+                        bits = empty_bitset();
+                    }
+                    set_bit(bits, position);
+                }
+                break;
+
+            case RuleType::QUALITY: {
+                bool indexed = true;
+                for (auto quality : rule.quality_levels) {
+                    auto slot = static_cast<size_t>(quality);
+                    if (slot >= QUALITY_SLOTS) {
+                        indexed = false;
+                        continue;
+                    }
+                    auto& bits = quality_bits_[slot];
+                    if (bits.empty()) {
+                        bits = empty_bitset();
+                    }
+                    set_bit(bits, position);
+                }
+                if (indexed) {
+                    ++stats_.quality_rules;
+                } else {
+                    set_bit(residual_bits_, position);
+                    ++stats_.unindexed_rules;
+                }
+                break;
+            }
+
+            case RuleType::COMPOSITE: {
+                const auto* addresses =
+                    rule.condition ? required_addresses(*rule.condition) : nullptr;
+                if (addresses) {
+                    for (const auto& address : *addresses) {
+                        add_address(address, position);
+                    }
+                    ++stats_.composite_rules;
+                } else {
+                    set_bit(residual_bits_, position);
+                    ++stats_.unindexed_rules;
+                }
+                break;
+            }
+
+            case RuleType::VALUE:
+            case RuleType::TIMESTAMP:
+            case RuleType::CUSTOM:
+            default:
+                set_bit(residual_bits_, position);
+                ++stats_.unindexed_rules;
+                break;
+        }
+    }
+
+    // Only look IDs up: interning every rule address would grow the global table
+    // with each rebuild. Addresses interned later are found through the string path
+    auto& interner    = common::StringInterner::global();
+    address_id_limit_ = static_cast<common::StringInterner::Id>(interner.size());
+    address_id_index_.reserve(address_index_.size());
+    for (const auto& [address, positions] : address_index_) {
+        if (auto id = interner.find(address)) {
+            address_id_index_.emplace(*id, &positions);
+        }
+    }
+
+    stats_.static_keys   = address_index_.size();
+    stats_.protocol_keys = protocol_bits_.size();
+}
+
+void RuleIndex::collect_candidates(const common::DataPoint& dp,
+                                   std::vector<uint64_t>& words) const {
+    words.assign(residual_bits_.begin(), residual_bits_.end());
+
+    if (rule_count_ == 0) {
+        return;
+    }
+
+    auto address = dp.address();
+
+    if (!address_index_.empty()) {
+        const std::vector<uint32_t>* positions = nullptr;
+        const auto id = dp.address_id();
+        if (id != common::StringInterner::EMPTY_ID && id < address_id_limit_) {
+            auto it = address_id_index_.find(id);
+            if (it != address_id_index_.end()) {
+                positions = it->second;
+            }
+        } else {
+            auto it = address_index_.find(address);
+            if (it != address_index_.end()) {
+                positions = &it->second;
+            }
+        }
+        if (positions != nullptr) {
+            for (uint32_t position : *positions) {
+                set_bit(words, position);
+            }
+        }
+    }
+
+    if (!prefix_trie_.empty()) {
+        thread_local std::vector<uint32_t> prefix_hits;
+        prefix_hits.clear();
+        prefix_trie_.collect_prefix_matches(address, prefix_hits);
+        for (uint32_t position : prefix_hits) {
+            set_bit(words, position);
+        }
+    }
+
+    if (!protocol_bits_.empty()) {
+        auto it = protocol_bits_.find(dp.protocol_id());
+        if (it != protocol_bits_.end()) {
+            or_into(words, it->second);
+        }
+    }
+
+    auto slot = static_cast<size_t>(dp.quality());
+    if (slot < QUALITY_SLOTS && !quality_bits_[slot].empty()) {
+        or_into(words, quality_bits_[slot]);
+    }
+}
+
+}  // namespace ipb::core
@@ -2,16 +2,17 @@
 
 #include <ipb/common/debug.hpp>
 #include <ipb/common/error.hpp>
+#include <ipb/common/lockfree_task_queue.hpp>
 #include <ipb/common/platform.hpp>
 
 #include <condition_variable>
 #include <mutex>
-#include <shared_mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "ipb/core/scheduler/task_queue.hpp"
+#include "ipb/core/scheduler/timer_wheel.hpp"
 
 namespace ipb::core {
 
@@ -19,6 +20,10 @@ using namespace common::debug;
 
 namespace {
 constexpr std::string_view LOG_CAT = category::SCHEDULER;
+
+// Scheduler and worker index of the calling thread, if it is a worker
+thread_local const EDFSchedulerImpl* t_scheduler = nullptr;
+thread_local size_t t_worker                     = WorkStealingTaskQueue::NO_WORKER;
 }  // anonymous namespace
 
 // ============================================================================
@@ -28,10 +33,28 @@ constexpr std::string_view LOG_CAT = category::SCHEDULER;
 class EDFSchedulerImpl {
 public:
     explicit EDFSchedulerImpl(const EDFSchedulerConfig& config)
-        : config_(config), task_queue_(config.max_queue_size) {
+        : config_(config), timer_wheel_(config.timer_tick, common::Timestamp::now()) {
         if (config_.worker_threads == 0) {
             config_.worker_threads = std::thread::hardware_concurrency();
         }
+
+        switch (config_.queue_backend) {
+            case EDFSchedulerConfig::QueueBackend::LOCK_FREE:
+                lockfree_queue_ =
+                    std::make_unique<common::LockFreeTaskQueue>(config_.max_queue_size);
+                break;
+            case EDFSchedulerConfig::QueueBackend::WORK_STEALING:
+                stealing_queue_ = std::make_unique<WorkStealingTaskQueue>(config_.worker_threads,
+                                                                          config_.max_queue_size);
+                break;
+            case EDFSchedulerConfig::QueueBackend::MUTEX_HEAP:
+                task_queue_ = std::make_unique<TaskQueue>(config_.max_queue_size);
+                break;
+        }
+
+        if (config_.admission_control) {
+            demand_ = std::make_unique<DeadlineDemand>(config_.admission_slot_width);
+        }
     }
 
     ~EDFSchedulerImpl() { stop_immediate(); }
@@ -71,9 +94,8 @@ public:
             }
         }
 
-        // Start deadline checker thread
-        IPB_LOG_DEBUG(LOG_CAT, "Starting deadline checker thread");
-        deadline_checker_ = std::thread([this]() { deadline_check_loop(); });
+        IPB_LOG_DEBUG(LOG_CAT, "Starting timer thread");
+        timer_thread_ = std::thread([this]() { timer_loop(); });
 
         IPB_LOG_INFO(LOG_CAT, "EDFScheduler started successfully");
         return true;
@@ -90,7 +112,8 @@ public:
         IPB_LOG_INFO(LOG_CAT, "Stopping EDFScheduler...");
 
         stop_requested_.store(true);
-        task_cv_.notify_all();
+        wake_all_workers();
+        wake_timer_thread();
 
         for (auto& worker : workers_) {
             if (worker.joinable()) {
@@ -99,8 +122,8 @@ public:
         }
         workers_.clear();
 
-        if (deadline_checker_.joinable()) {
-            deadline_checker_.join();
+        if (timer_thread_.joinable()) {
+            timer_thread_.join();
         }
 
         IPB_LOG_INFO(LOG_CAT, "EDFScheduler stopped");
@@ -109,11 +132,12 @@ public:
     void stop_immediate() {
         stop_requested_.store(true);
         running_.store(false);
-        task_cv_.notify_all();
+        wake_all_workers();
+        wake_timer_thread();
 
         // Cancel all pending tasks
         ScheduledTask task;
-        while (task_queue_.pop(task)) {
+        while (dequeue(task)) {
             task.state = TaskState::CANCELLED;
             stats_.tasks_cancelled.fetch_add(1, std::memory_order_relaxed);
 
@@ -129,8 +153,8 @@ public:
         }
         workers_.clear();
 
-        if (deadline_checker_.joinable()) {
-            deadline_checker_.join();
+        if (timer_thread_.joinable()) {
+            timer_thread_.join();
         }
     }
 
@@ -171,9 +195,19 @@ public:
             return result;
         }
 
-        if (IPB_UNLIKELY(!task_queue_.push(std::move(task)))) {
+        if (IPB_UNLIKELY(demand_ && !admissible(task))) {
+            stats_.tasks_rejected.fetch_add(1, std::memory_order_relaxed);
+            IPB_LOG_DEBUG(LOG_CAT, "Task " << task.id << " rejected: deadline cannot be met");
+
+            result.task_id       = task.id;
+            result.error_message = "Deadline cannot be met";
+            return result;
+        }
+
+        const uint64_t task_id = task.id;
+        if (IPB_UNLIKELY(!enqueue(std::move(task)))) {
             // Queue full - apply overflow policy
-            IPB_LOG_WARN(LOG_CAT, "Task queue full (size=" << task_queue_.size() << ")");
+            IPB_LOG_WARN(LOG_CAT, "Task queue full (size=" << queue_size() << ")");
 
             if (config_.overflow_policy == EDFSchedulerConfig::OverflowPolicy::REJECT) {
                 result.error_message = "Queue full";
@@ -186,21 +220,23 @@ public:
 
         stats_.tasks_submitted.fetch_add(1, std::memory_order_relaxed);
 
-        auto queue_size = task_queue_.size();
-        stats_.current_queue_size.store(queue_size, std::memory_order_relaxed);
+        auto size = queue_size();
+        stats_.current_queue_size.store(size, std::memory_order_relaxed);
 
         // Update peak
         auto peak = stats_.peak_queue_size.load(std::memory_order_relaxed);
-        while (queue_size > peak) {
-            stats_.peak_queue_size.compare_exchange_weak(peak, queue_size);
+        while (size > peak) {
+            stats_.peak_queue_size.compare_exchange_weak(peak, size);
         }
 
-        // Wake up a worker
-        task_cv_.notify_one();
+        // Wake up a worker; busy workers pick the task up on their next pop
+        if (!stealing_queue_ && idle_workers_.load(std::memory_order_seq_cst) > 0) {
+            task_cv_.notify_one();
+        }
 
         result.success = true;
-        result.task_id = task.id;
-        IPB_LOG_TRACE(LOG_CAT, "Task " << task.id << " submitted successfully");
+        result.task_id = task_id;
+        IPB_LOG_TRACE(LOG_CAT, "Task " << task_id << " submitted successfully");
         return result;
     }
 
@@ -241,29 +277,77 @@ public:
 
     uint64_t submit_periodic(std::function<void()> func, std::chrono::nanoseconds period,
                              TaskPriority priority) {
-        uint64_t periodic_id = next_periodic_id_.fetch_add(1, std::memory_order_relaxed);
+        if (IPB_UNLIKELY(period.count() <= 0)) {
+            IPB_LOG_WARN(LOG_CAT, "Cannot submit periodic task: period must be positive");
+            return 0;
+        }
+
+        auto periodic           = std::make_unique<PeriodicTask>();
+        periodic->id            = next_periodic_id_.fetch_add(1, std::memory_order_relaxed);
+        periodic->task_function = std::move(func);
+        periodic->period        = period;
+        periodic->priority      = priority;
 
+        auto& entry       = *periodic;
+        const uint64_t id = entry.id;
+        bool due          = false;
         {
-            std::lock_guard lock(periodic_mutex_);
-            periodic_tasks_[periodic_id] =
-                PeriodicTask{periodic_id, std::move(func), period, priority, true};
-        }
+            std::lock_guard lock(timer_mutex_);
+            periodic_tasks_.emplace(id, std::move(periodic));
 
-        // Submit first occurrence
-        schedule_periodic_instance(periodic_id);
+            // The first instance is released right away
+            auto now = common::Timestamp::now();
+            due      = claim_release(entry, now, now);
+        }
+        timer_cv_.notify_one();
 
-        return periodic_id;
+        if (due) {
+            bool submitted = submit_release(entry);
+            std::lock_guard lock(timer_mutex_);
+            finish_release(entry, submitted);
+        }
+        return id;
     }
 
     bool cancel_periodic(uint64_t periodic_id) {
-        std::lock_guard lock(periodic_mutex_);
-        return periodic_tasks_.erase(periodic_id) > 0;
+        std::lock_guard lock(timer_mutex_);
+
+        auto it = periodic_tasks_.find(periodic_id);
+        if (it == periodic_tasks_.end()) {
+            return false;
+        }
+
+        // A queued instance may still refer to the entry; keep it until that is done
+        it->second->active.store(false, std::memory_order_release);
+        timer_wheel_.cancel(*it->second);
+        retired_periodic_.push_back(std::move(it->second));
+        periodic_tasks_.erase(it);
+        return true;
+    }
+
+    std::optional<PeriodicTaskStats> periodic_stats(uint64_t periodic_id) const {
+        std::lock_guard lock(timer_mutex_);
+
+        auto it = periodic_tasks_.find(periodic_id);
+        if (it == periodic_tasks_.end()) {
+            return std::nullopt;
+        }
+
+        const auto& periodic = *it->second;
+        PeriodicTaskStats stats;
+        stats.releases        = periodic.releases.load(std::memory_order_relaxed);
+        stats.started         = periodic.started.load(std::memory_order_relaxed);
+        stats.skipped         = periodic.skipped.load(std::memory_order_relaxed);
+        stats.last_jitter_ns  = periodic.last_jitter_ns.load(std::memory_order_relaxed);
+        stats.max_jitter_ns   = periodic.max_jitter_ns.load(std::memory_order_relaxed);
+        stats.total_jitter_ns = periodic.total_jitter_ns.load(std::memory_order_relaxed);
+        return stats;
     }
 
     bool cancel(uint64_t task_id) {
-        if (task_queue_.remove(task_id)) {
+        if (remove_queued(task_id)) {
             stats_.tasks_cancelled.fetch_add(1, std::memory_order_relaxed);
-            stats_.current_queue_size.store(task_queue_.size(), std::memory_order_relaxed);
+            stats_.current_queue_size.store(queue_size(), std::memory_order_relaxed);
             return true;
         }
         return false;
@@ -278,10 +362,19 @@ public:
         return std::nullopt;
     }
 
-    size_t pending_count() const noexcept { return task_queue_.size(); }
+    size_t pending_count() const noexcept { return queue_size(); }
 
     std::optional<common::Timestamp> nearest_deadline() const {
-        return task_queue_.nearest_deadline();
+        if (stealing_queue_) {
+            return stealing_queue_->nearest_deadline();
+        }
+        if (!lockfree_queue_) {
+            return task_queue_->nearest_deadline();
+        }
+        if (auto deadline_ns = lockfree_queue_->nearest_deadline()) {
+            return common::Timestamp(std::chrono::nanoseconds(*deadline_ns));
+        }
+        return std::nullopt;
     }
 
     void set_deadline_miss_callback(EDFScheduler::DeadlineMissCallback callback) {
@@ -308,30 +401,177 @@ public:
     }
 
 private:
-    void worker_loop(size_t worker_id) {
-        IPB_LOG_DEBUG(LOG_CAT, "Worker " << worker_id << " started");
+    // ========================================================================
+    // Ready queue
+    // ========================================================================
+
+    // The lock-free queue orders POD entries; each points at a heap record
+    // holding the task's functions and name, owned by whoever pops it.
+
+    bool enqueue(ScheduledTask&& task) {
+        if (demand_) {
+            // Count first: a worker may run and un-count the task as soon as it is queued
+            auto deadline = task.deadline;
+            demand_->add(deadline, task.arrival_time);
+            if (!enqueue_task(std::move(task))) {
+                demand_->remove(deadline);
+                return false;
+            }
+            return true;
+        }
+        return enqueue_task(std::move(task));
+    }
 
-        while (!stop_requested_.load(std::memory_order_acquire)) {
-            ScheduledTask task;
+    bool enqueue_task(ScheduledTask&& task) {
+        if (stealing_queue_) {
+            size_t worker = t_scheduler == this ? t_worker : WorkStealingTaskQueue::NO_WORKER;
+            return stealing_queue_->push(std::move(task), worker);
+        }
+        if (!lockfree_queue_) {
+            return task_queue_->push(std::move(task));
+        }
+
+        auto record = std::make_unique<ScheduledTask>(std::move(task));
+
+        common::LockFreeTask entry;
+        entry.id              = record->id;
+        entry.deadline_ns     = record->deadline.nanoseconds();
+        entry.arrival_time_ns = record->arrival_time.nanoseconds();
+        entry.priority        = static_cast<uint8_t>(record->priority);
+        entry.task_context    = record.get();
+
+        if (!lockfree_queue_->push(entry)) {
+            return false;
+        }
+        record.release();
+        return true;
+    }
+
+    /// Pop the next task for a worker (any task if worker is NO_WORKER)
+    bool dequeue(ScheduledTask& task, size_t worker = WorkStealingTaskQueue::NO_WORKER) {
+        if (!dequeue_task(task, worker)) {
+            return false;
+        }
+        if (demand_) {
+            demand_->remove(task.deadline);
+        }
+        return true;
+    }
+
+    bool dequeue_task(ScheduledTask& task, size_t worker) {
+        if (stealing_queue_) {
+            return worker == WorkStealingTaskQueue::NO_WORKER ? stealing_queue_->pop_any(task)
+                                                              : stealing_queue_->pop(worker, task);
+        }
+        if (!lockfree_queue_) {
+            return task_queue_->try_pop(task);
+        }
+
+        common::LockFreeTask entry;
+        if (!lockfree_queue_->pop(entry)) {
+            return false;
+        }
+        std::unique_ptr<ScheduledTask> record(static_cast<ScheduledTask*>(entry.task_context));
+        task = std::move(*record);
+        return true;
+    }
+
+    bool remove_queued(uint64_t task_id) {
+        std::optional<common::Timestamp> deadline;
 
-            // Wait for task
-            {
-                std::unique_lock lock(task_mutex_);
-                task_cv_.wait_for(lock, config_.check_interval, [this]() {
-                    return stop_requested_.load(std::memory_order_acquire) || !task_queue_.empty();
-                });
+        if (stealing_queue_ || task_queue_) {
+            auto task = stealing_queue_ ? stealing_queue_->extract(task_id)
+                                        : task_queue_->extract(task_id);
+            if (task) {
+                deadline = task->deadline;
             }
+        } else if (auto entry = lockfree_queue_->extract(task_id)) {
+            std::unique_ptr<ScheduledTask> record(static_cast<ScheduledTask*>(entry->task_context));
+            deadline = record->deadline;
+        }
 
-            if (stop_requested_.load(std::memory_order_acquire)) {
-                break;
+        if (deadline && demand_) {
+            demand_->remove(*deadline);
+        }
+        return deadline.has_value();
+    }
+
+    size_t queue_size() const noexcept {
+        if (stealing_queue_) {
+            return stealing_queue_->size();
+        }
+        return lockfree_queue_ ? lockfree_queue_->size() : task_queue_->size();
+    }
+
+    bool queue_empty() const {
+        if (stealing_queue_) {
+            return stealing_queue_->empty();
+        }
+        return lockfree_queue_ ? lockfree_queue_->empty() : task_queue_->empty();
+    }
+
+    /**
+     * @brief EDF admission test
+     *
+     * Lower-bounds the work due before the task's deadline; if even that,
+     * shared over all workers, plus the task itself overruns the deadline
+     * at the average measured execution time, the task cannot make it.
+     */
+    bool admissible(const ScheduledTask& task) const {
+        auto exec_ns = avg_execution_ns_.load(std::memory_order_relaxed);
+        if (exec_ns <= 0) {
+            return true;  // Nothing measured yet
+        }
+
+        auto ahead  = demand_->count_before(task.deadline, task.arrival_time);
+        auto rounds = static_cast<int64_t>(ahead / std::max<size_t>(config_.worker_threads, 1)) + 1;
+        return task.arrival_time + std::chrono::nanoseconds(rounds * exec_ns) <= task.deadline;
+    }
+
+    void wake_all_workers() {
+        if (stealing_queue_) {
+            stealing_queue_->wake_all();
+        }
+        task_cv_.notify_all();
+    }
+
+    /// Sleep until a task is submitted, the scheduler stops or check_interval passes
+    void wait_for_work(size_t worker_id) {
+        if (stealing_queue_) {
+            if (!stop_requested_.load(std::memory_order_acquire)) {
+                stealing_queue_->wait(worker_id, config_.check_interval);
             }
+            return;
+        }
+
+        std::unique_lock lock(task_mutex_);
+        idle_workers_.fetch_add(1, std::memory_order_seq_cst);
+        task_cv_.wait_for(lock, config_.check_interval, [this]() {
+            return stop_requested_.load(std::memory_order_acquire) || !queue_empty();
+        });
+        idle_workers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // ========================================================================
+    // Workers
+    // ========================================================================
+
+    void worker_loop(size_t worker_id) {
+        IPB_LOG_DEBUG(LOG_CAT, "Worker " << worker_id << " started");
+
+        t_scheduler = this;
+        t_worker    = worker_id;
 
-            // Try to get a task
-            if (!task_queue_.try_pop(task)) {
+        while (!stop_requested_.load(std::memory_order_acquire)) {
+            ScheduledTask task;
+
+            // Only sleep when there is nothing to run
+            if (!dequeue(task, worker_id)) {
+                wait_for_work(worker_id);
                 continue;
             }
 
-            stats_.current_queue_size.store(task_queue_.size(), std::memory_order_relaxed);
+            stats_.current_queue_size.store(queue_size(), std::memory_order_relaxed);
 
             IPB_LOG_TRACE(LOG_CAT, "Worker " << worker_id << " executing task " << task.id);
 
@@ -380,6 +620,7 @@ private:
 
             auto exec_time      = exec_timer.elapsed();
             task.execution_time = exec_time;
+            update_average_execution(exec_time.count());
 
             // Check if deadline was met
             auto finish_time  = common::Timestamp::now();
@@ -413,49 +654,160 @@ private:
             record_completed(task.id, task.state);
         }
 
+        t_scheduler = nullptr;
+        t_worker    = WorkStealingTaskQueue::NO_WORKER;
+
         IPB_LOG_DEBUG(LOG_CAT, "Worker " << worker_id << " stopped");
     }
 
-    void deadline_check_loop() {
-        while (!stop_requested_.load(std::memory_order_acquire)) {
-            std::this_thread::sleep_for(config_.check_interval);
+    // ========================================================================
+    // Periodic Tasks
+    // ========================================================================
+
+    // Periodic tasks are released on their period grid by the timer thread.
+    // Each entry embeds its wheel timer and lives on the heap until no
+    // instance refers to it, so a release neither allocates nor copies the
+    // task function: the queued instance only carries a pointer to the entry.
+    struct PeriodicTask : TimerNode {
+        uint64_t id = 0;
+        std::function<void()> task_function;
+        std::chrono::nanoseconds period{0};
+        TaskPriority priority = TaskPriority::NORMAL;
+
+        common::Timestamp release;  // Scheduled release of the current instance
+        std::atomic<bool> active{true};
+        std::atomic<bool> in_flight{false};  // Instance queued or running
+        bool submitting = false;             // Release being submitted (timer_mutex_)
+
+        std::atomic<uint64_t> releases{0};
+        std::atomic<uint64_t> started{0};
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<int64_t> last_jitter_ns{0};
+        std::atomic<int64_t> max_jitter_ns{0};
+        std::atomic<int64_t> total_jitter_ns{0};
+    };
 
-            // Check for imminent deadlines and wake workers if needed
-            auto nearest = task_queue_.nearest_deadline();
-            if (nearest) {
-                auto now        = common::Timestamp::now();
-                auto time_until = *nearest - now;
+    /**
+     * Claim the release due at @p release and re-arm the entry's timer for
+     * the next one. A release is skipped while the previous instance is
+     * unfinished, so slow tasks do not pile up. Requires timer_mutex_.
+     */
+    bool claim_release(PeriodicTask& periodic, common::Timestamp release,
+                       common::Timestamp now) {
+        bool claimed = !periodic.in_flight.exchange(true, std::memory_order_acq_rel);
+        if (claimed) {
+            periodic.release    = release;
+            periodic.submitting = true;
+        } else {
+            periodic.skipped.fetch_add(1, std::memory_order_relaxed);
+        }
 
-                if (time_until.count() < config_.check_interval.count() * 1000) {
-                    // Deadline is soon - make sure workers are awake
-                    task_cv_.notify_all();
-                }
-            }
+        // Stay on the period grid; drop releases the timer fell behind on
+        auto next = release + periodic.period;
+        while (next <= now) {
+            next = next + periodic.period;
+            periodic.skipped.fetch_add(1, std::memory_order_relaxed);
         }
+        timer_wheel_.arm(periodic, next);
+        return claimed;
     }
 
-    void schedule_periodic_instance(uint64_t periodic_id) {
-        std::shared_lock lock(periodic_mutex_);
+    /// Submit a claimed release; called without timer_mutex_
+    bool submit_release(PeriodicTask& periodic) {
+        ScheduledTask task;
+        task.deadline = periodic.release + periodic.period;
+        task.priority = periodic.priority;
 
-        auto it = periodic_tasks_.find(periodic_id);
-        if (it == periodic_tasks_.end() || !it->second.active) {
-            return;
+        // Small enough for std::function's inline storage
+        task.task_function       = [this, entry = &periodic]() { run_periodic(*entry); };
+        task.completion_callback = [entry = &periodic](TaskState, std::chrono::nanoseconds) {
+            entry->in_flight.store(false, std::memory_order_release);
+        };
+        return submit(std::move(task)).success;
+    }
+
+    /// Account for a submitted release. Requires timer_mutex_.
+    void finish_release(PeriodicTask& periodic, bool submitted) {
+        if (submitted) {
+            periodic.releases.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            periodic.skipped.fetch_add(1, std::memory_order_relaxed);
+            periodic.in_flight.store(false, std::memory_order_release);
         }
+        periodic.submitting = false;
+    }
 
-        auto& periodic = it->second;
-        auto deadline  = common::Timestamp::now() + periodic.period;
+    void run_periodic(PeriodicTask& periodic) {
+        if (IPB_UNLIKELY(!periodic.active.load(std::memory_order_acquire))) {
+            return;  // Cancelled while queued
+        }
 
-        // Create task that reschedules itself
-        ScheduledTask task;
-        task.deadline      = deadline;
-        task.priority      = periodic.priority;
-        task.task_function = [this, periodic_id, func = periodic.task_function]() {
-            func();
-            schedule_periodic_instance(periodic_id);  // Reschedule
-        };
+        auto jitter = (common::Timestamp::now() - periodic.release).count();
+        periodic.started.fetch_add(1, std::memory_order_relaxed);
+        periodic.last_jitter_ns.store(jitter, std::memory_order_relaxed);
+        periodic.total_jitter_ns.fetch_add(jitter, std::memory_order_relaxed);
+
+        int64_t current_max = periodic.max_jitter_ns.load(std::memory_order_relaxed);
+        while (jitter > current_max &&
+               !periodic.max_jitter_ns.compare_exchange_weak(current_max, jitter)) {}
+
+        periodic.task_function();
+    }
+
+    /// Free cancelled entries no instance refers to any more. Requires timer_mutex_.
+    void reclaim_periodic() {
+        std::erase_if(retired_periodic_, [](const auto& periodic) {
+            return !periodic->submitting &&
+                   !periodic->in_flight.load(std::memory_order_acquire);
+        });
+    }
+
+    struct DueRelease {
+        PeriodicTask* periodic;
+        bool submitted;
+    };
+
+    /// Sleep until the next timer expires, then release the periodic tasks it fires
+    void timer_loop() {
+        // Reused across wakeups, so steady-state releases do not allocate
+        std::vector<DueRelease> due;
+
+        std::unique_lock lock(timer_mutex_);
+        while (!stop_requested_.load(std::memory_order_acquire)) {
+            auto now = common::Timestamp::now();
+            timer_wheel_.advance(now, [&](TimerNode& node) {
+                auto& periodic = static_cast<PeriodicTask&>(node);
+                if (claim_release(periodic, periodic.expiry(), now)) {
+                    due.push_back({&periodic, false});
+                }
+            });
 
-        lock.unlock();
-        submit(std::move(task));
+            if (!due.empty()) {
+                // Submit outside the lock; callbacks may call back into the scheduler
+                lock.unlock();
+                for (auto& release : due) {
+                    release.submitted = submit_release(*release.periodic);
+                }
+                lock.lock();
+
+                for (const auto& release : due) {
+                    finish_release(*release.periodic, release.submitted);
+                }
+                due.clear();
+            }
+            reclaim_periodic();
+
+            auto next = timer_wheel_.next_expiry();
+            auto wait = next ? *next - common::Timestamp::now() : TIMER_IDLE_WAIT;
+            if (wait.count() > 0) {
+                timer_cv_.wait_for(lock, wait);
+            }
+        }
+    }
+
+    void wake_timer_thread() {
+        { std::lock_guard lock(timer_mutex_); }
+        timer_cv_.notify_all();
     }
 
     void update_latency_stats(int64_t latency_ns) {
@@ -482,6 +834,13 @@ private:
                !stats_.max_execution_ns.compare_exchange_weak(current_max, exec_ns)) {}
     }
 
+    /// Moving average (1/8 weight) feeding the admission test
+    void update_average_execution(int64_t exec_ns) {
+        auto average = avg_execution_ns_.load(std::memory_order_relaxed);
+        avg_execution_ns_.store(average == 0 ? exec_ns : average + (exec_ns - average) / 8,
+                                std::memory_order_relaxed);
+    }
+
     void record_completed(uint64_t task_id, TaskState state) {
         std::lock_guard lock(completed_mutex_);
 
@@ -499,26 +858,30 @@ private:
     std::atomic<bool> running_{false};
     std::atomic<bool> stop_requested_{false};
 
-    TaskQueue task_queue_;
+    // Exactly one of these, per config_.queue_backend
+    std::unique_ptr<TaskQueue> task_queue_;
+    std::unique_ptr<common::LockFreeTaskQueue> lockfree_queue_;
+    std::unique_ptr<WorkStealingTaskQueue> stealing_queue_;
+
+    // Admission control (only with config_.admission_control)
+    std::unique_ptr<DeadlineDemand> demand_;
+    std::atomic<int64_t> avg_execution_ns_{0};
     std::atomic<uint64_t> next_task_id_{1};
 
     std::vector<std::thread> workers_;
     std::mutex task_mutex_;
     std::condition_variable task_cv_;
-
-    std::thread deadline_checker_;
-
-    // Periodic tasks
-    struct PeriodicTask {
-        uint64_t id;
-        std::function<void()> task_function;
-        std::chrono::nanoseconds period;
-        TaskPriority priority;
-        bool active;
-    };
-    mutable std::shared_mutex periodic_mutex_;
-    std::unordered_map<uint64_t, PeriodicTask> periodic_tasks_;
+    std::atomic<size_t> idle_workers_{0};
+
+    // Periodic tasks and the timer wheel releasing them
+    static constexpr std::chrono::nanoseconds TIMER_IDLE_WAIT = std::chrono::seconds(1);
+    mutable std::mutex timer_mutex_;
+    std::condition_variable timer_cv_;
+    TimerWheel timer_wheel_;
+    std::unordered_map<uint64_t, std::unique_ptr<PeriodicTask>> periodic_tasks_;
+    std::vector<std::unique_ptr<PeriodicTask>> retired_periodic_;
     std::atomic<uint64_t> next_periodic_id_{1};
+    std::thread timer_thread_;
 
     // Completed task states
     mutable std::mutex completed_mutex_;
@@ -599,6 +962,10 @@ bool EDFScheduler::cancel_periodic(uint64_t periodic_id) {
     return impl_->cancel_periodic(periodic_id);
 }
 
+std::optional<PeriodicTaskStats> EDFScheduler::periodic_stats(uint64_t periodic_id) const {
+    return impl_->periodic_stats(periodic_id);
+}
+
 bool EDFScheduler::cancel(uint64_t task_id) {
     return impl_->cancel(task_id);
 }
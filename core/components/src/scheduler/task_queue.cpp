@@ -1,6 +1,7 @@
 #include "ipb/core/scheduler/task_queue.hpp"
 
 #include <algorithm>
+#include <limits>
 
 namespace ipb::core {
 
@@ -53,19 +54,23 @@ bool TaskQueue::peek(ScheduledTask& task) const {
 }
 
 bool TaskQueue::remove(uint64_t task_id) {
+    return extract(task_id).has_value();
+}
+
+std::optional<ScheduledTask> TaskQueue::extract(uint64_t task_id) {
     std::lock_guard lock(mutex_);
 
     // Unfortunately, std::priority_queue doesn't support removal
     // We need to rebuild the queue without the target task
     std::vector<ScheduledTask> tasks;
-    bool found = false;
+    std::optional<ScheduledTask> found;
 
     while (!queue_.empty()) {
         auto task = std::move(const_cast<ScheduledTask&>(queue_.top()));
         queue_.pop();
 
-        if (task.id == task_id) {
-            found = true;
+        if (!found && task.id == task_id) {
+            found = std::move(task);
         } else {
             tasks.push_back(std::move(task));
         }
@@ -106,4 +111,255 @@ std::optional<common::Timestamp> TaskQueue::nearest_deadline() const {
     return queue_.top().deadline;
 }
 
+// ============================================================================
+// WorkStealingTaskQueue
+// ============================================================================
+
+struct alignas(64) WorkStealingTaskQueue::Local {
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    // Min-heap on deadline (std::greater), guarded by mutex
+    std::vector<ScheduledTask> heap;
+
+    // Deadline at the top of the heap, readable without the lock (INT64_MAX if empty)
+    std::atomic<int64_t> head_deadline{std::numeric_limits<int64_t>::max()};
+
+    std::atomic<bool> idle{false};
+    bool wake = false;  // Guarded by mutex
+
+    void update_head() noexcept {
+        head_deadline.store(heap.empty() ? std::numeric_limits<int64_t>::max()
+                                         : heap.front().deadline.nanoseconds(),
+                            std::memory_order_release);
+    }
+};
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(size_t workers, size_t max_size)
+    : max_size_(max_size) {
+    locals_.reserve(std::max<size_t>(workers, 1));
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); ++i) {
+        locals_.push_back(std::make_unique<Local>());
+    }
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+bool WorkStealingTaskQueue::push(ScheduledTask task, size_t worker) {
+    // Reserve the slot first so size() covers every task a worker could find
+    if (size_.fetch_add(1, std::memory_order_seq_cst) >= max_size_) {
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto& local = *locals_[pick_worker(worker)];
+    {
+        std::lock_guard lock(local.mutex);
+        local.heap.push_back(std::move(task));
+        std::push_heap(local.heap.begin(), local.heap.end(), std::greater<ScheduledTask>{});
+        local.update_head();
+    }
+    if (local.idle.load(std::memory_order_seq_cst)) {
+        local.cv.notify_one();
+    }
+    return true;
+}
+
+size_t WorkStealingTaskQueue::pick_worker(size_t hint) noexcept {
+    const size_t count = locals_.size();
+    if (hint < count) {
+        return hint;
+    }
+
+    size_t start = next_worker_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        size_t candidate = (start + i) % count;
+        if (locals_[candidate]->idle.load(std::memory_order_seq_cst)) {
+            return candidate;
+        }
+    }
+    return start % count;
+}
+
+bool WorkStealingTaskQueue::pop_local(Local& local, ScheduledTask& task) {
+    std::lock_guard lock(local.mutex);
+    if (local.heap.empty()) {
+        return false;
+    }
+
+    std::pop_heap(local.heap.begin(), local.heap.end(), std::greater<ScheduledTask>{});
+    task = std::move(local.heap.back());
+    local.heap.pop_back();
+    local.update_head();
+
+    size_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool WorkStealingTaskQueue::pop(size_t worker, ScheduledTask& task) {
+    if (pop_local(*locals_[worker], task)) {
+        return true;
+    }
+    return steal(worker, task);
+}
+
+bool WorkStealingTaskQueue::steal(size_t thief, ScheduledTask& task) {
+    const size_t count = locals_.size();
+
+    // A victim can drain between the scan and the lock; rescan a few times
+    for (size_t attempt = 0; attempt < count; ++attempt) {
+        size_t victim    = thief;
+        int64_t earliest = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < count; ++i) {
+            if (i == thief) {
+                continue;
+            }
+            auto deadline = locals_[i]->head_deadline.load(std::memory_order_acquire);
+            if (deadline < earliest) {
+                earliest = deadline;
+                victim   = i;
+            }
+        }
+
+        if (victim == thief) {
+            return false;  // Nothing to steal
+        }
+        if (pop_local(*locals_[victim], task)) {
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingTaskQueue::pop_any(ScheduledTask& task) {
+    for (auto& local : locals_) {
+        if (pop_local(*local, task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::optional<ScheduledTask> WorkStealingTaskQueue::extract(uint64_t task_id) {
+    for (auto& local : locals_) {
+        std::lock_guard lock(local->mutex);
+        auto it = std::find_if(local->heap.begin(), local->heap.end(),
+                               [task_id](const ScheduledTask& t) { return t.id == task_id; });
+        if (it == local->heap.end()) {
+            continue;
+        }
+
+        std::optional<ScheduledTask> task(std::move(*it));
+        local->heap.erase(it);
+        std::make_heap(local->heap.begin(), local->heap.end(), std::greater<ScheduledTask>{});
+        local->update_head();
+        size_.fetch_sub(1, std::memory_order_release);
+        return task;
+    }
+    return std::nullopt;
+}
+
+void WorkStealingTaskQueue::wait(size_t worker, std::chrono::nanoseconds timeout) {
+    auto& local = *locals_[worker];
+    std::unique_lock lock(local.mutex);
+
+    // Announce idleness before the final check, so a push either sees the
+    // flag and notifies, or is already visible in size()
+    local.idle.store(true, std::memory_order_seq_cst);
+    if (size_.load(std::memory_order_seq_cst) == 0) {
+        local.cv.wait_for(lock, timeout, [&local] { return local.wake || !local.heap.empty(); });
+    }
+    local.wake = false;
+    local.idle.store(false, std::memory_order_relaxed);
+}
+
+void WorkStealingTaskQueue::wake_all() {
+    for (auto& local : locals_) {
+        {
+            std::lock_guard lock(local->mutex);
+            local->wake = true;
+        }
+        local->cv.notify_all();
+    }
+}
+
+std::optional<common::Timestamp> WorkStealingTaskQueue::nearest_deadline() const {
+    int64_t earliest = std::numeric_limits<int64_t>::max();
+    for (const auto& local : locals_) {
+        earliest = std::min(earliest, local->head_deadline.load(std::memory_order_acquire));
+    }
+
+    if (earliest == std::numeric_limits<int64_t>::max()) {
+        return std::nullopt;
+    }
+    return common::Timestamp(std::chrono::nanoseconds(earliest));
+}
+
+// ============================================================================
+// DeadlineDemand
+// ============================================================================
+
+DeadlineDemand::DeadlineDemand(std::chrono::nanoseconds slot_width)
+    : width_ns_(std::max<int64_t>(slot_width.count(), 1)) {}
+
+int64_t DeadlineDemand::slot_of(common::Timestamp t) const noexcept {
+    return t.nanoseconds() / width_ns_;
+}
+
+void DeadlineDemand::add(common::Timestamp deadline, common::Timestamp now) noexcept {
+    auto slot     = slot_of(deadline);
+    auto now_slot = slot_of(now);
+    if (slot < now_slot || slot - now_slot >= static_cast<int64_t>(BUCKETS)) {
+        return;  // Outside the horizon: not counted
+    }
+
+    auto& bucket = buckets_[static_cast<size_t>(slot) % BUCKETS];
+    auto tag     = tag_of(slot);
+    auto current = bucket.load(std::memory_order_relaxed);
+    while (true) {
+        uint64_t next;
+        if ((current & ~COUNT_MASK) != tag) {
+            next = tag | 1;  // Recycle a bucket left over from an earlier slot
+        } else if ((current & COUNT_MASK) == COUNT_MASK) {
+            return;  // Saturated
+        } else {
+            next = current + 1;
+        }
+        if (bucket.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+void DeadlineDemand::remove(common::Timestamp deadline) noexcept {
+    auto slot    = slot_of(deadline);
+    auto& bucket = buckets_[static_cast<size_t>(slot) % BUCKETS];
+    auto tag     = tag_of(slot);
+
+    // Tasks that were never counted, or whose bucket was recycled, are ignored
+    auto current = bucket.load(std::memory_order_relaxed);
+    while ((current & ~COUNT_MASK) == tag && (current & COUNT_MASK) > 0) {
+        if (bucket.compare_exchange_weak(current, current - 1, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+uint64_t DeadlineDemand::count_before(common::Timestamp deadline,
+                                      common::Timestamp now) const noexcept {
+    // The deadline's own slot may hold tasks due after it, which EDF runs later
+    auto now_slot = slot_of(now);
+    auto end      = std::min(slot_of(deadline), now_slot + static_cast<int64_t>(BUCKETS));
+
+    uint64_t count = 0;
+    for (auto slot = now_slot; slot < end; ++slot) {
+        auto value = buckets_[static_cast<size_t>(slot) % BUCKETS].load(std::memory_order_relaxed);
+        if ((value & ~COUNT_MASK) == tag_of(slot)) {
+            count += value & COUNT_MASK;
+        }
+    }
+    return count;
+}
+
 }  // namespace ipb::core
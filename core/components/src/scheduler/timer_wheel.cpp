@@ -0,0 +1,118 @@
+#include "ipb/core/scheduler/timer_wheel.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace ipb::core {
+
+namespace {
+
+constexpr uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+
+}  // anonymous namespace
+
+// ============================================================================
+// TimerWheel Implementation
+// ============================================================================
+
+TimerWheel::TimerWheel(std::chrono::nanoseconds tick, common::Timestamp now)
+    : tick_ns_(std::max<int64_t>(tick.count(), 1)), current_(0) {
+    current_ = tick_of(now);
+}
+
+uint64_t TimerWheel::tick_of(common::Timestamp t) const noexcept {
+    return static_cast<uint64_t>(std::max<int64_t>(t.nanoseconds(), 0) / tick_ns_);
+}
+
+void TimerWheel::arm(TimerNode& node, common::Timestamp expiry) noexcept {
+    cancel(node);
+
+    // Round up so a timer never fires before its expiry
+    auto ns           = std::max<int64_t>(expiry.nanoseconds(), 0);
+    node.expiry_      = expiry;
+    node.expiry_tick_ = static_cast<uint64_t>((ns + tick_ns_ - 1) / tick_ns_);
+    link(node);
+    ++size_;
+}
+
+void TimerWheel::cancel(TimerNode& node) noexcept {
+    if (!node.armed()) {
+        return;
+    }
+    *node.pprev_ = node.next_;
+    if (node.next_ != nullptr) {
+        node.next_->pprev_ = node.pprev_;
+    }
+    node.next_  = nullptr;
+    node.pprev_ = nullptr;
+    --size_;
+}
+
+void TimerWheel::link(TimerNode& node) noexcept {
+    // Already due: fire on the next tick
+    uint64_t expiry = std::max(node.expiry_tick_, current_ + 1);
+    uint64_t delta  = expiry - current_;
+
+    size_t level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+
+    // Beyond the wheel's span: park in the farthest top-level slot
+    constexpr uint64_t span = uint64_t{1} << (SLOT_BITS * LEVELS);
+    if (delta >= span) {
+        expiry = current_ + span - 1;
+    }
+
+    auto& head  = slots_[level][(expiry >> (SLOT_BITS * level)) & (SLOTS - 1)];
+    node.next_  = head;
+    node.pprev_ = &head;
+    if (head != nullptr) {
+        head->pprev_ = &node.next_;
+    }
+    head = &node;
+}
+
+void TimerWheel::cascade(size_t level) noexcept {
+    auto& slot      = slots_[level][(current_ >> (SLOT_BITS * level)) & (SLOTS - 1)];
+    TimerNode* node = slot;
+    slot            = nullptr;
+
+    while (node != nullptr) {
+        TimerNode* next = node->next_;
+        link(*node);
+        node = next;
+    }
+}
+
+uint64_t TimerWheel::next_tick() const noexcept {
+    if (size_ == 0) {
+        return NO_TICK;
+    }
+
+    uint64_t best = NO_TICK;
+    for (size_t level = 0; level < LEVELS; ++level) {
+        const unsigned shift = SLOT_BITS * static_cast<unsigned>(level);
+        const uint64_t pos   = current_ >> shift;
+
+        // A slot is processed when the clock reaches its start; the current
+        // slot of an upper level comes round again after a full turn
+        for (uint64_t k = 1; k <= SLOTS; ++k) {
+            if (slots_[level][(pos + k) & (SLOTS - 1)] != nullptr) {
+                best = std::min(best, (pos + k) << shift);
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+std::optional<common::Timestamp> TimerWheel::next_expiry() const noexcept {
+    auto tick = next_tick();
+    if (tick == NO_TICK) {
+        return std::nullopt;
+    }
+    return common::Timestamp(std::chrono::nanoseconds(static_cast<int64_t>(tick) * tick_ns_));
+}
+
+}  // namespace ipb::core
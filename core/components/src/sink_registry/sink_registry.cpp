@@ -17,8 +17,57 @@ using namespace common::debug;
 
 namespace {
 constexpr std::string_view LOG_CAT = category::ROUTER;  // Sinks are part of routing
+
+/// Lets sinks_ be searched by string_view without building a std::string
+struct SinkIdHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const noexcept {
+        return std::hash<std::string_view>{}(s);
+    }
+};
 }  // anonymous namespace
 
+// ============================================================================
+// SinkIdInterner Implementation
+// ============================================================================
+
+SinkHandle SinkIdInterner::intern(std::string_view id) {
+    {
+        std::shared_lock lock(mutex_);
+        auto it = handles_.find(id);
+        if (it != handles_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(mutex_);
+    auto it = handles_.find(id);
+    if (it != handles_.end()) {
+        return it->second;
+    }
+
+    auto handle = static_cast<SinkHandle>(ids_.size());
+    ids_.emplace_back(id);
+    handles_.emplace(ids_.back(), handle);
+    return handle;
+}
+
+SinkHandle SinkIdInterner::find(std::string_view id) const {
+    std::shared_lock lock(mutex_);
+    auto it = handles_.find(id);
+    return it != handles_.end() ? it->second : INVALID_SINK_HANDLE;
+}
+
+std::string_view SinkIdInterner::id(SinkHandle handle) const {
+    std::shared_lock lock(mutex_);
+    return handle < ids_.size() ? std::string_view(ids_[handle]) : std::string_view{};
+}
+
+size_t SinkIdInterner::size() const {
+    std::shared_lock lock(mutex_);
+    return ids_.size();
+}
+
 // ============================================================================
 // SinkRegistryImpl - Private Implementation
 // ============================================================================
@@ -95,6 +144,8 @@ public:
         info->type   = std::string(info->sink->sink_type());
         info->health = SinkHealth::UNKNOWN;
 
+        interner_->intern(id_str);
+
         // Capture type before moving info
         std::string sink_type = info->type;
         sinks_[id_str]        = std::move(info);
@@ -110,7 +161,7 @@ public:
 
         std::unique_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (IPB_UNLIKELY(it == sinks_.end())) {
             IPB_LOG_WARN(LOG_CAT, "Cannot unregister unknown sink: " << id);
             return false;
@@ -123,15 +174,17 @@ public:
         return true;
     }
 
+    const std::shared_ptr<SinkIdInterner>& interner() const noexcept { return interner_; }
+
     bool has_sink(std::string_view id) const {
         std::shared_lock lock(sinks_mutex_);
-        return sinks_.find(std::string(id)) != sinks_.end();
+        return sinks_.find(id) != sinks_.end();
     }
 
     std::shared_ptr<common::IIPBSink> get_sink(std::string_view id) {
         std::shared_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (it == sinks_.end()) {
             return nullptr;
         }
@@ -142,7 +195,7 @@ public:
     std::optional<SinkInfo> get_sink_info(std::string_view id) const {
         std::shared_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (it == sinks_.end()) {
             return std::nullopt;
         }
@@ -183,7 +236,7 @@ public:
     bool set_sink_enabled(std::string_view id, bool enabled) {
         std::shared_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (it == sinks_.end()) {
             return false;
         }
@@ -195,7 +248,7 @@ public:
     bool set_sink_weight(std::string_view id, uint32_t weight) {
         std::shared_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (it == sinks_.end()) {
             return false;
         }
@@ -207,7 +260,7 @@ public:
     bool set_sink_priority(std::string_view id, uint32_t priority) {
         std::shared_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (it == sinks_.end()) {
             return false;
         }
@@ -345,7 +398,7 @@ public:
         {
             std::shared_lock lock(sinks_mutex_);
 
-            auto it = sinks_.find(std::string(sink_id));
+            auto it = sinks_.find(sink_id);
             if (IPB_UNLIKELY(it == sinks_.end())) {
                 IPB_LOG_WARN(LOG_CAT, "Write to unknown sink: " << sink_id);
                 return common::Result<>(common::ErrorCode::INVALID_ARGUMENT, "Sink not found");
@@ -390,7 +443,7 @@ public:
         {
             std::shared_lock lock(sinks_mutex_);
 
-            auto it = sinks_.find(std::string(sink_id));
+            auto it = sinks_.find(sink_id);
             if (it == sinks_.end()) {
                 return common::Result<>(common::ErrorCode::INVALID_ARGUMENT, "Sink not found");
             }
@@ -456,7 +509,7 @@ public:
     SinkHealth get_sink_health(std::string_view id) const {
         std::shared_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (it == sinks_.end()) {
             return SinkHealth::UNKNOWN;
         }
@@ -470,7 +523,7 @@ public:
         {
             std::shared_lock lock(sinks_mutex_);
 
-            auto it = sinks_.find(std::string(id));
+            auto it = sinks_.find(id);
             if (it == sinks_.end()) {
                 return SinkHealth::UNKNOWN;
             }
@@ -525,7 +578,7 @@ public:
     void mark_sink_unhealthy(std::string_view id, std::string_view reason) {
         std::shared_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (it != sinks_.end()) {
             it->second->health            = SinkHealth::UNHEALTHY;
             it->second->health_message    = std::string(reason);
@@ -538,7 +591,7 @@ public:
     void mark_sink_healthy(std::string_view id) {
         std::shared_lock lock(sinks_mutex_);
 
-        auto it = sinks_.find(std::string(id));
+        auto it = sinks_.find(id);
         if (it != sinks_.end()) {
             it->second->health = SinkHealth::HEALTHY;
             it->second->health_message.clear();
@@ -646,11 +699,13 @@ private:
     SinkRegistryConfig config_;
     SinkRegistryStats stats_;
 
+    std::shared_ptr<SinkIdInterner> interner_ = std::make_shared<SinkIdInterner>();
+
     std::atomic<bool> running_{false};
     std::atomic<bool> stop_requested_{false};
 
     mutable std::shared_mutex sinks_mutex_;
-    std::unordered_map<std::string, std::shared_ptr<SinkInfo>> sinks_;
+    std::unordered_map<std::string, std::shared_ptr<SinkInfo>, SinkIdHash, std::equal_to<>> sinks_;
 
     std::unordered_map<LoadBalanceStrategy, std::unique_ptr<ILoadBalancer>> balancers_;
 
@@ -716,6 +771,18 @@ size_t SinkRegistry::sink_count() const noexcept {
     return impl_->sink_count();
 }
 
+SinkHandle SinkRegistry::intern_sink_id(std::string_view id) {
+    return impl_->interner()->intern(id);
+}
+
+std::string_view SinkRegistry::sink_id(SinkHandle handle) const {
+    return impl_->interner()->id(handle);
+}
+
+std::shared_ptr<SinkIdInterner> SinkRegistry::sink_interner() const noexcept {
+    return impl_->interner();
+}
+
 bool SinkRegistry::set_sink_enabled(std::string_view id, bool enabled) {
     return impl_->set_sink_enabled(id, enabled);
 }
@@ -0,0 +1,258 @@
+#pragma once
+
+/**
+ * @file micro_batcher.hpp
+ * @brief Per-rule micro-batching stage between rule matching and sink writes
+ *
+ * Routing rules with batching enabled do not write each matched data point
+ * to its sink. Points are collected per (rule, target sink) and written
+ * with a single write_batch() once either:
+ * - batch_size points have been collected, or
+ * - the oldest collected point has waited batch_timeout
+ *
+ * Timeouts are handled by a flusher thread that sleeps until the earliest
+ * pending batch deadline (never sooner than one flush interval after its
+ * previous check) and parks while nothing is pending, so a batch may wait up
+ * to batch_timeout plus one interval. Batches of one (rule, sink) reach the
+ * sink in the order they were taken, whichever thread flushes them.
+ *
+ * Each rule records how full its batches were when flushed (batch-fill
+ * histogram), which shows whether batch_size and batch_timeout fit the
+ * actual traffic.
+ */
+
+#include <ipb/common/data_point.hpp>
+#include <ipb/common/metrics.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ipb::router {
+
+/**
+ * @brief Batching parameters of one routing rule
+ */
+struct BatchPolicy {
+    uint32_t batch_size = 100;                   ///< Flush once this many points are pending
+    std::chrono::milliseconds batch_timeout{10};  ///< Flush once the oldest point waited this long
+};
+
+/**
+ * @brief Snapshot of one rule's batching statistics
+ */
+struct RuleBatchingStats {
+    uint32_t rule_id = 0;
+    BatchPolicy policy;
+
+    uint64_t batches_flushed  = 0;
+    uint64_t messages_batched = 0;  ///< Points written through flushed batches
+    uint64_t size_flushes     = 0;  ///< Flushed because batch_size was reached
+    uint64_t timeout_flushes  = 0;  ///< Flushed because batch_timeout expired
+    uint64_t failed_batches   = 0;  ///< Batches the sink write rejected
+    size_t pending            = 0;  ///< Points currently waiting
+
+    /// Upper bounds of the fill-ratio buckets (points / batch_size)
+    std::vector<double> fill_buckets;
+    /// Cumulative batch count per bucket; the last entry is +Inf
+    std::vector<uint64_t> fill_counts;
+
+    double avg_fill_ratio() const noexcept {
+        return batches_flushed > 0 && policy.batch_size > 0
+                 ? static_cast<double>(messages_batched) /
+                       (static_cast<double>(batches_flushed) * policy.batch_size)
+                 : 0.0;
+    }
+};
+
+/**
+ * @brief Collects matched data points per (rule, sink) and writes them in batches
+ *
+ * Thread-safe. Each rule has its own lock; adding points for different
+ * rules never contends. Sink writes always happen outside the locks, in
+ * ticket order per (rule, sink).
+ */
+class MicroBatcher {
+public:
+    /**
+     * @brief Writes one batch to a sink
+     * @return true if the sink accepted the batch
+     */
+    using WriteFn = std::function<bool(std::string_view sink_id,
+                                       std::span<const common::DataPoint> batch)>;
+
+    /// Fill-ratio bucket bounds shared by every rule's histogram
+    static const std::vector<double> FILL_BUCKETS;
+
+    /**
+     * @param write Called for every flushed batch, on the adding thread for
+     *              size-triggered flushes and on the flusher thread otherwise
+     * @param flush_interval Minimum time between two timeout checks of the flusher thread
+     */
+    explicit MicroBatcher(WriteFn write,
+                          std::chrono::milliseconds flush_interval = std::chrono::milliseconds(1));
+    ~MicroBatcher();
+
+    MicroBatcher(const MicroBatcher&)            = delete;
+    MicroBatcher& operator=(const MicroBatcher&) = delete;
+
+    // Rule policies
+
+    /// Enable batching for a rule, or change its policy (pending points are flushed first)
+    void set_policy(uint32_t rule_id, BatchPolicy policy);
+
+    /// Disable batching for a rule; pending points are flushed
+    void remove_policy(uint32_t rule_id);
+
+    /// Policy of a rule, if batching is enabled for it
+    std::optional<BatchPolicy> policy(uint32_t rule_id) const;
+
+    /// True if any rule has batching enabled (cheap check for the routing hot path)
+    bool has_policies() const noexcept {
+        return rule_count_.load(std::memory_order_acquire) != 0;
+    }
+
+    // Data path
+
+    /**
+     * @brief Queue a point for a rule's batch to a sink
+     * @return false if batching is not enabled for rule_id (nothing queued)
+     */
+    bool add(uint32_t rule_id, std::string_view sink_id, const common::DataPoint& dp);
+
+    /// Flush every batch whose oldest point has waited at least its rule's timeout
+    void flush_expired();
+
+    /// Flush every pending batch
+    void flush_all();
+
+    // Flusher thread
+
+    /// Start the timeout flusher thread
+    void start();
+
+    /// Stop the flusher thread and flush everything still pending
+    void stop();
+
+    bool is_running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    // Statistics
+
+    std::vector<RuleBatchingStats> stats() const;
+    std::optional<RuleBatchingStats> stats(uint32_t rule_id) const;
+
+    /// Total batches flushed across all rules
+    uint64_t batches_flushed() const noexcept {
+        return batches_flushed_.load(std::memory_order_relaxed);
+    }
+
+    /// Total points written through batches across all rules
+    uint64_t messages_batched() const noexcept {
+        return messages_batched_.load(std::memory_order_relaxed);
+    }
+
+    void reset_stats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    /// Batch being collected for one sink; nodes are never erased, so their address is stable
+    struct PendingBatch {
+        std::vector<common::DataPoint> points;
+        Clock::time_point opened;
+        uint64_t next_ticket = 0;          ///< Next write ticket (under the rule lock)
+        std::atomic<uint64_t> serving{0};  ///< Ticket allowed to write next
+    };
+
+    struct RuleState {
+        RuleState(uint32_t id, BatchPolicy p);
+
+        const uint32_t rule_id;
+        const BatchPolicy policy;
+
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, PendingBatch, StringHash, std::equal_to<>> pending;
+        size_t pending_points = 0;
+        bool retired          = false;  ///< Replaced or removed; add() must look up again
+
+        std::atomic<uint64_t> batches_flushed{0};
+        std::atomic<uint64_t> messages_batched{0};
+        std::atomic<uint64_t> size_flushes{0};
+        std::atomic<uint64_t> timeout_flushes{0};
+        std::atomic<uint64_t> failed_batches{0};
+        common::metrics::Histogram fill;
+    };
+
+    enum class FlushReason : uint8_t { SIZE, TIMEOUT, FORCED };
+
+    /// A batch taken out of a rule's pending map, written outside the lock
+    struct ReadyBatch {
+        std::string sink_id;
+        std::vector<common::DataPoint> points;
+        PendingBatch* lane = nullptr;  ///< Orders writes of the same (rule, sink)
+        uint64_t ticket    = 0;
+    };
+
+    std::shared_ptr<RuleState> find_rule(uint32_t rule_id) const;
+    std::vector<std::shared_ptr<RuleState>> all_rules() const;
+
+    /// Take expired (or, if force, all) batches out of a rule
+    static std::vector<ReadyBatch> take_batches(RuleState& rule, Clock::time_point now,
+                                                bool force, Clock::time_point& next_deadline);
+
+    /// Write a batch once every earlier ticket of its (rule, sink) has been written
+    void write(RuleState& rule, ReadyBatch& batch, FlushReason reason);
+    /**
+     * @brief Write out expired (or, if force, all) batches
+     * @param retire Marks a replaced/removed rule
+     * @return Deadline of the earliest batch still pending, Clock::time_point::max() if none
+     */
+    Clock::time_point flush_rule(RuleState& rule, Clock::time_point now, bool force,
+                                 bool retire = false);
+    /// Flush expired batches of every rule; returns the earliest remaining deadline
+    Clock::time_point flush_expired(Clock::time_point now);
+    /// Wake the flusher if a batch opened with deadline would be checked too late
+    void notify_batch_opened(Clock::time_point deadline);
+    void flusher_loop();
+    static RuleBatchingStats snapshot(const RuleState& rule);
+
+    WriteFn write_;
+    std::chrono::milliseconds flush_interval_;
+
+    mutable std::shared_mutex rules_mutex_;
+    std::unordered_map<uint32_t, std::shared_ptr<RuleState>> rules_;
+    std::atomic<size_t> rule_count_{0};
+
+    std::atomic<uint64_t> batches_flushed_{0};
+    std::atomic<uint64_t> messages_batched_{0};
+
+    std::atomic<bool> running_{false};
+    std::thread flusher_;
+
+    std::mutex flusher_mutex_;
+    std::condition_variable flusher_cv_;
+    bool flusher_kicked_ = false;  ///< Under flusher_mutex_
+    /// Time the flusher checks next (max while scanning or parked, min while stopped)
+    std::atomic<Clock::rep> flusher_wake_at_{Clock::time_point::min().time_since_epoch().count()};
+};
+
+}  // namespace ipb::router
@@ -30,6 +30,7 @@
 #include <ipb/core/rule_engine/rule_engine.hpp>
 #include <ipb/core/scheduler/edf_scheduler.hpp>
 #include <ipb/core/sink_registry/sink_registry.hpp>
+#include <ipb/router/micro_batcher.hpp>
 
 #include <atomic>
 #include <chrono>
@@ -180,7 +181,8 @@ struct RoutingRule {
     std::function<bool(const common::DataPoint&)> custom_condition;
     std::function<std::vector<std::string>(const common::DataPoint&)> custom_target_selector;
 
-    // Performance settings
+    // Micro-batching: matched points are collected per target sink and
+    // written with one write_batch() per batch_size points or batch_timeout
     bool enable_batching = false;
     uint32_t batch_size  = 100;
     std::chrono::milliseconds batch_timeout{10};
@@ -332,6 +334,19 @@ struct RouterConfig {
     bool enable_dead_letter_queue   = true;
     std::string dead_letter_sink_id = "dead_letter";
 
+    // Batch routing settings
+    /// Batches at least this large are evaluated in parallel on the scheduler's workers
+    size_t parallel_batch_threshold = 1024;
+    /// Data points per parallel evaluation chunk
+    size_t batch_chunk_size = 256;
+    /// How often pending micro-batches are checked against their rule's batch_timeout
+    std::chrono::milliseconds batch_flush_interval{1};
+
+    // Async routing settings
+    /// Maximum route_async() calls queued or running at once (0 = only the
+    /// scheduler's queue limit applies); further calls fail immediately
+    size_t max_pending_async_routes = 65536;
+
     // Debug/logging settings
     common::debug::LogLevel log_level = common::debug::LogLevel::INFO;
     bool enable_tracing               = true;
@@ -520,14 +535,43 @@ public:
 
     /**
      * @brief Route a batch of messages
+     *
+     * Large batches (see RouterConfig::parallel_batch_threshold) are
+     * evaluated in chunks on the scheduler's workers. Routed points are then
+     * grouped by destination sink and written with one write_batch() call
+     * per sink, in batch order.
      */
     IPB_NODISCARD common::Result<> route_batch(std::span<const common::DataPoint> batch);
 
     /**
-     * @brief Route asynchronously
+     * @brief Route asynchronously on the scheduler's worker pool
+     *
+     * No thread is created per call; the route runs as a scheduler task
+     * with the default deadline offset. When the router is saturated (see
+     * RouterConfig::max_pending_async_routes, or the scheduler queue is
+     * full) the returned future is already ready with
+     * SCHEDULER_OVERLOADED. A route that misses its deadline completes with
+     * DEADLINE_MISSED; routes still queued when the router stops complete
+     * with TASK_CANCELLED.
      */
     std::future<common::Result<>> route_async(const common::DataPoint& data_point);
 
+    /// Route asynchronously, taking ownership of the data point
+    std::future<common::Result<>> route_async(common::DataPoint&& data_point);
+
+    /**
+     * @brief Route asynchronously with a completion callback instead of a future
+     * @param on_complete Called on a scheduler worker with the routing result
+     * @return Error if the route could not be queued (on_complete is then not called)
+     */
+    IPB_NODISCARD common::Result<> route_async(common::DataPoint data_point,
+                                               std::function<void(common::Result<>)> on_complete);
+
+    /// Number of route_async() calls queued or running
+    size_t pending_async_routes() const noexcept {
+        return async_in_flight_.load(std::memory_order_relaxed);
+    }
+
     // =========================================================================
     // Scheduler Control
     // =========================================================================
@@ -586,6 +630,10 @@ public:
         uint64_t messages_published = 0;
         uint64_t messages_delivered = 0;
         uint64_t queue_overflows    = 0;
+
+        // Micro-batching
+        uint64_t batches_flushed  = 0;
+        uint64_t messages_batched = 0;
     };
 
     /**
@@ -598,6 +646,15 @@ public:
      */
     void reset_metrics();
 
+    /**
+     * @brief Batching statistics, including batch-fill histograms, of every
+     *        rule with batching enabled
+     */
+    std::vector<RuleBatchingStats> get_batching_stats() const;
+
+    /// Batching statistics of one rule (nullopt if batching is not enabled for it)
+    std::optional<RuleBatchingStats> get_batching_stats(uint32_t rule_id) const;
+
     // =========================================================================
     // Direct Component Access (for advanced usage)
     // =========================================================================
@@ -617,11 +674,17 @@ public:
 private:
     RouterConfig config_;
 
+    // route_async() calls queued or running; declared before the scheduler so
+    // that tasks it destroys can still release their slot. Every decrement
+    // notifies it, so wait_for_async_routes() can block on it
+    std::atomic<size_t> async_in_flight_{0};
+
     // Core components
     std::unique_ptr<core::MessageBus> message_bus_;
     std::unique_ptr<core::RuleEngine> rule_engine_;
     std::unique_ptr<core::EDFScheduler> scheduler_;
     std::unique_ptr<core::SinkRegistry> sink_registry_;
+    std::unique_ptr<MicroBatcher> batcher_;
 
     // State
     std::atomic<bool> running_{false};
@@ -629,14 +692,28 @@ private:
     // Subscriptions
     core::Subscription routing_subscription_;
 
+    /// Wait until every route_async() call has completed (queued tasks capture this)
+    void wait_for_async_routes() const noexcept;
+
     // Internal routing logic
     void handle_message(const core::Message& msg);
     common::Result<> dispatch_to_sinks(const common::DataPoint& dp,
                                        const std::vector<core::RuleMatchResult>& matches);
+    std::vector<std::vector<core::RuleMatchResult>> evaluate_batch(
+        std::span<const common::DataPoint> batch);
+    common::Result<> dispatch_batch_to_sinks(
+        std::span<const common::DataPoint> batch,
+        const std::vector<std::vector<core::RuleMatchResult>>& all_matches);
+
+    // Micro-batching helpers
+    bool is_batched(uint32_t rule_id) const {
+        return batcher_->has_policies() && batcher_->policy(rule_id).has_value();
+    }
+    void apply_batching(uint32_t rule_id, const RoutingRule& rule);
 
     // Rule conversion helpers
     static core::RoutingRule convert_rule(const RoutingRule& legacy);
-    static RoutingRule convert_rule_back(const core::RoutingRule& rule);
+    RoutingRule convert_rule_back(const core::RoutingRule& rule) const;
 
     // Validation helpers
     common::Result<> validate_sink_id(std::string_view sink_id) const;
@@ -0,0 +1,348 @@
+#include "ipb/router/micro_batcher.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace ipb::router {
+
+using common::DataPoint;
+
+const std::vector<double> MicroBatcher::FILL_BUCKETS = {0.1, 0.25, 0.5, 0.75, 0.9, 1.0};
+
+// ============================================================================
+// MicroBatcher Implementation
+// ============================================================================
+
+MicroBatcher::RuleState::RuleState(uint32_t id, BatchPolicy p)
+    : rule_id(id), policy(p),
+      fill("ipb_router_batch_fill_ratio", FILL_BUCKETS,
+           "Batch size at flush relative to the rule's batch_size",
+           {{"rule_id", std::to_string(id)}}) {}
+
+MicroBatcher::MicroBatcher(WriteFn write, std::chrono::milliseconds flush_interval)
+    : write_(std::move(write)),
+      flush_interval_(std::max(flush_interval, std::chrono::milliseconds(1))) {}
+
+MicroBatcher::~MicroBatcher() {
+    stop();
+}
+
+std::shared_ptr<MicroBatcher::RuleState> MicroBatcher::find_rule(uint32_t rule_id) const {
+    std::shared_lock lock(rules_mutex_);
+    auto it = rules_.find(rule_id);
+    return it != rules_.end() ? it->second : nullptr;
+}
+
+std::vector<std::shared_ptr<MicroBatcher::RuleState>> MicroBatcher::all_rules() const {
+    std::shared_lock lock(rules_mutex_);
+    std::vector<std::shared_ptr<RuleState>> rules;
+    rules.reserve(rules_.size());
+    for (const auto& [id, rule] : rules_) {
+        rules.push_back(rule);
+    }
+    return rules;
+}
+
+void MicroBatcher::set_policy(uint32_t rule_id, BatchPolicy policy) {
+    policy.batch_size = std::max<uint32_t>(1, policy.batch_size);
+
+    std::shared_ptr<RuleState> previous;
+    {
+        std::unique_lock lock(rules_mutex_);
+        auto& slot = rules_[rule_id];
+        if (slot && slot->policy.batch_size == policy.batch_size &&
+            slot->policy.batch_timeout == policy.batch_timeout) {
+            return;
+        }
+        previous = std::exchange(slot, std::make_shared<RuleState>(rule_id, policy));
+        if (!previous) {
+            rule_count_.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+
+    if (previous) {
+        // Points queued under the old policy go out now
+        flush_rule(*previous, Clock::now(), true, true);
+    }
+}
+
+void MicroBatcher::remove_policy(uint32_t rule_id) {
+    std::shared_ptr<RuleState> previous;
+    {
+        std::unique_lock lock(rules_mutex_);
+        auto it = rules_.find(rule_id);
+        if (it == rules_.end()) {
+            return;
+        }
+        previous = std::move(it->second);
+        rules_.erase(it);
+        rule_count_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    flush_rule(*previous, Clock::now(), true, true);
+}
+
+std::optional<BatchPolicy> MicroBatcher::policy(uint32_t rule_id) const {
+    auto rule = find_rule(rule_id);
+    if (!rule) {
+        return std::nullopt;
+    }
+    return rule->policy;
+}
+
+bool MicroBatcher::add(uint32_t rule_id, std::string_view sink_id, const DataPoint& dp) {
+    while (true) {
+        auto rule = find_rule(rule_id);
+        if (!rule) {
+            return false;
+        }
+
+        ReadyBatch full;
+        std::optional<Clock::time_point> opened;
+        {
+            std::lock_guard lock(rule->mutex);
+            if (rule->retired) {
+                // The policy was replaced after find_rule(); queue under the new one
+                continue;
+            }
+
+            auto it = rule->pending.find(sink_id);
+            if (it == rule->pending.end()) {
+                it = rule->pending.try_emplace(std::string(sink_id)).first;
+            }
+
+            auto& batch = it->second;
+            if (batch.points.empty()) {
+                batch.points.reserve(rule->policy.batch_size);
+                batch.opened = Clock::now();
+                opened       = batch.opened;
+            }
+            batch.points.push_back(dp);
+            ++rule->pending_points;
+
+            if (batch.points.size() >= rule->policy.batch_size) {
+                full.sink_id = it->first;
+                full.points  = std::exchange(batch.points, {});
+                full.lane    = &batch;
+                full.ticket  = batch.next_ticket++;
+                rule->pending_points -= full.points.size();
+                opened.reset();
+            }
+        }
+
+        if (opened) {
+            notify_batch_opened(*opened + rule->policy.batch_timeout);
+        }
+        if (full.lane) {
+            write(*rule, full, FlushReason::SIZE);
+        }
+        return true;
+    }
+}
+
+std::vector<MicroBatcher::ReadyBatch> MicroBatcher::take_batches(RuleState& rule,
+                                                                 Clock::time_point now,
+                                                                 bool force,
+                                                                 Clock::time_point& next_deadline) {
+    std::vector<ReadyBatch> ready;
+    for (auto& [sink_id, batch] : rule.pending) {
+        if (batch.points.empty()) {
+            continue;
+        }
+        const auto deadline = batch.opened + rule.policy.batch_timeout;
+        if (!force && now < deadline) {
+            next_deadline = std::min(next_deadline, deadline);
+            continue;
+        }
+        rule.pending_points -= batch.points.size();
+        ready.push_back(
+            ReadyBatch{sink_id, std::exchange(batch.points, {}), &batch, batch.next_ticket++});
+    }
+    return ready;
+}
+
+MicroBatcher::Clock::time_point MicroBatcher::flush_rule(RuleState& rule, Clock::time_point now,
+                                                         bool force, bool retire) {
+    std::vector<ReadyBatch> ready;
+    auto next_deadline = Clock::time_point::max();
+    {
+        std::lock_guard lock(rule.mutex);
+        rule.retired = rule.retired || retire;
+        ready        = take_batches(rule, now, force, next_deadline);
+    }
+
+    for (auto& batch : ready) {
+        write(rule, batch, force ? FlushReason::FORCED : FlushReason::TIMEOUT);
+    }
+    return next_deadline;
+}
+
+void MicroBatcher::write(RuleState& rule, ReadyBatch& batch, FlushReason reason) {
+    // A size flush and a timeout flush of the same sink can race once both left the
+    // rule lock; the ticket taken under the lock decides which one writes first
+    auto& serving = batch.lane->serving;
+    for (auto turn = serving.load(std::memory_order_acquire); turn != batch.ticket;
+         turn      = serving.load(std::memory_order_acquire)) {
+        serving.wait(turn, std::memory_order_acquire);
+    }
+
+    const size_t count = batch.points.size();
+    const bool written = write_(batch.sink_id, batch.points);
+
+    serving.store(batch.ticket + 1, std::memory_order_release);
+    serving.notify_all();
+
+    rule.batches_flushed.fetch_add(1, std::memory_order_relaxed);
+    rule.messages_batched.fetch_add(count, std::memory_order_relaxed);
+    if (!written) {
+        rule.failed_batches.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (reason == FlushReason::SIZE) {
+        rule.size_flushes.fetch_add(1, std::memory_order_relaxed);
+    } else if (reason == FlushReason::TIMEOUT) {
+        rule.timeout_flushes.fetch_add(1, std::memory_order_relaxed);
+    }
+    rule.fill.observe(static_cast<double>(count) / rule.policy.batch_size);
+
+    batches_flushed_.fetch_add(1, std::memory_order_relaxed);
+    messages_batched_.fetch_add(count, std::memory_order_relaxed);
+}
+
+void MicroBatcher::flush_expired() {
+    flush_expired(Clock::now());
+}
+
+MicroBatcher::Clock::time_point MicroBatcher::flush_expired(Clock::time_point now) {
+    auto next_deadline = Clock::time_point::max();
+    for (const auto& rule : all_rules()) {
+        next_deadline = std::min(next_deadline, flush_rule(*rule, now, false));
+    }
+    return next_deadline;
+}
+
+void MicroBatcher::flush_all() {
+    auto now = Clock::now();
+    for (const auto& rule : all_rules()) {
+        flush_rule(*rule, now, true);
+    }
+}
+
+// ============================================================================
+// Flusher Thread
+// ============================================================================
+
+void MicroBatcher::start() {
+    if (running_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    flusher_ = std::thread([this] { flusher_loop(); });
+}
+
+void MicroBatcher::stop() {
+    if (running_.exchange(false, std::memory_order_acq_rel)) {
+        {
+            std::lock_guard lock(flusher_mutex_);
+        }
+        flusher_cv_.notify_all();
+        if (flusher_.joinable()) {
+            flusher_.join();
+        }
+        flusher_wake_at_.store(Clock::time_point::min().time_since_epoch().count());
+    }
+    flush_all();
+}
+
+void MicroBatcher::notify_batch_opened(Clock::time_point deadline) {
+    // A batch may be checked up to one interval late; usually the flusher wakes in time
+    // anyway and nothing is signalled
+    if ((deadline + flush_interval_).time_since_epoch().count() >= flusher_wake_at_.load()) {
+        return;
+    }
+    {
+        std::lock_guard lock(flusher_mutex_);
+        flusher_kicked_ = true;
+    }
+    flusher_cv_.notify_one();
+}
+
+void MicroBatcher::flusher_loop() {
+    std::unique_lock lock(flusher_mutex_);
+    while (running_.load(std::memory_order_acquire)) {
+        flusher_kicked_ = false;
+        lock.unlock();
+
+        // Batches opened while scanning see max and wake the flusher again
+        flusher_wake_at_.store(Clock::time_point::max().time_since_epoch().count());
+        const auto now           = Clock::now();
+        const auto next_deadline = flush_expired(now);
+        const auto wake_at       = next_deadline == Clock::time_point::max()
+                                     ? next_deadline
+                                     : std::max(next_deadline, now + flush_interval_);
+        flusher_wake_at_.store(wake_at.time_since_epoch().count());
+
+        lock.lock();
+        // Parks indefinitely while nothing is pending
+        flusher_cv_.wait_until(lock, wake_at, [this] {
+            return flusher_kicked_ || !running_.load(std::memory_order_acquire);
+        });
+    }
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+RuleBatchingStats MicroBatcher::snapshot(const RuleState& rule) {
+    RuleBatchingStats stats;
+    stats.rule_id          = rule.rule_id;
+    stats.policy           = rule.policy;
+    stats.batches_flushed  = rule.batches_flushed.load(std::memory_order_relaxed);
+    stats.messages_batched = rule.messages_batched.load(std::memory_order_relaxed);
+    stats.size_flushes     = rule.size_flushes.load(std::memory_order_relaxed);
+    stats.timeout_flushes  = rule.timeout_flushes.load(std::memory_order_relaxed);
+    stats.failed_batches   = rule.failed_batches.load(std::memory_order_relaxed);
+    {
+        std::lock_guard lock(rule.mutex);
+        stats.pending = rule.pending_points;
+    }
+
+    stats.fill_buckets = rule.fill.buckets();
+    stats.fill_counts.reserve(stats.fill_buckets.size() + 1);
+    for (size_t i = 0; i <= stats.fill_buckets.size(); ++i) {
+        stats.fill_counts.push_back(rule.fill.bucket_count(i));
+    }
+    return stats;
+}
+
+std::vector<RuleBatchingStats> MicroBatcher::stats() const {
+    std::vector<RuleBatchingStats> result;
+    for (const auto& rule : all_rules()) {
+        result.push_back(snapshot(*rule));
+    }
+    std::sort(result.begin(), result.end(),
+              [](const auto& a, const auto& b) { return a.rule_id < b.rule_id; });
+    return result;
+}
+
+std::optional<RuleBatchingStats> MicroBatcher::stats(uint32_t rule_id) const {
+    auto rule = find_rule(rule_id);
+    if (!rule) {
+        return std::nullopt;
+    }
+    return snapshot(*rule);
+}
+
+void MicroBatcher::reset_stats() {
+    for (const auto& rule : all_rules()) {
+        rule->batches_flushed.store(0, std::memory_order_relaxed);
+        rule->messages_batched.store(0, std::memory_order_relaxed);
+        rule->size_flushes.store(0, std::memory_order_relaxed);
+        rule->timeout_flushes.store(0, std::memory_order_relaxed);
+        rule->failed_batches.store(0, std::memory_order_relaxed);
+        rule->fill.reset();
+    }
+    batches_flushed_.store(0, std::memory_order_relaxed);
+    messages_batched_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace ipb::router
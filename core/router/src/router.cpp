@@ -17,6 +17,7 @@
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace ipb::router {
@@ -602,6 +603,28 @@ Router::Router(const RouterConfig& config)
       rule_engine_(std::make_unique<core::RuleEngine>(config.rule_engine)),
       scheduler_(std::make_unique<core::EDFScheduler>(config.scheduler)),
       sink_registry_(std::make_unique<core::SinkRegistry>(config.sink_registry)) {
+    // Rule targets and registered sinks share one set of sink handles
+    rule_engine_->set_sink_interner(sink_registry_->sink_interner());
+
+    // The batcher outlives moves of this Router, so it captures the registry, not this
+    auto dead_letter = config.enable_dead_letter_queue ? config.dead_letter_sink_id : "";
+    batcher_         = std::make_unique<MicroBatcher>(
+        [registry = sink_registry_.get(), dead_letter](std::string_view sink_id,
+                                                       std::span<const DataPoint> batch) {
+            auto result = registry->write_batch_to_sink(sink_id, batch);
+            if (result.is_success()) {
+                return true;
+            }
+            IPB_LOG_WARN(category::ROUTER, "Batched write to " << sink_id
+                                                               << " failed: " << result.message());
+            if (!dead_letter.empty() && sink_id != dead_letter) {
+                if (!registry->write_batch_to_sink(dead_letter, batch).is_success()) {
+                    IPB_LOG_WARN(category::ROUTER, "Dead letter queue write failed");
+                }
+            }
+            return false;
+        },
+        config.batch_flush_interval);
     IPB_LOG_INFO(category::ROUTER, "Router created with config");
 }
 
@@ -611,21 +634,28 @@ Router::~Router() {
     std::ignore = stop();
 }
 
+// Queued async routes hold other's this and its in-flight counter, so they
+// are drained before the components change hands
 Router::Router(Router&& other) noexcept
-    : config_(std::move(other.config_)), message_bus_(std::move(other.message_bus_)),
-      rule_engine_(std::move(other.rule_engine_)), scheduler_(std::move(other.scheduler_)),
-      sink_registry_(std::move(other.sink_registry_)), running_(other.running_.load()),
+    : config_((other.wait_for_async_routes(), std::move(other.config_))),
+      message_bus_(std::move(other.message_bus_)), rule_engine_(std::move(other.rule_engine_)),
+      scheduler_(std::move(other.scheduler_)), sink_registry_(std::move(other.sink_registry_)),
+      batcher_(std::move(other.batcher_)), running_(other.running_.load()),
       routing_subscription_(std::move(other.routing_subscription_)) {
     other.running_.store(false);
 }
 
 Router& Router::operator=(Router&& other) noexcept {
     if (this != &other) {
+        std::ignore = stop();
+        other.wait_for_async_routes();
+
         config_        = std::move(other.config_);
         message_bus_   = std::move(other.message_bus_);
         rule_engine_   = std::move(other.rule_engine_);
         scheduler_     = std::move(other.scheduler_);
         sink_registry_ = std::move(other.sink_registry_);
+        batcher_       = std::move(other.batcher_);
         running_.store(other.running_.load());
         routing_subscription_ = std::move(other.routing_subscription_);
         other.running_.store(false);
@@ -669,6 +699,8 @@ Result<> Router::start() {
         return err(ErrorCode::INVALID_STATE, "Failed to start SinkRegistry");
     }
 
+    batcher_->start();
+
     // Subscribe to routing topic
     routing_subscription_ = message_bus_->subscribe(
         "routing/#", [this](const core::Message& msg) { handle_message(msg); });
@@ -690,15 +722,26 @@ Result<> Router::stop() {
     // Cancel subscription
     routing_subscription_.cancel();
 
-    // Stop components in reverse order
+    // Stop components in reverse order; pending micro-batches go out first
+    batcher_->stop();
     sink_registry_->stop();
-    scheduler_->stop();
+
+    // Also cancels queued tasks, completing pending async routes with TASK_CANCELLED
+    scheduler_->stop_immediate();
     message_bus_->stop();
 
     IPB_LOG_INFO(category::ROUTER, "Router stopped successfully");
     return ok();
 }
 
+void Router::wait_for_async_routes() const noexcept {
+    // Every decrement of async_in_flight_ notifies it
+    for (auto pending = async_in_flight_.load(std::memory_order_acquire); pending != 0;
+         pending      = async_in_flight_.load(std::memory_order_acquire)) {
+        async_in_flight_.wait(pending, std::memory_order_acquire);
+    }
+}
+
 bool Router::is_running() const noexcept {
     return running_.load(std::memory_order_acquire);
 }
@@ -865,6 +908,7 @@ Result<uint32_t> Router::add_rule(const RoutingRule& rule) {
 
     auto core_rule = convert_rule(rule);
     uint32_t id    = rule_engine_->add_rule(std::move(core_rule));
+    apply_batching(id, rule);
 
     IPB_LOG_INFO(category::ROUTER, "Rule added: " << rule.name << " id=" << id);
     return ok<uint32_t>(id);
@@ -884,6 +928,7 @@ Result<> Router::update_rule(uint32_t rule_id, const RoutingRule& rule) {
 
     auto core_rule = convert_rule(rule);
     if (rule_engine_->update_rule(rule_id, core_rule)) {
+        apply_batching(rule_id, rule);
         IPB_LOG_INFO(category::ROUTER, "Rule updated: " << rule_id);
         return ok();
     }
@@ -895,6 +940,7 @@ Result<> Router::remove_rule(uint32_t rule_id) {
     IPB_LOG_DEBUG(category::ROUTER, "Removing rule: " << rule_id);
 
     if (rule_engine_->remove_rule(rule_id)) {
+        batcher_->remove_policy(rule_id);
         IPB_LOG_INFO(category::ROUTER, "Rule removed: " << rule_id);
         return ok();
     }
@@ -911,6 +957,14 @@ Result<> Router::enable_rule(uint32_t rule_id, bool enabled) {
     return err(ErrorCode::RULE_NOT_FOUND, "Rule not found");
 }
 
+void Router::apply_batching(uint32_t rule_id, const RoutingRule& rule) {
+    if (rule.enable_batching) {
+        batcher_->set_policy(rule_id, BatchPolicy{rule.batch_size, rule.batch_timeout});
+    } else {
+        batcher_->remove_policy(rule_id);
+    }
+}
+
 std::vector<RoutingRule> Router::get_routing_rules() const {
     auto core_rules = rule_engine_->get_all_rules();
     std::vector<RoutingRule> result;
@@ -1000,39 +1054,95 @@ Result<> Router::route_batch(std::span<const DataPoint> batch) {
 
     IPB_LOG_DEBUG(category::ROUTER, "Routing batch of " << batch.size() << " messages");
 
-    // Batch evaluate all rules
-    auto all_matches = rule_engine_->evaluate_batch(batch);
+    auto all_matches = evaluate_batch(batch);
+    return dispatch_batch_to_sinks(batch, all_matches);
+}
 
-    uint64_t failed_count = 0;
+std::future<Result<>> Router::route_async(const DataPoint& data_point) {
+    return route_async(DataPoint(data_point));
+}
 
-    for (size_t i = 0; i < batch.size(); ++i) {
-        if (all_matches[i].empty()) {
-            if (config_.enable_dead_letter_queue) {
-                sink_registry_->write_to_sink(config_.dead_letter_sink_id, batch[i]);
-            }
-            continue;
+std::future<Result<>> Router::route_async(DataPoint&& data_point) {
+    auto promise = std::make_shared<std::promise<Result<>>>();
+    auto future  = promise->get_future();
+
+    auto queued = route_async(std::move(data_point), [promise](Result<> result) {
+        promise->set_value(std::move(result));
+    });
+    if (!queued) {
+        promise->set_value(std::move(queued));
+    }
+
+    return future;
+}
+
+Result<> Router::route_async(DataPoint data_point, std::function<void(Result<>)> on_complete) {
+    if (IPB_UNLIKELY(!running_.load(std::memory_order_acquire))) {
+        return err(ErrorCode::INVALID_STATE, "Router not running");
+    }
+
+    // Reserve a slot before queuing so concurrent callers cannot overshoot the limit
+    const size_t limit = config_.max_pending_async_routes;
+    if (async_in_flight_.fetch_add(1, std::memory_order_acq_rel) >= limit && limit != 0) {
+        async_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+        async_in_flight_.notify_all();
+        return err(ErrorCode::SCHEDULER_OVERLOADED, "Too many pending async routes");
+    }
+
+    // Completes exactly once: with the routing result, DEADLINE_MISSED, or
+    // TASK_CANCELLED if the scheduler discards the task without running it
+    struct Completion {
+        std::atomic<size_t>* in_flight;
+        std::function<void(Result<>)> on_complete;
+        bool done = false;
+
+        Completion(std::atomic<size_t>* counter, std::function<void(Result<>)> callback)
+            : in_flight(counter), on_complete(std::move(callback)) {}
+
+        void complete(Result<> result) {
+            done = true;
+            in_flight->fetch_sub(1, std::memory_order_acq_rel);
+            in_flight->notify_all();
+            on_complete(std::move(result));
         }
 
-        auto result = dispatch_to_sinks(batch[i], all_matches[i]);
-        if (!result) {
-            ++failed_count;
+        ~Completion() {
+            if (!done) {
+                complete(err(ErrorCode::TASK_CANCELLED, "Async route dropped by scheduler"));
+            }
         }
-    }
+    };
+    auto completion = std::make_shared<Completion>(&async_in_flight_, std::move(on_complete));
+
+    auto deadline  = Timestamp::now() + scheduler_->get_default_deadline_offset();
+    auto submitted = scheduler_->submit_with_callback(
+        [this, completion, dp = std::move(data_point)]() { completion->complete(route(dp)); },
+        deadline, [completion](core::TaskState state, std::chrono::nanoseconds) {
+            if (completion->done) {
+                return;
+            }
+            if (state == core::TaskState::DEADLINE_MISSED) {
+                completion->complete(
+                    err(ErrorCode::DEADLINE_MISSED, "Async route missed its deadline"));
+            } else if (state == core::TaskState::CANCELLED) {
+                completion->complete(err(ErrorCode::TASK_CANCELLED, "Router stopped"));
+            }
+        });
 
-    if (failed_count > 0) {
-        IPB_LOG_WARN(category::ROUTER, "Batch routing: " << failed_count << "/" << batch.size()
-                                                         << " messages failed");
-        return err(ErrorCode::ALL_SINKS_FAILED,
-                   "Some messages failed to route: " + std::to_string(failed_count));
+    if (!submitted) {
+        if (completion->done) {
+            // Rejected for an already-passed deadline; on_complete has run
+            return ok();
+        }
+        completion->done = true;
+        async_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+        async_in_flight_.notify_all();
+        return err(ErrorCode::SCHEDULER_OVERLOADED, submitted.error_message);
     }
 
     return ok();
 }
 
-std::future<Result<>> Router::route_async(const DataPoint& data_point) {
-    return std::async(std::launch::async, [this, dp = data_point]() { return route(dp); });
-}
-
 // ============================================================================
 // Scheduler Control
 // ============================================================================
@@ -1089,6 +1199,10 @@ Router::Metrics Router::get_metrics() const {
     metrics.queue_overflows     = bus_stats.queue_overflows.load();
     metrics.avg_routing_time_us = bus_stats.avg_latency_us();
 
+    // From micro-batcher
+    metrics.batches_flushed  = batcher_->batches_flushed();
+    metrics.messages_batched = batcher_->messages_batched();
+
     return metrics;
 }
 
@@ -1097,6 +1211,15 @@ void Router::reset_metrics() {
     rule_engine_->reset_stats();
     scheduler_->reset_stats();
     sink_registry_->reset_stats();
+    batcher_->reset_stats();
+}
+
+std::vector<RuleBatchingStats> Router::get_batching_stats() const {
+    return batcher_->stats();
+}
+
+std::optional<RuleBatchingStats> Router::get_batching_stats(uint32_t rule_id) const {
+    return batcher_->stats(rule_id);
 }
 
 // ============================================================================
@@ -1109,7 +1232,7 @@ void Router::handle_message(const core::Message& msg) {
     if (msg.type == core::Message::Type::DATA_POINT) {
         std::ignore = route(msg.payload);
     } else if (msg.type == core::Message::Type::DATA_BATCH) {
-        std::ignore = route_batch(msg.batch_payload);
+        std::ignore = route_batch(msg.batch());
     } else if (msg.type == core::Message::Type::DEADLINE_TASK) {
         Timestamp deadline(std::chrono::nanoseconds(msg.deadline_ns));
         std::ignore = route_with_deadline(msg.payload, deadline);
@@ -1132,6 +1255,20 @@ Result<> Router::dispatch_to_sinks(const DataPoint& dp,
                           ? core::LoadBalanceStrategy::FAILOVER
                           : core::LoadBalanceStrategy::ROUND_ROBIN;
 
+        if (is_batched(match.rule_id)) {
+            // Queue for the rule's batch to the selected sink instead of writing now
+            auto selection = sink_registry_->select_sink(match.target_ids, dp, strategy);
+            if (!selection.success) {
+                any_failed = true;
+                last_error = selection.error_message;
+                continue;
+            }
+            if (batcher_->add(match.rule_id, selection.selected_sink_ids[0], dp)) {
+                any_success = true;
+                continue;
+            }
+        }
+
         auto result = sink_registry_->write_with_load_balancing(match.target_ids, dp, strategy);
 
         if (result.is_success()) {
@@ -1162,6 +1299,181 @@ Result<> Router::dispatch_to_sinks(const DataPoint& dp,
     return ok();
 }
 
+std::vector<std::vector<core::RuleMatchResult>> Router::evaluate_batch(
+    std::span<const DataPoint> batch) {
+    const size_t chunk   = std::max<size_t>(1, config_.batch_chunk_size);
+    const size_t chunks  = (batch.size() + chunk - 1) / chunk;
+    const size_t workers = scheduler_->config().worker_threads;
+
+    if (batch.size() < config_.parallel_batch_threshold || chunks < 2 || workers == 0 ||
+        !scheduler_->is_running()) {
+        return rule_engine_->evaluate_batch(batch);
+    }
+
+    std::vector<std::vector<core::RuleMatchResult>> results(batch.size());
+
+    // Chunks are claimed from a shared counter by the helper tasks and by
+    // this thread, so the batch completes even when no worker is free (or
+    // when this thread is itself a worker). Helpers that start after the
+    // last chunk was claimed return without touching the batch.
+    struct Job {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+    };
+    auto job = std::make_shared<Job>();
+
+    auto run = [job, engine = rule_engine_.get(), batch, chunk, chunks, out = results.data()] {
+        size_t completed = 0;
+        for (size_t c = job->next.fetch_add(1); c < chunks; c = job->next.fetch_add(1)) {
+            const size_t end = std::min(batch.size(), (c + 1) * chunk);
+            for (size_t i = c * chunk; i < end; ++i) {
+                out[i] = engine->evaluate(batch[i]);
+            }
+            ++completed;
+        }
+        if (completed > 0 && job->done.fetch_add(completed) + completed == chunks) {
+            job->done.notify_all();
+        }
+    };
+
+    const size_t helpers = std::min(workers, chunks - 1);
+    for (size_t h = 0; h < helpers; ++h) {
+        if (!scheduler_->submit(run)) {
+            break;
+        }
+    }
+    run();
+
+    for (size_t done = job->done.load(); done != chunks; done = job->done.load()) {
+        job->done.wait(done);
+    }
+
+    return results;
+}
+
+Result<> Router::dispatch_batch_to_sinks(
+    std::span<const DataPoint> batch,
+    const std::vector<std::vector<core::RuleMatchResult>>& all_matches) {
+    // Point indices per destination sink, in batch order
+    struct SinkBatch {
+        std::string sink_id;
+        std::vector<uint32_t> points;
+        bool contiguous = true;  ///< points form one run of the batch
+    };
+    std::vector<SinkBatch> sink_batches;
+    std::unordered_map<std::string, size_t> sink_slots;
+
+    enum : uint8_t { DELIVERED = 1, FAILED = 2 };
+    std::vector<uint8_t> outcome(batch.size(), 0);
+    std::vector<uint32_t> dead_letters;
+    std::string last_error;
+
+    for (uint32_t i = 0; i < batch.size(); ++i) {
+        if (all_matches[i].empty()) {
+            if (config_.enable_dead_letter_queue) {
+                dead_letters.push_back(i);
+            }
+            continue;
+        }
+
+        for (const auto& match : all_matches[i]) {
+            if (!match.matched || match.target_ids.empty()) {
+                continue;
+            }
+
+            // Same strategy choice as dispatch_to_sinks()
+            auto strategy = (match.priority >= core::RulePriority::HIGH)
+                              ? core::LoadBalanceStrategy::FAILOVER
+                              : core::LoadBalanceStrategy::ROUND_ROBIN;
+
+            auto selection = sink_registry_->select_sink(match.target_ids, batch[i], strategy);
+            if (!selection.success) {
+                outcome[i] |= FAILED;
+                last_error = selection.error_message;
+                continue;
+            }
+
+            if (is_batched(match.rule_id) &&
+                batcher_->add(match.rule_id, selection.selected_sink_ids[0], batch[i])) {
+                outcome[i] |= DELIVERED;
+                continue;
+            }
+
+            auto [it, inserted] = sink_slots.try_emplace(selection.selected_sink_ids[0],
+                                                         sink_batches.size());
+            if (inserted) {
+                sink_batches.push_back(SinkBatch{selection.selected_sink_ids[0], {}, true});
+            }
+            auto& sink_batch = sink_batches[it->second];
+            if (!sink_batch.points.empty() && sink_batch.points.back() + 1 != i) {
+                sink_batch.contiguous = false;
+            }
+            sink_batch.points.push_back(i);
+        }
+    }
+
+    // One write_batch() per sink; contiguous runs are passed through without copying
+    std::vector<DataPoint> scratch;
+    for (const auto& sink_batch : sink_batches) {
+        const auto& points = sink_batch.points;
+
+        std::span<const DataPoint> span;
+        if (sink_batch.contiguous) {
+            span = batch.subspan(points.front(), points.size());
+        } else {
+            scratch.clear();
+            scratch.reserve(points.size());
+            for (uint32_t i : points) {
+                scratch.push_back(batch[i]);
+            }
+            span = scratch;
+        }
+
+        auto result = sink_registry_->write_batch_to_sink(sink_batch.sink_id, span);
+        if (!result.is_success()) {
+            last_error = result.error_message();
+            IPB_LOG_WARN(category::ROUTER,
+                         "Sink batch write to " << sink_batch.sink_id << " failed: " << last_error);
+        }
+        for (uint32_t i : points) {
+            outcome[i] |= result.is_success() ? DELIVERED : FAILED;
+        }
+    }
+
+    // Points no sink accepted go to the dead letter queue
+    uint64_t failed_count = 0;
+    for (uint32_t i = 0; i < batch.size(); ++i) {
+        if (outcome[i] == FAILED) {
+            ++failed_count;
+            if (config_.enable_dead_letter_queue) {
+                dead_letters.push_back(i);
+            }
+        }
+    }
+
+    if (!dead_letters.empty()) {
+        std::sort(dead_letters.begin(), dead_letters.end());
+        scratch.clear();
+        scratch.reserve(dead_letters.size());
+        for (uint32_t i : dead_letters) {
+            scratch.push_back(batch[i]);
+        }
+        auto dlq_result = sink_registry_->write_batch_to_sink(config_.dead_letter_sink_id, scratch);
+        if (!dlq_result.is_success()) {
+            IPB_LOG_WARN(category::ROUTER, "Dead letter queue write failed");
+        }
+    }
+
+    if (failed_count > 0) {
+        IPB_LOG_WARN(category::ROUTER, "Batch routing: " << failed_count << "/" << batch.size()
+                                                         << " messages failed");
+        return err(ErrorCode::ALL_SINKS_FAILED,
+                   "Some messages failed to route: " + std::to_string(failed_count));
+    }
+
+    return ok();
+}
+
 core::RoutingRule Router::convert_rule(const RoutingRule& legacy) {
     core::RoutingRule rule;
 
@@ -1224,7 +1536,7 @@ core::RoutingRule Router::convert_rule(const RoutingRule& legacy) {
     return rule;
 }
 
-RoutingRule Router::convert_rule_back(const core::RoutingRule& rule) {
+RoutingRule Router::convert_rule_back(const core::RoutingRule& rule) const {
     RoutingRule legacy;
 
     legacy.rule_id  = rule.id;
@@ -1275,6 +1587,13 @@ RoutingRule Router::convert_rule_back(const core::RoutingRule& rule) {
 
     legacy.target_sink_ids = rule.target_sink_ids;
 
+    // Batching lives in the router, not in the engine's rule
+    if (auto policy = batcher_->policy(rule.id)) {
+        legacy.enable_batching = true;
+        legacy.batch_size      = policy->batch_size;
+        legacy.batch_timeout   = policy->batch_timeout;
+    }
+
     return legacy;
 }
 
@@ -2,7 +2,7 @@
  * @file test_data_point.cpp
  * @brief Comprehensive unit tests for ipb::common data types (v1.5.0 API)
  *
- * Tests cover: Timestamp, Value, Quality, DataPoint, RawMessage
+ * Tests cover: Timestamp, SharedBuffer, Value, Quality, DataPoint, RawMessage
  */
 
 #include <ipb/common/data_point.hpp>
@@ -11,6 +11,8 @@
 #include <chrono>
 #include <cstring>
 #include <limits>
+#include <new>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -195,6 +197,47 @@ TEST_F(ValueTest, LongStringValue) {
     EXPECT_EQ(v.as_string_view(), long_str);
 }
 
+TEST_F(ValueTest, LongStringCopySharesBuffer) {
+    std::string long_str(100, 'x');
+    Value v1;
+    v1.set_string_view(long_str);
+
+    Value v2(v1);
+    Value v3;
+    v3 = v1;
+
+    EXPECT_EQ(v2.as_string_view().data(), v1.as_string_view().data());
+    EXPECT_EQ(v3.as_string_view().data(), v1.as_string_view().data());
+    EXPECT_EQ(v3.as_string_view(), long_str);
+}
+
+TEST_F(ValueTest, LongStringCopyOnWrite) {
+    std::string long_str(100, 'x');
+    Value v1;
+    v1.set_string_view(long_str);
+    Value v2(v1);
+
+    std::string other(80, 'y');
+    v1.set_string_view(other);
+
+    EXPECT_EQ(v1.as_string_view(), other);
+    EXPECT_EQ(v2.as_string_view(), long_str);
+}
+
+TEST_F(ValueTest, SetFromOwnLongString) {
+    std::string long_str = std::string(60, 'a') + std::string(60, 'b');
+    Value v;
+    v.set_string_view(long_str);
+
+    // Shrink into inline storage from a view of the external buffer
+    v.set_string_view(v.as_string_view().substr(60, 10));
+    EXPECT_EQ(v.as_string_view(), std::string(10, 'b'));
+
+    v.set_string_view(long_str);
+    v.set_string_view(v.as_string_view().substr(50));
+    EXPECT_EQ(v.as_string_view(), long_str.substr(50));
+}
+
 TEST_F(ValueTest, BinaryValue) {
     std::vector<uint8_t> data = {0x01, 0x02, 0x03, 0x04, 0x05};
     Value v;
@@ -553,6 +596,95 @@ TEST_F(DataPointTest, LongAddress) {
     EXPECT_EQ(dp.address(), long_address);
 }
 
+TEST_F(DataPointTest, LongAddressCopySharesBuffer) {
+    std::string long_address = "ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.MotorTemperature";
+
+    DataPoint dp1(long_address);
+    DataPoint dp2(dp1);
+    DataPoint dp3("short");
+    dp3 = dp1;
+
+    EXPECT_EQ(dp2.address().data(), dp1.address().data());
+    EXPECT_EQ(dp3.address().data(), dp1.address().data());
+
+    dp1.set_address("renamed");
+    EXPECT_EQ(dp1.address(), "renamed");
+    EXPECT_EQ(dp2.address(), long_address);
+    EXPECT_EQ(dp3.address(), long_address);
+}
+
+TEST_F(DataPointTest, LongAddressReleasedOnOtherThread) {
+    std::string long_address(64, 'n');
+    std::vector<DataPoint> copies;
+
+    {
+        DataPoint dp(long_address);
+        for (int i = 0; i < 8; ++i) {
+            copies.push_back(dp);
+        }
+    }
+
+    std::thread consumer([batch = std::move(copies), &long_address]() mutable {
+        for (const auto& dp : batch) {
+            EXPECT_EQ(dp.address(), long_address);
+        }
+        batch.clear();
+    });
+    consumer.join();
+}
+
+TEST_F(DataPointTest, InternedAddress) {
+    InternedString short_address("plant/line1/temp");
+    InternedString long_address("ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.MotorTemperature");
+
+    DataPoint dp(short_address);
+    EXPECT_EQ(dp.address(), "plant/line1/temp");
+    EXPECT_EQ(dp.address_id(), short_address.id());
+
+    // Long interned addresses are read from the interner, not copied
+    dp.set_address(long_address);
+    EXPECT_EQ(dp.address(), long_address.view());
+    EXPECT_EQ(dp.address().data(), long_address.view().data());
+    EXPECT_EQ(dp.address_id(), long_address.id());
+
+    DataPoint copy(dp);
+    EXPECT_EQ(copy.address_id(), long_address.id());
+    EXPECT_EQ(copy.address(), long_address.view());
+
+    DataPoint moved(std::move(copy));
+    EXPECT_EQ(moved.address_id(), long_address.id());
+    EXPECT_EQ(moved.address(), long_address.view());
+
+    // Plain text drops the ID
+    dp.set_address(std::string(64, 'p'));
+    EXPECT_EQ(dp.address_id(), StringInterner::EMPTY_ID);
+    EXPECT_EQ(dp.address(), std::string(64, 'p'));
+}
+
+TEST_F(DataPointTest, InternAddressInPlace) {
+    std::string long_text(48, 'i');
+    DataPoint dp(long_text);
+    EXPECT_EQ(dp.address_id(), StringInterner::EMPTY_ID);
+
+    auto id = dp.intern_address();
+    EXPECT_NE(id, StringInterner::EMPTY_ID);
+    EXPECT_EQ(id, InternedString(long_text).id());
+    EXPECT_EQ(dp.address(), long_text);
+    EXPECT_EQ(dp.intern_address(), id);
+
+    // Interned and plain points with the same address compare equal
+    EXPECT_EQ(dp, DataPoint(long_text));
+    EXPECT_EQ(dp, DataPoint(InternedString(long_text)));
+
+    // IDs are process-local and do not survive serialization
+    std::vector<uint8_t> buffer(dp.serialized_size());
+    dp.serialize(buffer);
+    DataPoint restored;
+    ASSERT_TRUE(restored.deserialize(buffer));
+    EXPECT_EQ(restored.address(), long_text);
+    EXPECT_EQ(restored.address_id(), StringInterner::EMPTY_ID);
+}
+
 TEST_F(DataPointTest, Equality) {
     Value v;
     v.set(static_cast<int32_t>(42));
@@ -664,6 +796,77 @@ TEST_F(DataPointTest, MemoryUsage) {
     }
 }
 
+// ============================================================================
+// SharedBuffer Tests
+// ============================================================================
+
+namespace {
+
+class CountingAllocator : public BufferAllocator {
+public:
+    void* allocate(size_t size) noexcept override {
+        ++allocations;
+        return ::operator new(size, std::nothrow);
+    }
+
+    void deallocate(void* ptr, size_t) noexcept override {
+        ++deallocations;
+        ::operator delete(ptr);
+    }
+
+    int allocations   = 0;
+    int deallocations = 0;
+};
+
+}  // namespace
+
+TEST(SharedBufferTest, CopiesShareOneBuffer) {
+    const std::string bytes(200, 'q');
+    SharedBuffer a;
+    ASSERT_TRUE(a.assign(bytes.data(), bytes.size()));
+    EXPECT_EQ(a.use_count(), 1u);
+
+    SharedBuffer b(a);
+    EXPECT_EQ(a.use_count(), 2u);
+    EXPECT_EQ(b.data(), a.data());
+
+    b.reset();
+    EXPECT_FALSE(b);
+    EXPECT_EQ(a.use_count(), 1u);
+}
+
+TEST(SharedBufferTest, AssignReusesUnsharedBuffer) {
+    const std::string first(200, 'q');
+    const std::string second(150, 'r');
+    SharedBuffer a;
+    ASSERT_TRUE(a.assign(first.data(), first.size()));
+    const uint8_t* storage = a.data();
+
+    ASSERT_TRUE(a.assign(second.data(), second.size()));
+    EXPECT_EQ(a.data(), storage);
+
+    SharedBuffer b(a);
+    ASSERT_TRUE(a.assign(first.data(), first.size()));
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_EQ(std::memcmp(b.data(), second.data(), second.size()), 0);
+}
+
+TEST(SharedBufferTest, ScopedAllocatorReceivesLongStorage) {
+    CountingAllocator allocator;
+    {
+        ScopedBufferAllocator scope(&allocator);
+        DataPoint dp(std::string(40, 'a'));
+        dp.value().set_string_view(std::string(100, 'v'));
+        DataPoint copy(dp);
+
+        // Short data stays inline
+        DataPoint small("short");
+        EXPECT_EQ(allocator.allocations, 2);
+    }
+    EXPECT_EQ(SharedBuffer::thread_allocator(), nullptr);
+    EXPECT_EQ(allocator.deallocations, 2);
+}
+
 // ============================================================================
 // RawMessage Tests
 // ============================================================================
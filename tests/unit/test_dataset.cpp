@@ -16,6 +16,8 @@
  * - Statistics (valid_count, invalid_count)
  * - Serialization (serialized_size, as_span, release)
  * - DataSetBuilder
+ * - Arena-backed DataSet (with_arena, allocation_scope)
+ * - ColumnarBatch (conversion, column filters, sort)
  */
 
 #include <ipb/common/dataset.hpp>
@@ -470,6 +472,25 @@ TEST_F(DataSetSortTest, SortCustom) {
     }
 }
 
+TEST_F(DataSetSortTest, SortByTimestampIsStable) {
+    DataSet ds;
+    for (int i = 0; i < 200; ++i) {
+        DataPoint dp("tag" + std::to_string(i));
+        dp.set_timestamp(Timestamp(std::chrono::nanoseconds((i * 37) % 10)));
+        ds.push_back(std::move(dp));
+    }
+
+    ds.sort_by_timestamp();
+
+    for (size_t i = 1; i < ds.size(); ++i) {
+        ASSERT_LE(ds[i - 1].timestamp(), ds[i].timestamp());
+        if (ds[i - 1].timestamp() == ds[i].timestamp()) {
+            EXPECT_LT(std::stoi(std::string(ds[i - 1].address().substr(3))),
+                      std::stoi(std::string(ds[i].address().substr(3))));
+        }
+    }
+}
+
 // ============================================================================
 // DataSet Grouping Tests
 // ============================================================================
@@ -806,3 +827,205 @@ TEST_F(DataSetBuilderTest, FluentAPI) {
 
     EXPECT_EQ(ds.size(), 3u);
 }
+
+// ============================================================================
+// Arena-backed DataSet Tests
+// ============================================================================
+
+class DataSetArenaTest : public ::testing::Test {
+protected:
+    static std::string long_address(int i) {
+        return "ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.Register" + std::to_string(i);
+    }
+};
+
+TEST_F(DataSetArenaTest, PlainSetHasNoArena) {
+    DataSet ds;
+    EXPECT_EQ(ds.arena(), nullptr);
+
+    auto scope = ds.allocation_scope();
+    EXPECT_EQ(SharedBuffer::thread_allocator(), nullptr);
+}
+
+TEST_F(DataSetArenaTest, EmplaceBackAllocatesFromArena) {
+    auto ds = DataSet::with_arena(1000);
+    ASSERT_NE(ds.arena(), nullptr);
+
+    for (int i = 0; i < 1000; ++i) {
+        ds.emplace_back(long_address(i));
+    }
+
+    // 1000 addresses in one 64KB chunk and a second one, instead of 1000 buffers
+    EXPECT_GE(ds.arena()->bytes_allocated(), 1000u * long_address(0).size());
+    EXPECT_LE(ds.arena()->chunk_count(), 2u);
+    EXPECT_EQ(ds[999].address(), long_address(999));
+    EXPECT_EQ(SharedBuffer::thread_allocator(), nullptr);
+}
+
+TEST_F(DataSetArenaTest, BuilderScopeCoversPointsBuiltDuringScan) {
+    auto builder = DataSetBuilder::with_arena(100);
+    {
+        auto scope = builder.allocation_scope();
+        for (int i = 0; i < 100; ++i) {
+            DataPoint dp(long_address(i));
+            dp.value().set_string_view(std::string(80, static_cast<char>('a' + i % 26)));
+            builder.add(std::move(dp));
+        }
+    }
+    EXPECT_EQ(SharedBuffer::thread_allocator(), nullptr);
+
+    DataSet ds = std::move(builder).build();
+    ASSERT_NE(ds.arena(), nullptr);
+    EXPECT_EQ(ds.arena()->chunk_count(), 1u);
+
+    size_t seen = 0;
+    ds.for_each_batch(32, [&seen, this](std::span<const DataPoint> batch) {
+        for (const auto& dp : batch) {
+            int i = static_cast<int>(seen++);
+            EXPECT_EQ(dp.address(), long_address(i));
+            EXPECT_EQ(dp.value().as_string_view(),
+                      std::string(80, static_cast<char>('a' + i % 26)));
+        }
+    });
+    EXPECT_EQ(seen, 100u);
+}
+
+TEST_F(DataSetArenaTest, CopiesOutliveTheSet) {
+    DataPoint survivor;
+    {
+        auto ds = DataSet::with_arena(10);
+        for (int i = 0; i < 10; ++i) {
+            ds.emplace_back(long_address(i));
+        }
+        survivor = ds[7];
+    }
+
+    EXPECT_EQ(survivor.address(), long_address(7));
+}
+
+TEST_F(DataSetArenaTest, OversizedValueGetsOwnChunk) {
+    auto ds = DataSet::with_arena(2, 1024);
+    ds.emplace_back(long_address(0));
+    {
+        auto scope = ds.allocation_scope();
+        ds.back().value().set_string_view(std::string(4096, 'x'));
+    }
+    ds.emplace_back(long_address(1));
+
+    EXPECT_EQ(ds.arena()->chunk_count(), 2u);
+    EXPECT_EQ(ds[0].value().as_string_view().size(), 4096u);
+    EXPECT_EQ(ds[1].address(), long_address(1));
+}
+
+// ============================================================================
+// ColumnarBatch Tests
+// ============================================================================
+
+class ColumnarBatchTest : public ::testing::Test {
+protected:
+    static DataSet make_scan(size_t count) {
+        DataSet ds;
+        for (size_t i = 0; i < count; ++i) {
+            DataPoint dp("ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.Register" + std::to_string(i));
+            if (i % 3 == 0) {
+                dp.intern_address();
+            }
+            if (i % 4 == 0) {
+                dp.value().set_string_view(std::string(60, static_cast<char>('a' + i % 26)));
+            } else {
+                dp.set_value(static_cast<double>(i));
+            }
+            dp.set_timestamp(Timestamp(std::chrono::nanoseconds(1000 - (i * 7) % 100)));
+            dp.set_protocol_id(static_cast<uint16_t>(i % 3));
+            dp.set_quality(static_cast<Quality>(i % 4));
+            dp.set_sequence_number(static_cast<uint32_t>(i));
+            ds.push_back(std::move(dp));
+        }
+        return ds;
+    }
+
+    static void expect_same(const DataPoint& a, const DataPoint& b) {
+        EXPECT_EQ(a.address(), b.address());
+        EXPECT_EQ(a.address_id(), b.address_id());
+        EXPECT_EQ(a.value(), b.value());
+        EXPECT_EQ(a.timestamp(), b.timestamp());
+        EXPECT_EQ(a.protocol_id(), b.protocol_id());
+        EXPECT_EQ(a.quality(), b.quality());
+        EXPECT_EQ(a.sequence_number(), b.sequence_number());
+    }
+
+    static void expect_same(const DataSet& expected, const ColumnarBatch& batch) {
+        ASSERT_EQ(batch.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            expect_same(expected[i], batch.point(i));
+        }
+    }
+};
+
+TEST_F(ColumnarBatchTest, RoundTripIsLossless) {
+    auto ds = make_scan(100);
+    ColumnarBatch batch(ds);
+
+    ASSERT_EQ(batch.size(), 100u);
+    EXPECT_EQ(batch.timestamps().size(), 100u);
+    EXPECT_NE(batch.address_ids()[0], StringInterner::EMPTY_ID);
+    EXPECT_EQ(batch.address_ids()[1], StringInterner::EMPTY_ID);
+    EXPECT_EQ(batch.address(1), ds[1].address());
+
+    auto back = batch.to_dataset();
+    ASSERT_EQ(back.size(), ds.size());
+    for (size_t i = 0; i < ds.size(); ++i) {
+        expect_same(ds[i], back[i]);
+    }
+    EXPECT_EQ(back.earliest_timestamp(), ds.earliest_timestamp());
+    EXPECT_EQ(back.protocol_count(1), ds.protocol_count(1));
+}
+
+TEST_F(ColumnarBatchTest, LongValuesShareBuffers) {
+    auto ds = make_scan(1);
+    ColumnarBatch batch(ds);
+    EXPECT_EQ(batch.values()[0].as_string_view().data(), ds[0].value().as_string_view().data());
+}
+
+TEST_F(ColumnarBatchTest, FiltersMatchDataSetFilters) {
+    auto ds = make_scan(200);
+    ColumnarBatch batch(ds);
+
+    expect_same(ds.filter_by_protocol(1), batch.filter_by_protocol(1));
+    expect_same(ds.filter_by_quality(Quality::BAD), batch.filter_by_quality(Quality::BAD));
+    expect_same(ds.filter_by_address_prefix("ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.Register1"),
+                batch.filter_by_address_prefix("ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.Register1"));
+
+    Timestamp start(std::chrono::nanoseconds(920));
+    Timestamp end(std::chrono::nanoseconds(960));
+    expect_same(ds.filter_by_timestamp_range(start, end),
+                batch.filter_by_timestamp_range(start, end));
+}
+
+TEST_F(ColumnarBatchTest, SortByTimestampMatchesDataSet) {
+    auto ds = make_scan(300);
+    ColumnarBatch batch(ds);
+
+    ds.sort_by_timestamp();
+    batch.sort_by_timestamp();
+
+    expect_same(ds, batch);
+    EXPECT_TRUE(std::is_sorted(batch.timestamps().begin(), batch.timestamps().end()));
+}
+
+TEST_F(ColumnarBatchTest, SelectAndClear) {
+    auto ds = make_scan(10);
+    ColumnarBatch batch(ds);
+
+    std::vector<uint32_t> rows{9, 0, 4, 4};
+    auto picked = batch.select(rows);
+    ASSERT_EQ(picked.size(), rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        expect_same(ds[rows[i]], picked.point(i));
+    }
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    batch.push_back(ds[2]);
+    expect_same(ds[2], batch.point(0));
+}
@@ -0,0 +1,174 @@
+/**
+ * @file test_dataset_allocations.cpp
+ * @brief Heap allocation counts of building and dropping a DataSet scan
+ *
+ * Replaces the global operator new, so it is kept out of test_dataset.
+ *
+ * Tests cover:
+ * - Per-point heap buffers (the path before pooled buffers) as a baseline
+ * - Pooled buffers in steady state
+ * - Arena-backed scans (DataSetBuilder::with_arena)
+ */
+
+#include <ipb/common/dataset.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ipb::common;
+
+// ============================================================================
+// Counting operator new
+// ============================================================================
+
+namespace {
+
+/// Only the thread running a measurement counts, so background threads do not skew it
+thread_local bool t_counting = false;
+std::atomic<size_t> g_new_calls{0};
+
+void* counted_alloc(size_t size) {
+    if (t_counting) {
+        g_new_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    std::abort();
+}
+
+void* counted_aligned_alloc(size_t size, std::align_val_t align) {
+    if (t_counting) {
+        g_new_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto alignment = static_cast<size_t>(align);
+    size           = (size + alignment - 1) / alignment * alignment;
+    if (void* ptr = std::aligned_alloc(alignment, size == 0 ? alignment : size)) {
+        return ptr;
+    }
+    std::abort();
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+    return counted_alloc(size);
+}
+void* operator new[](size_t size) {
+    return counted_alloc(size);
+}
+void* operator new(size_t size, std::align_val_t align) {
+    return counted_aligned_alloc(size, align);
+}
+void* operator new[](size_t size, std::align_val_t align) {
+    return counted_aligned_alloc(size, align);
+}
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+// ============================================================================
+// Scan Allocation Tests
+// ============================================================================
+
+class ScanAllocationTest : public ::testing::Test {
+protected:
+    static constexpr size_t SCAN_POINTS = 1000;
+
+    /// One operator new per buffer, like the path before pooled buffers
+    class NewAllocator final : public BufferAllocator {
+    public:
+        void* allocate(size_t size) noexcept override { return ::operator new(size); }
+        void deallocate(void* ptr, size_t) noexcept override { ::operator delete(ptr); }
+    };
+
+    void SetUp() override {
+        // Same shape as the dataset/scan_1k_* benchmarks: 55-byte node ids, 60-byte JSON values
+        for (size_t i = 0; i < SCAN_POINTS; ++i) {
+            addresses_.push_back("ns=2;s=Plant1.Line4.Cell7.Robot2.Axis3.Register" +
+                                 std::to_string(i));
+        }
+        payload_ = R"({"value":72.4,"unit":"degC","source":"plc-7","status":"ok"})";
+    }
+
+    /// Build a scan, read it back in batches and drop it; returns the operator new calls
+    size_t count_scan(DataSetBuilder builder, BufferAllocator* allocator = nullptr) {
+        g_new_calls.store(0, std::memory_order_relaxed);
+        t_counting = true;
+        {
+            auto scope = allocator != nullptr ? ScopedBufferAllocator(allocator)
+                                              : builder.allocation_scope();
+            for (const auto& address : addresses_) {
+                DataPoint dp(address);
+                dp.value().set_string_view(payload_);
+                builder.add(std::move(dp));
+            }
+        }
+        {
+            auto set     = std::move(builder).build();
+            size_t total = 0;
+            set.for_each_batch(256, [&total](std::span<const DataPoint> batch) {
+                total += batch.size();
+            });
+            EXPECT_EQ(total, SCAN_POINTS);
+        }
+        t_counting = false;
+        return g_new_calls.load(std::memory_order_relaxed);
+    }
+
+    std::vector<std::string> addresses_;
+    std::string payload_;
+};
+
+TEST_F(ScanAllocationTest, HeapBuffersAllocatePerPoint) {
+    NewAllocator heap;
+    size_t calls = count_scan(DataSetBuilder(SCAN_POINTS), &heap);
+    RecordProperty("operator_new_calls", static_cast<int>(calls));
+
+    // An address and a value buffer per point, plus the builder's vector
+    EXPECT_GE(calls, 2 * SCAN_POINTS);
+    EXPECT_LE(calls, 2 * SCAN_POINTS + 2);
+}
+
+TEST_F(ScanAllocationTest, PooledBuffersNeedNoPerPointAllocationsWhenWarm) {
+    count_scan(DataSetBuilder(SCAN_POINTS));
+
+    // Only the set's own storage; every buffer comes back out of the pool
+    size_t calls = count_scan(DataSetBuilder(SCAN_POINTS));
+    RecordProperty("operator_new_calls", static_cast<int>(calls));
+    EXPECT_LE(calls, 2u);
+}
+
+TEST_F(ScanAllocationTest, ArenaAllocatesPerChunk) {
+    size_t calls = count_scan(DataSetBuilder::with_arena(SCAN_POINTS));
+    RecordProperty("operator_new_calls", static_cast<int>(calls));
+
+    // The vector, the arena and its 64KB chunks (~150KB for this scan)
+    EXPECT_LE(calls, 6u);
+}
@@ -17,6 +17,7 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <thread>
@@ -383,6 +384,107 @@ TEST_F(ObjectPoolMultithreadedTest, ConcurrentAllocDealloc) {
     EXPECT_EQ(pool_.in_use(), 0u);
 }
 
+TEST_F(ObjectPoolMultithreadedTest, CrossThreadFree) {
+    constexpr int rounds    = 100;
+    constexpr int per_round = 200;
+
+    std::vector<TestObject*> handoff;
+    std::mutex handoff_mutex;
+    std::atomic<bool> done{false};
+    std::atomic<int> freed{0};
+
+    // Consumer frees everything the producer allocates
+    std::thread consumer([&]() {
+        std::vector<TestObject*> batch;
+        while (!done.load() || freed.load() < rounds * per_round) {
+            {
+                std::lock_guard lock(handoff_mutex);
+                batch.swap(handoff);
+            }
+            for (auto* obj : batch) {
+                pool_.deallocate(obj);
+                freed++;
+            }
+            batch.clear();
+            std::this_thread::yield();
+        }
+    });
+
+    for (int round = 0; round < rounds; ++round) {
+        for (int i = 0; i < per_round; ++i) {
+            TestObject* obj = pool_.allocate(i);
+            ASSERT_NE(obj, nullptr);
+            std::lock_guard lock(handoff_mutex);
+            handoff.push_back(obj);
+        }
+        // Let the consumer catch up so objects can flow back through the depot
+        while (freed.load() < (round + 1) * per_round) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true);
+    consumer.join();
+
+    EXPECT_EQ(pool_.in_use(), 0u);
+    // Freed objects are reused instead of growing the pool every round
+    EXPECT_LT(pool_.capacity(), static_cast<size_t>(rounds * per_round / 4));
+}
+
+TEST_F(ObjectPoolMultithreadedTest, NoObjectHandedOutTwice) {
+    constexpr int num_threads = 8;
+    constexpr int operations  = 2000;
+
+    std::vector<std::thread> threads;
+    std::atomic<int> corrupted{0};
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([this, t, &corrupted]() {
+            std::vector<std::pair<TestObject*, int>> held;
+            for (int i = 0; i < operations; ++i) {
+                int marker = t * operations + i;
+                held.emplace_back(pool_.allocate(marker), marker);
+
+                // Hold a few objects so chains move through the depot
+                if (held.size() > 40 || i % 7 == 0) {
+                    std::this_thread::yield();
+                    for (auto [obj, expected] : held) {
+                        if (obj->value != expected) {
+                            corrupted++;
+                        }
+                        pool_.deallocate(obj);
+                    }
+                    held.clear();
+                }
+            }
+            for (auto [obj, expected] : held) {
+                pool_.deallocate(obj);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(corrupted.load(), 0);
+    EXPECT_EQ(pool_.in_use(), 0u);
+}
+
+TEST_F(ObjectPoolMultithreadedTest, OwnershipFromBlockHeader) {
+    ObjectPool<TestObject, 128> other;
+
+    TestObject* mine   = pool_.allocate(1);
+    TestObject* theirs = other.allocate(2);
+
+    EXPECT_TRUE(pool_.owns(mine));
+    EXPECT_FALSE(pool_.owns(theirs));
+    EXPECT_TRUE(other.owns(theirs));
+    EXPECT_FALSE(other.owns(mine));
+
+    pool_.deallocate(mine);
+    other.deallocate(theirs);
+}
+
 // ============================================================================
 // PooledPtr Tests
 // ============================================================================
@@ -9,10 +9,13 @@
  * - MessageBus: Pub/sub functionality
  */
 
+#include <ipb/core/message_bus/channel.hpp>
 #include <ipb/core/message_bus/message_bus.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <ctime>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -65,6 +68,8 @@ TEST_F(MessageTest, ConstructWithTopicAndDataPoint) {
     DataPoint dp("sensor/temp1");
     dp.set_value(25.5);
 
+    MessageBus bus;
+    ASSERT_NE(bus.get_or_create_channel("sensors/temperature"), nullptr);
     Message msg("sensors/temperature", dp);
 
     EXPECT_EQ(msg.type, Message::Type::DATA_POINT);
@@ -72,6 +77,49 @@ TEST_F(MessageTest, ConstructWithTopicAndDataPoint) {
     EXPECT_EQ(msg.payload.address(), "sensor/temp1");
 }
 
+TEST_F(MessageTest, UnknownTopicIsNotInterned) {
+    Message msg("message_test/never_registered", DataPoint("t1"));
+
+    EXPECT_TRUE(msg.topic.empty());
+    EXPECT_FALSE(StringInterner::global().find("message_test/never_registered").has_value());
+}
+
+TEST_F(MessageTest, CompactEnvelope) {
+    // Header fields share the first cache line; the inline DataPoint follows
+    EXPECT_LE(sizeof(Message), sizeof(DataPoint) + 64);
+    EXPECT_EQ(sizeof(Message::topic), sizeof(uint32_t));
+}
+
+TEST_F(MessageTest, TopicAndSourceAreInterned) {
+    MessageBus bus;
+    ASSERT_NE(bus.get_or_create_channel("plant1/line4/sensors/temperature"), nullptr);
+    Message a("plant1/line4/sensors/temperature", DataPoint("t1"));
+    Message b("plant1/line4/sensors/temperature", DataPoint("t2"));
+    a.source_id = "scoop-a";
+    b.source_id = "scoop-a";
+
+    EXPECT_FALSE(a.topic.empty());
+    EXPECT_EQ(a.topic.id(), b.topic.id());
+    EXPECT_EQ(a.source_id.id(), b.source_id.id());
+    EXPECT_EQ(a.source_id, "scoop-a");
+}
+
+TEST_F(MessageTest, BatchPayloadIsShared) {
+    DataSet points;
+    points.push_back(DataPoint("p1"));
+    points.push_back(DataPoint("p2"));
+
+    Message msg;
+    msg.type          = Message::Type::DATA_BATCH;
+    msg.batch_payload = std::make_shared<const DataSet>(std::move(points));
+    EXPECT_TRUE(Message().batch().empty());
+
+    Message copy = msg;
+    ASSERT_EQ(copy.batch().size(), 2u);
+    EXPECT_EQ(copy.batch().data(), msg.batch().data());
+    EXPECT_EQ(copy.batch()[1].address(), "p2");
+}
+
 // ============================================================================
 // MessageBusStats Tests
 // ============================================================================
@@ -119,6 +167,36 @@ TEST_F(MessageBusStatsTest, Reset) {
     EXPECT_EQ(stats.messages_dropped.load(), 0u);
 }
 
+TEST_F(MessageBusStatsTest, LatencyHistogramPercentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0);
+
+    for (int64_t ns = 1; ns <= 1000; ++ns) {
+        histogram.record(ns);
+    }
+    EXPECT_EQ(histogram.count(), 1000u);
+
+    // Bucket upper bounds overshoot by at most a quarter of the value
+    auto p50 = histogram.percentile(0.50);
+    auto p99 = histogram.percentile(0.99);
+    EXPECT_GE(p50, 500);
+    EXPECT_LE(p50, 625);
+    EXPECT_GE(p99, 990);
+    EXPECT_LE(p99, 1238);
+    EXPECT_GE(histogram.percentile(1.0), 1000);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+}
+
+TEST_F(MessageBusStatsTest, PriorityLaneMapping) {
+    EXPECT_EQ(priority_lane(Message::Priority::REALTIME), PriorityLane::REALTIME);
+    EXPECT_EQ(priority_lane(Message::Priority::HIGH), PriorityLane::HIGH);
+    EXPECT_EQ(priority_lane(Message::Priority::NORMAL), PriorityLane::NORMAL);
+    EXPECT_EQ(priority_lane(Message::Priority::LOW), PriorityLane::LOW);
+    EXPECT_EQ(priority_lane(static_cast<Message::Priority>(200)), PriorityLane::HIGH);
+}
+
 // ============================================================================
 // MessageBusConfig Tests
 // ============================================================================
@@ -296,6 +374,29 @@ TEST_F(MessageBusTest, GetOrCreateChannel) {
     bus.stop();
 }
 
+TEST_F(MessageBusTest, ChannelsUseConfiguredCapacity) {
+    MessageBus bus(config_);
+
+    auto channel = bus.get_or_create_channel("test/capacity");
+    ASSERT_NE(channel, nullptr);
+    EXPECT_EQ(channel->capacity(), config_.default_buffer_size);
+    EXPECT_EQ(channel->allocated_segments(), 0u);
+
+    EXPECT_TRUE(bus.set_topic_capacity("test/capacity", 8));
+    EXPECT_EQ(channel->capacity(), 8u);
+
+    EXPECT_TRUE(bus.set_topic_capacity("test/other", 16));
+    EXPECT_EQ(bus.get_or_create_channel("test/other")->capacity(), 16u);
+}
+
+TEST_F(MessageBusTest, ConfigFromMemoryProfile) {
+    auto memory = ipb::common::MemoryConfig::edge();
+    auto config = MessageBusConfig::from_memory_config(memory);
+    EXPECT_EQ(config.max_channels, memory.message_bus_max_channels);
+    EXPECT_EQ(config.default_buffer_size, memory.message_bus_buffer_size);
+    EXPECT_EQ(config.dispatcher_threads, memory.message_bus_dispatcher_threads);
+}
+
 TEST_F(MessageBusTest, HasChannel) {
     MessageBus bus(config_);
     bus.start();
@@ -420,6 +521,440 @@ TEST_F(PubSubIntegrationTest, MultipleSubscribers) {
     bus.stop();
 }
 
+TEST_F(PubSubIntegrationTest, EveryTopicDelivered) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    constexpr int TOPICS             = 16;
+    constexpr int MESSAGES_PER_TOPIC = 10;
+
+    std::atomic<int> received{0};
+    std::vector<Subscription> subs;
+    for (int t = 0; t < TOPICS; ++t) {
+        subs.push_back(bus.subscribe("topic/" + std::to_string(t),
+                                     [&received](const Message&) { received++; }));
+    }
+
+    for (int i = 0; i < MESSAGES_PER_TOPIC; ++i) {
+        for (int t = 0; t < TOPICS; ++t) {
+            EXPECT_TRUE(bus.publish("topic/" + std::to_string(t), DataPoint("p")));
+        }
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received.load() < TOPICS * MESSAGES_PER_TOPIC &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bus.stop();
+
+    EXPECT_EQ(received.load(), TOPICS * MESSAGES_PER_TOPIC);
+    EXPECT_EQ(bus.stats().messages_delivered.load(),
+              static_cast<uint64_t>(TOPICS * MESSAGES_PER_TOPIC));
+}
+
+TEST_F(PubSubIntegrationTest, BacklogPublishedBeforeStartIsDeliveredInOrder) {
+    MessageBus bus(config_);
+
+    std::mutex received_mutex;
+    std::vector<uint64_t> sequences;
+    auto sub = bus.subscribe("backlog", [&](const Message& msg) {
+        std::lock_guard<std::mutex> lock(received_mutex);
+        sequences.push_back(msg.sequence);
+    });
+
+    // Larger than one dispatch turn, so the channel has to re-queue itself
+    constexpr size_t MESSAGES = 1000;
+    for (size_t i = 0; i < MESSAGES; ++i) {
+        ASSERT_TRUE(bus.publish("backlog", DataPoint("p")));
+    }
+
+    ASSERT_TRUE(bus.start());
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        {
+            std::lock_guard<std::mutex> lock(received_mutex);
+            if (sequences.size() == MESSAGES) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bus.stop();
+
+    std::lock_guard<std::mutex> lock(received_mutex);
+    ASSERT_EQ(sequences.size(), MESSAGES);
+    for (size_t i = 0; i < MESSAGES; ++i) {
+        EXPECT_EQ(sequences[i], i);
+    }
+}
+
+TEST_F(PubSubIntegrationTest, BatchIsSharedAcrossSubscribers) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    DataSet batch;
+    for (int i = 0; i < 100; ++i) {
+        batch.emplace_back("sensor/p" + std::to_string(i));
+    }
+    const DataPoint* points = batch.as_span().data();
+
+    std::mutex received_mutex;
+    std::vector<const DataPoint*> seen;
+    auto record = [&](const Message& msg) {
+        std::lock_guard<std::mutex> lock(received_mutex);
+        EXPECT_EQ(msg.batch().size(), 100u);
+        seen.push_back(msg.batch().data());
+    };
+    auto sub1 = bus.subscribe("sensors/batch", record);
+    auto sub2 = bus.subscribe("sensors/batch", record);
+    auto sub3 = bus.subscribe("sensors/#", record);
+
+    ASSERT_TRUE(bus.publish_batch("sensors/batch", std::move(batch)));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        {
+            std::lock_guard<std::mutex> lock(received_mutex);
+            if (seen.size() == 3) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bus.stop();
+
+    // Every subscriber sees the caller's original points, not a copy
+    std::lock_guard<std::mutex> lock(received_mutex);
+    ASSERT_EQ(seen.size(), 3u);
+    for (const auto* data : seen) {
+        EXPECT_EQ(data, points);
+    }
+}
+
+TEST_F(PubSubIntegrationTest, SharedBatchRepublishedWithoutCopy) {
+    MessageBus bus(config_);
+
+    DataSet points;
+    for (int i = 0; i < 10; ++i) {
+        points.emplace_back("p");
+    }
+    auto batch = std::make_shared<const DataSet>(std::move(points));
+    EXPECT_TRUE(bus.publish_batch("line/a", batch));
+    EXPECT_TRUE(bus.publish_batch("line/b", batch));
+
+    // One reference here, one per queued message
+    EXPECT_EQ(batch.use_count(), 3);
+}
+
+TEST_F(PubSubIntegrationTest, WildcardSubscriptionsReceiveMatchingTopics) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    std::atomic<int> all_sensors{0};
+    std::atomic<int> temperatures{0};
+    std::atomic<int> actuators{0};
+
+    auto sub1 = bus.subscribe("sensors/#", [&](const Message&) { all_sensors++; });
+    auto sub2 = bus.subscribe("sensors/+/temp", [&](const Message&) { temperatures++; });
+    auto sub3 = bus.subscribe("actuators/*", [&](const Message&) { actuators++; });
+    EXPECT_TRUE(sub1.is_active());
+    EXPECT_TRUE(sub2.is_active());
+    EXPECT_TRUE(sub3.is_active());
+
+    EXPECT_TRUE(bus.publish("sensors/a/temp", DataPoint("p")));
+    EXPECT_TRUE(bus.publish("sensors/b/temp", DataPoint("p")));
+    EXPECT_TRUE(bus.publish("sensors/b/humidity", DataPoint("p")));
+    EXPECT_TRUE(bus.publish("actuators/valve", DataPoint("p")));
+    EXPECT_TRUE(bus.publish("actuators/valve/state", DataPoint("p")));
+    EXPECT_TRUE(bus.publish("other", DataPoint("p")));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (bus.stats().messages_delivered.load() < 6 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bus.stop();
+
+    EXPECT_EQ(all_sensors.load(), 3);
+    EXPECT_EQ(temperatures.load(), 2);
+    EXPECT_EQ(actuators.load(), 1);
+}
+
+TEST_F(PubSubIntegrationTest, CancelledWildcardSubscriptionStopsReceiving) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    std::atomic<int> kept{0};
+    std::atomic<int> cancelled{0};
+    auto keep   = bus.subscribe("routing/#", [&](const Message&) { kept++; });
+    auto cancel = bus.subscribe("routing/#", [&](const Message&) { cancelled++; });
+
+    auto wait_for = [&](int expected) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (kept.load() < expected && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    EXPECT_TRUE(bus.publish("routing/in", DataPoint("p")));
+    wait_for(1);
+    EXPECT_EQ(cancelled.load(), 1);
+
+    cancel.cancel();
+    EXPECT_FALSE(cancel.is_active());
+    EXPECT_TRUE(keep.is_active());
+
+    // Same channel, so its cached subscriber list has to be invalidated
+    EXPECT_TRUE(bus.publish("routing/in", DataPoint("p")));
+    // A topic first seen after subscribing is resolved too
+    EXPECT_TRUE(bus.publish("routing/new/deeper", DataPoint("p")));
+    wait_for(3);
+    bus.stop();
+
+    EXPECT_EQ(kept.load(), 3);
+    EXPECT_EQ(cancelled.load(), 1);
+}
+
+TEST_F(PubSubIntegrationTest, InvalidWildcardPatternIsRejected) {
+    MessageBus bus(config_);
+    auto sub = bus.subscribe("sensors/#/more", [](const Message&) {});
+    EXPECT_FALSE(sub.is_active());
+}
+
+// ============================================================================
+// Queued Subscriber Tests
+// ============================================================================
+
+class QueuedSubscriberTest : public PubSubIntegrationTest {
+protected:
+    static bool wait_until(const std::function<bool()>& done) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return done();
+    }
+
+    /// Callback that blocks until released, recording the sequences it saw
+    SubscriberCallback blocking_callback() {
+        return [this](const Message& msg) {
+            while (!released_.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            sequences_.push_back(msg.sequence);
+        };
+    }
+
+    size_t received() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sequences_.size();
+    }
+
+    std::atomic<bool> released_{false};
+    std::mutex mutex_;
+    std::vector<uint64_t> sequences_;
+};
+
+TEST_F(QueuedSubscriberTest, SlowSubscriberDoesNotBlockOthers) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    std::atomic<int> fast{0};
+    SubscriptionOptions options;
+    options.queue_capacity = 128;
+
+    auto slow     = bus.subscribe("line/telemetry", blocking_callback(), options);
+    auto fast_sub = bus.subscribe("line/telemetry", [&fast](const Message&) { fast++; });
+    ASSERT_TRUE(slow.is_active());
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(bus.publish("line/telemetry", DataPoint("p")));
+    }
+
+    // The inline subscriber gets everything while the queued one is stuck
+    EXPECT_TRUE(wait_until([&] { return fast.load() == 100; }));
+    EXPECT_EQ(received(), 0u);
+
+    released_ = true;
+    EXPECT_TRUE(wait_until([&] { return received() == 100; }));
+    bus.stop();
+
+    auto stats = slow.delivery_stats();
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->delivered, 100u);
+    EXPECT_EQ(stats->dropped, 0u);
+    EXPECT_GE(stats->max_queued, 1u);
+    EXPECT_GT(stats->max_lag_ns, 0);
+    EXPECT_FALSE(fast_sub.delivery_stats().has_value());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    EXPECT_TRUE(std::is_sorted(sequences_.begin(), sequences_.end()));
+}
+
+TEST_F(QueuedSubscriberTest, LagExcludesCallbackTime) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    constexpr auto CALLBACK_TIME = std::chrono::milliseconds(200);
+    SubscriptionOptions options;
+    options.queue_capacity = 4;
+    auto sub               = bus.subscribe(
+        "line/slow", [&](const Message&) { std::this_thread::sleep_for(CALLBACK_TIME); }, options);
+
+    ASSERT_TRUE(bus.publish("line/slow", DataPoint("p")));
+    ASSERT_TRUE(wait_until([&] { return sub.delivery_stats()->delivered == 1; }));
+    bus.stop();
+
+    auto stats = sub.delivery_stats();
+    EXPECT_GT(stats->last_lag_ns, 0);
+    EXPECT_LT(stats->max_lag_ns, std::chrono::nanoseconds(CALLBACK_TIME).count());
+}
+
+TEST_F(QueuedSubscriberTest, BlockSleepsUntilSubscriberMakesRoom) {
+    auto queue =
+        SubscriberQueue::create(4, MessageBusConfig::DropPolicy::BLOCK, blocking_callback());
+
+    constexpr uint64_t MESSAGES = 12;
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<int64_t> cpu_ns{0};
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < MESSAGES; ++i) {
+            Message msg;
+            msg.sequence = i;
+            EXPECT_TRUE(queue->push(msg));
+            pushed++;
+        }
+        timespec cpu{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+        cpu_ns = cpu.tv_sec * 1000000000LL + cpu.tv_nsec;
+    });
+
+    // The producer stays blocked on the full queue while the subscriber is stuck
+    ASSERT_TRUE(wait_until([&] { return queue->stats().queued >= queue->capacity(); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_LT(pushed.load(), MESSAGES);
+
+    released_ = true;
+    producer.join();
+    EXPECT_TRUE(wait_until([&] { return received() == MESSAGES; }));
+
+    // Blocked for 200ms without spinning
+    EXPECT_LT(cpu_ns.load(), std::chrono::nanoseconds(std::chrono::milliseconds(50)).count());
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint64_t i = 0; i < MESSAGES; ++i) {
+        EXPECT_EQ(sequences_[i], i);
+    }
+}
+
+TEST_F(QueuedSubscriberTest, CloseReleasesBlockedPush) {
+    auto queue =
+        SubscriberQueue::create(4, MessageBusConfig::DropPolicy::BLOCK, blocking_callback());
+
+    std::atomic<bool> rejected{false};
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < 16; ++i) {
+            if (!queue->push(Message())) {
+                rejected = true;
+                return;
+            }
+        }
+    });
+    ASSERT_TRUE(wait_until([&] { return queue->stats().queued >= queue->capacity(); }));
+
+    queue->close();
+    producer.join();
+    EXPECT_TRUE(rejected.load());
+
+    released_ = true;
+    queue->stop();
+}
+
+TEST_F(QueuedSubscriberTest, DropOldestKeepsLatestMessages) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    SubscriptionOptions options;
+    options.queue_capacity = 4;
+    options.drop_policy    = MessageBusConfig::DropPolicy::DROP_OLDEST;
+    auto sub               = bus.subscribe("line/state", blocking_callback(), options);
+
+    constexpr uint64_t MESSAGES = 20;
+    for (uint64_t i = 0; i < MESSAGES; ++i) {
+        ASSERT_TRUE(bus.publish("line/state", DataPoint("p")));
+    }
+    ASSERT_TRUE(wait_until([&] {
+        auto stats = sub.delivery_stats();
+        return stats->dropped + stats->queued + 1 >= MESSAGES;
+    }));
+
+    released_ = true;
+    ASSERT_TRUE(wait_until([&] {
+        auto stats = sub.delivery_stats();
+        return stats->delivered + stats->dropped == MESSAGES;
+    }));
+    bus.stop();
+
+    EXPECT_GT(sub.delivery_stats()->dropped, 0u);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ASSERT_FALSE(sequences_.empty());
+    EXPECT_EQ(sequences_.back(), MESSAGES - 1);
+}
+
+TEST_F(QueuedSubscriberTest, DropNewestKeepsEarliestMessages) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    SubscriptionOptions options;
+    options.queue_capacity = 4;
+    options.drop_policy    = MessageBusConfig::DropPolicy::DROP_NEWEST;
+    auto sub               = bus.subscribe("line/state", blocking_callback(), options);
+
+    constexpr uint64_t MESSAGES = 20;
+    for (uint64_t i = 0; i < MESSAGES; ++i) {
+        ASSERT_TRUE(bus.publish("line/state", DataPoint("p")));
+    }
+    ASSERT_TRUE(wait_until([&] {
+        auto stats = sub.delivery_stats();
+        return stats->dropped + stats->queued + 1 >= MESSAGES;
+    }));
+
+    released_ = true;
+    ASSERT_TRUE(wait_until([&] {
+        auto stats = sub.delivery_stats();
+        return stats->delivered + stats->dropped == MESSAGES;
+    }));
+    bus.stop();
+
+    // At most one message in the callback plus a full queue got through
+    std::lock_guard<std::mutex> lock(mutex_);
+    ASSERT_FALSE(sequences_.empty());
+    EXPECT_LE(sequences_.size(), 5u);
+    EXPECT_LT(sequences_.back(), 5u);
+}
+
+TEST_F(QueuedSubscriberTest, WildcardSubscriberCanBeQueued) {
+    MessageBus bus(config_);
+    ASSERT_TRUE(bus.start());
+
+    released_ = true;
+    SubscriptionOptions options;
+    options.queue_capacity = 64;
+    auto sub               = bus.subscribe("line/+/temp", blocking_callback(), options);
+    ASSERT_TRUE(sub.is_active());
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(bus.publish("line/" + std::to_string(i) + "/temp", DataPoint("p")));
+    }
+    EXPECT_TRUE(wait_until([&] { return received() == 10; }));
+    bus.stop();
+
+    sub.cancel();
+    EXPECT_FALSE(sub.is_active());
+    EXPECT_FALSE(sub.delivery_stats().has_value());
+}
+
 // ============================================================================
 // Thread Safety Tests
 // ============================================================================
@@ -503,8 +1038,6 @@ TEST_F(MessageBusThreadSafetyTest, ConcurrentSubscribeUnsubscribe) {
 // Channel Tests - Additional Coverage
 // ============================================================================
 
-#include <ipb/core/message_bus/channel.hpp>
-
 class ChannelTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -611,6 +1144,146 @@ TEST_F(ChannelTest, PendingAndSubscriberCount) {
     EXPECT_EQ(channel_->subscriber_count(), 0u);
 }
 
+TEST_F(ChannelTest, QueuesItselfOncePerBacklog) {
+    struct CountingQueue : ChannelReadyQueue {
+        int enqueued = 0;
+        void enqueue(Channel&) noexcept override { ++enqueued; }
+    } queue;
+
+    channel_->attach(&queue, 3);
+    EXPECT_EQ(channel_->dispatch_shard(), 3u);
+
+    for (int i = 0; i < 5; ++i) {
+        channel_->publish(Message());
+    }
+    EXPECT_EQ(queue.enqueued, 1);
+
+    // Partial dispatch leaves work behind: the channel queues itself again
+    EXPECT_EQ(channel_->dispatch(2), 2u);
+    EXPECT_EQ(queue.enqueued, 2);
+
+    EXPECT_EQ(channel_->dispatch(), 3u);
+    EXPECT_EQ(queue.enqueued, 2);
+
+    // Idle again: the next publish is a new backlog
+    channel_->publish(Message());
+    EXPECT_EQ(queue.enqueued, 3);
+    channel_->dispatch();
+
+    channel_->attach(nullptr, 0);
+    channel_->publish(Message());
+    EXPECT_EQ(queue.enqueued, 3);
+}
+
+TEST_F(ChannelTest, StorageFollowsBacklog) {
+    EXPECT_EQ(channel_->allocated_segments(), 0u);
+
+    constexpr size_t MESSAGES = 10 * SegmentedMessageQueue::SEGMENT_SIZE;
+    for (size_t i = 0; i < MESSAGES; ++i) {
+        ASSERT_TRUE(channel_->publish(Message()));
+    }
+    EXPECT_GE(channel_->allocated_segments(), 10u);
+
+    EXPECT_EQ(channel_->dispatch(), MESSAGES);
+    // Only the current segment and one spare stay around
+    EXPECT_LE(channel_->allocated_segments(), 2u);
+}
+
+TEST_F(ChannelTest, CapacityLimitsBacklog) {
+    auto channel = std::make_shared<Channel>("bounded", 100);
+    EXPECT_EQ(channel->capacity(), 100u);
+
+    std::vector<uint64_t> sequences;
+    channel->subscribe([&](const Message& msg) { sequences.push_back(msg.sequence); });
+
+    for (int i = 0; i < 150; ++i) {
+        channel->publish(Message());
+    }
+    EXPECT_EQ(channel->pending_count(), 100u);
+    EXPECT_EQ(channel->messages_dropped.load(), 50u);
+
+    EXPECT_EQ(channel->dispatch(), 100u);
+    ASSERT_EQ(sequences.size(), 100u);
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        EXPECT_EQ(sequences[i], i);
+    }
+
+    channel->set_capacity(200);
+    for (int i = 0; i < 150; ++i) {
+        EXPECT_TRUE(channel->publish(Message()));
+    }
+}
+
+TEST_F(ChannelTest, CapacityIsSharedByPriorityLanes) {
+    auto channel = std::make_shared<Channel>("bounded", 100);
+
+    const Message::Priority priorities[] = {Message::Priority::REALTIME, Message::Priority::HIGH,
+                                            Message::Priority::NORMAL, Message::Priority::LOW};
+    size_t accepted = 0;
+    for (int i = 0; i < 400; ++i) {
+        accepted += channel->publish_priority(Message(), priorities[i % 4]) ? 1 : 0;
+    }
+    EXPECT_EQ(accepted, 100u);
+    EXPECT_EQ(channel->pending_count(), 100u);
+    EXPECT_EQ(channel->pending_count(PriorityLane::REALTIME), 25u);
+    EXPECT_EQ(channel->messages_dropped.load(), 300u);
+
+    // Dispatching frees room for any lane
+    EXPECT_EQ(channel->dispatch(10), 10u);
+    for (int i = 0; i < 20; ++i) {
+        accepted += channel->publish_priority(Message(), Message::Priority::LOW) ? 1 : 0;
+    }
+    EXPECT_EQ(accepted, 110u);
+    EXPECT_EQ(channel->pending_count(), 100u);
+}
+
+TEST_F(ChannelTest, ConcurrentPublishersKeepPerProducerOrder) {
+    constexpr int PRODUCERS             = 4;
+    constexpr int MESSAGES_PER_PRODUCER = 20000;
+
+    std::vector<int64_t> last(PRODUCERS, -1);
+    std::atomic<int> received{0};
+    std::atomic<int> out_of_order{0};
+    channel_->subscribe([&](const Message& msg) {
+        auto producer = static_cast<size_t>(msg.deadline_ns / MESSAGES_PER_PRODUCER);
+        auto index    = msg.deadline_ns % MESSAGES_PER_PRODUCER;
+        if (index <= last[producer]) {
+            out_of_order++;
+        }
+        last[producer] = index;
+        received++;
+    });
+
+    std::atomic<bool> done{false};
+    std::thread consumer([&] {
+        while (!done.load() || !channel_->empty()) {
+            channel_->dispatch();
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([this, p] {
+            for (int i = 0; i < MESSAGES_PER_PRODUCER; ++i) {
+                Message msg;
+                msg.deadline_ns = static_cast<int64_t>(p) * MESSAGES_PER_PRODUCER + i;
+                while (!channel_->publish(msg)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    done.store(true);
+    consumer.join();
+
+    EXPECT_EQ(received.load(), PRODUCERS * MESSAGES_PER_PRODUCER);
+    EXPECT_EQ(out_of_order.load(), 0);
+    EXPECT_LE(channel_->allocated_segments(), 2u);
+}
+
 TEST_F(ChannelTest, BufferOverflow) {
     // Test publishing many messages
     // The default buffer should handle this, but if it fills up,
@@ -625,6 +1298,95 @@ TEST_F(ChannelTest, BufferOverflow) {
     EXPECT_GE(channel_->pending_count(), 0u);
 }
 
+class ChannelPriorityTest : public ChannelTest {
+protected:
+    void publish(Message::Priority priority, int count = 1) {
+        for (int i = 0; i < count; ++i) {
+            ASSERT_TRUE(channel_->publish_priority(Message(), priority));
+        }
+    }
+
+    /// Dispatch everything and return the priorities in delivery order
+    std::vector<Message::Priority> drain() {
+        std::vector<Message::Priority> order;
+        auto id =
+            channel_->subscribe([&order](const Message& msg) { order.push_back(msg.priority); });
+        channel_->dispatch();
+        channel_->unsubscribe(id);
+        return order;
+    }
+};
+
+TEST_F(ChannelPriorityTest, RealtimeOvertakesBacklog) {
+    publish(Message::Priority::NORMAL, 100);
+    publish(Message::Priority::REALTIME);
+    EXPECT_EQ(channel_->pending_count(PriorityLane::NORMAL), 100u);
+    EXPECT_EQ(channel_->pending_count(PriorityLane::REALTIME), 1u);
+
+    auto order = drain();
+    ASSERT_EQ(order.size(), 101u);
+    EXPECT_EQ(order.front(), Message::Priority::REALTIME);
+}
+
+TEST_F(ChannelPriorityTest, LanesDrainHighestFirstInFifoOrder) {
+    channel_->set_priority_dispatch(true, 0);
+
+    std::vector<uint64_t> sequences;
+    auto id = channel_->subscribe([&](const Message& msg) { sequences.push_back(msg.sequence); });
+    publish(Message::Priority::LOW, 2);       // sequences 0, 1
+    publish(Message::Priority::HIGH, 2);      // 2, 3
+    publish(Message::Priority::REALTIME, 2);  // 4, 5
+    channel_->dispatch();
+    channel_->unsubscribe(id);
+
+    EXPECT_EQ(sequences, (std::vector<uint64_t>{4, 5, 2, 3, 0, 1}));
+}
+
+TEST_F(ChannelPriorityTest, StarvedLaneIsServed) {
+    channel_->set_priority_dispatch(true, 4);
+    publish(Message::Priority::LOW);
+    publish(Message::Priority::HIGH, 20);
+
+    auto order = drain();
+    ASSERT_EQ(order.size(), 21u);
+    auto low = std::find(order.begin(), order.end(), Message::Priority::LOW) - order.begin();
+    EXPECT_EQ(low, 4);
+}
+
+TEST_F(ChannelPriorityTest, StrictPriorityWithoutStarvationLimit) {
+    channel_->set_priority_dispatch(true, 0);
+    publish(Message::Priority::LOW);
+    publish(Message::Priority::HIGH, 20);
+
+    auto order = drain();
+    ASSERT_EQ(order.size(), 21u);
+    EXPECT_EQ(order.back(), Message::Priority::LOW);
+}
+
+TEST_F(ChannelPriorityTest, DisabledPriorityIsPlainFifo) {
+    channel_->set_priority_dispatch(false, 0);
+    publish(Message::Priority::NORMAL);
+    publish(Message::Priority::REALTIME);
+
+    auto order = drain();
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order.front(), Message::Priority::NORMAL);
+}
+
+TEST_F(ChannelPriorityTest, RecordsLatencyPerLane) {
+    MessageBusStats stats;
+    channel_->set_stats(&stats);
+    publish(Message::Priority::REALTIME, 3);
+    publish(Message::Priority::LOW);
+    drain();
+
+    EXPECT_EQ(stats.lane_latency[static_cast<size_t>(PriorityLane::REALTIME)].count(), 3u);
+    EXPECT_EQ(stats.lane_latency[static_cast<size_t>(PriorityLane::LOW)].count(), 1u);
+    EXPECT_EQ(stats.lane_latency[static_cast<size_t>(PriorityLane::NORMAL)].count(), 0u);
+    EXPECT_GT(stats.latency_percentile(PriorityLane::REALTIME, 0.99), 0);
+    EXPECT_GT(stats.max_latency_ns.load(), 0);
+}
+
 // ============================================================================
 // TopicMatcher Tests - Additional Coverage
 // ============================================================================
@@ -650,7 +1412,6 @@ TEST_F(TopicMatcherTest, MultiLevelWildcard) {
 
 TEST_F(TopicMatcherTest, TrailingHashWildcard) {
     // Test the trailing # wildcard
-    // Note: In this implementation, # must have content to match after the separator
     EXPECT_TRUE(TopicMatcher::matches("a/b/#", "a/b/c"));
     EXPECT_TRUE(TopicMatcher::matches("a/b/#", "a/b/c/d/e"));
     EXPECT_TRUE(TopicMatcher::matches("a/#", "a/b"));
@@ -721,3 +1482,92 @@ TEST_F(TopicMatcherTest, ComplexPatterns) {
     EXPECT_TRUE(TopicMatcher::matches("a/*/c/*/e", "a/b/c/d/e"));
     EXPECT_TRUE(TopicMatcher::matches("building/*/floor/*", "building/A/floor/1"));
 }
+
+TEST_F(TopicMatcherTest, PlusIsSingleLevelWildcard) {
+    EXPECT_TRUE(TopicMatcher::has_wildcards("sensors/+"));
+    EXPECT_TRUE(TopicMatcher::is_valid("sensors/+/value"));
+    EXPECT_FALSE(TopicMatcher::is_valid("sensors+"));
+    EXPECT_TRUE(TopicMatcher::matches("sensors/+/value", "sensors/a/value"));
+    EXPECT_FALSE(TopicMatcher::matches("sensors/+", "sensors/a/value"));
+}
+
+TEST_F(TopicMatcherTest, HashMatchesParentLevel) {
+    EXPECT_TRUE(TopicMatcher::matches("a/#", "a"));
+    EXPECT_TRUE(TopicMatcher::matches("a/+/#", "a/b"));
+    EXPECT_FALSE(TopicMatcher::matches("a/b/#", "a"));
+}
+
+// ============================================================================
+// TopicTrie Tests
+// ============================================================================
+
+#include <ipb/core/message_bus/topic_trie.hpp>
+
+class TopicTrieTest : public ::testing::Test {
+protected:
+    static std::vector<uint64_t> ids(const WildcardSubscribers& subscribers) {
+        std::vector<uint64_t> result;
+        for (const auto& subscriber : subscribers) {
+            result.push_back(subscriber->id);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    TopicTrie trie_;
+};
+
+TEST_F(TopicTrieTest, AgreesWithTopicMatcher) {
+    const std::vector<std::string> patterns = {
+        "#",       "a/#",   "a/b/#", "a/+",   "a/*/c", "+/b",     "+/+/+",
+        "a/b/c",   "x/#",   "a/+/#", "*",     "a/b",   "+/b/c/#",
+    };
+    const std::vector<std::string> topics = {
+        "a", "a/b", "a/b/c", "a/b/c/d", "a/x/c", "x", "x/b", "x/y/z", "b/b/c/d",
+    };
+
+    std::vector<uint64_t> pattern_ids;
+    for (const auto& pattern : patterns) {
+        pattern_ids.push_back(trie_.insert(pattern, [](const Message&) {}));
+        ASSERT_NE(pattern_ids.back(), 0u) << pattern;
+    }
+
+    for (const auto& topic : topics) {
+        std::vector<uint64_t> expected;
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            if (TopicMatcher::matches(patterns[i], topic)) {
+                expected.push_back(pattern_ids[i]);
+            }
+        }
+        EXPECT_EQ(ids(trie_.match(topic)), expected) << topic;
+    }
+}
+
+TEST_F(TopicTrieTest, RemoveBumpsGenerationAndDeactivates) {
+    auto id = trie_.insert("a/+/c", [](const Message&) {});
+    ASSERT_NE(id, 0u);
+    EXPECT_TRUE(trie_.contains(id));
+    EXPECT_EQ(trie_.size(), 1u);
+
+    auto cached     = trie_.match("a/b/c");
+    auto generation = trie_.generation();
+    ASSERT_EQ(cached.size(), 1u);
+
+    EXPECT_TRUE(trie_.remove(id));
+    EXPECT_FALSE(trie_.remove(id));
+    EXPECT_FALSE(trie_.contains(id));
+    EXPECT_EQ(trie_.size(), 0u);
+    EXPECT_NE(trie_.generation(), generation);
+
+    // A list resolved before the removal no longer delivers to it
+    EXPECT_FALSE(cached.front()->active.load());
+    EXPECT_TRUE(trie_.match("a/b/c").empty());
+}
+
+TEST_F(TopicTrieTest, RejectsInvalidPattern) {
+    auto generation = trie_.generation();
+    EXPECT_EQ(trie_.insert("a/#/b", [](const Message&) {}), 0u);
+    EXPECT_EQ(trie_.insert("", [](const Message&) {}), 0u);
+    EXPECT_EQ(trie_.generation(), generation);
+    EXPECT_EQ(trie_.size(), 0u);
+}
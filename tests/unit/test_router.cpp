@@ -8,6 +8,7 @@
  * - router::RouterConfig: Configuration
  * - RuleBuilder: Fluent rule construction
  * - Router: Core routing functionality
+ * - MicroBatcher: Per-rule micro-batching
  */
 
 #include <ipb/router/router.hpp>
@@ -16,7 +17,10 @@
 #include <chrono>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -44,8 +48,14 @@ struct RouterMockSinkState {
     std::atomic<bool> started{false};
     std::atomic<bool> healthy{true};
     std::atomic<int> write_count{0};
+    std::atomic<int> batch_calls{0};
+    std::atomic<bool> hold{false};  // write() blocks while set
     std::string last_address;
 
+    // Addresses received through write_batch(), in arrival order
+    std::mutex received_mutex;
+    std::vector<std::string> received;
+
     explicit RouterMockSinkState(const std::string& n) : name(n) {}
 };
 
@@ -79,6 +89,9 @@ public:
 
     // IIPBSinkBase interface
     Result<void> write(const DataPoint& dp) override {
+        while (state_->hold.load()) {
+            std::this_thread::yield();
+        }
         state_->write_count++;
         state_->last_address = std::string(dp.address());
         return ok();
@@ -86,6 +99,11 @@ public:
 
     Result<void> write_batch(std::span<const DataPoint> batch) override {
         state_->write_count += static_cast<int>(batch.size());
+        state_->batch_calls++;
+        std::lock_guard lock(state_->received_mutex);
+        for (const auto& dp : batch) {
+            state_->received.emplace_back(dp.address());
+        }
         return ok();
     }
 
@@ -133,7 +151,13 @@ public:
 
     // Access mock state for test assertions
     void set_healthy(bool h) { state_->healthy = h; }
+    void set_hold(bool h) { state_->hold = h; }
     int write_count() const { return state_->write_count.load(); }
+    int batch_calls() const { return state_->batch_calls.load(); }
+    std::vector<std::string> received() const {
+        std::lock_guard lock(state_->received_mutex);
+        return state_->received;
+    }
     std::string last_address() const { return state_->last_address; }
     bool is_started() const { return state_->started; }
 
@@ -674,6 +698,485 @@ TEST_F(MessageRoutingTest, RouteBatch) {
     (void)router.stop();
 }
 
+TEST_F(MessageRoutingTest, RouteBatchWritesOneBatchPerSink) {
+    router::Router router(config_);
+
+    auto sink_a = std::make_shared<RouterMockSink>("sink_a");
+    auto sink_b = std::make_shared<RouterMockSink>("sink_b");
+    ASSERT_TRUE(router.register_sink("a", sink_a->get()).is_success());
+    ASSERT_TRUE(router.register_sink("b", sink_b->get()).is_success());
+
+    auto rule_a = router::RuleBuilder().name("a").match_pattern("a/.*").route_to("a").build();
+    ASSERT_TRUE(router.add_rule(rule_a).is_success());
+    auto rule_b = router::RuleBuilder().name("b").match_pattern("b/.*").route_to("b").build();
+    ASSERT_TRUE(router.add_rule(rule_b).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    std::vector<DataPoint> batch;
+    std::vector<std::string> expected_a;
+    std::vector<std::string> expected_b;
+    for (int i = 0; i < 100; ++i) {
+        std::string address = (i % 3 == 0 ? "b/" : "a/") + std::to_string(i);
+        (i % 3 == 0 ? expected_b : expected_a).push_back(address);
+        batch.emplace_back(address);
+    }
+
+    EXPECT_TRUE(router.route_batch(batch).is_success());
+    (void)router.stop();
+
+    EXPECT_EQ(sink_a->batch_calls(), 1);
+    EXPECT_EQ(sink_b->batch_calls(), 1);
+    EXPECT_EQ(sink_a->received(), expected_a);
+    EXPECT_EQ(sink_b->received(), expected_b);
+}
+
+TEST_F(MessageRoutingTest, ParallelRouteBatchPreservesOrder) {
+    config_.parallel_batch_threshold = 64;
+    config_.batch_chunk_size         = 16;
+    router::Router router(config_);
+
+    auto sink = std::make_shared<RouterMockSink>("sink");
+    ASSERT_TRUE(router.register_sink("s", sink->get()).is_success());
+    auto rule_tags =
+        router::RuleBuilder().name("tags").match_pattern("tag/.*").route_to("s").build();
+    ASSERT_TRUE(router.add_rule(rule_tags).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    std::vector<DataPoint> batch;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 1000; ++i) {
+        std::string address = (i % 10 == 0 ? "other/" : "tag/") + std::to_string(i);
+        if (i % 10 != 0) {
+            expected.push_back(address);
+        }
+        batch.emplace_back(address);
+    }
+
+    for (int round = 0; round < 3; ++round) {
+        EXPECT_TRUE(router.route_batch(batch).is_success());
+    }
+    // Evaluation chunks were offered to the scheduler's workers
+    EXPECT_GT(router.scheduler().stats().tasks_submitted.load(), 0u);
+    (void)router.stop();
+
+    auto received = sink->received();
+    ASSERT_EQ(received.size(), expected.size() * 3);
+    EXPECT_EQ(sink->batch_calls(), 3);
+    for (size_t i = 0; i < received.size(); ++i) {
+        ASSERT_EQ(received[i], expected[i % expected.size()]) << "at " << i;
+    }
+}
+
+TEST_F(MessageRoutingTest, RouteBatchDeadLettersUnmatched) {
+    router::Router router(config_);
+
+    auto sink = std::make_shared<RouterMockSink>("sink");
+    auto dlq  = std::make_shared<RouterMockSink>("dlq");
+    ASSERT_TRUE(router.register_sink("s", sink->get()).is_success());
+    ASSERT_TRUE(router.register_sink(config_.dead_letter_sink_id, dlq->get()).is_success());
+    auto rule_known =
+        router::RuleBuilder().name("known").match_address("known").route_to("s").build();
+    ASSERT_TRUE(router.add_rule(rule_known).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    std::vector<DataPoint> batch;
+    batch.emplace_back("unknown/1");
+    batch.emplace_back("known");
+    batch.emplace_back("unknown/2");
+
+    EXPECT_TRUE(router.route_batch(batch).is_success());
+    (void)router.stop();
+
+    EXPECT_EQ(sink->received(), std::vector<std::string>{"known"});
+    EXPECT_EQ(dlq->batch_calls(), 1);
+    EXPECT_EQ(dlq->received(), (std::vector<std::string>{"unknown/1", "unknown/2"}));
+}
+
+TEST_F(MessageRoutingTest, RouteAsyncNotRunning) {
+    router::Router router(config_);
+
+    DataPoint dp("sensors/temp1");
+    auto result = router.route_async(dp).get();
+    EXPECT_TRUE(result.is_error());
+    EXPECT_EQ(result.code(), common::ErrorCode::INVALID_STATE);
+}
+
+TEST_F(MessageRoutingTest, RouteAsyncCompletesOnScheduler) {
+    router::Router router(config_);
+    router.set_default_deadline_offset(std::chrono::seconds(10));
+
+    auto sink = std::make_shared<RouterMockSink>("sink");
+    ASSERT_TRUE(router.register_sink("s", sink->get()).is_success());
+    auto rule = router::RuleBuilder().name("r").match_pattern("sensors/.*").route_to("s").build();
+    ASSERT_TRUE(router.add_rule(rule).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    std::vector<std::future<Result<>>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.push_back(router.route_async(DataPoint("sensors/" + std::to_string(i))));
+    }
+    for (auto& future : futures) {
+        EXPECT_TRUE(future.get().is_success());
+    }
+
+    EXPECT_EQ(sink->write_count(), 100);
+    EXPECT_EQ(router.pending_async_routes(), 0u);
+    EXPECT_GE(router.scheduler().stats().tasks_submitted.load(), 100u);
+    (void)router.stop();
+}
+
+TEST_F(MessageRoutingTest, RouteAsyncCallback) {
+    router::Router router(config_);
+    router.set_default_deadline_offset(std::chrono::seconds(10));
+
+    auto sink = std::make_shared<RouterMockSink>("sink");
+    ASSERT_TRUE(router.register_sink("s", sink->get()).is_success());
+    auto rule =
+        router::RuleBuilder().name("r").match_address("sensors/temp1").route_to("s").build();
+    ASSERT_TRUE(router.add_rule(rule).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    std::atomic<int> completed{0};
+    std::atomic<int> succeeded{0};
+    for (int i = 0; i < 10; ++i) {
+        auto queued = router.route_async(DataPoint("sensors/temp1"), [&](Result<> result) {
+            if (result.is_success()) {
+                succeeded++;
+            }
+            completed++;
+        });
+        ASSERT_TRUE(queued.is_success());
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (completed.load() < 10 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    (void)router.stop();
+
+    EXPECT_EQ(completed.load(), 10);
+    EXPECT_EQ(succeeded.load(), 10);
+}
+
+TEST_F(MessageRoutingTest, RouteAsyncRejectsWhenTooManyPending) {
+    config_.max_pending_async_routes          = 1;
+    router::Router router(config_);
+    router.set_default_deadline_offset(std::chrono::seconds(10));
+
+    auto sink = std::make_shared<RouterMockSink>("sink");
+    ASSERT_TRUE(router.register_sink("s", sink->get()).is_success());
+    auto rule =
+        router::RuleBuilder().name("r").match_address("sensors/temp1").route_to("s").build();
+    ASSERT_TRUE(router.add_rule(rule).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    sink->set_hold(true);
+    auto first = router.route_async(DataPoint("sensors/temp1"));
+    EXPECT_EQ(router.pending_async_routes(), 1u);
+
+    auto rejected = router.route_async(DataPoint("sensors/temp1")).get();
+    EXPECT_EQ(rejected.code(), common::ErrorCode::SCHEDULER_OVERLOADED);
+
+    sink->set_hold(false);
+    EXPECT_TRUE(first.get().is_success());
+    EXPECT_EQ(router.pending_async_routes(), 0u);
+    (void)router.stop();
+}
+
+TEST_F(MessageRoutingTest, RouteAsyncCancelledOnStop) {
+    config_.scheduler.worker_threads = 1;
+    router::Router router(config_);
+    router.set_default_deadline_offset(std::chrono::seconds(10));
+
+    auto sink = std::make_shared<RouterMockSink>("sink");
+    ASSERT_TRUE(router.register_sink("s", sink->get()).is_success());
+    auto rule =
+        router::RuleBuilder().name("r").match_address("sensors/temp1").route_to("s").build();
+    ASSERT_TRUE(router.add_rule(rule).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    // The first route blocks the only worker; the rest stay queued
+    sink->set_hold(true);
+    std::vector<std::future<Result<>>> futures;
+    for (int i = 0; i < 4; ++i) {
+        futures.push_back(router.route_async(DataPoint("sensors/temp1")));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::thread stopper([&router] { (void)router.stop(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sink->set_hold(false);
+    stopper.join();
+
+    int cancelled = 0;
+    for (auto& future : futures) {
+        ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        auto result = future.get();
+        if (result.code() == common::ErrorCode::TASK_CANCELLED) {
+            ++cancelled;
+        } else {
+            EXPECT_TRUE(result.is_success());
+        }
+    }
+    EXPECT_EQ(cancelled, 3);
+    EXPECT_EQ(router.pending_async_routes(), 0u);
+}
+
+TEST_F(MessageRoutingTest, MoveWaitsForAsyncRoutes) {
+    router::Router router(config_);
+    router.set_default_deadline_offset(std::chrono::seconds(10));
+
+    auto sink = std::make_shared<RouterMockSink>("sink");
+    ASSERT_TRUE(router.register_sink("s", sink->get()).is_success());
+    auto rule =
+        router::RuleBuilder().name("r").match_address("sensors/temp1").route_to("s").build();
+    ASSERT_TRUE(router.add_rule(rule).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    sink->set_hold(true);
+    auto first  = router.route_async(DataPoint("sensors/temp1"));
+    auto second = router.route_async(DataPoint("sensors/temp1"));
+
+    std::thread releaser([&sink] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        sink->set_hold(false);
+    });
+    router::Router moved(std::move(router));
+    releaser.join();
+
+    EXPECT_TRUE(first.get().is_success());
+    EXPECT_TRUE(second.get().is_success());
+    EXPECT_TRUE(moved.route_async(DataPoint("sensors/temp1")).get().is_success());
+    EXPECT_EQ(moved.pending_async_routes(), 0u);
+    EXPECT_EQ(sink->write_count(), 3);
+    (void)moved.stop();
+}
+
+// ============================================================================
+// Micro-Batching Tests
+// ============================================================================
+
+class MicroBatchingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_                                   = router::RouterConfig::default_config();
+        config_.message_bus.dispatcher_threads    = 2;
+        config_.scheduler.worker_threads          = 2;
+        config_.sink_registry.enable_health_check = false;
+    }
+
+    router::RouterConfig config_;
+};
+
+TEST_F(MicroBatchingTest, FlushesWhenBatchIsFull) {
+    std::vector<size_t> written;
+    router::MicroBatcher batcher([&](std::string_view, std::span<const DataPoint> batch) {
+        written.push_back(batch.size());
+        return true;
+    });
+    batcher.set_policy(7, router::BatchPolicy{4, std::chrono::hours(1)});
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(batcher.add(7, "sink", DataPoint("a/" + std::to_string(i))));
+    }
+    EXPECT_FALSE(batcher.add(8, "sink", DataPoint("a/x")));
+    EXPECT_EQ(written, (std::vector<size_t>{4, 4}));
+
+    auto stats = batcher.stats(7);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->pending, 2u);
+    EXPECT_EQ(stats->size_flushes, 2u);
+
+    batcher.flush_all();
+    EXPECT_EQ(written, (std::vector<size_t>{4, 4, 2}));
+    EXPECT_EQ(batcher.messages_batched(), 10u);
+}
+
+TEST_F(MicroBatchingTest, FlushesAfterTimeout) {
+    std::atomic<int> points{0};
+    router::MicroBatcher batcher(
+        [&](std::string_view, std::span<const DataPoint> batch) {
+            points += static_cast<int>(batch.size());
+            return true;
+        },
+        std::chrono::milliseconds(1));
+    batcher.set_policy(1, router::BatchPolicy{1000, std::chrono::milliseconds(5)});
+    batcher.start();
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(batcher.add(1, "sink", DataPoint("a")));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (points.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    batcher.stop();
+
+    EXPECT_EQ(points.load(), 3);
+    auto stats = batcher.stats(1);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->timeout_flushes, 1u);
+}
+
+TEST_F(MicroBatchingTest, ShortTimeoutWakesSleepingFlusher) {
+    std::atomic<int> points{0};
+    router::MicroBatcher batcher(
+        [&](std::string_view sink_id, std::span<const DataPoint> batch) {
+            if (sink_id == "fast") {
+                points += static_cast<int>(batch.size());
+            }
+            return true;
+        },
+        std::chrono::milliseconds(1));
+    batcher.set_policy(1, router::BatchPolicy{1000, std::chrono::hours(1)});
+    batcher.start();
+
+    // The flusher now sleeps until rule 1's deadline an hour away
+    EXPECT_TRUE(batcher.add(1, "slow", DataPoint("a")));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    batcher.set_policy(2, router::BatchPolicy{1000, std::chrono::milliseconds(5)});
+    EXPECT_TRUE(batcher.add(2, "fast", DataPoint("b")));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (points.load() < 1 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(points.load(), 1);
+    EXPECT_EQ(batcher.stats(1)->pending, 1u);
+    batcher.stop();
+}
+
+TEST_F(MicroBatchingTest, BatchesOfOneSinkAreWrittenInOrder) {
+    const auto producer = std::this_thread::get_id();
+    std::mutex mutex;
+    std::vector<uint32_t> sequence;
+    router::MicroBatcher batcher(
+        [&](std::string_view, std::span<const DataPoint> batch) {
+            // Hold timeout flushes so the next size flush overtakes them if unordered
+            if (std::this_thread::get_id() != producer) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            std::lock_guard lock(mutex);
+            for (const auto& dp : batch) {
+                sequence.push_back(dp.sequence_number());
+            }
+            return true;
+        },
+        std::chrono::milliseconds(1));
+    batcher.set_policy(1, router::BatchPolicy{3, std::chrono::milliseconds(1)});
+    batcher.start();
+
+    uint32_t next = 0;
+    auto add      = [&] {
+        DataPoint dp("a");
+        dp.set_sequence_number(next++);
+        EXPECT_TRUE(batcher.add(1, "sink", dp));
+    };
+    for (int round = 0; round < 5; ++round) {
+        // One point goes out by timeout, the next three by size while it is being written
+        add();
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        add();
+        add();
+        add();
+    }
+    batcher.stop();
+
+    ASSERT_EQ(sequence.size(), next);
+    for (uint32_t i = 0; i < next; ++i) {
+        ASSERT_EQ(sequence[i], i);
+    }
+}
+
+TEST_F(MicroBatchingTest, RecordsBatchFillHistogram) {
+    router::MicroBatcher batcher([](std::string_view, std::span<const DataPoint>) { return true; });
+    batcher.set_policy(1, router::BatchPolicy{10, std::chrono::hours(1)});
+
+    // One full batch (fill 1.0) and one with 2 of 10 points (fill 0.2)
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_TRUE(batcher.add(1, "sink", DataPoint("a")));
+    }
+    batcher.flush_all();
+
+    auto stats = batcher.stats(1);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->batches_flushed, 2u);
+    EXPECT_DOUBLE_EQ(stats->avg_fill_ratio(), 0.6);
+    ASSERT_EQ(stats->fill_buckets, router::MicroBatcher::FILL_BUCKETS);
+    ASSERT_EQ(stats->fill_counts.size(), stats->fill_buckets.size() + 1);
+    EXPECT_EQ(stats->fill_counts[0], 0u);      // <= 0.1
+    EXPECT_EQ(stats->fill_counts[1], 1u);      // <= 0.25
+    EXPECT_EQ(stats->fill_counts.back(), 2u);  // +Inf
+}
+
+TEST_F(MicroBatchingTest, PolicyChangeFlushesPendingPoints) {
+    std::vector<size_t> written;
+    router::MicroBatcher batcher([&](std::string_view, std::span<const DataPoint> batch) {
+        written.push_back(batch.size());
+        return true;
+    });
+    batcher.set_policy(1, router::BatchPolicy{10, std::chrono::hours(1)});
+    EXPECT_TRUE(batcher.add(1, "sink", DataPoint("a")));
+    EXPECT_TRUE(batcher.add(1, "sink", DataPoint("a")));
+
+    batcher.set_policy(1, router::BatchPolicy{2, std::chrono::hours(1)});
+    EXPECT_EQ(written, (std::vector<size_t>{2}));
+
+    batcher.remove_policy(1);
+    EXPECT_FALSE(batcher.has_policies());
+    EXPECT_FALSE(batcher.add(1, "sink", DataPoint("a")));
+}
+
+TEST_F(MicroBatchingTest, RouterBatchesPerRule) {
+    router::Router router(config_);
+
+    auto batched = std::make_shared<RouterMockSink>("batched");
+    auto direct  = std::make_shared<RouterMockSink>("direct");
+    ASSERT_TRUE(router.register_sink("b", batched->get()).is_success());
+    ASSERT_TRUE(router.register_sink("d", direct->get()).is_success());
+
+    auto batched_rule = router::RuleBuilder()
+                            .name("batched")
+                            .match_pattern("b/.*")
+                            .route_to("b")
+                            .enable_batching(10, std::chrono::hours(1))
+                            .build();
+    auto batched_id = router.add_rule(batched_rule);
+    ASSERT_TRUE(batched_id.is_success());
+    auto direct_rule =
+        router::RuleBuilder().name("direct").match_pattern("d/.*").route_to("d").build();
+    ASSERT_TRUE(router.add_rule(direct_rule).is_success());
+    ASSERT_TRUE(router.start().is_success());
+
+    for (int i = 0; i < 25; ++i) {
+        EXPECT_TRUE(router.route(DataPoint("b/" + std::to_string(i))).is_success());
+        EXPECT_TRUE(router.route(DataPoint("d/" + std::to_string(i))).is_success());
+    }
+
+    EXPECT_EQ(batched->batch_calls(), 2);
+    EXPECT_EQ(batched->received().size(), 20u);
+    EXPECT_EQ(direct->batch_calls(), 0);
+    EXPECT_EQ(direct->write_count(), 25);
+
+    auto rule = router.get_rule(batched_id.value());
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_TRUE(rule->enable_batching);
+    EXPECT_EQ(rule->batch_size, 10u);
+
+    // Stopping flushes the partial batch
+    (void)router.stop();
+    EXPECT_EQ(batched->batch_calls(), 3);
+    EXPECT_EQ(batched->received().size(), 25u);
+    EXPECT_EQ(router.get_metrics().batches_flushed, 3u);
+
+    auto stats = router.get_batching_stats(batched_id.value());
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->size_flushes, 2u);
+    EXPECT_EQ(stats->messages_batched, 25u);
+}
+
 // ============================================================================
 // Scheduler Control Tests
 // ============================================================================
@@ -8,11 +8,23 @@
  * - RoutingRule: Rule definition and evaluation
  * - RuleBuilder: Fluent rule construction
  * - RuleEngine: Rule management and evaluation
+ * - RuleIndex: Candidate selection equivalent to a linear scan
+ * - MatchCache: Sharded result cache with TTL, eviction and epochs
+ * - Rule snapshots: versioned, atomically replaced rule tables
+ * - CompiledCondition: COMPOSITE rule condition trees
+ * - Batch evaluation: column-wise VALUE rules and per-rule match bitmaps
  */
 
+#include <ipb/core/rule_engine/compiled_condition.hpp>
+#include <ipb/core/rule_engine/match_cache.hpp>
 #include <ipb/core/rule_engine/rule_engine.hpp>
+#include <ipb/core/rule_engine/rule_index.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -196,6 +208,41 @@ TEST_F(RoutingRuleTest, AverageEvalTime) {
     EXPECT_DOUBLE_EQ(rule.avg_eval_time_ns(), 500.0);  // 500ns average
 }
 
+TEST_F(RoutingRuleTest, BuilderCompilesPattern) {
+    auto rule = RuleBuilder().match_pattern("sensors/temp.*").route_to("sink").build();
+
+    ASSERT_NE(rule.pattern_matcher(), nullptr);
+    EXPECT_EQ(rule.compiled_pattern->source, "sensors/temp.*");
+
+    // Copies share the same immutable compiled form
+    RoutingRule copy(rule);
+    EXPECT_EQ(copy.compiled_pattern.get(), rule.compiled_pattern.get());
+}
+
+TEST_F(RoutingRuleTest, StalePatternIsNotUsed) {
+    auto rule = RuleBuilder().match_pattern("sensors/temp.*").route_to("sink").build();
+
+    rule.address_pattern = "alarms/.*";
+    EXPECT_EQ(rule.pattern_matcher(), nullptr);
+    EXPECT_TRUE(rule.evaluate(DataPoint("alarms/high")).matched);
+    EXPECT_FALSE(rule.evaluate(DataPoint("sensors/temp1")).matched);
+
+    rule.compile_pattern();
+    ASSERT_NE(rule.pattern_matcher(), nullptr);
+    EXPECT_EQ(rule.compiled_pattern->source, "alarms/.*");
+}
+
+TEST_F(RoutingRuleTest, NoCompilationInSteadyState) {
+    auto rule = RuleBuilder().match_pattern("sensors/(\\w+)/temp").route_to("sink").build();
+
+    auto before = PatternMatcherFactory::compilation_count();
+    for (int i = 0; i < 100; ++i) {
+        auto result = rule.evaluate(DataPoint("sensors/room" + std::to_string(i) + "/temp"));
+        EXPECT_TRUE(result.matched);
+    }
+    EXPECT_EQ(PatternMatcherFactory::compilation_count(), before);
+}
+
 // ============================================================================
 // RuleEngineStats Tests
 // ============================================================================
@@ -260,6 +307,7 @@ TEST_F(RuleEngineConfigTest, DefaultValues) {
     EXPECT_EQ(config.cache_size, 65536u);
     EXPECT_TRUE(config.prefer_ctre);
     EXPECT_TRUE(config.precompile_patterns);
+    EXPECT_TRUE(config.enable_rule_index);
 }
 
 // ============================================================================
@@ -666,3 +714,1037 @@ TEST_F(RuleEngineTest, MoveConstruction) {
     RuleEngine engine2(std::move(engine1));
     EXPECT_EQ(engine2.rule_count(), 1u);
 }
+
+TEST_F(RuleEngineTest, NoPatternCompilationInSteadyState) {
+    config_.enable_cache = false;
+    RuleEngine engine(config_);
+
+    auto id = engine.add_rule(
+        RuleBuilder().name("temps").match_pattern("sensors/.*/temp").route_to("sink").build());
+    engine.add_rule(RuleBuilder().name("all").match_pattern(".*").route_to("sink").build());
+
+    auto copy = engine.get_rule(id);
+    ASSERT_TRUE(copy.has_value());
+
+    auto before = PatternMatcherFactory::compilation_count();
+    for (int i = 0; i < 100; ++i) {
+        DataPoint dp("sensors/room" + std::to_string(i) + "/temp");
+        EXPECT_EQ(engine.evaluate(dp).size(), 2u);
+        EXPECT_TRUE(engine.evaluate_first(dp).has_value());
+        EXPECT_TRUE(copy->evaluate(dp).matched);
+    }
+    EXPECT_EQ(PatternMatcherFactory::compilation_count(), before);
+}
+
+TEST_F(RuleEngineTest, EvaluateIntoReportsSinkHandles) {
+    RuleEngine engine(config_);
+
+    auto temps = engine.add_rule(RuleBuilder()
+                                     .name("temps")
+                                     .match_pattern("sensors/(\\w+)/temp")
+                                     .route_to(std::vector<std::string>{"influx", "kafka"})
+                                     .build());
+    auto all   = engine.add_rule(RuleBuilder()
+                                     .name("all")
+                                     .priority(RulePriority::LOW)
+                                     .match_pattern(".*")
+                                     .route_to("archive")
+                                     .build());
+
+    RuleMatchSet matches;
+    EXPECT_EQ(engine.evaluate_into(DataPoint("sensors/room1/temp"), matches), 2u);
+    ASSERT_EQ(matches.size(), 2u);
+
+    const auto& interner = engine.sink_interner();
+    EXPECT_EQ(matches[0].rule_id, temps);
+    ASSERT_EQ(matches[0].sinks.size(), 2u);
+    EXPECT_EQ(interner.id(matches[0].sinks[0]), "influx");
+    EXPECT_EQ(interner.id(matches[0].sinks[1]), "kafka");
+    EXPECT_TRUE(matches[0].captured_groups.empty());
+
+    EXPECT_EQ(matches[1].rule_id, all);
+    ASSERT_EQ(matches[1].sinks.size(), 1u);
+    EXPECT_EQ(interner.id(matches[1].sinks[0]), "archive");
+
+    // Reuse clears previous results
+    EXPECT_EQ(engine.evaluate_into(DataPoint("other"), matches), 1u);
+    EXPECT_EQ(matches[0].rule_id, all);
+}
+
+TEST_F(RuleEngineTest, EvaluateIntoCapturesGroupsOnRequest) {
+    RuleEngine engine(config_);
+    engine.add_rule(
+        RuleBuilder().name("temps").match_pattern("sensors/(\\w+)/temp").route_to("sink").build());
+
+    RuleMatchSet matches;
+    engine.evaluate_into(DataPoint("sensors/room7/temp"), matches, true);
+    ASSERT_EQ(matches.size(), 1u);
+
+    auto string_result = engine.evaluate(DataPoint("sensors/room7/temp"));
+    ASSERT_EQ(string_result.size(), 1u);
+    EXPECT_EQ(std::vector<std::string>(matches[0].captured_groups.begin(),
+                                       matches[0].captured_groups.end()),
+              string_result[0].captured_groups);
+}
+
+TEST_F(RuleEngineTest, SharedSinkInterner) {
+    SinkRegistry registry;
+    auto kafka = registry.intern_sink_id("kafka");
+
+    RuleEngine engine(config_);
+    engine.add_rule(RuleBuilder().name("r").match_address("a").route_to("influx").build());
+    engine.set_sink_interner(registry.sink_interner());
+    engine.add_rule(RuleBuilder().name("k").match_address("a").route_to("kafka").build());
+
+    RuleMatchSet matches;
+    ASSERT_EQ(engine.evaluate_into(DataPoint("a"), matches), 2u);
+    EXPECT_EQ(registry.sink_id(matches[0].sinks[0]), "influx");
+    EXPECT_EQ(matches[1].sinks[0], kafka);
+}
+
+// ============================================================================
+// RuleIndex Tests
+// ============================================================================
+
+class RuleIndexTest : public ::testing::Test {
+protected:
+    static RuleEngineConfig make_config(bool use_index) {
+        RuleEngineConfig config;
+        config.enable_cache      = false;
+        config.enable_rule_index = use_index;
+        return config;
+    }
+
+    static std::vector<RoutingRule> mixed_rules() {
+        std::vector<RoutingRule> rules;
+        for (int i = 0; i < 40; ++i) {
+            rules.push_back(RuleBuilder()
+                                .name("static_" + std::to_string(i))
+                                .priority(i % 3 == 0 ? RulePriority::HIGH : RulePriority::NORMAL)
+                                .match_addresses({"plant/line" + std::to_string(i % 10) + "/temp",
+                                                  "plant/line" + std::to_string(i) + "/flow"})
+                                .route_to("s" + std::to_string(i))
+                                .build());
+        }
+        auto pattern_rule = [](std::string name, std::string pattern, std::string sink,
+                               RulePriority priority = RulePriority::NORMAL) {
+            return RuleBuilder()
+                .name(std::move(name))
+                .priority(priority)
+                .match_pattern(std::move(pattern))
+                .route_to(std::move(sink))
+                .build();
+        };
+        rules.push_back(pattern_rule("prefix", "plant/line1.*", "p"));
+        rules.push_back(pattern_rule("glob", "plant/*/temp", "g"));
+        rules.push_back(pattern_rule("alt", "plant/line2/temp|alarms/.*", "a"));
+        rules.push_back(pattern_rule("any", ".*flow", "f", RulePriority::LOW));
+        rules.push_back(pattern_rule("literal", "plant/line3/temp", "l"));
+        rules.push_back(RuleBuilder().name("proto").match_protocols({1, 7}).route_to("pr").build());
+        rules.push_back(RuleBuilder()
+                            .name("bad")
+                            .priority(RulePriority::HIGHEST)
+                            .match_quality(Quality::BAD)
+                            .route_to("q")
+                            .build());
+
+        ValueCondition hot;
+        hot.op        = CompareOp::GT;
+        hot.reference = 50.0;
+        rules.push_back(RuleBuilder().name("hot").match_value(hot).route_to("v").build());
+        rules.push_back(RuleBuilder()
+                            .name("custom")
+                            .match_custom([](const DataPoint& dp) { return dp.protocol_id() == 3; })
+                            .route_to("c")
+                            .build());
+        return rules;
+    }
+
+    static std::vector<DataPoint> probe_points() {
+        std::vector<DataPoint> points;
+        const Quality qualities[] = {Quality::GOOD, Quality::BAD, Quality::STALE};
+        for (int i = 0; i < 60; ++i) {
+            std::string address = (i % 4 == 0)   ? "plant/line" + std::to_string(i % 12) + "/temp"
+                                  : (i % 4 == 1) ? "plant/line" + std::to_string(i) + "/flow"
+                                  : (i % 4 == 2) ? "alarms/critical/" + std::to_string(i)
+                                                 : "unmatched/" + std::to_string(i);
+            DataPoint dp(address, Value{}, static_cast<uint16_t>(i % 8));
+            dp.set_value(static_cast<double>(i));
+            dp.set_quality(qualities[i % 3]);
+            points.push_back(dp);
+        }
+        return points;
+    }
+
+    static std::vector<uint32_t> ids(const std::vector<RuleMatchResult>& results) {
+        std::vector<uint32_t> out;
+        for (const auto& r : results) {
+            out.push_back(r.rule_id);
+        }
+        return out;
+    }
+};
+
+TEST_F(RuleIndexTest, LiteralPrefix) {
+    EXPECT_EQ(RuleIndex::literal_prefix("sensors/temp1"), "sensors/temp1");
+    EXPECT_EQ(RuleIndex::literal_prefix("sensors/temp.*"), "sensors/temp");
+    EXPECT_EQ(RuleIndex::literal_prefix("sensors/temp*"), "sensors/tem");
+    EXPECT_EQ(RuleIndex::literal_prefix("sensors/t?"), "sensors/");
+    EXPECT_EQ(RuleIndex::literal_prefix("sensors/(a|b)"), "");
+    EXPECT_EQ(RuleIndex::literal_prefix(".*temp"), "");
+    EXPECT_EQ(RuleIndex::literal_prefix("^sensors"), "");
+    EXPECT_EQ(RuleIndex::literal_prefix(""), "");
+}
+
+TEST_F(RuleIndexTest, IndexedMatchesLinearScan) {
+    RuleEngine indexed(make_config(true));
+    RuleEngine linear(make_config(false));
+
+    for (const auto& rule : mixed_rules()) {
+        indexed.add_rule(rule);
+        linear.add_rule(rule);
+    }
+
+    for (const auto& dp : probe_points()) {
+        SCOPED_TRACE(std::string(dp.address()));
+        EXPECT_EQ(ids(indexed.evaluate(dp)), ids(linear.evaluate(dp)));
+        EXPECT_EQ(ids(indexed.evaluate_priority(dp, RulePriority::HIGH)),
+                  ids(linear.evaluate_priority(dp, RulePriority::HIGH)));
+
+        auto first_indexed = indexed.evaluate_first(dp);
+        auto first_linear  = linear.evaluate_first(dp);
+        ASSERT_EQ(first_indexed.has_value(), first_linear.has_value());
+        if (first_indexed) {
+            EXPECT_EQ(first_indexed->rule_id, first_linear->rule_id);
+        }
+    }
+
+    EXPECT_LT(indexed.stats().rules_evaluated.load(), linear.stats().rules_evaluated.load());
+}
+
+TEST_F(RuleIndexTest, OnlyCandidatesAreEvaluated) {
+    RuleEngine engine(make_config(true));
+
+    for (int i = 0; i < 1000; ++i) {
+        engine.add_rule(RuleBuilder()
+                            .name("r" + std::to_string(i))
+                            .match_address("tag/" + std::to_string(i))
+                            .route_to("sink")
+                            .build());
+    }
+
+    auto results = engine.evaluate(DataPoint("tag/500"));
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(engine.stats().rules_evaluated.load(), 1u);
+
+    EXPECT_TRUE(engine.evaluate(DataPoint("tag/unknown")).empty());
+    EXPECT_EQ(engine.stats().rules_evaluated.load(), 1u);
+}
+
+TEST_F(RuleIndexTest, IndexFollowsRuleMutations) {
+    RuleEngine engine(make_config(true));
+
+    auto id = engine.add_rule(
+        RuleBuilder().name("r").match_address("tag/a").route_to("sink").build());
+    EXPECT_EQ(engine.evaluate(DataPoint("tag/a")).size(), 1u);
+
+    engine.update_rule(id, RuleBuilder().name("r").match_address("tag/b").route_to("sink").build());
+    EXPECT_TRUE(engine.evaluate(DataPoint("tag/a")).empty());
+    EXPECT_EQ(engine.evaluate(DataPoint("tag/b")).size(), 1u);
+
+    engine.set_rule_enabled(id, false);
+    EXPECT_TRUE(engine.evaluate(DataPoint("tag/b")).empty());
+    engine.set_rule_enabled(id, true);
+
+    engine.remove_rule(id);
+    EXPECT_TRUE(engine.evaluate(DataPoint("tag/b")).empty());
+}
+
+TEST_F(RuleIndexTest, BuildDoesNotInternRuleAddresses) {
+    RuleEngine engine(make_config(true));
+    auto rule = [](std::string address) {
+        return RuleBuilder().name(address).match_address(address).route_to("s").build();
+    };
+    engine.add_rule(rule("rule_index/known"));
+    engine.add_rule(rule("rule_index/late"));
+    EXPECT_FALSE(StringInterner::global().find("rule_index/late").has_value());
+
+    // Interned before a rebuild: found through the ID index
+    DataPoint known(InternedString("rule_index/known"));
+    engine.add_rule(rule("rule_index/other"));
+    EXPECT_EQ(engine.evaluate(known).size(), 1u);
+
+    // Interned after the last build: found through the address string
+    DataPoint late(InternedString("rule_index/late"));
+    EXPECT_EQ(engine.evaluate(late).size(), 1u);
+    EXPECT_TRUE(engine.evaluate(DataPoint(InternedString("rule_index/none"))).empty());
+}
+
+TEST_F(RuleIndexTest, EqualPriorityKeepsInsertionOrder) {
+    RuleEngine engine(make_config(true));
+
+    std::vector<uint32_t> expected;
+    for (int i = 0; i < 5; ++i) {
+        expected.push_back(engine.add_rule(RuleBuilder()
+                                               .name("r" + std::to_string(i))
+                                               .match_pattern("tag/.*")
+                                               .route_to("s")
+                                               .build()));
+    }
+
+    EXPECT_EQ(ids(engine.evaluate(DataPoint("tag/x"))), expected);
+}
+
+// ============================================================================
+// MatchCache Tests
+// ============================================================================
+
+class MatchCacheTest : public ::testing::Test {
+protected:
+    static MatchCache::ResultsPtr results_for(uint32_t rule_id) {
+        RuleMatchResult result;
+        result.matched = true;
+        result.rule_id = rule_id;
+        return std::make_shared<const MatchCache::Results>(1, result);
+    }
+};
+
+TEST_F(MatchCacheTest, InsertAndFind) {
+    MatchCache cache(64, 4, std::chrono::milliseconds(0));
+
+    EXPECT_EQ(cache.find("a"), nullptr);
+    EXPECT_FALSE(cache.insert("a", results_for(1), cache.epoch()));
+
+    auto found = cache.find("a");
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ((*found)[0].rule_id, 1u);
+
+    // Overwrite keeps a single entry
+    cache.insert("a", results_for(2), cache.epoch());
+    EXPECT_EQ((*cache.find("a"))[0].rule_id, 2u);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(MatchCacheTest, ShardCountIsBounded) {
+    EXPECT_EQ(MatchCache(1024, 12, std::chrono::milliseconds(0)).shard_count(), 8u);
+    EXPECT_EQ(MatchCache(2, 16, std::chrono::milliseconds(0)).shard_count(), 2u);
+    EXPECT_EQ(MatchCache(0, 16, std::chrono::milliseconds(0)).shard_count(), 1u);
+}
+
+TEST_F(MatchCacheTest, BoundedWithEviction) {
+    MatchCache cache(16, 2, std::chrono::milliseconds(0));
+
+    size_t evictions = 0;
+    for (uint32_t i = 0; i < 200; ++i) {
+        if (cache.insert("addr/" + std::to_string(i), results_for(i), cache.epoch())) {
+            ++evictions;
+        }
+    }
+
+    EXPECT_LE(cache.size(), cache.capacity());
+    EXPECT_GT(evictions, 0u);
+
+    // Most recent insert is always present
+    auto last = cache.find("addr/199");
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ((*last)[0].rule_id, 199u);
+}
+
+TEST_F(MatchCacheTest, SlotsGrowOnDemand) {
+    // Tens of millions of slots would be allocated up front if storage were eager
+    std::vector<std::unique_ptr<MatchCache>> caches;
+    for (int i = 0; i < 8; ++i) {
+        caches.push_back(std::make_unique<MatchCache>(size_t{1} << 22, 16,
+                                                      std::chrono::milliseconds(0)));
+    }
+    EXPECT_EQ(caches[0]->capacity(), size_t{1} << 22);
+
+    // Growing past the first slots keeps earlier keys valid, and a cleared
+    // shard fills up and evicts again
+    MatchCache cache(64, 1, std::chrono::milliseconds(0));
+    for (int round = 0; round < 2; ++round) {
+        for (uint32_t i = 0; i < 64; ++i) {
+            EXPECT_FALSE(cache.insert("addr/" + std::to_string(i), results_for(i), cache.epoch()));
+        }
+        for (uint32_t i = 0; i < 64; ++i) {
+            ASSERT_NE(cache.find("addr/" + std::to_string(i)), nullptr);
+        }
+        EXPECT_TRUE(cache.insert("addr/extra", results_for(64), cache.epoch()));
+        cache.clear();
+    }
+}
+
+TEST_F(MatchCacheTest, ReferencedEntriesGetSecondChance) {
+    MatchCache cache(4, 1, std::chrono::milliseconds(0));
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        cache.insert("addr/" + std::to_string(i), results_for(i), cache.epoch());
+    }
+
+    // Keep addr/0 hot while new entries push the others out
+    for (uint32_t i = 4; i < 10; ++i) {
+        ASSERT_NE(cache.find("addr/0"), nullptr);
+        cache.insert("addr/" + std::to_string(i), results_for(i), cache.epoch());
+    }
+    EXPECT_NE(cache.find("addr/0"), nullptr);
+}
+
+TEST_F(MatchCacheTest, TtlExpiry) {
+    MatchCache cache(64, 1, std::chrono::milliseconds(5));
+
+    cache.insert("a", results_for(1), cache.epoch());
+    EXPECT_NE(cache.find("a"), nullptr);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(cache.find("a"), nullptr);
+}
+
+TEST_F(MatchCacheTest, EpochInvalidation) {
+    MatchCache cache(64, 4, std::chrono::milliseconds(0));
+
+    auto epoch = cache.epoch();
+    cache.insert("a", results_for(1), epoch);
+    cache.invalidate();
+
+    EXPECT_EQ(cache.find("a"), nullptr);
+
+    // Results computed before the invalidation are rejected
+    EXPECT_FALSE(cache.insert("b", results_for(2), epoch));
+    EXPECT_EQ(cache.find("b"), nullptr);
+
+    cache.insert("a", results_for(3), cache.epoch());
+    EXPECT_EQ((*cache.find("a"))[0].rule_id, 3u);
+}
+
+TEST_F(MatchCacheTest, EraseIfAndClear) {
+    MatchCache cache(64, 4, std::chrono::milliseconds(0));
+
+    cache.insert("sensors/1", results_for(1), cache.epoch());
+    cache.insert("sensors/2", results_for(2), cache.epoch());
+    cache.insert("alarms/1", results_for(3), cache.epoch());
+
+    cache.erase_if([](std::string_view a) { return a.starts_with("sensors/"); });
+    EXPECT_EQ(cache.find("sensors/1"), nullptr);
+    EXPECT_EQ(cache.find("sensors/2"), nullptr);
+    EXPECT_NE(cache.find("alarms/1"), nullptr);
+
+    cache.insert("sensors/1", results_for(4), cache.epoch());
+    EXPECT_NE(cache.find("sensors/1"), nullptr);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.find("alarms/1"), nullptr);
+}
+
+TEST_F(MatchCacheTest, InternedAddressKeys) {
+    MatchCache cache(64, 4, std::chrono::milliseconds(0));
+    InternedString sensor("match_cache/sensors/1");
+    InternedString alarm("match_cache/alarms/1");
+
+    EXPECT_EQ(cache.find(sensor), nullptr);
+    cache.insert(sensor, results_for(1), cache.epoch());
+    cache.insert(alarm, results_for(2), cache.epoch());
+
+    auto found = cache.find(sensor);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ((*found)[0].rule_id, 1u);
+    EXPECT_EQ(cache.size(), 2u);
+
+    // Pattern invalidation sees the interned text
+    cache.erase_if([](std::string_view a) { return a.starts_with("match_cache/sensors/"); });
+    EXPECT_EQ(cache.find(sensor), nullptr);
+    EXPECT_NE(cache.find(alarm), nullptr);
+
+    cache.invalidate();
+    EXPECT_EQ(cache.find(alarm), nullptr);
+}
+
+TEST_F(MatchCacheTest, InternedPointsMatchLikePlainPoints) {
+    RuleEngineConfig config;
+    config.cache_ttl_ms = 0;
+    RuleEngine engine(config);
+
+    engine.add_rule(RuleBuilder().name("a").match_address("plant/line1/temp").route_to("s1").build());
+    engine.add_rule(RuleBuilder().name("b").match_pattern("plant/line1/.*").route_to("s2").build());
+
+    DataPoint interned(InternedString("plant/line1/temp"));
+    ASSERT_NE(interned.address_id(), StringInterner::EMPTY_ID);
+
+    EXPECT_EQ(engine.evaluate(interned).size(), 2u);
+    EXPECT_EQ(engine.evaluate(interned).size(), 2u);
+    EXPECT_EQ(engine.evaluate(DataPoint("plant/line1/temp")).size(), 2u);
+    EXPECT_EQ(engine.stats().cache_hits.load(), 1u);
+
+    EXPECT_EQ(engine.evaluate(DataPoint(InternedString("plant/line1/flow"))).size(), 1u);
+}
+
+TEST_F(MatchCacheTest, RuleChangesInvalidateEngineCache) {
+    RuleEngineConfig config;
+    config.cache_ttl_ms = 0;
+    RuleEngine engine(config);
+
+    engine.add_rule(RuleBuilder().name("a").match_address("tag").route_to("s1").build());
+    EXPECT_EQ(engine.evaluate(DataPoint("tag")).size(), 1u);
+    EXPECT_EQ(engine.evaluate(DataPoint("tag")).size(), 1u);
+    EXPECT_EQ(engine.stats().cache_hits.load(), 1u);
+
+    auto id = engine.add_rule(RuleBuilder().name("b").match_address("tag").route_to("s2").build());
+    EXPECT_EQ(engine.evaluate(DataPoint("tag")).size(), 2u);
+
+    engine.set_rule_enabled(id, false);
+    EXPECT_EQ(engine.evaluate(DataPoint("tag")).size(), 1u);
+}
+
+TEST_F(MatchCacheTest, ConcurrentEvaluateWithRuleChanges) {
+    RuleEngineConfig config;
+    config.cache_size = 64;
+    RuleEngine engine(config);
+
+    for (int i = 0; i < 32; ++i) {
+        engine.add_rule(RuleBuilder()
+                            .name("r" + std::to_string(i))
+                            .match_address("tag/" + std::to_string(i))
+                            .route_to("sink")
+                            .build());
+    }
+
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 8; ++t) {
+        readers.emplace_back([&, t] {
+            for (int i = 0; i < 2000; ++i) {
+                auto results = engine.evaluate(DataPoint("tag/" + std::to_string((i + t) % 32)));
+                if (results.size() != 1) {
+                    wrong.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 50; ++i) {
+        auto id = engine.add_rule(
+            RuleBuilder().name("extra").match_address("extra").route_to("sink").build());
+        engine.remove_rule(id);
+    }
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(wrong.load(), 0);
+    EXPECT_LE(engine.stats().cache_evictions.load(), engine.stats().cache_misses.load());
+}
+
+// ============================================================================
+// Rule Snapshot Tests
+// ============================================================================
+
+class RuleSnapshotTest : public ::testing::Test {
+protected:
+    /// A rule set in which every rule routes "tag" to the given sink
+    static std::vector<RoutingRule> rule_set(const std::string& sink, int count) {
+        std::vector<RoutingRule> rules;
+        for (int i = 0; i < count; ++i) {
+            rules.push_back(RuleBuilder()
+                                .name(sink + "_" + std::to_string(i))
+                                .match_address("tag")
+                                .route_to(sink)
+                                .build());
+        }
+        return rules;
+    }
+};
+
+TEST_F(RuleSnapshotTest, VersionIncrementsOnEveryChange) {
+    RuleEngine engine;
+    auto v0 = engine.rules_version();
+
+    auto id = engine.add_rule(RuleBuilder().name("r").match_address("a").route_to("s").build());
+    EXPECT_GT(engine.rules_version(), v0);
+
+    auto v1 = engine.rules_version();
+    engine.set_rule_enabled(id, false);
+    EXPECT_GT(engine.rules_version(), v1);
+
+    // Failed mutations publish nothing
+    auto v2 = engine.rules_version();
+    EXPECT_FALSE(engine.remove_rule(id + 100));
+    EXPECT_EQ(engine.rules_version(), v2);
+
+    engine.replace_rules(rule_set("s", 3));
+    EXPECT_GT(engine.rules_version(), v2);
+}
+
+TEST_F(RuleSnapshotTest, ReplaceRulesSwapsWholeSet) {
+    RuleEngine engine;
+    engine.add_rule(RuleBuilder().name("old").match_address("tag").route_to("old").build());
+
+    auto ids = engine.replace_rules(rule_set("new", 3));
+    ASSERT_EQ(ids.size(), 3u);
+    EXPECT_EQ(engine.rule_count(), 3u);
+
+    auto results = engine.evaluate(DataPoint("tag"));
+    ASSERT_EQ(results.size(), 3u);
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].rule_id, ids[i]);
+        EXPECT_EQ(results[i].target_ids, std::vector<std::string>{"new"});
+    }
+
+    // New IDs keep increasing across replacements
+    auto more = engine.replace_rules(rule_set("newer", 1));
+    ASSERT_EQ(more.size(), 1u);
+    EXPECT_GT(more[0], ids.back());
+    EXPECT_FALSE(engine.get_rule(ids[0]).has_value());
+}
+
+TEST_F(RuleSnapshotTest, ReplaceRulesOrdersByPriority) {
+    RuleEngine engine;
+
+    auto rules        = rule_set("s", 3);
+    rules[2].priority = RulePriority::HIGHEST;
+    auto ids          = engine.replace_rules(std::move(rules));
+
+    auto results = engine.evaluate(DataPoint("tag"));
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].rule_id, ids[2]);
+    EXPECT_EQ(results[1].rule_id, ids[0]);
+    EXPECT_EQ(results[2].rule_id, ids[1]);
+}
+
+TEST_F(RuleSnapshotTest, UnchangedRulesKeepStatistics) {
+    RuleEngineConfig config;
+    config.enable_cache = false;
+    RuleEngine engine(config);
+
+    auto keep =
+        engine.add_rule(RuleBuilder().name("keep").match_address("a").route_to("s").build());
+    engine.evaluate(DataPoint("a"));
+
+    engine.add_rule(RuleBuilder().name("other").match_address("b").route_to("s").build());
+    engine.evaluate(DataPoint("a"));
+
+    auto rule = engine.get_rule(keep);
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->match_count.load(), 2u);
+}
+
+TEST_F(RuleSnapshotTest, ReadersSeeCompleteRuleSets) {
+    RuleEngine engine;
+    engine.replace_rules(rule_set("a", 4));
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto results = engine.evaluate(DataPoint("tag"));
+                // Either the complete "a" set (4 rules) or the complete "b" set (6 rules)
+                if (results.size() != 4 && results.size() != 6) {
+                    torn.fetch_add(1);
+                    continue;
+                }
+                const auto& sink = results.front().target_ids.front();
+                for (const auto& r : results) {
+                    if (r.target_ids.front() != sink) {
+                        torn.fetch_add(1);
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        engine.replace_rules(i % 2 == 0 ? rule_set("b", 6) : rule_set("a", 4));
+    }
+    done.store(true);
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+}
+
+// ============================================================================
+// Composite Rule Tests
+// ============================================================================
+
+class CompositeRuleTest : public ::testing::Test {
+protected:
+    using Kind = RuleCondition::Kind;
+
+    static ValueCondition greater_than(double reference) {
+        ValueCondition cond;
+        cond.op        = CompareOp::GT;
+        cond.reference = reference;
+        return cond;
+    }
+
+    static DataPoint point(std::string address, double value, uint16_t protocol = 0,
+                           Quality quality = Quality::GOOD) {
+        DataPoint dp(address, Value{}, protocol);
+        dp.set_value(static_cast<double>(value));
+        dp.set_quality(quality);
+        return dp;
+    }
+};
+
+TEST_F(CompositeRuleTest, AndOrNotSemantics) {
+    auto cond = RuleCondition::pattern("plant/.*") &&
+                (RuleCondition::quality(Quality::GOOD) || RuleCondition::protocol(7)) &&
+                !RuleCondition::value(greater_than(100.0));
+    auto compiled = CompiledCondition::compile(cond);
+
+    EXPECT_TRUE(compiled.evaluate(point("plant/a", 50.0)));
+    EXPECT_TRUE(compiled.evaluate(point("plant/a", 50.0, 7, Quality::BAD)));
+    EXPECT_FALSE(compiled.evaluate(point("plant/a", 50.0, 1, Quality::BAD)));
+    EXPECT_FALSE(compiled.evaluate(point("plant/a", 150.0)));
+    EXPECT_FALSE(compiled.evaluate(point("other/a", 50.0)));
+}
+
+TEST_F(CompositeRuleTest, EmptyOperands) {
+    EXPECT_TRUE(CompiledCondition::compile(RuleCondition::all_of({})).evaluate(point("a", 0)));
+    EXPECT_FALSE(CompiledCondition::compile(RuleCondition::any_of({})).evaluate(point("a", 0)));
+    EXPECT_FALSE(CompiledCondition().evaluate(point("a", 0)));
+}
+
+TEST_F(CompositeRuleTest, CheapChecksRunFirst) {
+    auto cond = RuleCondition::pattern("plant/.*") && RuleCondition::value(greater_than(1.0)) &&
+                RuleCondition::address("plant/a") && RuleCondition::protocol(3) &&
+                !RuleCondition::quality(Quality::BAD);
+    auto compiled = CompiledCondition::compile(cond);
+
+    std::vector<Kind> expected = {Kind::AND,    Kind::PROTOCOL, Kind::NOT,    Kind::QUALITY,
+                                  Kind::STATIC, Kind::VALUE,    Kind::PATTERN};
+    EXPECT_EQ(compiled.program(), expected);
+}
+
+TEST_F(CompositeRuleTest, NestedNodesAreFlattened) {
+    auto cond = RuleCondition::all_of(
+        {RuleCondition::all_of({RuleCondition::protocol(1), RuleCondition::protocol(2)}),
+         RuleCondition::any_of({RuleCondition::negate(
+             RuleCondition::negate(RuleCondition::quality(Quality::GOOD)))})});
+    auto compiled = CompiledCondition::compile(cond);
+
+    std::vector<Kind> expected = {Kind::AND, Kind::PROTOCOL, Kind::PROTOCOL, Kind::QUALITY};
+    EXPECT_EQ(compiled.program(), expected);
+}
+
+TEST_F(CompositeRuleTest, BuilderCompilesCondition) {
+    auto rule = RuleBuilder()
+                    .name("hot_good_plant")
+                    .match_all({RuleCondition::pattern("plant/.*"),
+                                RuleCondition::quality(Quality::GOOD),
+                                RuleCondition::value(greater_than(80.0))})
+                    .route_to("alarms")
+                    .build();
+
+    EXPECT_EQ(rule.type, RuleType::COMPOSITE);
+    ASSERT_NE(rule.compiled_condition, nullptr);
+    EXPECT_TRUE(rule.evaluate(point("plant/t1", 90.0)).matched);
+    EXPECT_FALSE(rule.evaluate(point("plant/t1", 70.0)).matched);
+    EXPECT_FALSE(rule.evaluate(point("plant/t1", 90.0, 0, Quality::BAD)).matched);
+}
+
+TEST_F(CompositeRuleTest, UncompiledRuleStillEvaluates) {
+    RoutingRule rule;
+    rule.type      = RuleType::COMPOSITE;
+    rule.condition = RuleCondition::address("a") || RuleCondition::address("b");
+
+    EXPECT_TRUE(rule.evaluate(point("b", 0)).matched);
+    EXPECT_FALSE(rule.evaluate(point("c", 0)).matched);
+
+    auto before = PatternMatcherFactory::compilation_count();
+    RuleEngine engine;
+    engine.add_rule(RuleBuilder()
+                        .match_any({RuleCondition::pattern("x/.*"), RuleCondition::address("y")})
+                        .route_to("s")
+                        .build());
+    auto after_add = PatternMatcherFactory::compilation_count();
+    EXPECT_GT(after_add, before);
+
+    EXPECT_EQ(engine.evaluate(point("x/1", 0)).size(), 1u);
+    EXPECT_EQ(engine.evaluate(point("y", 0)).size(), 1u);
+    EXPECT_EQ(PatternMatcherFactory::compilation_count(), after_add);
+}
+
+TEST_F(CompositeRuleTest, IndexedMatchesLinearScan) {
+    RuleEngineConfig config;
+    config.enable_cache = false;
+    RuleEngine indexed(config);
+    config.enable_rule_index = false;
+    RuleEngine linear(config);
+
+    std::vector<RoutingRule> rules;
+    for (int i = 0; i < 20; ++i) {
+        auto address = "plant/" + std::to_string(i);
+        rules.push_back(RuleBuilder()
+                            .match_all({RuleCondition::value(greater_than(i)),
+                                        RuleCondition::address(address)})
+                            .route_to("s")
+                            .build());
+    }
+    rules.push_back(RuleBuilder()
+                        .match_any({RuleCondition::address("plant/3"), RuleCondition::protocol(2)})
+                        .route_to("s")
+                        .build());
+    rules.push_back(RuleBuilder()
+                        .match_condition(!RuleCondition::address("plant/4"))
+                        .route_to("s")
+                        .build());
+    indexed.replace_rules(rules);
+    linear.replace_rules(rules);
+
+    for (int i = 0; i < 40; ++i) {
+        auto dp = point("plant/" + std::to_string(i % 25), i, static_cast<uint16_t>(i % 3));
+        SCOPED_TRACE(std::string(dp.address()));
+        auto a = indexed.evaluate(dp);
+        auto b = linear.evaluate(dp);
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t j = 0; j < a.size(); ++j) {
+            EXPECT_EQ(a[j].rule_id, b[j].rule_id);
+        }
+    }
+
+    EXPECT_LT(indexed.stats().rules_evaluated.load(), linear.stats().rules_evaluated.load());
+}
+
+// ============================================================================
+// Batch Evaluation Tests
+// ============================================================================
+
+class BatchEvaluationTest : public ::testing::Test {
+protected:
+    static ValueCondition condition(CompareOp op, double reference, double high = 0.0) {
+        ValueCondition cond;
+        cond.op             = op;
+        cond.reference      = reference;
+        cond.reference_high = high;
+        return cond;
+    }
+
+    /// Mixed batch: floats, integers, bools, strings and empty values
+    static std::vector<DataPoint> mixed_batch(size_t count) {
+        std::vector<DataPoint> points;
+        for (size_t i = 0; i < count; ++i) {
+            DataPoint dp("plc/" + std::to_string(i % 50), Value{}, static_cast<uint16_t>(i % 4));
+            switch (i % 5) {
+                case 0:
+                    dp.set_value(static_cast<double>(i % 120));
+                    break;
+                case 1:
+                    dp.set_value(static_cast<int32_t>(i % 90));
+                    break;
+                case 2:
+                    dp.set_value(i % 2 == 0);
+                    break;
+                case 3: {
+                    Value text;
+                    text.set_string_view(i % 3 == 0 ? "alarm" : "ok");
+                    dp.set_value(std::move(text));
+                    break;
+                }
+                default:
+                    break;
+            }
+            points.push_back(std::move(dp));
+        }
+        return points;
+    }
+};
+
+TEST_F(BatchEvaluationTest, ColumnMatchesScalar) {
+    const CompareOp ops[] = {CompareOp::EQ, CompareOp::NE, CompareOp::LT,     CompareOp::LE,
+                             CompareOp::GT, CompareOp::GE, CompareOp::BETWEEN};
+
+    std::vector<double> values;
+    for (int i = 0; i < 130; ++i) {
+        values.push_back(static_cast<double>(i % 17) - 4.0);
+    }
+    std::vector<uint64_t> numeric((values.size() + 63) / 64, 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i % 7 != 0) {
+            numeric[i / 64] |= uint64_t{1} << (i % 64);
+        }
+    }
+
+    for (auto op : ops) {
+        auto resolved = condition(op, 3.0, 8.0).resolve();
+        std::vector<uint64_t> bits(numeric.size(), ~uint64_t{0});
+        resolved.evaluate_column(values, numeric, bits);
+
+        for (size_t i = 0; i < values.size(); ++i) {
+            Value value;
+            value.set(static_cast<double>(values[i]));
+            bool expected = i % 7 != 0 && resolved.evaluate(value);
+            EXPECT_EQ(((bits[i / 64] >> (i % 64)) & 1) != 0, expected)
+                << "op=" << static_cast<int>(op) << " i=" << i;
+        }
+    }
+}
+
+TEST_F(BatchEvaluationTest, ResolvedStringReference) {
+    ValueCondition cond;
+    cond.op        = CompareOp::EQ;
+    cond.reference = std::string("alarm");
+
+    auto resolved = cond.resolve();
+    ASSERT_NE(resolved.text, nullptr);
+
+    Value alarm;
+    alarm.set_string_view("alarm");
+    Value ok;
+    ok.set_string_view("ok");
+    EXPECT_TRUE(resolved.evaluate(alarm));
+    EXPECT_FALSE(resolved.evaluate(ok));
+    EXPECT_EQ(cond.evaluate(alarm), resolved.evaluate(alarm));
+}
+
+TEST_F(BatchEvaluationTest, BitmapsMatchPerPointEvaluation) {
+    RuleEngineConfig config;
+    config.enable_cache = false;
+    RuleEngine engine(config);
+
+    engine.add_rule(RuleBuilder()
+                        .name("high")
+                        .match_value(condition(CompareOp::GT, 80.0))
+                        .route_to("alarms")
+                        .build());
+    engine.add_rule(RuleBuilder()
+                        .name("band")
+                        .match_value(condition(CompareOp::BETWEEN, 10.0, 20.0))
+                        .route_to("s")
+                        .build());
+    ValueCondition text;
+    text.op        = CompareOp::EQ;
+    text.reference = std::string("alarm");
+    engine.add_rule(RuleBuilder().name("text").match_value(text).route_to("s").build());
+    engine.add_rule(RuleBuilder().name("addr").match_address("plc/7").route_to("s").build());
+    engine.add_rule(RuleBuilder().name("pattern").match_pattern("plc/1.*").route_to("s").build());
+    engine.add_rule(RuleBuilder().name("proto").match_protocol(2).route_to("s").build());
+    auto disabled = engine.add_rule(RuleBuilder()
+                                        .name("off")
+                                        .match_value(condition(CompareOp::GE, 0.0))
+                                        .route_to("s")
+                                        .build());
+    engine.set_rule_enabled(disabled, false);
+
+    auto points = mixed_batch(300);
+    RuleBatchMatches matches;
+    auto total = engine.evaluate_batch_into(points, matches);
+
+    ASSERT_EQ(matches.point_count(), points.size());
+    ASSERT_EQ(matches.rule_count(), engine.rule_count());
+
+    size_t expected_total = 0;
+    for (size_t p = 0; p < points.size(); ++p) {
+        auto results = engine.evaluate(points[p]);
+        expected_total += results.size();
+        for (size_t row = 0; row < matches.rule_count(); ++row) {
+            bool expected = std::any_of(results.begin(), results.end(), [&](const auto& r) {
+                return r.rule_id == matches.rule_id(row);
+            });
+            EXPECT_EQ(matches.matched(row, p), expected)
+                << "rule=" << matches.rule_id(row) << " point=" << p;
+        }
+    }
+    EXPECT_EQ(total, expected_total);
+    EXPECT_GT(total, 0u);
+
+    for (size_t row = 0; row < matches.rule_count(); ++row) {
+        if (matches.rule_id(row) == disabled) {
+            EXPECT_EQ(matches.match_count(row), 0u);
+        }
+    }
+}
+
+TEST_F(BatchEvaluationTest, ColumnsMatchPointBatch) {
+    RuleEngineConfig config;
+    config.enable_cache = false;
+    RuleEngine engine(config);
+
+    engine.add_rule(RuleBuilder()
+                        .name("high")
+                        .match_value(condition(CompareOp::GT, 80.0))
+                        .route_to("alarms")
+                        .build());
+    ValueCondition text;
+    text.op        = CompareOp::EQ;
+    text.reference = std::string("alarm");
+    engine.add_rule(RuleBuilder().name("text").match_value(text).route_to("s").build());
+    engine.add_rule(RuleBuilder().name("addr").match_address("plc/7").route_to("s").build());
+    engine.add_rule(RuleBuilder().name("pattern").match_pattern("plc/1.*").route_to("s").build());
+    engine.add_rule(RuleBuilder().name("proto").match_protocols({1, 3}).route_to("s").build());
+    engine.add_rule(
+        RuleBuilder().name("quality").match_quality(Quality::UNCERTAIN).route_to("s").build());
+    engine.add_rule(RuleBuilder()
+                        .name("custom")
+                        .match_custom([](const DataPoint& dp) { return dp.protocol_id() == 2; })
+                        .route_to("s")
+                        .build());
+    auto window       = RuleBuilder().name("window").route_to("s").build();
+    window.type       = RuleType::TIMESTAMP;
+    window.start_time = Timestamp(std::chrono::nanoseconds(100));
+    window.end_time   = Timestamp(std::chrono::nanoseconds(199));
+    engine.add_rule(std::move(window));
+    auto disabled = engine.add_rule(
+        RuleBuilder().name("off").match_protocol(1).route_to("s").build());
+    engine.set_rule_enabled(disabled, false);
+
+    auto points = mixed_batch(300);
+    for (size_t i = 0; i < points.size(); ++i) {
+        points[i].set_quality(i % 3 == 0 ? Quality::UNCERTAIN : Quality::GOOD);
+        points[i].set_timestamp(Timestamp(std::chrono::nanoseconds(i)));
+        if (i % 2 == 0) {
+            points[i].intern_address();
+        }
+    }
+
+    RuleBatchMatches expected;
+    auto expected_total = engine.evaluate_batch_into(points, expected);
+
+    RuleBatchMatches matches;
+    auto total = engine.evaluate_columns_into(ColumnarBatch(points), matches);
+
+    EXPECT_EQ(total, expected_total);
+    EXPECT_GT(total, 0u);
+    ASSERT_EQ(matches.point_count(), expected.point_count());
+    ASSERT_EQ(matches.rule_count(), expected.rule_count());
+    for (size_t row = 0; row < matches.rule_count(); ++row) {
+        EXPECT_EQ(matches.rule_id(row), expected.rule_id(row));
+        EXPECT_TRUE(std::equal(matches.bitmap(row).begin(), matches.bitmap(row).end(),
+                               expected.bitmap(row).begin()))
+            << "rule=" << matches.rule_id(row);
+        if (matches.rule_id(row) != disabled) {
+            EXPECT_GT(matches.match_count(row), 0u) << "rule=" << matches.rule_id(row);
+        }
+    }
+
+    EXPECT_EQ(engine.evaluate_columns_into(ColumnarBatch(), matches), 0u);
+    EXPECT_EQ(matches.rule_count(), engine.rule_count());
+}
+
+TEST_F(BatchEvaluationTest, ReusedAcrossBatches) {
+    RuleEngine engine;
+    engine.add_rule(RuleBuilder()
+                        .name("high")
+                        .match_value(condition(CompareOp::GT, 50.0))
+                        .route_to("a")
+                        .build());
+
+    RuleBatchMatches matches;
+    auto large = mixed_batch(1000);
+    EXPECT_GT(engine.evaluate_batch_into(large, matches), 0u);
+
+    std::vector<DataPoint> small;
+    small.emplace_back("x", Value{});
+    small.back().set_value(10.0);
+    EXPECT_EQ(engine.evaluate_batch_into(small, matches), 0u);
+    EXPECT_EQ(matches.point_count(), 1u);
+    EXPECT_EQ(matches.words_per_rule(), 1u);
+
+    EXPECT_EQ(engine.evaluate_batch_into({}, matches), 0u);
+    EXPECT_EQ(matches.rule_count(), 1u);
+}
@@ -10,6 +10,8 @@
  */
 
 #include <ipb/core/scheduler/edf_scheduler.hpp>
+#include <ipb/core/scheduler/task_queue.hpp>
+#include <ipb/core/scheduler/timer_wheel.hpp>
 
 #include <atomic>
 #include <chrono>
@@ -465,6 +467,431 @@ TEST_F(EDFSchedulerTest, EDFOrdering) {
     // The key is that all tasks execute
 }
 
+// ============================================================================
+// Lock-Free Backend Tests
+// ============================================================================
+
+class EDFSchedulerLockFreeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_.worker_threads = 1;
+        config_.max_queue_size = 10000;
+        config_.queue_backend  = EDFSchedulerConfig::QueueBackend::LOCK_FREE;
+    }
+
+    template <typename Predicate>
+    static bool wait_until(Predicate pred, std::chrono::milliseconds timeout) {
+        auto until = std::chrono::steady_clock::now() + timeout;
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() > until) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    /// Occupy the single worker until release_ is set
+    void block_worker(EDFScheduler& scheduler) {
+        std::atomic<bool> started{false};
+        scheduler.submit(
+            [this, &started]() {
+                started = true;
+                while (!released_.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            },
+            Timestamp::now() + std::chrono::seconds(10));
+        ASSERT_TRUE(wait_until([&] { return started.load(); }, std::chrono::seconds(5)));
+    }
+
+    EDFSchedulerConfig config_;
+    std::atomic<bool> released_{false};
+};
+
+TEST_F(EDFSchedulerLockFreeTest, ExecutesTasks) {
+    EDFScheduler scheduler(config_);
+    ASSERT_TRUE(scheduler.start());
+
+    std::atomic<TaskState> state{TaskState::PENDING};
+    auto result = scheduler.submit_with_callback(
+        []() {}, Timestamp::now() + std::chrono::seconds(5),
+        [&state](TaskState s, std::chrono::nanoseconds) { state = s; });
+    ASSERT_TRUE(result);
+
+    EXPECT_TRUE(wait_until([&] { return state.load() == TaskState::COMPLETED; },
+                           std::chrono::seconds(5)));
+    EXPECT_EQ(scheduler.stats().tasks_completed.load(), 1u);
+    scheduler.stop();
+}
+
+TEST_F(EDFSchedulerLockFreeTest, RunsInDeadlineOrder) {
+    EDFScheduler scheduler(config_);
+    ASSERT_TRUE(scheduler.start());
+    block_worker(scheduler);
+
+    std::vector<int> order;
+    auto now    = Timestamp::now();
+    auto record = [&order](int n) { return [&order, n]() { order.push_back(n); }; };
+
+    scheduler.submit(record(3), now + std::chrono::seconds(3));
+    scheduler.submit(record(1), now + std::chrono::seconds(1));
+    scheduler.submit(record(2), now + std::chrono::seconds(2));
+
+    // Equal deadline and priority: submission order
+    scheduler.submit(record(4), now + std::chrono::seconds(4));
+    scheduler.submit(record(5), now + std::chrono::seconds(4));
+
+    EXPECT_EQ(scheduler.pending_count(), 5u);
+    ASSERT_TRUE(scheduler.nearest_deadline().has_value());
+    EXPECT_EQ(*scheduler.nearest_deadline(), now + std::chrono::seconds(1));
+
+    released_ = true;
+    ASSERT_TRUE(wait_until([&] { return scheduler.stats().tasks_completed.load() == 6; },
+                           std::chrono::seconds(5)));
+    scheduler.stop();
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST_F(EDFSchedulerLockFreeTest, CancelRemovesQueuedTask) {
+    EDFScheduler scheduler(config_);
+    ASSERT_TRUE(scheduler.start());
+    block_worker(scheduler);
+
+    std::atomic<bool> ran{false};
+    auto result = scheduler.submit([&ran]() { ran = true; }, std::chrono::seconds(5));
+    ASSERT_TRUE(result);
+
+    EXPECT_TRUE(scheduler.cancel(result.task_id));
+    EXPECT_FALSE(scheduler.cancel(result.task_id));
+    EXPECT_EQ(scheduler.pending_count(), 0u);
+
+    released_ = true;
+    scheduler.stop();
+    EXPECT_FALSE(ran.load());
+    EXPECT_EQ(scheduler.stats().tasks_cancelled.load(), 1u);
+}
+
+TEST_F(EDFSchedulerLockFreeTest, ConcurrentProducers) {
+    config_.worker_threads = 2;
+    EDFScheduler scheduler(config_);
+    ASSERT_TRUE(scheduler.start());
+
+    constexpr int NUM_THREADS      = 8;
+    constexpr int TASKS_PER_THREAD = 250;
+
+    std::atomic<int> completed{0};
+    std::atomic<int> accepted{0};
+    auto deadline = Timestamp::now() + std::chrono::seconds(30);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < TASKS_PER_THREAD; ++i) {
+                if (scheduler.submit([&completed]() { completed++; }, deadline)) {
+                    accepted++;
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(accepted.load(), NUM_THREADS * TASKS_PER_THREAD);
+    EXPECT_TRUE(wait_until([&] { return completed.load() == accepted.load(); },
+                           std::chrono::seconds(10)));
+    scheduler.stop();
+
+    EXPECT_EQ(scheduler.stats().deadlines_met.load(),
+              static_cast<uint64_t>(NUM_THREADS * TASKS_PER_THREAD));
+}
+
+// ============================================================================
+// Work-Stealing Queue Tests
+// ============================================================================
+
+class WorkStealingTaskQueueTest : public ::testing::Test {
+protected:
+    static ScheduledTask make_task(uint64_t id, int64_t deadline_ms) {
+        ScheduledTask task;
+        task.id       = id;
+        task.deadline = Timestamp(std::chrono::milliseconds(deadline_ms));
+        return task;
+    }
+};
+
+TEST_F(WorkStealingTaskQueueTest, LocalHeapIsEarliestDeadlineFirst) {
+    WorkStealingTaskQueue queue(2, 100);
+    queue.push(make_task(1, 30), 0);
+    queue.push(make_task(2, 10), 0);
+    queue.push(make_task(3, 20), 0);
+    EXPECT_EQ(queue.size(), 3u);
+
+    ScheduledTask task;
+    std::vector<uint64_t> order;
+    while (queue.pop(0, task)) {
+        order.push_back(task.id);
+    }
+    EXPECT_EQ(order, (std::vector<uint64_t>{2, 3, 1}));
+    EXPECT_EQ(queue.steals(), 0u);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(WorkStealingTaskQueueTest, IdleWorkerStealsEarliestDeadline) {
+    WorkStealingTaskQueue queue(3, 100);
+    queue.push(make_task(1, 30), 1);
+    queue.push(make_task(2, 20), 2);
+    queue.push(make_task(3, 10), 2);
+
+    ScheduledTask task;
+    ASSERT_TRUE(queue.pop(0, task));
+    EXPECT_EQ(task.id, 3u);
+    ASSERT_TRUE(queue.pop(0, task));
+    EXPECT_EQ(task.id, 2u);
+    ASSERT_TRUE(queue.pop(0, task));
+    EXPECT_EQ(task.id, 1u);
+    EXPECT_EQ(queue.steals(), 3u);
+    EXPECT_FALSE(queue.pop(0, task));
+}
+
+TEST_F(WorkStealingTaskQueueTest, ExtractAndLimits) {
+    WorkStealingTaskQueue queue(2, 3);
+    EXPECT_FALSE(queue.nearest_deadline().has_value());
+
+    EXPECT_TRUE(queue.push(make_task(1, 30)));
+    EXPECT_TRUE(queue.push(make_task(2, 10)));
+    EXPECT_TRUE(queue.push(make_task(3, 20)));
+    EXPECT_FALSE(queue.push(make_task(4, 5)));  // Full
+
+    ASSERT_TRUE(queue.nearest_deadline().has_value());
+    EXPECT_EQ(*queue.nearest_deadline(), Timestamp(std::chrono::milliseconds(10)));
+
+    auto removed = queue.extract(2);
+    ASSERT_TRUE(removed.has_value());
+    EXPECT_EQ(removed->id, 2u);
+    EXPECT_FALSE(queue.remove(2));
+    EXPECT_EQ(*queue.nearest_deadline(), Timestamp(std::chrono::milliseconds(20)));
+
+    ScheduledTask task;
+    size_t drained = 0;
+    while (queue.pop_any(task)) {
+        ++drained;
+    }
+    EXPECT_EQ(drained, 2u);
+}
+
+TEST_F(WorkStealingTaskQueueTest, DeadlineDemandCountsWithinHorizon) {
+    DeadlineDemand demand(std::chrono::milliseconds(1));
+    Timestamp now(std::chrono::seconds(100));
+
+    demand.add(now + std::chrono::milliseconds(2), now);
+    demand.add(now + std::chrono::milliseconds(5), now);
+    demand.add(now + std::chrono::milliseconds(5), now);
+    demand.add(now + std::chrono::seconds(10), now);  // Beyond the horizon
+
+    EXPECT_EQ(demand.count_before(now + std::chrono::milliseconds(1), now), 0u);
+    EXPECT_EQ(demand.count_before(now + std::chrono::milliseconds(3), now), 1u);
+    EXPECT_EQ(demand.count_before(now + std::chrono::milliseconds(6), now), 3u);
+    EXPECT_EQ(demand.count_before(now + std::chrono::seconds(20), now), 3u);
+
+    demand.remove(now + std::chrono::milliseconds(5));
+    demand.remove(now + std::chrono::seconds(10));  // Never counted: ignored
+    EXPECT_EQ(demand.count_before(now + std::chrono::milliseconds(6), now), 2u);
+
+    // Once time has moved past a slot its tasks no longer count
+    EXPECT_EQ(demand.count_before(now + std::chrono::milliseconds(6),
+                                  now + std::chrono::milliseconds(3)),
+              1u);
+
+    // Tasks sharing the deadline's slot may be due after it, so none of them count
+    demand.add(now + std::chrono::microseconds(7900), now);
+    demand.add(now + std::chrono::microseconds(7100), now);
+    EXPECT_EQ(demand.count_before(now + std::chrono::microseconds(7050), now), 2u);
+    EXPECT_EQ(demand.count_before(now + std::chrono::microseconds(7500), now), 2u);
+    EXPECT_EQ(demand.count_before(now + std::chrono::milliseconds(8), now), 4u);
+}
+
+class EDFSchedulerWorkStealingTest : public EDFSchedulerLockFreeTest {
+protected:
+    void SetUp() override {
+        EDFSchedulerLockFreeTest::SetUp();
+        config_.queue_backend = EDFSchedulerConfig::QueueBackend::WORK_STEALING;
+    }
+};
+
+TEST_F(EDFSchedulerWorkStealingTest, ConcurrentProducers) {
+    config_.worker_threads = 4;
+    EDFScheduler scheduler(config_);
+    ASSERT_TRUE(scheduler.start());
+
+    constexpr int NUM_THREADS      = 8;
+    constexpr int TASKS_PER_THREAD = 250;
+
+    std::atomic<int> completed{0};
+    auto deadline = Timestamp::now() + std::chrono::seconds(30);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < TASKS_PER_THREAD; ++i) {
+                EXPECT_TRUE(scheduler.submit([&completed]() { completed++; }, deadline));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(wait_until([&] { return completed.load() == NUM_THREADS * TASKS_PER_THREAD; },
+                           std::chrono::seconds(10)));
+    scheduler.stop();
+    EXPECT_EQ(scheduler.pending_count(), 0u);
+}
+
+TEST_F(EDFSchedulerWorkStealingTest, RunsInDeadlineOrder) {
+    EDFScheduler scheduler(config_);
+    ASSERT_TRUE(scheduler.start());
+    block_worker(scheduler);
+
+    std::vector<int> order;
+    auto now    = Timestamp::now();
+    auto record = [&order](int n) { return [&order, n]() { order.push_back(n); }; };
+
+    scheduler.submit(record(3), now + std::chrono::seconds(3));
+    scheduler.submit(record(1), now + std::chrono::seconds(1));
+    scheduler.submit(record(2), now + std::chrono::seconds(2));
+    EXPECT_EQ(*scheduler.nearest_deadline(), now + std::chrono::seconds(1));
+
+    released_ = true;
+    ASSERT_TRUE(wait_until([&] { return scheduler.stats().tasks_completed.load() == 4; },
+                           std::chrono::seconds(5)));
+    scheduler.stop();
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(EDFSchedulerWorkStealingTest, PeriodicTasksRun) {
+    config_.worker_threads = 2;
+    EDFScheduler scheduler(config_);
+    ASSERT_TRUE(scheduler.start());
+
+    std::atomic<int> runs{0};
+    auto id = scheduler.submit_periodic([&runs]() { runs++; }, std::chrono::milliseconds(5));
+
+    EXPECT_TRUE(wait_until([&] { return runs.load() >= 3; }, std::chrono::seconds(5)));
+    scheduler.cancel_periodic(id);
+    scheduler.stop();
+}
+
+TEST_F(EDFSchedulerWorkStealingTest, AdmissionRejectsInfeasibleDeadline) {
+    config_.admission_control = true;
+    EDFScheduler scheduler(config_);
+    ASSERT_TRUE(scheduler.start());
+
+    // Nothing measured yet: everything is admitted
+    std::atomic<bool> done{false};
+    ASSERT_TRUE(scheduler.submit(
+        [&done]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            done = true;
+        },
+        std::chrono::seconds(5)));
+    ASSERT_TRUE(wait_until([&] { return done.load(); }, std::chrono::seconds(5)));
+    ASSERT_TRUE(wait_until([&] { return scheduler.stats().tasks_completed.load() == 1; },
+                           std::chrono::seconds(5)));
+
+    // Tasks now take ~20ms, so a 2ms deadline cannot be met
+    auto rejected = scheduler.submit([]() {}, std::chrono::milliseconds(2));
+    EXPECT_FALSE(rejected);
+    EXPECT_EQ(rejected.error_message, "Deadline cannot be met");
+    EXPECT_EQ(scheduler.stats().tasks_rejected.load(), 1u);
+
+    EXPECT_TRUE(scheduler.submit([]() {}, std::chrono::seconds(5)));
+    scheduler.stop();
+}
+
+// ============================================================================
+// Timer Wheel Tests
+// ============================================================================
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+    struct TestTimer : TimerNode {
+        int id = 0;
+    };
+
+    static Timestamp at_ms(double ms) {
+        return Timestamp(std::chrono::nanoseconds(static_cast<int64_t>(ms * 1e6)));
+    }
+
+    std::vector<int> advance_to(double ms) {
+        std::vector<int> fired;
+        wheel_.advance(at_ms(ms),
+                       [&](TimerNode& node) { fired.push_back(static_cast<TestTimer&>(node).id); });
+        return fired;
+    }
+
+    TimerWheel wheel_{std::chrono::milliseconds(1), at_ms(0)};
+};
+
+TEST_F(TimerWheelTest, FiresInExpiryOrderAcrossLevels) {
+    TestTimer t1, t2, t3, t4;
+    t1.id = 1;
+    t2.id = 2;
+    t3.id = 3;
+    t4.id = 4;
+
+    wheel_.arm(t1, at_ms(5));
+    wheel_.arm(t2, at_ms(70));    // Level 1
+    wheel_.arm(t3, at_ms(5000));  // Level 2
+    wheel_.arm(t4, at_ms(3));
+    EXPECT_EQ(wheel_.size(), 4u);
+
+    EXPECT_EQ(advance_to(100), (std::vector<int>{4, 1, 2}));
+    EXPECT_TRUE(advance_to(4999).empty());
+    EXPECT_EQ(advance_to(5000), (std::vector<int>{3}));
+    EXPECT_TRUE(wheel_.empty());
+    EXPECT_FALSE(t3.armed());
+}
+
+TEST_F(TimerWheelTest, NeverFiresEarly) {
+    TestTimer timer;
+    wheel_.arm(timer, at_ms(2.5));
+
+    EXPECT_TRUE(advance_to(2.9).empty());
+    EXPECT_EQ(advance_to(3).size(), 1u);
+}
+
+TEST_F(TimerWheelTest, RearmFromCallbackAndCancel) {
+    TestTimer periodic, cancelled;
+    wheel_.arm(periodic, at_ms(10));
+    wheel_.arm(cancelled, at_ms(15));
+
+    ASSERT_TRUE(wheel_.next_expiry().has_value());
+    EXPECT_EQ(wheel_.next_expiry()->nanoseconds(), at_ms(10).nanoseconds());
+
+    wheel_.cancel(cancelled);
+    EXPECT_FALSE(cancelled.armed());
+    EXPECT_EQ(wheel_.size(), 1u);
+
+    // Re-arm on a 10ms grid, as the scheduler does for periodic tasks
+    int fired = 0;
+    wheel_.advance(at_ms(95), [&](TimerNode& node) {
+        ++fired;
+        wheel_.arm(node, node.expiry() + std::chrono::milliseconds(10));
+    });
+
+    EXPECT_EQ(fired, 9);
+    EXPECT_TRUE(periodic.armed());
+    EXPECT_EQ(periodic.expiry().nanoseconds(), at_ms(100).nanoseconds());
+
+    wheel_.cancel(periodic);
+    EXPECT_TRUE(wheel_.empty());
+    EXPECT_FALSE(wheel_.next_expiry().has_value());
+}
+
 // ============================================================================
 // Periodic Task Tests
 // ============================================================================
@@ -519,6 +946,68 @@ TEST_F(PeriodicTaskTest, CancelPeriodic) {
     scheduler.stop();
 }
 
+TEST_F(PeriodicTaskTest, ReportsJitterStats) {
+    EDFScheduler scheduler(config_);
+    scheduler.start();
+
+    std::atomic<int> execution_count{0};
+    auto periodic_id = scheduler.submit_periodic([&execution_count]() { execution_count++; },
+                                                 std::chrono::milliseconds(20));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    auto stats = scheduler.periodic_stats(periodic_id);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_GE(stats->releases, 3u);
+    EXPECT_LE(stats->started, stats->releases);
+    EXPECT_GE(stats->max_jitter_ns, stats->last_jitter_ns);
+    EXPECT_GE(stats->last_jitter_ns, 0);
+    EXPECT_GE(stats->avg_jitter_us(), 0.0);
+
+    EXPECT_TRUE(scheduler.cancel_periodic(periodic_id));
+    EXPECT_FALSE(scheduler.periodic_stats(periodic_id).has_value());
+    EXPECT_FALSE(scheduler.periodic_stats(periodic_id + 100).has_value());
+
+    scheduler.stop();
+}
+
+TEST_F(PeriodicTaskTest, SkipsReleasesWhileInstanceRuns) {
+    EDFScheduler scheduler(config_);
+    scheduler.start();
+
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    auto periodic_id = scheduler.submit_periodic(
+        [&]() {
+            int now_running = ++running;
+            int expected    = max_running.load();
+            while (now_running > expected &&
+                   !max_running.compare_exchange_weak(expected, now_running)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            --running;
+        },
+        std::chrono::milliseconds(10));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    auto stats = scheduler.periodic_stats(periodic_id);
+    scheduler.cancel_periodic(periodic_id);
+    scheduler.stop();
+
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_GT(stats->skipped, 0u);
+    EXPECT_EQ(max_running.load(), 1);
+}
+
+TEST_F(PeriodicTaskTest, RejectsNonPositivePeriod) {
+    EDFScheduler scheduler(config_);
+    scheduler.start();
+
+    EXPECT_EQ(scheduler.submit_periodic([]() {}, std::chrono::nanoseconds(0)), 0u);
+
+    scheduler.stop();
+}
+
 // ============================================================================
 // Thread Safety Tests
 // ============================================================================
@@ -7,6 +7,7 @@
  * - SinkInfo: Sink metadata and statistics
  * - SinkSelectionResult: Selection results
  * - SinkRegistryStats: Registry statistics
+ * - SinkIdInterner: Sink ID to handle interning
  * - SinkRegistry: Sink management and load balancing
  */
 
@@ -298,6 +299,59 @@ TEST_F(SinkRegistryConfigTest, DefaultValues) {
     EXPECT_TRUE(config.enable_failover);
 }
 
+// ============================================================================
+// SinkIdInterner Tests
+// ============================================================================
+
+class SinkIdInternerTest : public ::testing::Test {};
+
+TEST_F(SinkIdInternerTest, InternIsStable) {
+    SinkIdInterner interner;
+
+    auto kafka  = interner.intern("kafka");
+    auto influx = interner.intern("influx");
+
+    EXPECT_EQ(kafka, 0u);
+    EXPECT_EQ(influx, 1u);
+    EXPECT_EQ(interner.intern("kafka"), kafka);
+    EXPECT_EQ(interner.size(), 2u);
+
+    EXPECT_EQ(interner.id(kafka), "kafka");
+    EXPECT_EQ(interner.id(influx), "influx");
+    EXPECT_TRUE(interner.id(42).empty());
+}
+
+TEST_F(SinkIdInternerTest, FindDoesNotIntern) {
+    SinkIdInterner interner;
+
+    EXPECT_EQ(interner.find("missing"), INVALID_SINK_HANDLE);
+    EXPECT_EQ(interner.size(), 0u);
+
+    auto handle = interner.intern("present");
+    EXPECT_EQ(interner.find("present"), handle);
+}
+
+TEST_F(SinkIdInternerTest, ConcurrentIntern) {
+    SinkIdInterner interner;
+
+    std::vector<std::future<std::vector<SinkHandle>>> futures;
+    for (int t = 0; t < 4; ++t) {
+        futures.push_back(std::async(std::launch::async, [&interner] {
+            std::vector<SinkHandle> handles;
+            for (int i = 0; i < 100; ++i) {
+                handles.push_back(interner.intern("sink_" + std::to_string(i)));
+            }
+            return handles;
+        }));
+    }
+
+    auto first = futures[0].get();
+    for (size_t t = 1; t < futures.size(); ++t) {
+        EXPECT_EQ(futures[t].get(), first);
+    }
+    EXPECT_EQ(interner.size(), 100u);
+}
+
 // ============================================================================
 // SinkRegistry Tests
 // ============================================================================
@@ -332,6 +386,22 @@ TEST_F(SinkRegistryTest, StartStop) {
     EXPECT_FALSE(registry.is_running());
 }
 
+TEST_F(SinkRegistryTest, RegisterInternsSinkId) {
+    SinkRegistry registry(config_);
+
+    auto sink = std::make_shared<MockSink>("test_sink");
+    registry.register_sink("sink1", sink->get());
+
+    auto handle = registry.sink_interner()->find("sink1");
+    ASSERT_NE(handle, INVALID_SINK_HANDLE);
+    EXPECT_EQ(registry.intern_sink_id("sink1"), handle);
+    EXPECT_EQ(registry.sink_id(handle), "sink1");
+
+    // Handles survive unregistration
+    registry.unregister_sink("sink1");
+    EXPECT_EQ(registry.intern_sink_id("sink1"), handle);
+}
+
 TEST_F(SinkRegistryTest, RegisterSink) {
     SinkRegistry registry(config_);
 
@@ -0,0 +1,136 @@
+/**
+ * @file test_string_interner.cpp
+ * @brief Unit tests for StringInterner and InternedString
+ *
+ * Tests cover:
+ * - Stable IDs for equal strings
+ * - ID to text round trips and the reserved empty-string ID
+ * - InternedString handle comparisons
+ * - Concurrent interning from several threads
+ */
+
+#include <ipb/common/string_interner.hpp>
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ipb::common;
+
+// ============================================================================
+// StringInterner Tests
+// ============================================================================
+
+class StringInternerTest : public ::testing::Test {
+protected:
+    StringInterner interner;
+};
+
+TEST_F(StringInternerTest, EmptyStringIsReserved) {
+    EXPECT_EQ(interner.size(), 1u);
+    EXPECT_EQ(interner.intern(""), StringInterner::EMPTY_ID);
+    EXPECT_EQ(interner.view(StringInterner::EMPTY_ID), "");
+}
+
+TEST_F(StringInternerTest, EqualStringsShareId) {
+    std::string a = "plant1/line4/sensors/temperature";
+    std::string b = a;
+
+    auto id = interner.intern(a);
+    EXPECT_NE(id, StringInterner::EMPTY_ID);
+    EXPECT_EQ(interner.intern(b), id);
+    EXPECT_NE(interner.intern("plant1/line4/sensors/pressure"), id);
+    EXPECT_EQ(interner.size(), 3u);
+}
+
+TEST_F(StringInternerTest, ViewRoundTrip) {
+    auto id = interner.intern("sensors/temp1");
+    EXPECT_EQ(interner.view(id), "sensors/temp1");
+    EXPECT_EQ(interner.view(12345), "");
+}
+
+TEST_F(StringInternerTest, FindDoesNotInsert) {
+    EXPECT_FALSE(interner.find("unknown").has_value());
+    EXPECT_EQ(interner.size(), 1u);
+
+    auto id = interner.intern("known");
+    EXPECT_EQ(interner.find("known"), id);
+}
+
+TEST_F(StringInternerTest, GrowsPastOneChunk) {
+    std::vector<StringInterner::Id> ids;
+    for (size_t i = 0; i < StringInterner::CHUNK_SIZE + 10; ++i) {
+        ids.push_back(interner.intern("topic/" + std::to_string(i)));
+    }
+    for (size_t i = 0; i < ids.size(); ++i) {
+        EXPECT_EQ(interner.view(ids[i]), "topic/" + std::to_string(i));
+    }
+}
+
+TEST_F(StringInternerTest, ConcurrentInterningAgreesOnIds) {
+    constexpr size_t THREADS = 4;
+    constexpr size_t STRINGS = 500;
+
+    std::vector<std::vector<StringInterner::Id>> ids(THREADS);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < STRINGS; ++i) {
+                ids[t].push_back(interner.intern("s" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t t = 1; t < THREADS; ++t) {
+        EXPECT_EQ(ids[t], ids[0]);
+    }
+    EXPECT_EQ(std::set<StringInterner::Id>(ids[0].begin(), ids[0].end()).size(), STRINGS);
+    EXPECT_EQ(interner.size(), STRINGS + 1);
+}
+
+// ============================================================================
+// InternedString Tests
+// ============================================================================
+
+TEST(InternedStringTest, DefaultIsEmpty) {
+    InternedString s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_EQ(s.id(), StringInterner::EMPTY_ID);
+    EXPECT_EQ(s.view(), "");
+}
+
+TEST(InternedStringTest, HandlesCompareById) {
+    InternedString a("sensors/temperature");
+    InternedString b(std::string("sensors/temperature"));
+    InternedString c("sensors/pressure");
+
+    EXPECT_EQ(a.id(), b.id());
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a == c);
+    EXPECT_EQ(a, "sensors/temperature");
+    EXPECT_EQ(InternedString::from_id(a.id()), a);
+}
+
+TEST(InternedStringTest, AssignFromText) {
+    InternedString s;
+    s = "test/topic";
+    EXPECT_FALSE(s.empty());
+    EXPECT_EQ(s.view(), "test/topic");
+
+    std::string_view text = s;
+    EXPECT_EQ(text, "test/topic");
+}
+
+TEST(InternedStringTest, FindOnlyReturnsKnownText) {
+    EXPECT_TRUE(InternedString::find("interned_string_test/unknown").empty());
+    EXPECT_FALSE(StringInterner::global().find("interned_string_test/unknown").has_value());
+
+    InternedString known("interned_string_test/known");
+    EXPECT_EQ(InternedString::find("interned_string_test/known"), known);
+}